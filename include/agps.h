@@ -0,0 +1,13 @@
+// agps.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// AssistNow Online (u-blox) : éphémérides, almanach et position/heure approchées
+// Les données sont téléchargées (AGPS_URL), mises en cache dans LittleFS puis
+// injectées dans le récepteur au démarrage pour réduire le temps du premier fix.
+// ====================================================================================
+
+// Injecte le cache s'il est récent, sinon le télécharge d'abord (WiFi requis).
+// Renvoie true si des données d'assistance ont été envoyées au récepteur.
+bool agpsBegin(Stream &gpsPort, double approxLat, double approxLon);
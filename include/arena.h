@@ -0,0 +1,59 @@
+// arena.h
+#pragma once
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ====================================================================================
+// Arène d'allocation par récupération
+// Un bloc unique réservé au démarrage (PSRAM si la carte en a, sinon RAM interne)
+// fournit toutes les allocations temporaires d'une récupération (document JSON,
+// filtre, fenêtre gzip si la place le permet). Les blocs sont empilés ; reset() les
+// libère tous d'un coup. Le tas général ne voit ni ces allocations ni leurs trous.
+// ====================================================================================
+
+class Arena {
+public:
+  // Réserve la zone une fois pour toutes ; false si aucune réservation n'a abouti
+  bool begin(size_t psramBytes, size_t internalBytes);
+
+  void *allocate(size_t size);           // nullptr si l'arène est pleine
+  void *reallocate(void *ptr, size_t size); // agrandi sur place si c'est le dernier bloc
+  void deallocate(void *ptr);            // seul le dernier bloc est réellement rendu
+  void reset();                          // libère tout (fin de récupération)
+
+  bool ready() const { return _base != nullptr; }
+  bool owns(const void *ptr) const { return _base && ptr >= _base && ptr < _base + _size; }
+  size_t blockSize(const void *ptr) const; // taille demandée d'un bloc de l'arène
+  bool inPsram() const { return _psram; }
+  size_t capacity() const { return _size; }
+  size_t used() const { return _top; }
+  size_t peak() const { return _peak; }           // depuis le dernier reset
+  size_t highWater() const { return _highWater; } // depuis le démarrage
+  uint32_t failures() const { return _failures; } // demandes refusées (arène pleine ; repli sur le tas)
+
+private:
+  uint8_t *_base = nullptr;
+  size_t _size = 0;
+  size_t _top = 0;
+  size_t _last = SIZE_MAX; // décalage de l'en-tête du dernier bloc
+  size_t _peak = 0;
+  size_t _highWater = 0;
+  uint32_t _failures = 0;
+  bool _psram = false;
+};
+
+// Allocateur ArduinoJson adossé à une arène (JsonDocument doc(&allocator)). Si l'arène
+// n'est pas réservée ou est pleine, les blocs sont pris sur le tas (comptés dans failures())
+class ArenaJsonAllocator : public ArduinoJson::Allocator {
+public:
+  explicit ArenaJsonAllocator(Arena &arena) : _arena(arena) {}
+  void *allocate(size_t size) override;
+  void deallocate(void *ptr) override;
+  void *reallocate(void *ptr, size_t size) override;
+
+private:
+  Arena &_arena;
+};
+
+// Arène partagée des récupérations réseau (météo), réservée dans setup()
+extern Arena fetchArena;
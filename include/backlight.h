@@ -0,0 +1,19 @@
+// backlight.h
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+
+// Rétroéclairage adaptatif piloté par le capteur de luminosité (PIN_LIGHT_SENSOR)
+// et mise en veille de l'écran après une période sans appui bouton.
+
+void backlightBegin(Adafruit_ST77xx &panel);
+void backlightLoop();                 // tâche périodique (BACKLIGHT_SAMPLE_MS)
+// Signale une activité utilisateur ; renvoie true si l'écran vient d'être réveillé
+bool backlightNotifyActivity();
+bool backlightIsAsleep();              // écran éteint ou en cours d'extinction
+bool backlightIsLowLight();           // luminosité lissée sous LUMIN_LOW_THRESHOLD
+uint8_t backlightAmbientPct();        // luminosité ambiante lissée (0..100 %)
+uint8_t backlightDuty();              // consigne courante du PWM (0..255)
+uint8_t backlightAvgDutyPct();        // rapport cyclique moyen depuis le boot (%)
+// Économie estimée par jour vs rétroéclairage fixe à 200/255 (mWh/jour)
+uint32_t backlightSavedMwhPerDay();
@@ -0,0 +1,35 @@
+// baro_forecast.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Prévision locale à court terme (méthode Zambretti) à partir de la pression BME280
+// Historique de la pression station sur 3 h (un point toutes les BARO_HISTORY_STEP_MS),
+// pression ramenée au niveau de la mer avec l'altitude GPS, puis classement par tables
+// (tendance x pression) en une des 26 prévisions Zambretti. Aucun réseau nécessaire.
+// ====================================================================================
+
+#define BARO_HISTORY_LEN (3 * 3600000UL / BARO_HISTORY_STEP_MS + 1)
+
+struct BaroForecast {
+  bool valid;          // au moins une mesure de pression
+  bool trendValid;     // historique suffisant (BARO_MIN_SPAN_MS), sinon tendance « stable »
+  float stationHpa;    // pression mesurée
+  float seaLevelHpa;   // ramenée au niveau de la mer
+  float trendHpa3h;    // variation ramenée à 3 h
+  int8_t trend;        // -1 baisse, 0 stable, +1 hausse
+  uint8_t z;           // indice Zambretti 1..32
+  char letter;         // 'A' (beau stable) .. 'Z' (tempête)
+  const char *text;    // texte court, ASCII
+  const char *icon;    // code d'icône (drawWeatherIcon)
+  uint32_t classifyUs; // coût du dernier classement
+};
+
+// Classement seul : pression niveau mer (hPa), tendance -1/0/+1, saison +1 été / -1 hiver / 0 inconnue
+uint8_t zambrettiIndex(float seaLevelHpa, int8_t trend, int8_t season);
+char zambrettiLetter(uint8_t z);
+const char *zambrettiText(char letter);
+const char *zambrettiIcon(char letter);
+
+// Ajoute une mesure (appelé à chaque lecture du capteur) et reclasse
+void baroAddSample(float stationHpa, float altitudeM, double latitude, BaroForecast &out);
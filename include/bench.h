@@ -0,0 +1,29 @@
+// bench.h
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ====================================================================================
+// Micro-bancs d'essai sur cible (firmware Meteo_Station_bench, METEO_BENCH=1)
+// Chaque cas est exécuté après un tour de chauffe (caches flash et polices chargés),
+// chaque exécution étant chronométrée avec le compteur de cycles du CPU (CCOUNT).
+// Les résultats sortent sur le port série en lignes JSON préfixées "BENCH ", une par
+// cas, comparées d'une version à l'autre par tools/bench_compare.py.
+// ====================================================================================
+
+typedef void (*BenchFn)();
+
+struct BenchResult {
+  uint16_t iterations;
+  uint32_t minCycles;
+  uint32_t medianCycles;
+  uint32_t meanCycles;
+  uint32_t maxCycles;
+};
+
+// Ligne d'en-tête : version, fréquence CPU, version ESP-IDF, tas libre
+void benchBegin();
+// Chronomètre 'iterations' exécutions de fn (au plus BENCH_MAX_ITERATIONS) et publie la ligne du cas
+BenchResult benchRun(const char *name, BenchFn fn, uint16_t iterations = BENCH_ITERATIONS);
+// Ligne de fin : nombre de cas et durée de la série
+void benchEnd();
@@ -0,0 +1,69 @@
+// bench_payload.h
+#pragma once
+#include <Arduino.h>
+
+// Réponse OneCall type (48 h, 8 jours, une alerte) pour le banc d'analyse JSON ;
+// mêmes champs que l'API, en flash
+static const char BENCH_ONECALL_JSON[] PROGMEM = R"json(
+{"lat":44.83,"lon":-0.57,"timezone":"Europe/Paris","timezone_offset":7200,
+"current":{"dt":1792461600,"sunrise":1792439200,"sunset":1792477200,"temp":17.42,"feels_like":17.05,"pressure":1014,"humidity":72,"dew_point":12.31,"uvi":1.84,"clouds":40,"visibility":10000,"wind_speed":4.63,"wind_deg":240,"wind_gust":8.2,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}]},
+"hourly":[
+{"dt":1792461600,"temp":10.17,"feels_like":9.77,"pressure":1014,"humidity":70,"dew_point":5.17,"uvi":0,"clouds":0,"visibility":10000,"wind_speed":3.0,"wind_deg":200,"wind_gust":6.0,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.0},
+{"dt":1792465200,"temp":11.0,"feels_like":10.6,"pressure":1014,"humidity":71,"dew_point":6.0,"uvi":0,"clouds":7,"visibility":10000,"wind_speed":3.4,"wind_deg":203,"wind_gust":6.49,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.13},
+{"dt":1792468800,"temp":11.96,"feels_like":11.56,"pressure":1014,"humidity":72,"dew_point":6.96,"uvi":0,"clouds":14,"visibility":10000,"wind_speed":3.78,"wind_deg":206,"wind_gust":6.96,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.26},
+{"dt":1792472400,"temp":13.0,"feels_like":12.6,"pressure":1014,"humidity":73,"dew_point":8.0,"uvi":0,"clouds":21,"visibility":10000,"wind_speed":4.13,"wind_deg":209,"wind_gust":7.36,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.39},
+{"dt":1792476000,"temp":14.04,"feels_like":13.64,"pressure":1014,"humidity":74,"dew_point":9.04,"uvi":0.52,"clouds":28,"visibility":10000,"wind_speed":4.43,"wind_deg":212,"wind_gust":7.68,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.52},
+{"dt":1792479600,"temp":15.0,"feels_like":14.6,"pressure":1014,"humidity":75,"dew_point":10.0,"uvi":1.0,"clouds":35,"visibility":10000,"wind_speed":4.68,"wind_deg":215,"wind_gust":7.9,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.65},
+{"dt":1792483200,"temp":15.83,"feels_like":15.43,"pressure":1014,"humidity":76,"dew_point":10.83,"uvi":1.41,"clouds":42,"visibility":10000,"wind_speed":4.86,"wind_deg":218,"wind_gust":7.99,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.78},
+{"dt":1792486800,"temp":16.46,"feels_like":16.06,"pressure":1014,"humidity":77,"dew_point":11.46,"uvi":1.73,"clouds":49,"visibility":10000,"wind_speed":4.97,"wind_deg":221,"wind_gust":7.97,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.91},
+{"dt":1792490400,"temp":16.86,"feels_like":16.46,"pressure":1013,"humidity":78,"dew_point":11.86,"uvi":1.93,"clouds":56,"visibility":10000,"wind_speed":5.0,"wind_deg":224,"wind_gust":7.82,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.04},
+{"dt":1792494000,"temp":17.0,"feels_like":16.6,"pressure":1013,"humidity":79,"dew_point":12.0,"uvi":2.0,"clouds":63,"visibility":10000,"wind_speed":4.95,"wind_deg":227,"wind_gust":7.56,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.17},
+{"dt":1792497600,"temp":16.86,"feels_like":16.46,"pressure":1013,"humidity":80,"dew_point":11.86,"uvi":1.93,"clouds":70,"visibility":10000,"wind_speed":4.82,"wind_deg":230,"wind_gust":7.2,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.3},
+{"dt":1792501200,"temp":16.46,"feels_like":16.06,"pressure":1013,"humidity":81,"dew_point":11.46,"uvi":1.73,"clouds":77,"visibility":10000,"wind_speed":4.62,"wind_deg":233,"wind_gust":6.76,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.43},
+{"dt":1792504800,"temp":15.83,"feels_like":15.43,"pressure":1013,"humidity":82,"dew_point":10.83,"uvi":1.41,"clouds":84,"visibility":10000,"wind_speed":4.35,"wind_deg":236,"wind_gust":6.28,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.56},
+{"dt":1792508400,"temp":15.0,"feels_like":14.6,"pressure":1013,"humidity":83,"dew_point":10.0,"uvi":1.0,"clouds":91,"visibility":10000,"wind_speed":4.03,"wind_deg":239,"wind_gust":5.78,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.69},
+{"dt":1792512000,"temp":14.04,"feels_like":13.64,"pressure":1013,"humidity":84,"dew_point":9.04,"uvi":0.52,"clouds":98,"visibility":10000,"wind_speed":3.67,"wind_deg":242,"wind_gust":5.3,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.82},
+{"dt":1792515600,"temp":13.0,"feels_like":12.6,"pressure":1013,"humidity":70,"dew_point":8.0,"uvi":0.0,"clouds":5,"visibility":10000,"wind_speed":3.28,"wind_deg":245,"wind_gust":4.86,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.95},
+{"dt":1792519200,"temp":11.96,"feels_like":11.56,"pressure":1012,"humidity":71,"dew_point":6.96,"uvi":0,"clouds":12,"visibility":10000,"wind_speed":2.88,"wind_deg":248,"wind_gust":4.49,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.08},
+{"dt":1792522800,"temp":11.0,"feels_like":10.6,"pressure":1012,"humidity":72,"dew_point":6.0,"uvi":0,"clouds":19,"visibility":10000,"wind_speed":2.49,"wind_deg":251,"wind_gust":4.21,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.21},
+{"dt":1792526400,"temp":10.17,"feels_like":9.77,"pressure":1012,"humidity":73,"dew_point":5.17,"uvi":0,"clouds":26,"visibility":10000,"wind_speed":2.11,"wind_deg":254,"wind_gust":4.04,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.34},
+{"dt":1792530000,"temp":9.54,"feels_like":9.14,"pressure":1012,"humidity":74,"dew_point":4.54,"uvi":0,"clouds":33,"visibility":10000,"wind_speed":1.78,"wind_deg":257,"wind_gust":4.0,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.47},
+{"dt":1792533600,"temp":9.14,"feels_like":8.74,"pressure":1012,"humidity":75,"dew_point":4.14,"uvi":0,"clouds":40,"visibility":10000,"wind_speed":1.49,"wind_deg":260,"wind_gust":4.08,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.6},
+{"dt":1792537200,"temp":9.0,"feels_like":8.6,"pressure":1012,"humidity":76,"dew_point":4.0,"uvi":0,"clouds":47,"visibility":10000,"wind_speed":1.26,"wind_deg":263,"wind_gust":4.28,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.73},
+{"dt":1792540800,"temp":9.14,"feels_like":8.74,"pressure":1012,"humidity":77,"dew_point":4.14,"uvi":0,"clouds":54,"visibility":10000,"wind_speed":1.1,"wind_deg":266,"wind_gust":4.59,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.86},
+{"dt":1792544400,"temp":9.54,"feels_like":9.14,"pressure":1012,"humidity":78,"dew_point":4.54,"uvi":0,"clouds":61,"visibility":10000,"wind_speed":1.01,"wind_deg":269,"wind_gust":4.98,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"pop":0.99},
+{"dt":1792548000,"temp":10.17,"feels_like":9.77,"pressure":1011,"humidity":79,"dew_point":5.17,"uvi":0,"clouds":68,"visibility":10000,"wind_speed":1.01,"wind_deg":272,"wind_gust":5.44,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.12},
+{"dt":1792551600,"temp":11.0,"feels_like":10.6,"pressure":1011,"humidity":80,"dew_point":6.0,"uvi":0,"clouds":75,"visibility":10000,"wind_speed":1.08,"wind_deg":275,"wind_gust":5.93,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.25},
+{"dt":1792555200,"temp":11.96,"feels_like":11.56,"pressure":1011,"humidity":81,"dew_point":6.96,"uvi":0,"clouds":82,"visibility":10000,"wind_speed":1.23,"wind_deg":278,"wind_gust":6.43,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.38},
+{"dt":1792558800,"temp":13.0,"feels_like":12.6,"pressure":1011,"humidity":82,"dew_point":8.0,"uvi":0,"clouds":89,"visibility":10000,"wind_speed":1.45,"wind_deg":281,"wind_gust":6.9,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.51},
+{"dt":1792562400,"temp":14.04,"feels_like":13.64,"pressure":1011,"humidity":83,"dew_point":9.04,"uvi":0.52,"clouds":96,"visibility":10000,"wind_speed":1.74,"wind_deg":284,"wind_gust":7.31,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.64},
+{"dt":1792566000,"temp":15.0,"feels_like":14.6,"pressure":1011,"humidity":84,"dew_point":10.0,"uvi":1.0,"clouds":3,"visibility":10000,"wind_speed":2.07,"wind_deg":287,"wind_gust":7.65,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"pop":0.77},
+{"dt":1792569600,"temp":15.83,"feels_like":15.43,"pressure":1011,"humidity":70,"dew_point":10.83,"uvi":1.41,"clouds":10,"visibility":10000,"wind_speed":2.44,"wind_deg":290,"wind_gust":7.88,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.9},
+{"dt":1792573200,"temp":16.46,"feels_like":16.06,"pressure":1011,"humidity":71,"dew_point":11.46,"uvi":1.73,"clouds":17,"visibility":10000,"wind_speed":2.83,"wind_deg":293,"wind_gust":7.99,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.03},
+{"dt":1792576800,"temp":16.86,"feels_like":16.46,"pressure":1010,"humidity":72,"dew_point":11.86,"uvi":1.93,"clouds":24,"visibility":10000,"wind_speed":3.23,"wind_deg":296,"wind_gust":7.98,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.16},
+{"dt":1792580400,"temp":17.0,"feels_like":16.6,"pressure":1010,"humidity":73,"dew_point":12.0,"uvi":2.0,"clouds":31,"visibility":10000,"wind_speed":3.62,"wind_deg":299,"wind_gust":7.85,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.29},
+{"dt":1792584000,"temp":16.86,"feels_like":16.46,"pressure":1010,"humidity":74,"dew_point":11.86,"uvi":1.93,"clouds":38,"visibility":10000,"wind_speed":3.99,"wind_deg":302,"wind_gust":7.6,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.42},
+{"dt":1792587600,"temp":16.46,"feels_like":16.06,"pressure":1010,"humidity":75,"dew_point":11.46,"uvi":1.73,"clouds":45,"visibility":10000,"wind_speed":4.31,"wind_deg":305,"wind_gust":7.25,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"pop":0.55},
+{"dt":1792591200,"temp":15.83,"feels_like":15.43,"pressure":1010,"humidity":76,"dew_point":10.83,"uvi":1.41,"clouds":52,"visibility":10000,"wind_speed":4.59,"wind_deg":308,"wind_gust":6.82,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.68},
+{"dt":1792594800,"temp":15.0,"feels_like":14.6,"pressure":1010,"humidity":77,"dew_point":10.0,"uvi":1.0,"clouds":59,"visibility":10000,"wind_speed":4.8,"wind_deg":311,"wind_gust":6.35,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.81},
+{"dt":1792598400,"temp":14.04,"feels_like":13.64,"pressure":1010,"humidity":78,"dew_point":9.04,"uvi":0.52,"clouds":66,"visibility":10000,"wind_speed":4.94,"wind_deg":314,"wind_gust":5.85,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.94},
+{"dt":1792602000,"temp":13.0,"feels_like":12.6,"pressure":1010,"humidity":79,"dew_point":8.0,"uvi":0.0,"clouds":73,"visibility":10000,"wind_speed":5.0,"wind_deg":317,"wind_gust":5.36,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.07},
+{"dt":1792605600,"temp":11.96,"feels_like":11.56,"pressure":1009,"humidity":80,"dew_point":6.96,"uvi":0,"clouds":80,"visibility":10000,"wind_speed":4.98,"wind_deg":320,"wind_gust":4.91,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.2},
+{"dt":1792609200,"temp":11.0,"feels_like":10.6,"pressure":1009,"humidity":81,"dew_point":6.0,"uvi":0,"clouds":87,"visibility":10000,"wind_speed":4.88,"wind_deg":323,"wind_gust":4.53,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"pop":0.33},
+{"dt":1792612800,"temp":10.17,"feels_like":9.77,"pressure":1009,"humidity":82,"dew_point":5.17,"uvi":0,"clouds":94,"visibility":10000,"wind_speed":4.71,"wind_deg":326,"wind_gust":4.24,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.46},
+{"dt":1792616400,"temp":9.54,"feels_like":9.14,"pressure":1009,"humidity":83,"dew_point":4.54,"uvi":0,"clouds":1,"visibility":10000,"wind_speed":4.47,"wind_deg":329,"wind_gust":4.06,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.59},
+{"dt":1792620000,"temp":9.14,"feels_like":8.74,"pressure":1009,"humidity":84,"dew_point":4.14,"uvi":0,"clouds":8,"visibility":10000,"wind_speed":4.17,"wind_deg":332,"wind_gust":4.0,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.72},
+{"dt":1792623600,"temp":9.0,"feels_like":8.6,"pressure":1009,"humidity":70,"dew_point":4.0,"uvi":0,"clouds":15,"visibility":10000,"wind_speed":3.82,"wind_deg":335,"wind_gust":4.06,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.85},
+{"dt":1792627200,"temp":9.14,"feels_like":8.74,"pressure":1009,"humidity":71,"dew_point":4.14,"uvi":0,"clouds":22,"visibility":10000,"wind_speed":3.45,"wind_deg":338,"wind_gust":4.25,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.98},
+{"dt":1792630800,"temp":9.54,"feels_like":9.14,"pressure":1009,"humidity":72,"dew_point":4.54,"uvi":0,"clouds":29,"visibility":10000,"wind_speed":3.05,"wind_deg":341,"wind_gust":4.54,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"pop":0.11}],
+"daily":[
+{"dt":1792454400,"sunrise":1792439200,"sunset":1792477200,"moonrise":1792461200,"moonset":1792421200,"moon_phase":0.0,"summary":"Journée avec des averses","temp":{"day":17.4,"min":10.2,"max":18.6,"night":11.8,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1013,"humidity":68,"dew_point":11.2,"wind_speed":4.1,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"clouds":60,"pop":0.0,"rain":1.2,"uvi":2.1},
+{"dt":1792540800,"sunrise":1792525600,"sunset":1792563600,"moonrise":1792547600,"moonset":1792507600,"moon_phase":0.1,"summary":"Journée avec des averses","temp":{"day":17.1,"min":10.0,"max":18.3,"night":11.6,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1014,"humidity":69,"dew_point":11.2,"wind_speed":4.4,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"clouds":60,"pop":0.1,"rain":1.2,"uvi":2.1},
+{"dt":1792627200,"sunrise":1792612000,"sunset":1792650000,"moonrise":1792634000,"moonset":1792594000,"moon_phase":0.2,"summary":"Journée avec des averses","temp":{"day":16.8,"min":9.8,"max":18.0,"night":11.4,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1015,"humidity":70,"dew_point":11.2,"wind_speed":4.7,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"clouds":60,"pop":0.2,"rain":1.2,"uvi":2.1},
+{"dt":1792713600,"sunrise":1792698400,"sunset":1792736400,"moonrise":1792720400,"moonset":1792680400,"moon_phase":0.3,"summary":"Journée avec des averses","temp":{"day":16.5,"min":9.6,"max":17.7,"night":11.2,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1016,"humidity":71,"dew_point":11.2,"wind_speed":5.0,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":501,"main":"Rain","description":"pluie modérée","icon":"10d"}],"clouds":60,"pop":0.3,"rain":1.2,"uvi":2.1},
+{"dt":1792800000,"sunrise":1792784800,"sunset":1792822800,"moonrise":1792806800,"moonset":1792766800,"moon_phase":0.4,"summary":"Journée avec des averses","temp":{"day":16.2,"min":9.4,"max":17.4,"night":11.0,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1017,"humidity":72,"dew_point":11.2,"wind_speed":5.3,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":800,"main":"Clear","description":"ciel dégagé","icon":"01d"}],"clouds":60,"pop":0.4,"rain":1.2,"uvi":2.1},
+{"dt":1792886400,"sunrise":1792871200,"sunset":1792909200,"moonrise":1792893200,"moonset":1792853200,"moon_phase":0.5,"summary":"Journée avec des averses","temp":{"day":15.9,"min":9.2,"max":17.1,"night":10.8,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1018,"humidity":73,"dew_point":11.2,"wind_speed":5.6,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":802,"main":"Clouds","description":"partiellement nuageux","icon":"03d"}],"clouds":60,"pop":0.5,"rain":1.2,"uvi":2.1},
+{"dt":1792972800,"sunrise":1792957600,"sunset":1792995600,"moonrise":1792979600,"moonset":1792939600,"moon_phase":0.6,"summary":"Journée avec des averses","temp":{"day":15.6,"min":9.0,"max":16.8,"night":10.6,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1019,"humidity":74,"dew_point":11.2,"wind_speed":5.9,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":804,"main":"Clouds","description":"couvert","icon":"04d"}],"clouds":60,"pop":0.6,"rain":1.2,"uvi":2.1},
+{"dt":1793059200,"sunrise":1793044000,"sunset":1793082000,"moonrise":1793066000,"moonset":1793026000,"moon_phase":0.7,"summary":"Journée avec des averses","temp":{"day":15.3,"min":8.8,"max":16.5,"night":10.4,"eve":15.1,"morn":10.9},"feels_like":{"day":17.0,"night":11.2,"eve":14.7,"morn":10.3},"pressure":1020,"humidity":75,"dew_point":11.2,"wind_speed":6.2,"wind_deg":230,"wind_gust":9.4,"weather":[{"id":500,"main":"Rain","description":"légère pluie","icon":"10d"}],"clouds":60,"pop":0.7,"rain":1.2,"uvi":2.1}],
+"alerts":[{"sender_name":"METEO-FRANCE","event":"Vigilance jaune orages","start":1792468800,"end":1792512000,"description":"Orages localement forts en fin de journée, avec grêle et rafales de 70 à 80 km/h.","tags":["Thunderstorm"]}]}
+)json";
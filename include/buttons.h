@@ -3,49 +3,180 @@
 #include <Arduino.h>
 #include "config.h"
 
-// --- [DEPRECATED] Ce fichier n'est plus utilisé ---
-// La gestion des boutons a été déplacée dans main.cpp (fonction getButtonEvent())
-// pour éviter les problèmes de configuration et de synchronisation.
-// Le code est conservé ici pour référence future.
-
-/*
-// Déclarations anticipées (forward declarations) des variables et fonctions
-// qui sont définies dans main.cpp mais utilisées ici.
-enum Page : int;
-extern Page currentPage;
-void renderPage();
-
-namespace Buttons {
-
-constexpr unsigned long DEBOUNCE_DELAY = 50; // ms
-unsigned long lastDebounceTime = 0;
-
-void setup() {
-    pinMode(PIN_BTN1, INPUT);
-    pinMode(PIN_BTN2, INPUT);
-}
-
-void loop() {
-    if ((millis() - lastDebounceTime) > DEBOUNCE_DELAY) {
-        static int lastBtn1State = HIGH;
-        static int lastBtn2State = HIGH;
-        int btn1Reading = digitalRead(PIN_BTN1);
-        int btn2Reading = digitalRead(PIN_BTN2);
-
-        if (btn1Reading == LOW && lastBtn1State == HIGH) {
-            currentPage = (Page)((currentPage + 1) % 5);
-            renderPage();
-            lastDebounceTime = millis();
+// ====================================================================================
+// Gestion des boutons par interruptions
+// Les fronts sont capturés en ISR (horodatés) et poussés dans une file ; le debouncing
+// et la reconnaissance des gestes se font ensuite sur ces horodatages, ce qui évite de
+// perdre un appui pendant que loop() est bloquée (réseau) ou que le CPU dort.
+// ====================================================================================
+
+enum ButtonGesture : uint8_t {
+  BTN_GESTURE_NONE,
+  BTN_GESTURE_SHORT,   // appui court (émis dès le relâchement)
+  BTN_GESTURE_LONG,    // appui maintenu BTN_LONG_PRESS_MS
+  BTN_GESTURE_CHORD,   // deux boutons enfoncés ensemble (émis pour le second bouton)
+  BTN_GESTURE_REPEAT   // répétition automatique tant que le bouton reste maintenu
+};
+
+struct ButtonEvent {
+  uint8_t button;       // index du bouton (0 = BTN1, 1 = BTN2)
+  ButtonGesture gesture;
+  uint32_t timeMs;      // horodatage du front à l'origine du geste
+};
+
+// Front brut capturé en ISR
+struct ButtonEdge {
+  uint8_t button;
+  bool pressed;
+  uint32_t timeMs;
+};
+
+// Machine à états unique pour N boutons, pilotée par horodatages.
+template <uint8_t N>
+class ButtonMachine {
+public:
+  void reset(const bool pressed[N], uint32_t now) {
+    for (uint8_t i = 0; i < N; i++) {
+      Btn &b = _btn[i];
+      b.state = pressed[i] ? ST_IGNORE : ST_IDLE;
+      b.stable = b.raw = pressed[i];
+      b.rawT = b.pendingSince = now;
+    }
+    _head = _count = 0;
+  }
+
+  // Front brut (ordre chronologique par bouton)
+  void onEdge(uint8_t i, bool pressed, uint32_t t) {
+    if (i >= N) return;
+    advance(i, t);
+    Btn &b = _btn[i];
+    if (pressed == b.raw) return;
+    if (b.raw == b.stable) b.pendingSince = t; // début d'une transition
+    b.raw = pressed;
+    b.rawT = t;
+  }
+
+  // Fait avancer les temporisations jusqu'à 'now' puis dépile un événement
+  bool poll(uint32_t now, ButtonEvent &evt) {
+    for (uint8_t i = 0; i < N; i++) advance(i, now);
+    if (_count == 0) return false;
+    evt = _events[_head];
+    _head = (_head + 1) % EVENT_QUEUE_LEN;
+    _count--;
+    return true;
+  }
+
+  // Délai (ms) avant la prochaine échéance interne, UINT32_MAX si aucune
+  uint32_t msUntilNextDeadline(uint32_t now) const {
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < N; i++) {
+      const Btn &b = _btn[i];
+      uint32_t due = UINT32_MAX;
+      if (b.raw != b.stable) due = b.rawT + BTN_DEBOUNCE_MS;
+      else if (b.state == ST_DOWN) due = b.downT + BTN_LONG_PRESS_MS;
+      else if (b.state == ST_HELD) due = b.nextRepeatT;
+      if (due == UINT32_MAX) continue;
+      uint32_t wait = (int32_t)(due - now) > 0 ? due - now : 0;
+      if (wait < best) best = wait;
+    }
+    return best;
+  }
+
+  bool isPressed(uint8_t i) const { return i < N && _btn[i].stable; }
+
+private:
+  enum State : uint8_t { ST_IDLE, ST_DOWN, ST_HELD, ST_IGNORE };
+  static constexpr uint8_t EVENT_QUEUE_LEN = 8;
+
+  struct Btn {
+    State state;
+    bool stable, raw;
+    uint32_t rawT, pendingSince, downT, nextRepeatT;
+  };
+
+  Btn _btn[N] = {};
+  ButtonEvent _events[EVENT_QUEUE_LEN];
+  uint8_t _head = 0, _count = 0;
+
+  void emit(uint8_t i, ButtonGesture g, uint32_t t) {
+    if (_count == EVENT_QUEUE_LEN) return; // file pleine : l'événement est perdu
+    _events[(_head + _count) % EVENT_QUEUE_LEN] = {i, g, t};
+    _count++;
+  }
+
+  // Échéances temporelles (appui long, répétition)
+  void timeouts(uint8_t i, uint32_t t) {
+    Btn &b = _btn[i];
+    switch (b.state) {
+      case ST_DOWN:
+        if ((int32_t)(t - b.downT) >= BTN_LONG_PRESS_MS) {
+          emit(i, BTN_GESTURE_LONG, b.downT);
+          b.state = ST_HELD;
+          b.nextRepeatT = b.downT + BTN_LONG_PRESS_MS + BTN_REPEAT_DELAY_MS;
+        }
+        break;
+      case ST_HELD:
+        while ((int32_t)(t - b.nextRepeatT) >= 0) {
+          emit(i, BTN_GESTURE_REPEAT, b.nextRepeatT);
+          b.nextRepeatT += BTN_REPEAT_INTERVAL_MS;
         }
-        if (btn2Reading == LOW && lastBtn2State == HIGH) {
-            currentPage = (Page)((currentPage + 4) % 5); // (current - 1 + 5) % 5
-            renderPage();
-            lastDebounceTime = millis();
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Transition validée (signal stable pendant BTN_DEBOUNCE_MS)
+  void commit(uint8_t i, bool pressed, uint32_t t) {
+    Btn &b = _btn[i];
+    b.stable = pressed;
+    switch (b.state) {
+      case ST_IDLE:
+        if (!pressed) break;
+        b.state = ST_DOWN;
+        b.downT = t;
+        // Un autre bouton déjà enfoncé (appui court en cours) : accord des deux boutons,
+        // aucun appui court ni long n'est émis pour eux
+        for (uint8_t j = 0; j < N; j++) {
+          if (j == i || _btn[j].state != ST_DOWN) continue;
+          emit(i, BTN_GESTURE_CHORD, t);
+          _btn[j].state = ST_IGNORE;
+          b.state = ST_IGNORE;
+          break;
         }
-        lastBtn1State = btn1Reading;
-        lastBtn2State = btn2Reading;
+        break;
+      case ST_DOWN:
+        if (!pressed) { emit(i, BTN_GESTURE_SHORT, b.downT); b.state = ST_IDLE; }
+        break;
+      case ST_HELD:
+      case ST_IGNORE: // maintenu au démarrage ou accord : attendre le relâchement
+        if (!pressed) b.state = ST_IDLE;
+        break;
     }
-}
+  }
+
+  void advance(uint8_t i, uint32_t t) {
+    Btn &b = _btn[i];
+    if (b.raw != b.stable && (int32_t)(t - b.rawT) >= BTN_DEBOUNCE_MS) {
+      uint32_t commitT = b.pendingSince;
+      // Les autres boutons d'abord jusqu'à cet instant : un accord est reconnu dans
+      // l'ordre des fronts même si loop() dépile les deux transitions en retard
+      for (uint8_t j = 0; j < N; j++) {
+        if (j != i) advance(j, commitT);
+      }
+      timeouts(i, commitT);
+      commit(i, b.raw, commitT);
+    }
+    timeouts(i, t);
+  }
+};
+
+#define NUM_BUTTONS 2
 
-} // namespace Buttons
-*/
\ No newline at end of file
+void buttonsBegin();
+// Dépile le prochain geste reconnu ; false si aucun
+bool buttonsPoll(ButtonEvent &evt);
+// Délai avant la prochaine échéance de la machine à états (UINT32_MAX si aucune)
+uint32_t buttonsMsUntilNextDeadline();
+// Horodatage du dernier front capturé (activité utilisateur)
+uint32_t buttonsLastActivityMs();
@@ -1,7 +1,7 @@
 #pragma once
 
-// v1.0.20-dev - Ajout logs debug détaillés (API météo, clé, HTTP, JSON, affichage)
-#define DIAGNOSTIC_VERSION "1.0.20-dev"
+// v1.0.71-dev - Météo : journal des en-têtes sans String temporaire
+#define DIAGNOSTIC_VERSION "1.0.71-dev"
 
 // Vérification de la présence du fichier secrets.h
 #ifndef __has_include
@@ -32,12 +32,28 @@
 // Deux boutons
 #define PIN_BTN1 34      // GPIO 34 : Input Only - (Sélectionné pour le "safe boot" à la place de GPIO 0)
 #define PIN_BTN2 27      // GPIO 27 : Input
+// Boutons : temporisations (ms)
+#define BTN_DEBOUNCE_MS 50          // Temps de stabilisation du signal
+#define BTN_LONG_PRESS_MS 800       // Durée d'un appui long
+#define BTN_REPEAT_DELAY_MS 500     // Délai avant répétition automatique (après l'appui long)
+#define BTN_REPEAT_INTERVAL_MS 150  // Période de répétition automatique
+#define BTN_EDGE_QUEUE_LEN 32       // Fronts en attente de traitement
 // Buzzer
 #define PIN_BUZZER 25    // GPIO 25 : Output pour le Buzzer
 // Moduel GPS GT-U7 (UART 2)
 #define PIN_GPS_RX 16    // GPIO 16 (RX2) : Réception (vers GPS TX)
 #define PIN_GPS_TX 17    // GPIO 17 (TX2) : Transmission (vers GPS RX)
 #define PIN_GPS_PPS 26   // GPIO 26 : Pulse Per Second
+#define GPS_BAUD 38400            // débit UART après configuration UBX
+#define GPS_NAV_RATE_MS 1000      // période de navigation du récepteur
+#define GPS_RAW_ECHO 0            // 1 = recopie le flux NMEA brut sur le port série (captures de test/host/fixtures/gps)
+
+// AssistNow Online (u-blox) ; AGPS_URL peut pointer vers un bouchon local (tools/agps_stub.py)
+#define AGPS_URL "https://online-live1.services.u-blox.com/GetOnlineData.ashx"
+#define AGPS_CACHE_FILE "/agps.ubx"
+#define AGPS_MAX_AGE_S 7200       // éphémérides AssistNow Online valables 2 à 4 h
+#define AGPS_POS_ACC_M 50000      // précision annoncée de la position approchée
+#define AGPS_FRAME_GAP_MS 10      // pause après chaque trame AID injectée (pas d'ACK sur u-blox 7)
 // Capteur GY-BME280 / OLED (I2C)
 #define I2C_SDA 21       // GPIO 21 : I2C Data (SDA) - Utilisé par BME280
 #define I2C_SCL 22       // GPIO 22 : I2C Clock (SCL) - Utilisé par BME280
@@ -57,13 +73,36 @@
 #define DEFAULT_INSEE "33063"
 
 // Seuils & paramètres
-#define LUMIN_LOW_THRESHOLD 30
+#define LUMIN_LOW_THRESHOLD 30 // luminosité ambiante lissée (%) sous laquelle la LED RGB s'éteint
 #define TEMP_HIGH_ALERT 35.0
 #define TEMP_LOW_ALERT  -2.0
 
 // Affichage
 #define TFT_WIDTH 240
 #define TFT_HEIGHT 240
+#define GLYPH_CACHE_SLOTS 12     // glyphes pré-mélangés conservés (LRU)
+#define GLYPH_CACHE_SLOT_PX 768  // pixels max par glyphe (24x32), 1,5 Ko par slot
+#define PAGE_CACHE_BAND_H 16     // hauteur des bandes de rendu hors écran (7,5 Ko)
+#define PAGE_CACHE_BYTES 20480   // taille max d'une page compressée (RLE), x2 pages voisines
+#ifndef METEO_BENCH
+#define METEO_BENCH 0            // 1 = firmware de micro-bancs d'essai (env Meteo_Station_bench)
+#endif
+// Mesures au démarrage (plusieurs secondes de boot) : firmware de bancs d'essai seulement
+#define RENDER_STATS_AT_BOOT METEO_BENCH    // pixels/surimpression/transactions de chaque page
+#define RENDER_BENCH_AT_BOOT METEO_BENCH    // grande température GFX/U8g2, mise en page d'une alerte
+#define RENDER_FRAME_DUMP 0      // 1 = envoie aussi chaque page sur le port série (tools/frame_to_png.py)
+#define TELEMETRY_BENCH_AT_BOOT METEO_BENCH // compare MessagePack, JSON et texte (taille, temps d'encodage)
+#define BENCH_ITERATIONS 100     // exécutions chronométrées par cas (hors tour de chauffe)
+#define BENCH_MAX_ITERATIONS 200
+
+// Rétroéclairage adaptatif
+#define BACKLIGHT_SAMPLE_MS 200      // période d'échantillonnage du capteur de luminosité
+#define BACKLIGHT_FADE_MS 400        // durée du fondu LEDC
+#define BACKLIGHT_SLEEP_MS 300000    // veille écran après 5 min sans appui
+// Courbe luminosité ambiante (%) -> PWM (0..255), points croissants
+#define BACKLIGHT_CURVE {{0, 8}, {10, 40}, {30, 110}, {60, 190}, {100, 255}}
+#define BACKLIGHT_FULL_MW 130        // consommation estimée du rétroéclairage à 100 %
+#define TFT_PANEL_MW 30              // consommation estimée de la dalle ST7789 active
 
 // NTP
 #define NTP_SERVER "pool.ntp.org"
@@ -71,6 +110,75 @@
 
 // Rafraîchissements (ms)
 #define REFRESH_SENSOR_MS 5000
-#define REFRESH_WEATHER_MS 300000
+#define WEATHER_INTERVAL_MIN_MS 600000   // temps changeant ou alerte en cours
+#define WEATHER_INTERVAL_MAX_MS 3600000  // temps stable
+#define WEATHER_FAST_DP_HPA3H 3.0f       // tendance de pression locale jugée rapide (hPa/3 h)
+#define WEATHER_FAST_DT_CPH 2.0f         // variation de température extérieure jugée rapide (°C/h)
+#define WEATHER_MOVE_KM 5.0f             // déplacement de la station qui anticipe la récupération
+#define WEATHER_CELL_DEG 0.02            // maille des positions envoyées à l'API (~2 km)
+#define WEATHER_CACHE_SLOTS 4            // mailles gardées en cache (~1,6 Ko chacune)
+#define WEATHER_CACHE_MAX_AGE_MS 1800000 // données d'une maille réutilisables jusqu'à cet âge
+#define WEATHER_DAILY_BUDGET 150         // requêtes OneCall max par jour
+#define WEATHER_BACKOFF_MIN_MS 60000     // après un échec (doublé à chaque échec, avec gigue)
+#define WEATHER_BACKOFF_MAX_MS 3600000
+#define WEATHER_QUOTA_BACKOFF_MS 1800000 // minimum après une réponse 429 (quota du fournisseur)
 #define RETRY_GPS_MS 15000
 #define NTP_RESYNC_MS 3600000
+#define TELEGRAM_POLL_MS 2500
+#define HTTP_READ_TIMEOUT_MS 5000  // attente max d'un octet de réponse HTTP
+#define WEATHER_GZIP_HEAP_MARGIN 16384 // tas laissé libre en plus de la fenêtre gzip (TLS, JSON)
+#define WEATHER_ARENA 1             // 0 = document JSON non filtré sur le tas général (comparaison de fragmentation)
+#define ARENA_PSRAM_BYTES 131072    // arène des récupérations avec PSRAM : JSON et fenêtre gzip
+#define ARENA_INTERNAL_BYTES 24576  // sans PSRAM : document JSON filtré seulement
+#define WEATHER_ARENA_JSON_BYTES 24576 // place gardée au JSON avant d'y loger la fenêtre gzip
+#define WIFI_ACTIVE_MW 400          // consommation estimée de la radio WiFi en réception/émission
+#define WIFI_CHECK_MS 1000          // surveillance du lien WiFi
+#define WIFI_FAST_TIMEOUT_MS 3000   // connexion directe à l'AP en cache au démarrage
+#define WIFI_ATTEMPT_TIMEOUT_MS 8000
+#define WIFI_CACHED_ATTEMPTS 2      // tentatives sur l'AP en cache avant balayage
+#define WIFI_BACKOFF_MIN_MS 2000
+#define WIFI_BACKOFF_MAX_MS 120000
+#define WIFI_LEASE_REUSE_S 3600     // âge max d'un bail DHCP repris tel quel (0 = toujours DHCP)
+#define LOCAL_API_PORT 80           // point d'entrée local (/ota, /telemetry)
+#define LOCAL_API_POLL_MS 200
+#define OTA_GZIP_HEAP_MARGIN 16384  // tas laissé libre en plus de la fenêtre gzip (TLS, flash)
+#define OTA_VALIDATE_MS 300000      // délai pour valider une nouvelle image, sinon retour arrière
+#define OTA_VALIDATE_POLL_MS 5000
+#define OTA_URL_MAX 256             // URL d'image (et de sa signature)
+#define OTA_SIG_MAX 512             // signature détachée (RSA 4096 au plus)
+#ifndef OTA_HTTP_TOKEN
+#define OTA_HTTP_TOKEN "YOUR_OTA_TOKEN" // jeton du POST /ota local (secrets.h) ; non renseigné : refusé
+#endif
+#define OTA_HTTP_TOKEN_HEADER "X-OTA-Token"
+#ifndef OTA_SIGNING_PUBKEY
+#define OTA_SIGNING_PUBKEY ""       // clé publique PEM (secrets.h) ; vide : OTA refusée
+#endif
+#define TELEMETRY_LOG_MS 600000     // une trame de télémétrie en flash toutes les 10 min
+#define TELEMETRY_LOG_FILE "/telemetry.bin"
+#define TELEMETRY_LOG_MAX_BYTES 65536 // taille avant rotation (~10 jours de trames)
+#define SCHED_IDLE_WINDOW_MS 10000 // fenêtre de calcul du temps CPU libre
+#define SCHED_REPORT_MS 600000     // rapport du temps CPU par tâche (10 min)
+
+// Lieux surveillés (page SURVEILLANCE) : { nom, latitude, longitude }, au plus WATCHLIST_MAX
+// (chaque lieu coûte une requête OneCall par cycle, décomptée du budget journalier)
+#define WATCHLIST_LOCATIONS                                                                      \
+  {                                                                                              \
+    {"Bordeaux", 44.8378f, -0.5792f}, {"Arcachon", 44.6586f, -1.1689f},                          \
+    {"Lacanau", 45.0017f, -1.1964f}, {"Cap Ferret", 44.6300f, -1.2500f},                         \
+  }
+#define WATCHLIST_MAX 8
+#define WATCHLIST_REFRESH_MS 7200000  // un cycle toutes les 2 h (4 lieux : 48 requêtes/jour au plus),
+                                      // reporté si le budget hors réserve de la météo principale manque
+#define WATCHLIST_FIRST_DELAY_MS 90000 // après la première récupération météo et NTP
+
+// Prévision barométrique locale (Zambretti)
+#define BARO_HISTORY_STEP_MS 600000  // un point d'historique toutes les 10 min (3 h = 19 points)
+#define BARO_MIN_SPAN_MS 3600000     // historique minimal pour une tendance (extrapolée à 3 h)
+#define BARO_STEADY_HPA 1.6f         // |variation| sur 3 h en dessous de laquelle la pression est stable
+#define BARO_SEASON_ADJUST_HPA 7.0f  // correction saisonnière Zambretti (7 % de 950-1050 hPa)
+#define BARO_DEFAULT_ALT_M 30.0f     // altitude sans fix GPS (Bordeaux)
+#define BARO_RAW_LOG 0               // 1 = recopie chaque mesure sur le port série (captures de test/host/fixtures/baro)
+#define WEATHER_STALE_MS 3600000     // au-delà, l'accueil affiche la prévision locale
+
+// Surveillance du tas
+#define HEAP_TREND_PERIOD_MS 3600000 // 1 échantillon de tendance par heure (24 h glissantes)
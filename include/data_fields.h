@@ -0,0 +1,22 @@
+// data_fields.h
+#pragma once
+#include <Arduino.h>
+
+// Données affichées, chacune avec un compteur de génération incrémenté à chaque
+// changement visible. Les caches d'affichage comparent ces générations pour savoir
+// s'ils sont encore à jour.
+enum DataField : uint8_t {
+  DATA_WEATHER,   // WeatherSnapshot (actuel, prévisions, alertes)
+  DATA_INTERIOR,  // gTempInt / gHumInt / gBaro (BME280)
+  DATA_GEO,       // gLat / gLon / gUseDefaultGeo
+  DATA_WIFI,      // état et qualité de la liaison WiFi
+  DATA_SYSTEM,    // uptime, mémoire, charge CPU, rétroéclairage
+  DATA_UI,        // état d'interface propre aux pages (défilement)
+  DATA_WATCH,     // lieux surveillés (watchlist.h)
+  DATA_FIELD_COUNT
+};
+
+#define DATA_MASK(f) (1UL << (f))
+
+void dataChanged(DataField f);
+uint32_t dataGeneration(DataField f);
@@ -0,0 +1,37 @@
+// font_renderer.h
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+
+// ====================================================================================
+// Rendu de texte en polices proportionnelles U8g2 (format compressé RLE)
+// Chaque glyphe est décodé une seule fois, lissé (sur-échantillonnage) puis mélangé
+// aux couleurs texte/fond et conservé dans un petit cache LRU en RGB565.
+// Une chaîne est ensuite envoyée à l'écran en une seule fenêtre SPI, ligne par ligne.
+// ====================================================================================
+
+struct FontSpec {
+  const uint8_t *u8g2Font; // police U8g2 (u8g2_font_*)
+  uint8_t oversample;      // 1 = net, 2 = anti-aliasé (la police est réduite de moitié)
+};
+
+// Polices de l'interface
+extern const FontSpec FONT_TEMP_BIG;  // grande température (page HOME)
+extern const FontSpec FONT_TITLE;     // titres de pages
+
+// 'screen' bénéficie de l'envoi en masse ; les autres cibles (canevas hors écran) sont dessinées pixel par pixel
+void fontBegin(Adafruit_SPITFT &screen);
+// Largeur en pixels d'une chaîne (UTF-8, caractères Latin-1)
+int16_t fontTextWidth(const FontSpec &font, const char *text);
+// Hauteur de cellule (ascendante + descendante) en pixels
+int16_t fontLineHeight(const FontSpec &font);
+// Dessine 'text' avec la ligne de base en 'baselineY' ; renvoie la position x finale
+int16_t fontDrawText(Adafruit_GFX &g, int16_t x, int16_t baselineY, const char *text,
+                     const FontSpec &font, uint16_t fg, uint16_t bg);
+
+struct GlyphCacheStats {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
+};
+const GlyphCacheStats &fontCacheStats();
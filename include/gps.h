@@ -3,12 +3,19 @@
 #include <Arduino.h>
 
 struct GpsFix {
-  bool hasFix;
-  double lat;
-  double lon;
+  bool hasFix;        // nouvelle position valide depuis le dernier appel
+  int32_t latE7;      // degrés x 1e7
+  int32_t lonE7;
+  int32_t altCm;      // altitude GGA (niveau moyen des mers)
+  uint16_t hdopX100;
   uint8_t sats;
+  uint32_t utcMs;     // heure UTC en ms depuis minuit
+  uint32_t dateDmy;   // jjmmaa, 0 si inconnue
   bool ppsLocked;
 };
 
-void gpsBegin();
-void gpsLoop(GpsFix &fix);
\ No newline at end of file
+// Configure le récepteur (UBX) et injecte l'assistance AssistNow autour de la position approchée
+void gpsBegin(double approxLat, double approxLon);
+void gpsLoop(GpsFix &fix);
+// Débit de l'analyseur NMEA et compteurs de trames (préfixe [GPS])
+void gpsLogStats();
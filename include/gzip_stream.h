@@ -0,0 +1,62 @@
+// gzip_stream.h
+#pragma once
+#include <Arduino.h>
+#include "rom/miniz.h"
+
+// ====================================================================================
+// Décompression gzip en flux (tinfl de miniz, en ROM sur l'ESP32)
+// Le corps compressé est lu par petits blocs depuis la source ; seule la fenêtre
+// LZ77 de 32 Ko est conservée, jamais le corps décompressé entier. Le CRC32 de la sortie
+// est tenu au fil de la décompression et comparé au pied de page (voir readTrailer).
+// ====================================================================================
+
+#define GZIP_WORK_BYTES (sizeof(tinfl_decompressor) + TINFL_LZ_DICT_SIZE)
+
+class Arena;
+
+class GzipInflateStream : public Stream {
+public:
+  explicit GzipInflateStream(Stream &source);
+  ~GzipInflateStream();
+
+  // Lit l'en-tête gzip ; false si mémoire insuffisante ou format invalide.
+  // arena : fenêtre prise dans l'arène si elle y tient, sinon sur le tas
+  bool begin(Arena *arena = nullptr);
+  bool ok() const { return _status >= 0; }
+  bool finished() const { return _done; }
+  // CRC32 et taille (ISIZE) du pied de page conformes ; valide une fois finished()
+  bool trailerOk() const { return _trailerOk; }
+  // Décompresse le reste du flux (blancs après le JSON) et vérifie le pied de page
+  bool finish();
+  uint32_t inBytes() const { return _inTotal; }
+  uint32_t outBytes() const { return _outTotal; }
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buffer, size_t length) override;
+  using Stream::readBytes;
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  bool fill();
+  int sourceByte();
+  bool inflateMore();
+  void readTrailer();
+
+  Stream &_source;
+  tinfl_decompressor *_inflator = nullptr;
+  uint8_t *_dict = nullptr;     // fenêtre circulaire, aussi tampon de sortie
+  bool _arenaWork = false;      // _inflator et _dict appartiennent à une arène
+  uint8_t _in[512];
+  size_t _inPos = 0, _inLen = 0;
+  size_t _dictOfs = 0;          // position d'écriture dans la fenêtre
+  size_t _outPos = 0, _outLen = 0; // octets prêts à lire : _dict[_outPos .. _outPos+_outLen)
+  int _status = TINFL_STATUS_NEEDS_MORE_INPUT;
+  bool _sourceEnd = false;
+  bool _done = false;
+  bool _trailerOk = false;
+  uint8_t _tail[8] = {0};       // 8 derniers octets reçus de la source
+  uint32_t _crc = 0;
+  uint32_t _inTotal = 0, _outTotal = 0;
+};
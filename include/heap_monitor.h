@@ -0,0 +1,63 @@
+// heap_monitor.h
+#pragma once
+#include <Arduino.h>
+
+// Sites d'appel instrumentés (cycle capteurs, météo, Telegram, rendu)
+enum HeapSite : uint8_t {
+  HEAP_SITE_SENSOR,
+  HEAP_SITE_WEATHER,
+  HEAP_SITE_TELEGRAM,
+  HEAP_SITE_RENDER,
+  HEAP_SITE_COUNT
+};
+
+// Statistiques cumulées par site d'appel. Les variations portent sur le tas libre à
+// l'entrée et à la sortie du site (rétention nette), pas sur les allocations elles-mêmes :
+// celles-ci ne sont comptées qu'avec un compteur de plateforme (heapMonitorSetAllocCounter).
+struct HeapSiteStats {
+  uint32_t calls;
+  int32_t lastFreeDelta;  // variation du tas libre lors du dernier appel (octets)
+  int32_t worstFreeDelta; // pire variation observée (fuite / rétention)
+  uint32_t minFreeAfter;  // tas libre le plus bas observé en sortie de site
+  uint32_t allocs;        // allocations faites dans le site (0 sans compteur)
+  uint64_t allocBytes;
+};
+
+// Instantané du tas
+struct HeapStats {
+  uint32_t freeHeap;
+  uint32_t largestBlock;  // plus grand bloc allouable d'un seul tenant
+  uint32_t minEverFree;   // minimum historique du tas libre (depuis le boot)
+  uint32_t minLargestBlock; // plus petit "plus grand bloc" observé (fragmentation au long cours)
+  uint32_t peakUsed;      // pic d'utilisation observé (taille totale - libre)
+  uint8_t fragPct;        // 100 - plus_grand_bloc / libre
+};
+
+#define HEAP_TREND_LEN 24 // échantillons de tendance (1 par HEAP_TREND_PERIOD_MS)
+
+void heapMonitorBegin();
+void heapMonitorSample();                 // à appeler périodiquement (cycle capteurs)
+const HeapStats &heapMonitorStats();
+// Tendance du plus grand bloc libre (octets), du plus ancien au plus récent
+uint8_t heapMonitorTrend(uint32_t *out, uint8_t maxLen);
+const HeapSiteStats &heapMonitorSite(HeapSite site);
+const char *heapSiteName(HeapSite site);
+void heapMonitorLog();
+
+// Compteur cumulé d'allocations (nombre, octets demandés) : l'ESP-IDF n'en expose pas sans
+// traçage du tas, la cible n'en a donc pas ; l'allocateur instrumenté du simulateur hôte
+// en fournit un, dont HeapProbe déduit les allocations de chaque site
+typedef void (*HeapAllocCounterFn)(uint32_t &allocs, uint64_t &bytes);
+void heapMonitorSetAllocCounter(HeapAllocCounterFn fn);
+
+// Mesure RAII de la variation du tas autour d'un site d'appel
+class HeapProbe {
+public:
+  explicit HeapProbe(HeapSite site);
+  ~HeapProbe();
+private:
+  HeapSite _site;
+  uint32_t _freeBefore;
+  uint32_t _allocsBefore;
+  uint64_t _bytesBefore;
+};
@@ -0,0 +1,64 @@
+// http_reader.h
+#pragma once
+#include <Arduino.h>
+#include <Client.h>
+#include "config.h"
+
+// ====================================================================================
+// Lecteur de réponse HTTP/1.1 en flux
+// Ligne de statut et en-têtes utiles lus dans des tampons fixes, puis corps exposé
+// comme un Stream. Le corps s'arrête à Content-Length ou au dernier bloc chunked,
+// sans attendre la fermeture de la connexion ni un délai d'expiration.
+// ====================================================================================
+
+class HttpResponseReader : public Stream {
+public:
+  explicit HttpResponseReader(Client &client, uint32_t timeoutMs = HTTP_READ_TIMEOUT_MS);
+
+  // Lit statut et en-têtes ; false si connexion fermée, délai dépassé ou réponse invalide
+  bool readHeaders();
+
+  int status() const { return _status; }
+  int32_t contentLength() const { return _contentLength; } // -1 si absent
+  bool chunked() const { return _chunked; }
+  const char *contentType() const { return _contentType; }
+  const char *contentEncoding() const { return _contentEncoding; }
+  bool keepAlive() const { return _keepAlive; }
+
+  // Corps entièrement reçu (Content-Length atteint ou bloc chunked de taille 0)
+  bool finished() const { return _state == DONE; }
+  uint32_t bodyBytes() const { return _bodyBytes; }
+  uint32_t headersUs() const { return _headersUs; }   // requête envoyée -> fin des en-têtes
+  uint32_t lastByteUs() const { return _lastByteUs; } // micros() à la lecture du dernier octet du corps
+
+  // Stream : octets du corps uniquement (-1 s'il n'y en a pas encore ou plus)
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buffer, size_t length) override;
+  using Stream::readBytes;
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  enum State : uint8_t { HEADERS, BODY, CHUNK_SIZE, CHUNK_DATA, CHUNK_END, DONE, FAILED };
+  static const uint8_t LINE_MAX = 128;
+
+  int readLine(char *line, uint8_t max); // longueur, -1 si délai/fermeture
+  bool nextChunk();
+  int rawRead();
+  void consumed(uint32_t n);
+
+  Client &_client;
+  uint32_t _timeoutMs;
+  State _state = HEADERS;
+  int _status = 0;
+  int32_t _contentLength = -1;
+  bool _chunked = false;
+  bool _keepAlive = true;
+  uint32_t _remaining = 0; // octets restants dans le corps ou le bloc courant
+  uint32_t _bodyBytes = 0;
+  uint32_t _headersUs = 0;
+  uint32_t _lastByteUs = 0;
+  char _contentType[40] = "";
+  char _contentEncoding[16] = "";
+};
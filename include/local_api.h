@@ -0,0 +1,13 @@
+// local_api.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Point d'entrée HTTP sur le réseau local (démarré à la première connexion WiFi)
+//   POST /ota (url=...&sha256=..., en-tête X-OTA-Token)  mise à jour du firmware (voir ota.h)
+//   GET /telemetry                                       trame courante (application/msgpack)
+//   GET /telemetry.log                                   journal des trames en flash
+// ====================================================================================
+
+// Tâche périodique : traite les requêtes en attente
+void localApiJob();
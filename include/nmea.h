@@ -0,0 +1,50 @@
+// nmea.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Analyseur NMEA sans allocation, limité aux trames GGA et RMC
+// La somme de contrôle est calculée au fil des octets. Les autres trames (GSV, GSA,
+// VTG, GLL...) sont reconnues dès leur en-tête puis ignorées jusqu'au '$' suivant.
+// Toutes les valeurs sont en virgule fixe (aucun double).
+// ====================================================================================
+
+struct NmeaFix {
+  int32_t latE7;      // degrés x 1e7
+  int32_t lonE7;
+  int32_t altCm;      // altitude au-dessus du niveau moyen des mers (GGA)
+  uint16_t hdopX100;  // dilution horizontale x 100
+  uint8_t sats;
+  uint8_t quality;    // qualité GGA (0 = pas de fix)
+  bool rmcValid;      // statut RMC 'A'
+  uint32_t utcMs;     // heure UTC en ms depuis minuit
+  uint32_t dateDmy;   // date RMC jjmmaa (0 = inconnue)
+};
+
+class NmeaParser {
+public:
+  // Renvoie true quand une trame GGA ou RMC valide vient d'être décodée
+  bool encode(char c);
+  const NmeaFix &fix() const { return _fix; }
+
+  uint32_t sentencesOk = 0;     // GGA/RMC acceptées
+  uint32_t checksumErrors = 0;
+  uint32_t sentencesSkipped = 0; // autres trames ignorées
+
+private:
+  enum State : uint8_t { IDLE, BODY, SKIP, CHECK1, CHECK2 };
+  static const uint8_t FIELD_MAX = 15;
+
+  void endField();
+  void decodeField(uint8_t kind);
+
+  State _state = IDLE;
+  uint8_t _sentence = 0;  // index dans la table des trames
+  uint8_t _field = 0;
+  uint8_t _len = 0;
+  uint8_t _sum = 0;
+  uint8_t _rxSum = 0;
+  char _buf[FIELD_MAX + 1];
+  NmeaFix _fix = {};
+  NmeaFix _pending = {};  // valeurs de la trame en cours, validées par la somme de contrôle
+};
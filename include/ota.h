@@ -0,0 +1,42 @@
+// ota.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Mise à jour du firmware à distance (OTA)
+// L'image est téléchargée (compressée gzip si l'URL finit par .gz ou si le serveur
+// l'annonce) et décompressée en flux directement dans la partition d'application
+// inactive : aucun tampon de la taille de l'image. Avant de l'activer, le SHA-256 de
+// l'image décompressée est comparé à celui demandé et sa signature (fichier <url>.sig,
+// signature DER du SHA-256) vérifiée avec la clé publique OTA_SIGNING_PUBKEY : la
+// commande et le serveur ne sont pas des sources de confiance. Le premier démarrage
+// doit être validé (otaValidateJob), sinon le chargeur revient à l'ancienne version.
+// Déclenchement : commande Telegram /ota (chat autorisé) ou POST /ota du point d'entrée
+// local (local_api.h).
+// ====================================================================================
+
+// Avancement : octets reçus (compressés) et taille annoncée (-1 si inconnue).
+// Appelé à chaque bloc écrit, 0/total au début.
+typedef void (*OtaProgressFn)(uint32_t received, int32_t total);
+
+struct OtaResult {
+  bool ok;
+  char error[64];
+  uint32_t downloadBytes; // octets reçus sur le réseau
+  uint32_t imageBytes;    // octets écrits en flash (image décompressée)
+  uint32_t durationMs;    // requête -> image vérifiée
+  uint32_t maxUiGapMs;    // plus long intervalle sans rafraîchir l'écran ni lire les boutons
+  bool gzip;
+};
+
+// Journalise la partition courante et l'état de validation ; enregistre l'affichage
+void otaBegin(OtaProgressFn progress);
+
+// Télécharge, écrit et vérifie l'image ; ne redémarre pas (voir otaRestart)
+bool otaRun(const char *url, const char *sha256Hex, OtaResult &result);
+String otaResultText(const OtaResult &result);
+void otaRestart();
+
+// Tâche périodique : validation du premier démarrage après mise à jour
+// (WiFi reconnecté) ou retour à l'ancienne image après OTA_VALIDATE_MS
+void otaValidateJob();
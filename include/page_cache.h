@@ -0,0 +1,38 @@
+// page_cache.h
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include "data_fields.h"
+
+// ====================================================================================
+// Pré-rendu des pages voisines de la page courante
+// Les pages sont dessinées hors écran par bandes horizontales (peu de RAM), une bande
+// par passage de loop(), et compressées en RLE. Un changement de page devient un seul
+// transfert SPI en masse.
+// Un cache n'est invalidé que si l'une des données dont dépend la page a changé.
+// ====================================================================================
+
+typedef void (*PageRenderFn)(Adafruit_GFX &g, int page);
+typedef uint32_t (*PageDepsFn)(int page); // masque DATA_MASK(...) des données affichées
+
+void pageCacheBegin(PageRenderFn render, PageDepsFn deps);
+// Fonction de rendu enregistrée (nullptr si le cache est désactivé) : outils de mesure
+PageRenderFn pageCacheRenderer();
+// Affiche 'page' depuis le cache ; false si absente ou périmée
+bool pageCacheBlit(Adafruit_SPITFT &tft, int page);
+// Rend une bande d'une page voisine périmée ; renvoie true s'il reste du travail
+bool pageCachePrerender(int currentPage, int numPages);
+// Rend 'page' d'un bloc dans un slot et renvoie son image RLE (diagnostic : évince une
+// page voisine) ; nullptr si l'image dépasse PAGE_CACHE_BYTES
+const uint8_t *pageCacheEncode(int page, uint32_t &len);
+
+struct PageCacheStats {
+  uint32_t pages;      // pages pré-rendues avec succès
+  uint32_t bands;      // bandes rendues
+  uint32_t restarts;   // rendus repris (donnée modifiée entre deux bandes)
+  uint32_t overflows;  // images RLE au-delà de PAGE_CACHE_BYTES
+  uint32_t maxPageUs;  // plus long rendu d'une page (somme de ses bandes)
+};
+const PageCacheStats &pageCacheStats();
+// Journalise les compteurs ([CACHE])
+void pageCacheReport();
@@ -0,0 +1,22 @@
+// render_stats.h
+#pragma once
+#include <Arduino.h>
+#include "page_cache.h"
+
+// Comptabilité du coût de rendu d'une page, sans matériel supplémentaire :
+// la page est dessinée sur un canevas de comptage compatible Adafruit_GFX.
+struct RenderStats {
+  uint32_t pixelsWritten;  // pixels écrits (toutes primitives, après découpe à l'écran)
+  uint32_t pixelsDistinct; // pixels différents touchés au moins une fois
+  uint32_t transactions;   // transactions SPI équivalentes (startWrite/endWrite de premier niveau)
+  uint32_t primitives;     // appels de primitives de dessin
+  uint32_t renderUs;       // temps CPU du rendu sur le canevas
+  uint32_t crc;            // CRC32 de l'image (détection de régressions de mise en page)
+  bool rleOverflow;        // image RLE au-delà de PAGE_CACHE_BYTES : pas de CRC
+};
+
+// Mesure une page (page de rendu identique à l'écran)
+bool renderStatsMeasure(PageRenderFn render, int page, RenderStats &out);
+// Mesure toutes les pages et journalise (préfixe [RENDU]) ; si dumpFrames, envoie
+// aussi chaque image compressée sur le port série (voir tools/frame_to_png.py)
+void renderStatsReportAll(PageRenderFn render, int numPages, bool dumpFrames);
@@ -0,0 +1,45 @@
+// scheduler.h
+#pragma once
+#include <Arduino.h>
+
+// Ordonnanceur à échéances : chaque tâche périodique garde sa prochaine échéance et
+// loop() se bloque (notification FreeRTOS) jusqu'à la plus proche ou jusqu'à un
+// événement externe (bouton, UART GPS, PPS).
+
+typedef void (*JobFn)();
+typedef uint8_t JobId;
+
+#define SCHED_MAX_JOBS 14
+#define SCHED_INVALID_JOB 0xFF
+
+void schedulerBegin();  // à appeler depuis la tâche qui exécute loop()
+JobId schedulerAdd(const char *name, JobFn fn, uint32_t periodMs, uint32_t firstDelayMs = 0);
+void schedulerSetPeriod(JobId id, uint32_t periodMs);
+void schedulerTrigger(JobId id);  // exécution au prochain passage
+void schedulerSetNext(JobId id, uint32_t delayMs); // prochaine exécution dans delayMs (période inchangée)
+void schedulerRunDue();           // exécute les tâches arrivées à échéance
+// Bloque jusqu'à la prochaine échéance (bornée par maxWaitMs) ou une notification
+void schedulerWait(uint32_t maxWaitMs = UINT32_MAX);
+
+// Réveil de la boucle principale sur événement externe
+void schedulerNotify();
+void IRAM_ATTR schedulerNotifyFromISR();
+
+// Pourcentage de temps CPU passé bloqué (fenêtre glissante SCHED_IDLE_WINDOW_MS)
+uint8_t schedulerIdlePct();
+
+// Journalise (préfixe [SCHED]) le temps CPU de chaque tâche et du reste de loop(),
+// ainsi que le nombre d'itérations de la boucle, puis remet les compteurs à zéro
+void schedulerReport();
+
+// Cumul depuis le démarrage (non remis à zéro par schedulerReport), pour les bilans
+// sur de longues durées (simulateur hôte)
+struct SchedJobTotals {
+  const char *name;
+  uint32_t runs;
+  uint64_t totalUs;
+  uint32_t maxUs;
+};
+uint8_t schedulerJobCount();
+bool schedulerJobTotals(JobId id, SchedJobTotals &out);
+uint32_t schedulerLoopCount(); // appels à schedulerWait
@@ -21,3 +21,15 @@
 // Telegram
 #define TELEGRAM_BOT_TOKEN "YOUR_TELEGRAM_BOT_TOKEN"
 #define TELEGRAM_CHAT_ID "YOUR_TELEGRAM_CHAT_ID"
+
+// Mise à jour OTA depuis le réseau local (POST http://<station>/ota, en-tête X-OTA-Token)
+#define OTA_HTTP_TOKEN "YOUR_OTA_TOKEN"
+
+// Clé publique de vérification des images OTA (PEM, ECDSA P-256 ou RSA). La clé privée
+// reste hors du dépôt et signe chaque image (voir tools/ota_server.py --cle) :
+//   openssl ecparam -name prime256v1 -genkey -noout -out ota_key.pem
+//   openssl ec -in ota_key.pem -pubout
+#define OTA_SIGNING_PUBKEY \
+  "-----BEGIN PUBLIC KEY-----\n" \
+  "YOUR_OTA_PUBLIC_KEY\n" \
+  "-----END PUBLIC KEY-----\n"
@@ -0,0 +1,30 @@
+// telemetry_frame.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Trames de télémétrie binaires (MessagePack, schéma versionné)
+// Un seul encodeur pour toutes les sorties (point d'entrée local, journal en flash,
+// MQTT) : un instantané des mesures est sérialisé en tableaux positionnels de
+// valeurs entières (virgule fixe). Décodage : tools/telemetry_decode.py.
+//
+// Schéma 1 :
+//   [1, epoch, uptime_s,
+//    [t_int_c100, hr_int_pm, p_station_hpa10, p_mer_hpa10, tendance_hpa10_3h, zambretti],
+//    [t_ext_c100, hr_ext_pct, vent_cms, code, t_min_c100, t_max_c100, alerte, age_s],
+//    [lat_e7, lon_e7, alt_cm, sats, hdop_x100, gps],
+//    [tas_libre, plus_grand_bloc, cpu_libre_pct, rssi_dbm, coupures_wifi, requetes_meteo]]
+// Une valeur inconnue (NaN, pas de fix, pas de données) est encodée nil.
+// ====================================================================================
+
+#define TELEMETRY_SCHEMA_VERSION 1
+#define TELEMETRY_FRAME_MAX 192
+
+// Encode l'état courant ; renvoie la taille de la trame, 0 si le tampon est trop petit
+size_t telemetryEncode(uint8_t *buf, size_t size);
+
+// Ajoute une trame au journal en flash (préfixe de longueur 2 octets, rotation en .old)
+void telemetryLogJob();
+
+// Taille et temps d'encodage : MessagePack, même document en JSON, texte Telegram ([TELEM])
+void telemetryBenchmark();
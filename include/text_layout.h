@@ -0,0 +1,38 @@
+// text_layout.h
+#pragma once
+#include <Arduino.h>
+#include "weather.h"
+
+// ====================================================================================
+// Mise en page de texte long pour la police GFX intégrée (6x8, jeu CP437)
+// Le texte UTF-8 est converti une fois en CP437 (accents français compris) puis coupé
+// aux espaces ; la table des lignes est conservée jusqu'au texte suivant.
+// ====================================================================================
+
+#define TEXT_LAYOUT_MAX_LINES 128
+
+// UTF-8 -> CP437 (police GFX avec cp437(true)) ; renvoie la longueur écrite
+size_t utf8ToCp437(const char *src, char *dst, size_t dstSize);
+
+class TextLayout {
+public:
+  // Convertit et coupe 'utf8' en lignes d'au plus maxCols caractères
+  void layout(const char *utf8, uint8_t maxCols);
+
+  uint16_t lineCount() const { return _count; }
+  const char *lineText(uint16_t i) const { return _text + _lines[i].start; }
+  uint8_t lineLen(uint16_t i) const { return _lines[i].len; }
+  bool truncated() const { return _truncated; } // texte au-delà de TEXT_LAYOUT_MAX_LINES
+  uint32_t layoutUs() const { return _layoutUs; }
+
+private:
+  struct Line {
+    uint16_t start;
+    uint8_t len;
+  };
+  char _text[WEATHER_ALERT_DESC_MAX];
+  Line _lines[TEXT_LAYOUT_MAX_LINES];
+  uint16_t _count = 0;
+  bool _truncated = false;
+  uint32_t _layoutUs = 0;
+};
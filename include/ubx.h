@@ -0,0 +1,26 @@
+// ubx.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Protocole binaire UBX (u-blox) : configuration du GT-U7 (NEO-7)
+// ====================================================================================
+
+#define UBX_CLASS_ACK 0x05
+#define UBX_CLASS_CFG 0x06
+#define UBX_CFG_PRT 0x00
+#define UBX_CFG_MSG 0x01
+#define UBX_CFG_RATE 0x08
+
+// Trame B5 62 cls id len payload ck_a ck_b
+void ubxSend(Stream &port, uint8_t cls, uint8_t id, const uint8_t *payload, uint16_t len);
+// true sur ACK-ACK, false sur ACK-NAK ou délai dépassé (le flux NMEA est ignoré)
+bool ubxWaitAck(Stream &port, uint8_t cls, uint8_t id, uint32_t timeoutMs);
+
+// Le récepteur répond-il à 'baud' ? Interrogation CFG-RATE, ACK attendu ; le port hôte
+// reste à ce débit
+bool ubxProbe(HardwareSerial &port, uint32_t baud, uint32_t timeoutMs);
+
+// Passe le port à 'baud', coupe GSV/GSA/VTG/GLL et règle la période de navigation.
+// En cas d'échec le port hôte revient à son débit d'avant l'appel.
+bool ubxConfigure(HardwareSerial &port, uint32_t baud, uint16_t measRateMs);
@@ -0,0 +1,55 @@
+// watchlist.h
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+// ====================================================================================
+// Lieux surveillés (page SURVEILLANCE)
+// La météo actuelle de chaque lieu de WATCHLIST_LOCATIONS est récupérée en un seul
+// cycle : toutes les requêtes partent à la suite sur une même connexion TLS
+// (HTTP/1.1 keep-alive, requêtes en pipeline), puis les réponses sont lues dans
+// l'ordre. Si le serveur ferme la connexion en route, les requêtes restantes sont
+// renvoyées sur une nouvelle connexion. Chaque lieu tient dans une entrée de 12 octets.
+// ====================================================================================
+
+struct WatchLocation {
+  const char *name;
+  float lat, lon;
+};
+
+#define WATCH_VALID 0x01 // au moins une récupération réussie
+#define WATCH_ALERT 0x02 // alerte officielle en cours
+
+struct WatchEntry {
+  int16_t temp;       // centi-degrés (FORECAST_TEMP_NONE si inconnue)
+  uint16_t code;      // code condition OpenWeather
+  uint16_t wind;      // cm/s
+  uint8_t humidity;   // %
+  uint8_t flags;      // WATCH_*
+  uint32_t fetchedMs; // millis() de la dernière mise à jour
+};
+
+uint8_t watchlistCount();
+const WatchLocation &watchlistLocation(uint8_t i);
+const WatchEntry &watchlistEntry(uint8_t i);
+
+struct WatchlistStats {
+  uint32_t cycles;
+  uint8_t lastCount;        // lieux demandés au dernier cycle
+  uint16_t lastSent;        // requêtes envoyées (renvois compris), décomptées du budget
+  uint8_t lastReceived;     // réponses reçues (dans l'ordre des requêtes)
+  uint8_t lastOk;           // réponses valides
+  uint8_t connections;      // connexions TLS ouvertes au dernier cycle
+  uint32_t connectMs;       // durée de la première connexion (poignée de main TLS)
+  uint32_t totalMs;         // cycle complet
+  uint32_t readyMs[WATCHLIST_MAX]; // cumul : k+1 lieux reçus après readyMs[k] ms
+  uint32_t lastCycleMs;     // millis() de la fin du dernier cycle (0 : aucun)
+};
+const WatchlistStats &watchlistStats();
+
+// Tâche périodique : un cycle de récupération si le WiFi, la suspension (429, clé refusée) et
+// le budget hors réserve de la récupération principale (weatherPolicySpare) le permettent
+void watchlistJob();
+
+// Durée du cycle en fonction du nombre de lieux reçus et coût estimé sans pipeline ([SURV])
+void watchlistReport();
@@ -1,12 +1,40 @@
 #pragma once
 #include <Arduino.h>
-#include <vector>
+#include <ArduinoJson.h>
 
-// Structure pour une prévision journalière
-struct Forecast {
-    float tempDay;
-    float tempNight;
-    int conditionCode;
+// --- [REWRITE] Prévisions en virgule fixe, tableaux de capacité fixe (struct-of-arrays) ---
+// Températures en centi-degrés (int16), vent en cm/s (uint16), probabilité de pluie en %.
+// Aucune allocation dynamique : les tableaux sont réécrits en place à chaque récupération.
+#define FORECAST_HOURLY_MAX 48
+#define FORECAST_DAILY_MAX 8
+#define FORECAST_TEMP_NONE INT16_MIN
+#define WEATHER_ALERT_TITLE_MAX 64
+#define WEATHER_ALERT_DESC_MAX 1024 // descriptions OpenWeather tronquées au-delà
+
+inline int16_t tempToCenti(float t) { return isnan(t) ? FORECAST_TEMP_NONE : (int16_t)lroundf(t * 100.0f); }
+inline float centiToTemp(int16_t c) { return c == FORECAST_TEMP_NONE ? NAN : c / 100.0f; }
+
+// Prévisions horaires (48 h)
+struct HourlyForecast {
+    uint32_t startTime;                    // horodatage UNIX de la première heure
+    uint8_t count;
+    int16_t temp[FORECAST_HOURLY_MAX];     // centi-degrés
+    uint16_t code[FORECAST_HOURLY_MAX];    // code condition OpenWeather
+    uint8_t pop[FORECAST_HOURLY_MAX];      // probabilité de précipitation (%)
+    uint16_t wind[FORECAST_HOURLY_MAX];    // vitesse du vent (cm/s)
+};
+
+// Prévisions journalières (8 jours)
+struct DailyForecast {
+    uint32_t startTime;
+    uint8_t count;
+    int16_t tempDay[FORECAST_DAILY_MAX];
+    int16_t tempNight[FORECAST_DAILY_MAX];
+    int16_t tempMin[FORECAST_DAILY_MAX];
+    int16_t tempMax[FORECAST_DAILY_MAX];
+    uint16_t code[FORECAST_DAILY_MAX];
+    uint8_t pop[FORECAST_DAILY_MAX];
+    uint16_t wind[FORECAST_DAILY_MAX];
 };
 
 // Structure pour la météo actuelle
@@ -18,15 +46,17 @@ struct CurrentWeather {
     float tempMin;
     float tempMax;
     bool hasAlert;
-    String alertTitle;
-    String alertDesc;
-    String alertSeverity;
+    // Tampons fixes : WeatherData se copie sans allocation (double tampon, weather_store.h)
+    char alertTitle[WEATHER_ALERT_TITLE_MAX];
+    char alertDesc[WEATHER_ALERT_DESC_MAX];
+    char alertSeverity[16];
 };
 
 // Structure globale météo
 struct WeatherData {
     CurrentWeather now;
-    std::vector<Forecast> forecast;
+    HourlyForecast hourly;
+    DailyForecast daily;
 };
 
 String formatWeatherBrief(const WeatherData &data);
@@ -34,5 +64,12 @@ String formatWeatherBrief(const WeatherData &data);
 // Convertit un code OpenWeather (int) en code d'icône (String)
 String weatherCodeToIcon(int code);
 
+// Journalise l'empreinte mémoire des prévisions (virgule fixe vs float + std::vector)
+void weatherLogFootprint();
+
 // Fonction de récupération météo
-bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out);
\ No newline at end of file
+bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out);
+// Extraction d'une réponse OneCall analysée (champs absents : valeurs inchangées ou vides)
+bool weatherFromJson(JsonDocument &doc, WeatherData &out);
+// Code HTTP de la dernière tentative (0 : pas de réponse du serveur)
+int weatherLastHttpStatus();
\ No newline at end of file
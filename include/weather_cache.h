@@ -0,0 +1,42 @@
+// weather_cache.h
+#pragma once
+#include <Arduino.h>
+#include "weather.h"
+
+// ====================================================================================
+// Cache météo par maille géographique (stations mobiles)
+// La position est ramenée au centre d'une maille de WEATHER_CELL_DEG : toutes les
+// requêtes d'une même maille sont identiques, et un déplacement de quelques mètres ne
+// change plus rien. Les dernières données récupérées sont gardées par maille (LRU de
+// WEATHER_CACHE_SLOTS entrées horodatées) : une station qui fait l'aller-retour sur
+// un trajet réutilise les données encore récentes au lieu d'interroger l'API.
+// ====================================================================================
+
+struct WeatherCell {
+  int32_t latIdx, lonIdx; // indices de la maille (floor(coordonnée / WEATHER_CELL_DEG))
+  bool operator==(const WeatherCell &o) const { return latIdx == o.latIdx && lonIdx == o.lonIdx; }
+  bool operator!=(const WeatherCell &o) const { return !(*this == o); }
+};
+
+// Maille contenant (lat, lon) ; centre de la maille, coordonnées envoyées à l'API
+WeatherCell weatherCellOf(double lat, double lon);
+void weatherCellCenter(const WeatherCell &cell, float &lat, float &lon);
+
+// Données de moins de WEATHER_CACHE_MAX_AGE_MS pour cette maille : copiées dans 'out'
+// avec leur âge ; compte un succès ou un échec du cache
+bool weatherCacheLookup(const WeatherCell &cell, WeatherData &out, uint32_t &ageMs);
+// Données fraîches disponibles pour la maille, sans les copier ni compter la consultation
+bool weatherCacheHas(const WeatherCell &cell);
+// Récupération réussie : remplace l'entrée de la maille ou la moins récemment utilisée
+void weatherCacheStore(const WeatherCell &cell, const WeatherData &data);
+
+struct WeatherCacheStats {
+  uint32_t lookups;
+  uint32_t hits;      // = requêtes API évitées
+  uint32_t stores;
+  uint32_t evictions; // entrées d'autres mailles remplacées
+};
+const WeatherCacheStats &weatherCacheStats();
+
+// Taux de succès, requêtes évitées et mailles en cache ([METEO])
+void weatherCacheReport();
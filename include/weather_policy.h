@@ -0,0 +1,59 @@
+// weather_policy.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Politique de rafraîchissement météo et budget de requêtes
+// L'intervalle entre deux récupérations OneCall s'adapte à la vitesse d'évolution du
+// temps (tendance de pression locale, variation de la température extérieure), aux
+// alertes et au déplacement de la station. Les échecs repoussent la tentative suivante
+// (délai exponentiel avec gigue), et le nombre de requêtes par jour ne dépasse jamais
+// WEATHER_DAILY_BUDGET.
+// ====================================================================================
+
+struct WeatherPolicyStats {
+  uint16_t callsToday;       // requêtes envoyées depuis minuit (ou depuis 24 h sans heure)
+  uint16_t failuresToday;
+  uint8_t consecutiveFailures;
+  int lastHttpStatus;
+  uint32_t intervalMs;       // délai retenu avant la prochaine récupération
+  const char *reason;        // motif de ce délai
+  uint32_t lastOkMs;         // millis() de la dernière récupération réussie (0 : aucune)
+  float tempRateCph;         // variation de la température extérieure (°C/h)
+};
+
+void weatherPolicyBegin();
+
+// Budget du jour non épuisé : une requête peut partir
+bool weatherPolicyAllow();
+// Délai jusqu'à ce que le budget permette une nouvelle requête
+uint32_t weatherPolicyBudgetWaitMs();
+// Requêtes encore permises aujourd'hui
+uint16_t weatherPolicyRemaining();
+// Requêtes disponibles hors récupération principale : restantes moins la réserve de celle-ci
+// (une requête par WEATHER_INTERVAL_MIN_MS jusqu'à la fin du jour)
+uint16_t weatherPolicySpare();
+// Durée restante de la suspension après une réponse 429, 401 ou 403 (0 : aucune)
+uint32_t weatherPolicyHoldMs();
+
+// Enregistre une tentative et son résultat (code HTTP : weatherLastHttpStatus()) ; elle
+// n'est comptée sur le budget que si le serveur a répondu (httpStatus != 0)
+void weatherPolicyRecord(bool ok, int httpStatus, float lat, float lon, float tempNow, bool hasAlert);
+// Requêtes envoyées hors de la récupération principale (lieux surveillés) : budget, et
+// suspension si le fournisseur a répondu 429, 401 ou 403 (refusedStatus, 0 sinon)
+void weatherPolicyCount(uint16_t calls, uint16_t failures, int refusedStatus);
+// Données publiées depuis le cache par maille (aucune requête) : récupérées il y a ageMs en (lat, lon)
+void weatherPolicyServed(float lat, float lon, uint32_t ageMs, float tempNow, bool hasAlert);
+
+// Délai avant la prochaine récupération ; tendance de pression NAN si inconnue
+uint32_t weatherPolicyNextDelayMs(float pressureTrendHpa3h);
+
+// true (une seule fois) si la station s'est éloignée de WEATHER_MOVE_KM du dernier point récupéré
+bool weatherPolicyMoved(double lat, double lon);
+
+// Âge des données publiées (UINT32_MAX si aucune)
+uint32_t weatherPolicyAgeMs();
+const WeatherPolicyStats &weatherPolicyStats();
+
+// Requêtes du jour, projection sur 24 h, intervalle courant et âge des données ([METEO])
+void weatherPolicyReport();
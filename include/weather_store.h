@@ -0,0 +1,41 @@
+// weather_store.h
+#pragma once
+#include <Arduino.h>
+#include "weather.h"
+
+// ====================================================================================
+// Données météo publiées en double tampon, lecture sans verrou
+// Le producteur (récupération météo) remplit un tampon privé puis le publie d'un
+// seul échange atomique : un échec en cours de route ne laisse jamais un mélange
+// d'anciennes et de nouvelles valeurs. Un compteur de lecteurs par tampon empêche
+// le producteur de réécrire un tampon encore lu.
+// ====================================================================================
+
+void weatherStoreBegin();
+
+// Vue cohérente des dernières données publiées, valable pendant la durée de vie de l'objet
+class WeatherSnapshot {
+public:
+  WeatherSnapshot();
+  ~WeatherSnapshot();
+  WeatherSnapshot(const WeatherSnapshot &) = delete;
+  WeatherSnapshot &operator=(const WeatherSnapshot &) = delete;
+
+  const WeatherData *operator->() const { return _data; }
+  const WeatherData &operator*() const { return *_data; }
+  uint32_t generation() const { return _generation; }
+
+private:
+  const WeatherData *_data;
+  uint8_t _idx;
+  uint32_t _generation;
+};
+
+// Producteur unique : tampon privé initialisé avec les données publiées
+// (nullptr si un lecteur retient encore ce tampon au-delà du délai)
+WeatherData *weatherBeginUpdate();
+void weatherPublish();      // rend le tampon privé visible, génération + 1
+void weatherAbortUpdate();  // abandonne le tampon privé (données publiées inchangées)
+
+// Incrémentée à chaque publication : un rendu peut être sauté si elle n'a pas changé
+uint32_t weatherGeneration();
@@ -0,0 +1,130 @@
+// widgets.h
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "config.h"
+#include "data_fields.h"
+
+// ====================================================================================
+// Widgets en mode retenu
+// Une page est une liste constante de widgets (libellé, valeur, icône, barre ou zone
+// personnalisée), chacun avec sa boîte englobante et le masque des données dont il
+// dépend. Sur l'écran, une mise à jour ne retrace que les widgets dont une dépendance
+// a changé de génération (dataChanged) et dont le contenu diffère de celui affiché :
+// seule leur boîte est effacée et renvoyée à l'écran.
+// ====================================================================================
+
+enum WidgetKind : uint8_t {
+  WIDGET_LABEL,  // texte fixe (tracé avec la page seulement)
+  WIDGET_VALUE,  // texte calculé par 'fill'
+  WIDGET_ICON,   // icône météo nommée par 'fill' (drawWeatherIcon)
+  WIDGET_BAR,    // jauge horizontale 0..100 calculée par 'fill'
+  WIDGET_CUSTOM  // tracé libre par 'draw' (courbe, listes défilantes)
+};
+
+// Police : taille GFX 1..3 (coin haut gauche du texte) ou police U8g2 (ligne de base)
+enum WidgetFont : uint8_t { WFONT_GFX1 = 1, WFONT_GFX2 = 2, WFONT_TITLE = 0x10, WFONT_TEMP_BIG = 0x11 };
+
+#define WIDGET_TEXT_MAX 48
+#define WIDGETS_PER_PAGE_MAX 24
+#define WIDGET_BG 0x0000
+
+// Contenu courant d'un widget ; la couleur est préremplie avec celle du widget
+struct WidgetContent {
+  char text[WIDGET_TEXT_MAX]; // VALUE : texte ; ICON : code d'icône
+  uint16_t color;
+  uint8_t level;              // BAR : remplissage en %
+};
+
+struct Widget;
+typedef void (*WidgetFillFn)(WidgetContent &c);
+// partial : le widget est déjà à l'écran et sa boîte n'a pas été effacée (retraçage
+// partiel possible). Renvoie le nombre de pixels envoyés (0 = toute la boîte).
+typedef uint32_t (*WidgetDrawFn)(Adafruit_GFX &g, const Widget &w, bool partial);
+
+struct Widget {
+  WidgetKind kind;
+  uint8_t font;
+  int16_t x, y, w, h;  // boîte englobante
+  int8_t textDy;       // position verticale du texte dans la boîte (ligne de base en U8g2)
+  uint16_t color;
+  uint32_t deps;       // DATA_MASK(...) ; 0 = statique
+  const char *text;    // LABEL
+  WidgetFillFn fill;   // VALUE, ICON, BAR
+  WidgetDrawFn draw;   // CUSTOM
+};
+
+struct WidgetPage {
+  const Widget *items;
+  uint8_t count;
+};
+
+// Page construite depuis un tableau constant : le nombre de widgets est vérifié à la
+// compilation (l'état retenu de l'écran suit au plus WIDGETS_PER_PAGE_MAX widgets)
+template <size_t N>
+constexpr WidgetPage widgetPage(const Widget (&items)[N]) {
+  static_assert(N <= WIDGETS_PER_PAGE_MAX, "page : plus de WIDGETS_PER_PAGE_MAX widgets");
+  return WidgetPage{items, (uint8_t)N};
+}
+
+// --- Constructeurs (tables constantes en flash) ---
+constexpr uint8_t widgetTextLen(const char *s) { return *s ? 1 + widgetTextLen(s + 1) : 0; }
+
+// Libellé en police GFX, boîte ajustée au texte
+constexpr Widget widgetLabel(int16_t x, int16_t y, uint8_t size, uint16_t color, const char *text) {
+  return Widget{WIDGET_LABEL, size, x, y, (int16_t)(6 * size * widgetTextLen(text)), (int16_t)(8 * size), 0,
+                color, 0, text, nullptr, nullptr};
+}
+// Titre de page en police proportionnelle (ligne de base y = 42)
+constexpr Widget widgetTitle(const char *text) {
+  return Widget{WIDGET_LABEL, WFONT_TITLE, 10, 26, 220, 20, 16, 0x07FF, 0, text, nullptr, nullptr};
+}
+// Ligne(s) de texte GFX jusqu'au bord droit de l'écran
+constexpr Widget widgetLine(int16_t x, int16_t y, uint16_t color, uint32_t deps, WidgetFillFn fill,
+                            uint8_t lines = 1) {
+  return Widget{WIDGET_VALUE, WFONT_GFX1, x, y, (int16_t)(TFT_WIDTH - x), (int16_t)(8 * lines), 0, color, deps,
+                nullptr, fill, nullptr};
+}
+constexpr Widget widgetValue(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t font, int8_t textDy,
+                             uint16_t color, uint32_t deps, WidgetFillFn fill) {
+  return Widget{WIDGET_VALUE, font, x, y, w, h, textDy, color, deps, nullptr, fill, nullptr};
+}
+constexpr Widget widgetIcon(int16_t x, int16_t y, uint32_t deps, WidgetFillFn fill) {
+  return Widget{WIDGET_ICON, 0, x, y, 26, 26, 0, 0, deps, nullptr, fill, nullptr};
+}
+constexpr Widget widgetBar(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint32_t deps,
+                           WidgetFillFn fill) {
+  return Widget{WIDGET_BAR, 0, x, y, w, h, 0, color, deps, nullptr, fill, nullptr};
+}
+constexpr Widget widgetCustom(int16_t x, int16_t y, int16_t w, int16_t h, uint32_t deps, WidgetDrawFn draw) {
+  return Widget{WIDGET_CUSTOM, 0, x, y, w, h, 0, 0, deps, nullptr, nullptr, draw};
+}
+
+// Efface la boîte d'un widget (tracés CUSTOM)
+void widgetClear(Adafruit_GFX &g, const Widget &w);
+
+// Tracé complet d'une page sur une cible quelconque (écran, pré-rendu, mesures)
+void widgetsDraw(Adafruit_GFX &g, const WidgetPage &page);
+// Union des dépendances des widgets d'une page (invalidation du cache de pages)
+uint32_t widgetsDeps(const WidgetPage &page);
+
+// --- État retenu de l'écran ---
+// Met l'écran à jour : tracé complet si 'page' n'y est pas, sinon seulement les widgets invalidés
+void widgetsUpdate(Adafruit_GFX &screen, const WidgetPage &page);
+// 'page' vient d'être affichée par un autre moyen (cache pré-rendu) avec les données courantes
+void widgetsScreenSync(const WidgetPage &page);
+// L'écran a été modifié hors widgets (progression OTA) : prochain tracé complet
+void widgetsScreenInvalidate();
+
+struct WidgetStats {
+  uint32_t updates;      // mises à jour incrémentales
+  uint32_t fullPaints;   // tracés complets à l'écran
+  uint32_t invalidated;  // widgets dont une dépendance a changé
+  uint32_t redrawn;      // widgets effectivement retracés (contenu différent)
+  uint32_t pixels;       // pixels envoyés par les mises à jour incrémentales
+  uint8_t lastInvalidated, lastRedrawn;
+  uint32_t lastPixels;
+};
+const WidgetStats &widgetsStats();
+// Journalise et remet à zéro les compteurs ([WIDGET])
+void widgetsReport();
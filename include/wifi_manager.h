@@ -0,0 +1,27 @@
+// wifi_manager.h
+#pragma once
+#include <Arduino.h>
+
+// ====================================================================================
+// Connexion WiFi rapide et reprise en arrière-plan
+// Le dernier point d'accès (SSID, BSSID, canal) et le bail DHCP sont conservés en
+// mémoire RTC et en NVS : une reconnexion vise directement l'AP, sans balayage.
+// Après une coupure, la tâche de fond retente avec un délai exponentiel.
+// ====================================================================================
+
+struct WifiLinkStats {
+  uint32_t lastConnectMs;   // durée de la dernière connexion (début de tentative -> IP)
+  uint32_t lastOutageMs;    // durée de la dernière coupure terminée
+  uint32_t outageStartMs;   // début de la coupure en cours (0 si connecté)
+  uint32_t nextAttemptMs;   // échéance de la prochaine tentative (millis)
+  uint16_t disconnects;
+  int8_t rssiAvg;           // moyenne glissante (dBm)
+  int8_t rssiMin;
+  bool fastPath;            // dernière connexion obtenue depuis le cache (sans balayage)
+};
+
+// Connexion au démarrage (bloquante, bornée) ; true si connecté
+bool wifiBegin();
+// Tâche périodique : surveillance du lien, reconnexion, qualité (RSSI)
+void wifiJob();
+const WifiLinkStats &wifiStats();
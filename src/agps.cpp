@@ -0,0 +1,110 @@
+// agps.cpp
+#include "config.h"
+#include "agps.h"
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <LittleFS.h>
+
+// Fichier de cache : [époque du téléchargement, 4 octets LSB d'abord][messages UBX AID-*]
+static bool cacheAge(uint32_t &ageS) {
+  File f = LittleFS.open(AGPS_CACHE_FILE, "r");
+  if (!f) return false;
+  uint8_t hdr[4];
+  bool ok = f.read(hdr, sizeof(hdr)) == sizeof(hdr) && f.size() > sizeof(hdr);
+  f.close();
+  if (!ok) return false;
+  uint32_t stamp = hdr[0] | (hdr[1] << 8) | (hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+  time_t now = time(nullptr);
+  ageS = (now > stamp) ? (uint32_t)(now - stamp) : 0;
+  return true;
+}
+
+static bool download(double lat, double lon) {
+  if (WiFi.status() != WL_CONNECTED) return false;
+  uint32_t t0 = millis();
+  // Format 'aid' : messages AID-* compris par les récepteurs u-blox 7
+  String url = String(AGPS_URL) + "?token=" + TOKEN_UBLOX_AGPS +
+               ";gnss=gps;datatype=eph,alm,aux,pos;format=aid;lat=" + String(lat, 2) +
+               ";lon=" + String(lon, 2) + ";pacc=" + String(AGPS_POS_ACC_M);
+  HTTPClient http;
+  http.begin(url);
+  int code = http.GET();
+  if (code != HTTP_CODE_OK) {
+    Serial.printf("[AGPS] ERREUR: HTTP %d\n", code);
+    http.end();
+    return false;
+  }
+
+  File f = LittleFS.open(AGPS_CACHE_FILE ".tmp", "w");
+  if (!f) {
+    http.end();
+    return false;
+  }
+  uint32_t stamp = (uint32_t)time(nullptr);
+  uint8_t hdr[4] = {(uint8_t)stamp, (uint8_t)(stamp >> 8), (uint8_t)(stamp >> 16), (uint8_t)(stamp >> 24)};
+  f.write(hdr, sizeof(hdr));
+  int bytes = http.writeToStream(&f);
+  f.close();
+  http.end();
+  if (bytes <= 0) {
+    LittleFS.remove(AGPS_CACHE_FILE ".tmp");
+    Serial.printf("[AGPS] ERREUR: telechargement interrompu (%d)\n", bytes);
+    return false;
+  }
+  // Remplacement atomique : un téléchargement interrompu ne détruit pas l'ancien cache
+  LittleFS.remove(AGPS_CACHE_FILE);
+  LittleFS.rename(AGPS_CACHE_FILE ".tmp", AGPS_CACHE_FILE);
+  Serial.printf("[AGPS] %d o telecharges en %lu ms\n", bytes, (unsigned long)(millis() - t0));
+  return true;
+}
+
+// Une trame AID à la fois, ligne vidée puis pause : le u-blox 7 n'acquitte pas les AID et
+// un envoi d'un bloc du fichier déborde son tampon de réception
+static bool inject(Stream &gpsPort) {
+  File f = LittleFS.open(AGPS_CACHE_FILE, "r");
+  if (!f) return false;
+  f.seek(4);
+  uint8_t frame[128]; // AID-EPH, la plus longue : 104 o de charge utile
+  size_t total = 0;
+  uint16_t frames = 0;
+  uint32_t t0 = millis();
+  while (f.read(frame, 6) == 6) {
+    uint16_t len = frame[4] | frame[5] << 8;
+    if (frame[0] != 0xB5 || frame[1] != 0x62 || len + 8u > sizeof(frame) ||
+        f.read(frame + 6, len + 2) != len + 2u) {
+      Serial.printf("[AGPS] ERREUR: trame %u illisible, injection arretee\n", frames);
+      break;
+    }
+    gpsPort.write(frame, len + 8);
+    gpsPort.flush();
+    delay(AGPS_FRAME_GAP_MS);
+    total += len + 8;
+    frames++;
+  }
+  f.close();
+  Serial.printf("[AGPS] %u o injectes (%u trames) en %lu ms\n", (unsigned)total, frames,
+                (unsigned long)(millis() - t0));
+  return total > 0;
+}
+
+bool agpsBegin(Stream &gpsPort, double approxLat, double approxLon) {
+  if (!LittleFS.begin(true)) {
+    Serial.println("[AGPS] ERREUR: LittleFS indisponible");
+    return false;
+  }
+
+  // L'âge du cache n'a de sens qu'une fois l'heure NTP obtenue
+  struct tm tmNow;
+  bool timeKnown = getLocalTime(&tmNow, 2000);
+  uint32_t ageS = 0;
+  bool cached = cacheAge(ageS);
+  bool fresh = cached && timeKnown && ageS < AGPS_MAX_AGE_S;
+
+  if (!fresh && download(approxLat, approxLon)) {
+    cached = true;
+    ageS = 0;
+  } else if (cached) {
+    Serial.printf("[AGPS] Cache de %lu min%s\n", (unsigned long)(ageS / 60), timeKnown ? "" : " (heure inconnue)");
+  }
+  return cached && inject(gpsPort);
+}
@@ -0,0 +1,113 @@
+// arena.cpp
+#include "arena.h"
+#include <esp_heap_caps.h>
+
+#define ARENA_ALIGN 8
+#define ARENA_HEADER 8 // taille du bloc, alignée
+
+Arena fetchArena;
+
+static size_t alignUp(size_t n) {
+  return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+bool Arena::begin(size_t psramBytes, size_t internalBytes) {
+  if (_base) return true;
+  if (psramFound() && psramBytes) {
+    _base = (uint8_t *)heap_caps_malloc(psramBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (_base) {
+      _size = psramBytes;
+      _psram = true;
+    }
+  }
+  if (!_base && internalBytes) {
+    _base = (uint8_t *)heap_caps_malloc(internalBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (_base) _size = internalBytes;
+  }
+  Serial.printf("[ARENA] %u o reserves en %s\n", (unsigned)_size, !_base ? "(echec)" : _psram ? "PSRAM" : "RAM interne");
+  return _base != nullptr;
+}
+
+void *Arena::allocate(size_t size) {
+  size_t need = ARENA_HEADER + alignUp(size);
+  if (!_base || need > _size - _top) {
+    _failures++;
+    return nullptr;
+  }
+  uint8_t *hdr = _base + _top;
+  *(uint32_t *)hdr = (uint32_t)size;
+  _last = _top;
+  _top += need;
+  if (_top > _peak) _peak = _top;
+  if (_top > _highWater) _highWater = _top;
+  return hdr + ARENA_HEADER;
+}
+
+void *Arena::reallocate(void *ptr, size_t size) {
+  if (!ptr) return allocate(size);
+  uint8_t *hdr = (uint8_t *)ptr - ARENA_HEADER;
+  size_t offset = hdr - _base;
+  if (offset == _last) {
+    // Dernier bloc (chaîne en cours d'analyse) : redimensionné sur place
+    size_t need = ARENA_HEADER + alignUp(size);
+    if (need > _size - offset) {
+      _failures++;
+      return nullptr;
+    }
+    *(uint32_t *)hdr = (uint32_t)size;
+    _top = offset + need;
+    if (_top > _peak) _peak = _top;
+    if (_top > _highWater) _highWater = _top;
+    return ptr;
+  }
+  // Bloc intermédiaire réduit (ou inchangé) : rien à déplacer
+  size_t oldSize = *(uint32_t *)hdr;
+  if (size <= oldSize) return ptr;
+  // Agrandi : copie en fin d'arène, l'ancien reste perdu jusqu'au reset
+  void *moved = allocate(size);
+  if (moved) memcpy(moved, ptr, min(oldSize, size));
+  return moved;
+}
+
+size_t Arena::blockSize(const void *ptr) const {
+  return *(const uint32_t *)((const uint8_t *)ptr - ARENA_HEADER);
+}
+
+void Arena::deallocate(void *ptr) {
+  if (!ptr) return;
+  size_t offset = (uint8_t *)ptr - ARENA_HEADER - _base;
+  if (offset == _last) {
+    _top = offset;
+    _last = SIZE_MAX;
+  }
+}
+
+void Arena::reset() {
+  _top = 0;
+  _last = SIZE_MAX;
+  _peak = 0;
+}
+
+// Arène absente ou pleine : le document continue sur le tas plutôt que d'échouer
+void *ArenaJsonAllocator::allocate(size_t size) {
+  void *p = _arena.ready() ? _arena.allocate(size) : nullptr;
+  return p ? p : malloc(size);
+}
+
+void ArenaJsonAllocator::deallocate(void *ptr) {
+  if (_arena.owns(ptr)) _arena.deallocate(ptr);
+  else free(ptr);
+}
+
+void *ArenaJsonAllocator::reallocate(void *ptr, size_t size) {
+  if (!ptr) return allocate(size);
+  if (!_arena.owns(ptr)) return realloc(ptr, size);
+  void *p = _arena.reallocate(ptr, size);
+  if (p) return p;
+  // Plus de place dans l'arène : le bloc passe sur le tas
+  p = malloc(size);
+  if (!p) return nullptr;
+  memcpy(p, ptr, min(_arena.blockSize(ptr), size));
+  _arena.deallocate(ptr);
+  return p;
+}
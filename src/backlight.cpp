@@ -0,0 +1,148 @@
+// backlight.cpp
+#include "config.h"
+#include "backlight.h"
+#include "buttons.h"
+#include <driver/ledc.h>
+
+#ifdef SOC_LEDC_SUPPORT_HS_MODE
+#define BL_LEDC_MODE (LEDC_BL_CH < 8 ? LEDC_HIGH_SPEED_MODE : LEDC_LOW_SPEED_MODE)
+#else
+#define BL_LEDC_MODE LEDC_LOW_SPEED_MODE
+#endif
+#define BL_LEDC_CHANNEL ((ledc_channel_t)(LEDC_BL_CH % 8))
+
+// Courbe luminosité ambiante (%) -> rapport cyclique (0..255), interpolation linéaire
+struct CurvePoint { uint8_t lumPct; uint8_t duty; };
+static const CurvePoint kCurve[] = BACKLIGHT_CURVE;
+static const uint8_t kCurveLen = sizeof(kCurve) / sizeof(kCurve[0]);
+
+static Adafruit_ST77xx *tftPanel = nullptr;
+static float ambientPct = 100.0f;   // valeur lissée (EMA)
+static uint8_t currentDuty = 255;
+// Mise en veille en deux pas (sans bloquer l'ordonnanceur) : fondu vers 0, puis SLPIN
+// au premier passage de backlightLoop() après la fin du fondu
+enum BacklightState : uint8_t { BL_AWAKE, BL_FADING_OUT, BL_ASLEEP };
+static BacklightState state = BL_AWAKE;
+static uint32_t fadeOutStartMs = 0;
+static uint32_t lastActivityMs = 0;
+
+// Compteurs de rapport cyclique (intégration sur le temps)
+static uint32_t lastAccountMs = 0;
+static uint64_t dutyMsSum = 0;      // somme duty * ms
+static uint64_t awakeMs = 0;        // temps écran allumé
+static uint64_t totalMs = 0;
+
+static uint8_t curveDuty(float lum) {
+  if (lum <= kCurve[0].lumPct) return kCurve[0].duty;
+  for (uint8_t i = 1; i < kCurveLen; i++) {
+    if (lum <= kCurve[i].lumPct) {
+      const CurvePoint &a = kCurve[i - 1], &b = kCurve[i];
+      return a.duty + (uint8_t)((lum - a.lumPct) * (b.duty - a.duty) / (b.lumPct - a.lumPct));
+    }
+  }
+  return kCurve[kCurveLen - 1].duty;
+}
+
+static void accountDuty() {
+  uint32_t now = millis();
+  uint32_t dt = now - lastAccountMs;
+  lastAccountMs = now;
+  dutyMsSum += (uint64_t)currentDuty * dt;
+  if (state != BL_ASLEEP) awakeMs += dt; // dalle active pendant le fondu
+  totalMs += dt;
+}
+
+// Fondu matériel LEDC vers la consigne (sans réveiller le CPU)
+static void fadeTo(uint8_t duty, uint32_t ms) {
+  accountDuty();
+  if (duty == currentDuty) return;
+  ledc_set_fade_with_time(BL_LEDC_MODE, BL_LEDC_CHANNEL, duty, ms);
+  ledc_fade_start(BL_LEDC_MODE, BL_LEDC_CHANNEL, LEDC_FADE_NO_WAIT);
+  currentDuty = duty;
+}
+
+static uint8_t readAmbientPct() {
+  // Capteur : tension croissante avec la lumière, ADC 12 bits
+  return (uint8_t)(analogRead(PIN_LIGHT_SENSOR) * 100UL / 4095);
+}
+
+void backlightBegin(Adafruit_ST77xx &panel) {
+  tftPanel = &panel;
+  analogSetPinAttenuation(PIN_LIGHT_SENSOR, ADC_11db);
+  ledc_fade_func_install(0);
+  ambientPct = readAmbientPct();
+  lastActivityMs = lastAccountMs = millis();
+  fadeTo(curveDuty(ambientPct), BACKLIGHT_FADE_MS);
+}
+
+void backlightLoop() {
+  // Lissage exponentiel (constante de temps ~ BACKLIGHT_SAMPLE_MS * 8)
+  ambientPct += (readAmbientPct() - ambientPct) / 8.0f;
+
+  // Inactivité comparée en durées écoulées (correcte au passage à zéro de millis())
+  uint32_t now = millis();
+  uint32_t idleMs = min(now - lastActivityMs, now - buttonsLastActivityMs());
+  if (state == BL_AWAKE && idleMs > BACKLIGHT_SLEEP_MS) {
+    Serial.println("[ECLAIRAGE] Mise en veille ecran (inactivite)");
+    fadeTo(0, BACKLIGHT_FADE_MS);
+    state = BL_FADING_OUT;
+    fadeOutStartMs = now;
+    return;
+  }
+  if (state == BL_FADING_OUT && now - fadeOutStartMs >= BACKLIGHT_FADE_MS) {
+    tftPanel->enableSleep(true); // fondu terminé : SLPIN
+    state = BL_ASLEEP;
+  }
+  if (state != BL_AWAKE) {
+    accountDuty();
+    return;
+  }
+
+  uint8_t target = curveDuty(ambientPct);
+  // Hystérésis : ignorer les petites variations (bruit ADC)
+  if (abs((int)target - (int)currentDuty) >= 4) fadeTo(target, BACKLIGHT_FADE_MS);
+  else accountDuty();
+}
+
+bool backlightNotifyActivity() {
+  lastActivityMs = millis();
+  if (state == BL_AWAKE) return false;
+  Serial.println("[ECLAIRAGE] Reveil ecran");
+  if (state == BL_ASLEEP) {
+    tftPanel->enableSleep(false);
+    delay(5); // délai requis après SLPOUT
+  }
+  state = BL_AWAKE; // un fondu en cours est simplement inversé
+  accountDuty();
+  fadeTo(curveDuty(ambientPct), BACKLIGHT_FADE_MS);
+  return true;
+}
+
+bool backlightIsAsleep() {
+  return state != BL_AWAKE;
+}
+
+bool backlightIsLowLight() {
+  return ambientPct < LUMIN_LOW_THRESHOLD;
+}
+
+uint8_t backlightAmbientPct() {
+  return (uint8_t)ambientPct;
+}
+
+uint8_t backlightDuty() {
+  return currentDuty;
+}
+
+uint8_t backlightAvgDutyPct() {
+  return totalMs ? (uint8_t)(dutyMsSum * 100 / (totalMs * 255)) : 0;
+}
+
+uint32_t backlightSavedMwhPerDay() {
+  if (totalMs == 0) return 0;
+  // Référence : rétroéclairage fixe à 200/255 et dalle toujours active
+  float refMw = BACKLIGHT_FULL_MW * 200.0f / 255.0f + TFT_PANEL_MW;
+  float avgMw = BACKLIGHT_FULL_MW * (float)dutyMsSum / (255.0f * totalMs) + TFT_PANEL_MW * (float)awakeMs / totalMs;
+  float saved = (refMw - avgMw) * 24.0f;
+  return saved > 0 ? (uint32_t)saved : 0;
+}
@@ -0,0 +1,145 @@
+// baro_forecast.cpp
+#include "config.h"
+#include "baro_forecast.h"
+#include <time.h>
+
+// --- Tables Zambretti ---
+// Indice Z = a - b x P (P niveau mer en hPa, coefficients x100), borné par tendance
+struct ZambrettiRange {
+  int16_t a100;
+  int16_t b100;
+  uint8_t zMin, zMax;
+};
+static const ZambrettiRange kRanges[3] = {
+  {12700, 12, 1, 9},   // baisse
+  {14400, 13, 10, 19}, // stable
+  {18500, 16, 20, 32}, // hausse
+};
+
+// Lettre de prévision pour chaque indice Z (1..32)
+static const char kLetters[] = " ABDHORUXZ" "ABEKNPSWXZ" "ABCFGIJLMQTYZ";
+
+struct ZambrettiText {
+  const char *text;
+  const char *icon;
+};
+// Indexé par lettre - 'A' (V inutilisée)
+static const ZambrettiText kTexts[26] = {
+  {"Beau temps stable", "clear"},
+  {"Beau temps", "clear"},
+  {"Devenant beau", "clear"},
+  {"Beau, se degradant", "clouds"},
+  {"Beau, averses possibles", "clouds"},
+  {"Assez beau, amelioration", "clouds"},
+  {"Assez beau, averses tot", "clouds"},
+  {"Assez beau, averses plus tard", "clouds"},
+  {"Averses puis amelioration", "rain"},
+  {"Variable, amelioration", "clouds"},
+  {"Assez beau, averses probables", "clouds"},
+  {"Instable, eclaircies plus tard", "clouds"},
+  {"Instable, amelioration probable", "rain"},
+  {"Averses, eclaircies", "rain"},
+  {"Averses, se degradant", "rain"},
+  {"Variable, un peu de pluie", "rain"},
+  {"Instable, courtes eclaircies", "rain"},
+  {"Instable, pluie plus tard", "rain"},
+  {"Instable, pluie par moments", "rain"},
+  {"Tres instable, eclaircies", "rain"},
+  {"Pluie par moments, aggravation", "rain"},
+  {"", "clouds"},
+  {"Pluie frequente", "rain"},
+  {"Tres instable, pluie", "rain"},
+  {"Tempete, amelioration possible", "storm"},
+  {"Tempete, fortes pluies", "storm"},
+};
+
+uint8_t zambrettiIndex(float seaLevelHpa, int8_t trend, int8_t season) {
+  // Correction saisonnière : en été une hausse annonce mieux, en hiver une baisse annonce pire
+  float p = seaLevelHpa;
+  if (season > 0 && trend > 0) p += BARO_SEASON_ADJUST_HPA;
+  if (season < 0 && trend < 0) p -= BARO_SEASON_ADJUST_HPA;
+  const ZambrettiRange &r = kRanges[trend + 1];
+  long z = lroundf((r.a100 - r.b100 * p) / 100.0f);
+  return (uint8_t)constrain(z, (long)r.zMin, (long)r.zMax);
+}
+
+char zambrettiLetter(uint8_t z) {
+  return (z >= 1 && z <= 32) ? kLetters[z] : '?';
+}
+
+const char *zambrettiText(char letter) {
+  return (letter >= 'A' && letter <= 'Z') ? kTexts[letter - 'A'].text : "";
+}
+
+const char *zambrettiIcon(char letter) {
+  return (letter >= 'A' && letter <= 'Z') ? kTexts[letter - 'A'].icon : "clouds";
+}
+
+// --- Historique de pression (pression station : indépendante de l'altitude retenue) ---
+struct BaroHistory {
+  struct Point {
+    uint32_t ms;
+    uint16_t hpa10;
+  };
+  Point points[BARO_HISTORY_LEN];
+  uint8_t count = 0;
+  uint8_t head = 0;          // prochain emplacement
+  float filtered = NAN;      // pression lissée (bruit du capteur ~0,1 hPa)
+  float altitudeM = NAN;     // altitude lissée (bruit GPS de quelques mètres)
+};
+
+static float seaLevel(float stationHpa, float altitudeM) {
+  return stationHpa / powf(1.0f - altitudeM / 44330.0f, 5.255f);
+}
+
+// Saison au lieu de la station : +1 été (avril-septembre au nord), -1 hiver, 0 heure inconnue
+static int8_t currentSeason(double latitude) {
+  time_t now = time(nullptr);
+  struct tm tmv;
+  localtime_r(&now, &tmv);
+  if (tmv.tm_year + 1900 < 2020) return 0;
+  bool northSummer = tmv.tm_mon >= 3 && tmv.tm_mon <= 8;
+  return (northSummer == (latitude >= 0)) ? 1 : -1;
+}
+
+static void update(BaroHistory &h, float stationHpa, float altitudeM, int8_t season, uint32_t nowMs,
+                   BaroForecast &out) {
+  uint32_t t0 = micros();
+  h.filtered = isnan(h.filtered) ? stationHpa : h.filtered + (stationHpa - h.filtered) / 8.0f;
+  if (!isnan(altitudeM)) {
+    h.altitudeM = isnan(h.altitudeM) ? altitudeM : h.altitudeM + (altitudeM - h.altitudeM) / 16.0f;
+  }
+
+  const BaroHistory::Point *last = h.count ? &h.points[(h.head + BARO_HISTORY_LEN - 1) % BARO_HISTORY_LEN] : nullptr;
+  if (!last || nowMs - last->ms >= BARO_HISTORY_STEP_MS) {
+    h.points[h.head] = {nowMs, (uint16_t)lroundf(h.filtered * 10.0f)};
+    h.head = (h.head + 1) % BARO_HISTORY_LEN;
+    if (h.count < BARO_HISTORY_LEN) h.count++;
+  }
+
+  // Tendance : mesure actuelle contre le point le plus ancien (3 h au plus), ramenée à 3 h
+  const BaroHistory::Point &oldest = h.points[(h.head + BARO_HISTORY_LEN - h.count) % BARO_HISTORY_LEN];
+  uint32_t span = nowMs - oldest.ms;
+  out.trendValid = span >= BARO_MIN_SPAN_MS;
+  out.trendHpa3h = out.trendValid ? (h.filtered - oldest.hpa10 / 10.0f) * (3 * 3600000.0f / span) : 0.0f;
+  out.trend = (out.trendHpa3h <= -BARO_STEADY_HPA) ? -1 : (out.trendHpa3h >= BARO_STEADY_HPA) ? 1 : 0;
+
+  out.valid = true;
+  out.stationHpa = h.filtered;
+  out.seaLevelHpa = seaLevel(h.filtered, isnan(h.altitudeM) ? BARO_DEFAULT_ALT_M : h.altitudeM);
+  out.z = zambrettiIndex(out.seaLevelHpa, out.trend, season);
+  out.letter = zambrettiLetter(out.z);
+  out.text = zambrettiText(out.letter);
+  out.icon = zambrettiIcon(out.letter);
+  out.classifyUs = micros() - t0;
+}
+
+static BaroHistory history;
+
+void baroAddSample(float stationHpa, float altitudeM, double latitude, BaroForecast &out) {
+#if BARO_RAW_LOG
+  Serial.printf("BARO,%lu,%.2f,%.1f\n", (unsigned long)millis(), stationHpa, altitudeM);
+#endif
+  if (isnan(stationHpa) || stationHpa < 300.0f || stationHpa > 1100.0f) return; // capteur absent
+  update(history, stationHpa, altitudeM, currentSeason(latitude), millis(), out);
+}
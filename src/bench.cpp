@@ -0,0 +1,56 @@
+// bench.cpp
+#include "bench.h"
+#include <esp_system.h>
+
+static uint32_t samples[BENCH_MAX_ITERATIONS];
+static uint16_t caseCount = 0;
+static uint32_t seriesStartMs = 0;
+
+void benchBegin() {
+  caseCount = 0;
+  seriesStartMs = millis();
+  Serial.printf("BENCH {\"begin\":1,\"version\":\"%s\",\"cpu_mhz\":%u,\"idf\":\"%s\",\"heap\":%u}\n",
+                DIAGNOSTIC_VERSION, (unsigned)ESP.getCpuFreqMHz(), esp_get_idf_version(),
+                (unsigned)ESP.getFreeHeap());
+}
+
+BenchResult benchRun(const char *name, BenchFn fn, uint16_t iterations) {
+  BenchResult r = {};
+  if (iterations == 0) iterations = 1;
+  if (iterations > BENCH_MAX_ITERATIONS) iterations = BENCH_MAX_ITERATIONS;
+  fn(); // chauffe : cache flash, glyphes, premières allocations
+
+  uint64_t total = 0;
+  for (uint16_t i = 0; i < iterations; i++) {
+    uint32_t c0 = ESP.getCycleCount();
+    fn();
+    samples[i] = ESP.getCycleCount() - c0; // différence modulo 2^32 : valable jusqu'à ~17 s à 240 MHz
+    total += samples[i];
+  }
+  // Tri par insertion (quelques centaines d'échantillons au plus) pour la médiane
+  for (uint16_t i = 1; i < iterations; i++) {
+    uint32_t v = samples[i];
+    uint16_t j = i;
+    for (; j > 0 && samples[j - 1] > v; j--) samples[j] = samples[j - 1];
+    samples[j] = v;
+  }
+  r.iterations = iterations;
+  r.minCycles = samples[0];
+  r.medianCycles = samples[iterations / 2];
+  r.meanCycles = (uint32_t)(total / iterations);
+  r.maxCycles = samples[iterations - 1];
+
+  // Médiane en µs avec une décimale (entiers seulement)
+  uint32_t mhz = max<uint32_t>(ESP.getCpuFreqMHz(), 1);
+  uint32_t tenthsUs = (uint32_t)((uint64_t)r.medianCycles * 10 / mhz);
+  Serial.printf("BENCH {\"case\":\"%s\",\"n\":%u,\"min\":%lu,\"med\":%lu,\"mean\":%lu,\"max\":%lu,\"us\":%lu.%lu}\n",
+                name, r.iterations, (unsigned long)r.minCycles, (unsigned long)r.medianCycles,
+                (unsigned long)r.meanCycles, (unsigned long)r.maxCycles, (unsigned long)(tenthsUs / 10),
+                (unsigned long)(tenthsUs % 10));
+  caseCount++;
+  return r;
+}
+
+void benchEnd() {
+  Serial.printf("BENCH {\"end\":1,\"cases\":%u,\"ms\":%lu}\n", caseCount, (unsigned long)(millis() - seriesStartMs));
+}
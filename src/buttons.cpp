@@ -0,0 +1,67 @@
+// buttons.cpp
+#include "buttons.h"
+#include "scheduler.h"
+#include <driver/gpio.h>
+
+static const uint8_t kButtonPins[NUM_BUTTONS] = {PIN_BTN1, PIN_BTN2};
+
+static QueueHandle_t edgeQueue = nullptr;
+static ButtonMachine<NUM_BUTTONS> machine;
+static volatile uint32_t lastEdgeMs = 0;
+static uint32_t droppedEdges = 0;
+static volatile bool queueOverflow = false;
+
+// Une ISR par bouton (index connu à la compilation)
+template <uint8_t I>
+static void IRAM_ATTR buttonIsr() {
+  ButtonEdge e = {I, gpio_get_level((gpio_num_t)kButtonPins[I]) == 0, (uint32_t)millis()};
+  lastEdgeMs = e.timeMs;
+  BaseType_t woken = pdFALSE;
+  if (xQueueSendFromISR(edgeQueue, &e, &woken) != pdTRUE) queueOverflow = true;
+  if (woken) portYIELD_FROM_ISR();
+  schedulerNotifyFromISR(); // réveiller loop()
+}
+
+void buttonsBegin() {
+  // GPIO 34 (BTN1) : INPUT-ONLY sans pull-up interne, pull-up externe requise
+  // GPIO 27 (BTN2) : GPIO normal, peut utiliser pull-up interne
+  pinMode(PIN_BTN1, INPUT);
+  pinMode(PIN_BTN2, INPUT_PULLUP);
+
+  edgeQueue = xQueueCreate(BTN_EDGE_QUEUE_LEN, sizeof(ButtonEdge));
+
+  bool pressed[NUM_BUTTONS];
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) pressed[i] = digitalRead(kButtonPins[i]) == LOW;
+  machine.reset(pressed, millis());
+
+  attachInterrupt(PIN_BTN1, buttonIsr<0>, CHANGE);
+  attachInterrupt(PIN_BTN2, buttonIsr<1>, CHANGE);
+  // Pas de gpio_wakeup_enable() ici : il remplacerait le type d'interruption CHANGE
+  // (niveau bas) et les relâchements ne seraient plus capturés. Le firmware n'entre
+  // jamais en light-sleep ; s'il le fait un jour, le réveil GPIO devra être armé juste
+  // avant esp_light_sleep_start() et GPIO_INTR_ANYEDGE rétabli au retour.
+}
+
+bool buttonsPoll(ButtonEvent &evt) {
+  ButtonEdge e;
+  while (xQueueReceive(edgeQueue, &e, 0) == pdTRUE) machine.onEdge(e.button, e.pressed, e.timeMs);
+  if (queueOverflow) {
+    queueOverflow = false;
+    droppedEdges++;
+    Serial.printf("[BTN] ATTENTION: file de fronts pleine (%u debordements)\n", (unsigned)droppedEdges);
+  }
+
+  if (!machine.poll(millis(), evt)) return false;
+
+  static const char *const kNames[] = {"-", "court", "long", "accord", "repetition"};
+  Serial.printf("[BTN] Bouton %u : appui %s\n", evt.button + 1, kNames[evt.gesture]);
+  return true;
+}
+
+uint32_t buttonsMsUntilNextDeadline() {
+  return machine.msUntilNextDeadline(millis());
+}
+
+uint32_t buttonsLastActivityMs() {
+  return lastEdgeMs;
+}
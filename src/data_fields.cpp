@@ -0,0 +1,12 @@
+// data_fields.cpp
+#include "data_fields.h"
+
+static uint32_t generations[DATA_FIELD_COUNT];
+
+void dataChanged(DataField f) {
+  if (f < DATA_FIELD_COUNT) generations[f]++;
+}
+
+uint32_t dataGeneration(DataField f) {
+  return f < DATA_FIELD_COUNT ? generations[f] : 0;
+}
@@ -0,0 +1,339 @@
+// font_renderer.cpp
+#include "config.h"
+#include "font_renderer.h"
+#include <U8g2lib.h>
+
+const FontSpec FONT_TEMP_BIG = {u8g2_font_logisoso58_tr, 2};
+const FontSpec FONT_TITLE = {u8g2_font_helvB24_tf, 2};
+
+// --- En-tête d'une police U8g2 (23 octets) ---
+struct U8g2FontInfo {
+  uint8_t bitsPer0, bitsPer1;
+  uint8_t bitsPerW, bitsPerH, bitsPerX, bitsPerY, bitsPerD;
+  uint8_t maxHeight;
+  int8_t yOffset;
+  uint16_t startUpperA, startLowerA;
+};
+
+static U8g2FontInfo readFontInfo(const uint8_t *f) {
+  U8g2FontInfo fi;
+  fi.bitsPer0 = f[2];
+  fi.bitsPer1 = f[3];
+  fi.bitsPerW = f[4];
+  fi.bitsPerH = f[5];
+  fi.bitsPerX = f[6];
+  fi.bitsPerY = f[7];
+  fi.bitsPerD = f[8];
+  fi.maxHeight = f[10];
+  fi.yOffset = (int8_t)f[12];
+  fi.startUpperA = (f[17] << 8) | f[18];
+  fi.startLowerA = (f[19] << 8) | f[20];
+  return fi;
+}
+
+// Lecture de bits LSB d'abord (format U8g2)
+struct BitReader {
+  const uint8_t *p;
+  uint8_t bitPos;
+
+  uint8_t get(uint8_t cnt) {
+    uint8_t val = *p >> bitPos;
+    uint8_t next = bitPos + cnt;
+    if (next >= 8) {
+      uint8_t s = 8 - bitPos;
+      p++;
+      val |= *p << s;
+      next -= 8;
+    }
+    bitPos = next;
+    return val & ((1U << cnt) - 1);
+  }
+  int8_t getSigned(uint8_t cnt) { return (int8_t)get(cnt) - (int8_t)(1 << (cnt - 1)); }
+};
+
+// Données d'un glyphe (encodage 8 bits), nullptr si absent
+static const uint8_t *findGlyph(const uint8_t *font, const U8g2FontInfo &fi, uint8_t encoding) {
+  const uint8_t *g = font + 23;
+  if (encoding >= 'a') g += fi.startLowerA;
+  else if (encoding >= 'A') g += fi.startUpperA;
+  for (;;) {
+    if (g[1] == 0) return nullptr;
+    if (g[0] == encoding) return g + 2;
+    g += g[1];
+  }
+}
+
+static inline int16_t floorDiv(int16_t a, int16_t b) {
+  return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static inline uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t a, uint8_t aMax) {
+  if (a == 0) return bg;
+  if (a >= aMax) return fg;
+  uint16_t r = (((fg >> 11) & 0x1F) * a + ((bg >> 11) & 0x1F) * (aMax - a)) / aMax;
+  uint16_t g = (((fg >> 5) & 0x3F) * a + ((bg >> 5) & 0x3F) * (aMax - a)) / aMax;
+  uint16_t b = ((fg & 0x1F) * a + (bg & 0x1F) * (aMax - a)) / aMax;
+  return (r << 11) | (g << 5) | b;
+}
+
+// --- Cache LRU de glyphes pré-mélangés (RGB565) ---
+struct GlyphSlot {
+  const uint8_t *font;
+  uint16_t fg, bg;
+  uint8_t encoding;
+  bool used;
+  uint8_t w, h;
+  int8_t xOff, yOff;  // position du coin haut-gauche relative au curseur / à la ligne de base
+  uint8_t advance;
+  uint32_t lastUse;
+  uint32_t pin;       // passe de tracé qui utilise le slot (non évinçable pendant cette passe)
+  uint16_t *pixels;
+};
+
+static GlyphSlot slots[GLYPH_CACHE_SLOTS];
+static uint16_t *pool = nullptr;
+static uint32_t useClock = 0;
+static uint32_t drawPass = 0; // passe de tracé en cours (slots épinglés)
+static GlyphCacheStats cacheStats = {0, 0, 0};
+static Adafruit_SPITFT *screenTarget = nullptr;
+
+void fontBegin(Adafruit_SPITFT &screen) {
+  screenTarget = &screen;
+  if (pool) return;
+  // Réservé une fois au démarrage : pas d'allocation pendant le rendu
+  pool = (uint16_t *)malloc(GLYPH_CACHE_SLOTS * GLYPH_CACHE_SLOT_PX * sizeof(uint16_t));
+  if (!pool) {
+    Serial.println("[FONT] ERREUR: allocation du cache de glyphes impossible");
+    return;
+  }
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    slots[i].used = false;
+    slots[i].pin = 0;
+    slots[i].pixels = pool + i * GLYPH_CACHE_SLOT_PX;
+  }
+}
+
+const GlyphCacheStats &fontCacheStats() {
+  return cacheStats;
+}
+
+// Décode un glyphe, le réduit (sur-échantillonnage) et le mélange dans 'slot'
+static bool rasterizeGlyph(const FontSpec &font, uint8_t encoding, uint16_t fg, uint16_t bg, GlyphSlot &slot) {
+  const U8g2FontInfo fi = readFontInfo(font.u8g2Font);
+  const uint8_t *data = findGlyph(font.u8g2Font, fi, encoding);
+  if (!data) return false;
+
+  const uint8_t S = font.oversample;
+  BitReader br = {data, 0};
+  uint8_t w = br.get(fi.bitsPerW);
+  uint8_t h = br.get(fi.bitsPerH);
+  int8_t x = br.getSigned(fi.bitsPerX);
+  int8_t y = br.getSigned(fi.bitsPerY);
+  int8_t d = br.getSigned(fi.bitsPerD);
+
+  // Boîte du glyphe en sortie (pixels réels)
+  int16_t gx0 = x, gy0 = -(h + y);
+  int16_t ox0 = floorDiv(gx0, S), oy0 = floorDiv(gy0, S);
+  int16_t ow = w ? floorDiv(gx0 + w - 1, S) - ox0 + 1 : 0;
+  int16_t oh = h ? floorDiv(gy0 + h - 1, S) - oy0 + 1 : 0;
+  if (ow * oh > GLYPH_CACHE_SLOT_PX) {
+    Serial.printf("[FONT] Glyphe %u trop grand pour le cache (%dx%d)\n", encoding, ow, oh);
+    return false;
+  }
+
+  slot.font = font.u8g2Font;
+  slot.encoding = encoding;
+  slot.fg = fg;
+  slot.bg = bg;
+  slot.w = ow;
+  slot.h = oh;
+  slot.xOff = ox0;
+  slot.yOff = oy0;
+  slot.advance = (d + S / 2) / S;
+  slot.used = true;
+
+  // Accumulation de la couverture (0..S*S) directement dans le tampon du slot
+  uint16_t *cov = slot.pixels;
+  memset(cov, 0, ow * oh * sizeof(uint16_t));
+  if (w > 0) {
+    uint8_t lx = 0, ly = 0;
+    auto run = [&](uint8_t len, bool on) {
+      uint8_t cnt = len;
+      for (;;) {
+        uint8_t rem = w - lx;
+        uint8_t cur = cnt < rem ? cnt : rem;
+        if (on) {
+          int16_t oy = floorDiv(gy0 + ly, S) - oy0;
+          for (uint8_t i = 0; i < cur; i++) cov[oy * ow + floorDiv(gx0 + lx + i, S) - ox0]++;
+        }
+        if (cnt < rem) break;
+        cnt -= rem;
+        lx = 0;
+        ly++;
+      }
+      lx += cnt;
+    };
+    for (;;) {
+      uint8_t a = br.get(fi.bitsPer0);
+      uint8_t b = br.get(fi.bitsPer1);
+      do {
+        run(a, false);
+        run(b, true);
+      } while (br.get(1) != 0);
+      if (ly >= h) break;
+    }
+  }
+
+  const uint8_t aMax = S * S;
+  for (int i = 0; i < ow * oh; i++) cov[i] = blend565(fg, bg, cov[i], aMax);
+  return true;
+}
+
+// Slot du glyphe, épinglé pour la passe de tracé en cours ; nullptr si le glyphe est absent
+// ou si tous les slots sont déjà épinglés ('full' : la passe doit être tracée avant de continuer)
+static const GlyphSlot *getGlyph(const FontSpec &font, uint8_t encoding, uint16_t fg, uint16_t bg, bool &full) {
+  useClock++;
+  full = false;
+  GlyphSlot *victim = nullptr;
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    GlyphSlot &s = slots[i];
+    if (s.used && s.encoding == encoding && s.font == font.u8g2Font && s.fg == fg && s.bg == bg) {
+      s.lastUse = useClock;
+      s.pin = drawPass;
+      cacheStats.hits++;
+      return &s;
+    }
+    if (s.used && s.pin == drawPass) continue; // déjà collecté pour cette passe
+    if (!victim || !s.used) victim = &s;
+    else if (victim->used && s.lastUse < victim->lastUse) victim = &s;
+  }
+  if (!victim) {
+    full = true;
+    return nullptr;
+  }
+  cacheStats.misses++;
+  if (victim->used) cacheStats.evictions++;
+  victim->used = false;
+  if (!rasterizeGlyph(font, encoding, fg, bg, *victim)) return nullptr;
+  victim->lastUse = useClock;
+  victim->pin = drawPass;
+  return victim;
+}
+
+// Décode le prochain caractère UTF-8 (limité à Latin-1), '?' sinon
+static uint8_t nextLatin1(const char *&p) {
+  uint8_t c = (uint8_t)*p++;
+  if (c < 0x80) return c;
+  if ((c & 0xE0) == 0xC0 && (*p & 0xC0) == 0x80) {
+    uint16_t cp = ((c & 0x1F) << 6) | (*p++ & 0x3F);
+    return cp < 0x100 ? (uint8_t)cp : '?';
+  }
+  while ((*p & 0xC0) == 0x80) p++; // séquence plus longue : ignorée
+  return '?';
+}
+
+int16_t fontLineHeight(const FontSpec &font) {
+  return (font.u8g2Font[10] + font.oversample - 1) / font.oversample;
+}
+
+int16_t fontTextWidth(const FontSpec &font, const char *text) {
+  // Lecture de l'avance seule (sans décoder ni polluer le cache)
+  const U8g2FontInfo fi = readFontInfo(font.u8g2Font);
+  int16_t w = 0;
+  for (const char *p = text; *p;) {
+    const uint8_t *data = findGlyph(font.u8g2Font, fi, nextLatin1(p));
+    if (!data) continue;
+    BitReader br = {data, 0};
+    br.get(fi.bitsPerW);
+    br.get(fi.bitsPerH);
+    br.get(fi.bitsPerX);
+    br.get(fi.bitsPerY);
+    w += (br.getSigned(fi.bitsPerD) + font.oversample / 2) / font.oversample;
+  }
+  return w;
+}
+
+// Trace une passe de glyphes résolus (slots épinglés) dans une cellule commune
+static void drawGlyphRun(Adafruit_GFX &g, int16_t x, int16_t cellY, int16_t top, int16_t cellH,
+                         const GlyphSlot *const glyphs[], const int16_t pens[], uint8_t n, int16_t width,
+                         uint16_t bg) {
+  if (&g != screenTarget) {
+    // Cible hors écran : fond de cellule puis pixels de glyphes (une transaction, comme à l'écran)
+    int16_t baselineY = cellY - top;
+    g.startWrite();
+    g.fillRect(x, cellY, width, cellH, bg);
+    for (uint8_t k = 0; k < n; k++) {
+      const GlyphSlot *gl = glyphs[k];
+      for (int16_t r = 0; r < gl->h; r++) {
+        for (int16_t c = 0; c < gl->w; c++) {
+          uint16_t px = gl->pixels[r * gl->w + c];
+          int16_t dx = pens[k] + gl->xOff + c;
+          if (px != bg && dx >= 0 && dx < width) g.drawPixel(x + dx, baselineY + gl->yOff + r, px);
+        }
+      }
+    }
+    g.endWrite();
+    return;
+  }
+  Adafruit_SPITFT &tft = *screenTarget;
+
+  // Une seule fenêtre d'adresse, envoi ligne par ligne
+  static uint16_t line[TFT_WIDTH];
+  tft.startWrite();
+  tft.setAddrWindow(x, cellY, width, cellH);
+  for (int16_t row = 0; row < cellH; row++) {
+    int16_t gy = top + row;
+    for (int16_t i = 0; i < width; i++) line[i] = bg;
+    for (uint8_t k = 0; k < n; k++) {
+      const GlyphSlot *gl = glyphs[k];
+      int16_t r = gy - gl->yOff;
+      if (r < 0 || r >= gl->h) continue;
+      const uint16_t *src = gl->pixels + r * gl->w;
+      for (int16_t c = 0; c < gl->w; c++) {
+        int16_t px = pens[k] + gl->xOff + c;
+        if (px < 0 || px >= width || src[c] == bg) continue;
+        line[px] = src[c];
+      }
+    }
+    tft.writePixels(line, width);
+  }
+  tft.endWrite();
+}
+
+int16_t fontDrawText(Adafruit_GFX &g, int16_t x, int16_t baselineY, const char *text,
+                     const FontSpec &font, uint16_t fg, uint16_t bg) {
+  if (!pool) return x;
+  const U8g2FontInfo fi = readFontInfo(font.u8g2Font);
+  const uint8_t S = font.oversample;
+  // Cellule verticale commune à toute la chaîne
+  int16_t top = floorDiv(-(fi.maxHeight + fi.yOffset), S);
+  int16_t cellH = fontLineHeight(font) + 1;
+
+  // Les glyphes d'une passe restent épinglés dans le cache jusqu'à son tracé. Une chaîne
+  // de plus de GLYPH_CACHE_SLOTS glyphes distincts est tracée en plusieurs passes.
+  const GlyphSlot *glyphs[TFT_WIDTH / 4];
+  int16_t pens[TFT_WIDTH / 4];
+  const char *p = text;
+  while (*p && x < TFT_WIDTH) {
+    drawPass++;
+    uint8_t n = 0;
+    int16_t pen = 0;
+    while (*p && n < TFT_WIDTH / 4) {
+      const char *q = p;
+      bool full;
+      const GlyphSlot *gl = getGlyph(font, nextLatin1(q), fg, bg, full);
+      if (full) break; // caractère repris à la passe suivante
+      p = q;
+      if (!gl) continue;
+      glyphs[n] = gl;
+      pens[n++] = pen;
+      pen += gl->advance;
+    }
+    if (n == 0) break; // GLYPH_CACHE_SLOTS nul ou caractères absents de la police
+    int16_t width = min<int16_t>(pen, TFT_WIDTH - x);
+    if (width > 0) drawGlyphRun(g, x, baselineY + top, top, cellH, glyphs, pens, n, width, bg);
+    x += pen;
+    if (n == TFT_WIDTH / 4) break; // au-delà de la largeur de l'écran
+  }
+  return x;
+}
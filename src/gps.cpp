@@ -2,39 +2,91 @@
 #include "config.h"
 #include "gps.h"
 #include <HardwareSerial.h>
-#include <TinyGPSPlus.h>
+#include "nmea.h"
+#include "ubx.h"
+#include "agps.h"
+#include "scheduler.h"
 
 HardwareSerial GPS(1);
-TinyGPSPlus gpsParser;
+static NmeaParser gpsParser;
 
 volatile bool ppsPulse = false;
 unsigned long lastPpsMs = 0;
 
+// Débit de l'analyse (remis à zéro à chaque gpsLogStats)
+static uint32_t parsedBytes = 0;
+static uint32_t parseUs = 0;
+
+// Temps du premier fix
+static uint32_t gpsStartMs = 0;
+static bool firstFixLogged = false;
+static bool assisted = false;
+
 void IRAM_ATTR ppsISR() {
   ppsPulse = true;
   lastPpsMs = millis();
+  schedulerNotifyFromISR();
 }
 
-void gpsBegin() {
-  GPS.begin(9600, SERIAL_8N1, PIN_GPS_RX, PIN_GPS_TX);
+// Données NMEA reçues : réveiller loop() (appelé depuis la tâche d'événements UART)
+static void gpsOnReceive() {
+  schedulerNotify();
+}
+
+void gpsBegin(double approxLat, double approxLon) {
+  // Après un redémarrage de l'ESP32 seul (OTA, /reboot, chien de garde) le GT-U7, toujours
+  // alimenté, est resté à GPS_BAUD ; 9600 bauds (réglages d'usine) s'il ne répond pas
+  GPS.begin(GPS_BAUD, SERIAL_8N1, PIN_GPS_RX, PIN_GPS_TX);
+  bool configured = ubxProbe(GPS, GPS_BAUD, 300);
+  if (!configured && !ubxProbe(GPS, 9600, 300)) {
+    Serial.printf("[GPS] ERREUR: pas de reponse UBX a %u ni a 9600 bauds\n", (unsigned)GPS_BAUD);
+  }
+  Serial.printf("[GPS] Recepteur a %u bauds%s\n", (unsigned)GPS.baudRate(), configured ? " (deja configure)" : "");
+  ubxConfigure(GPS, GPS_BAUD, GPS_NAV_RATE_MS);
+  assisted = agpsBegin(GPS, approxLat, approxLon);
+  gpsStartMs = millis();
+  GPS.onReceive(gpsOnReceive);
   pinMode(PIN_GPS_PPS, INPUT);
   attachInterrupt(PIN_GPS_PPS, ppsISR, RISING);
 }
 
 void gpsLoop(GpsFix &fix) {
+  bool updated = false;
+  uint32_t t0 = micros();
   while (GPS.available() > 0) {
     char c = GPS.read();
-    gpsParser.encode(c);
+#if GPS_RAW_ECHO
+    Serial.write(c);
+#endif
+    if (gpsParser.encode(c)) updated = true;
+    parsedBytes++;
   }
+  parseUs += micros() - t0;
 
-  if (gpsParser.location.isUpdated() && gpsParser.location.isValid()) {
-    fix.lat = gpsParser.location.lat();
-    fix.lon = gpsParser.location.lng();
-    fix.hasFix = true;
-  } else {
-    fix.hasFix = false;
+  const NmeaFix &nf = gpsParser.fix();
+  fix.hasFix = updated;
+  if (updated && !firstFixLogged) {
+    firstFixLogged = true;
+    Serial.printf("[GPS] Premier fix (TTFF) en %lu ms, %s assistance, %u satellites\n",
+                  (unsigned long)(millis() - gpsStartMs), assisted ? "avec" : "sans", nf.sats);
   }
-
-  fix.sats = gpsParser.satellites.value();
+  if (updated) {
+    fix.latE7 = nf.latE7;
+    fix.lonE7 = nf.lonE7;
+    fix.altCm = nf.altCm;
+    fix.hdopX100 = nf.hdopX100;
+    fix.utcMs = nf.utcMs;
+    fix.dateDmy = nf.dateDmy;
+  }
+  fix.sats = nf.sats;
   fix.ppsLocked = (millis() - lastPpsMs) < 1500;
-}
\ No newline at end of file
+}
+
+void gpsLogStats() {
+  Serial.printf("[GPS] NMEA: %u o analyses en %u us (%u o/ms CPU), trames ok %u, ignorees %u, erreurs %u\n",
+                (unsigned)parsedBytes, (unsigned)parseUs, (unsigned)(parseUs ? parsedBytes * 1000ULL / parseUs : 0),
+                (unsigned)gpsParser.sentencesOk, (unsigned)gpsParser.sentencesSkipped,
+                (unsigned)gpsParser.checksumErrors);
+  parsedBytes = 0;
+  parseUs = 0;
+}
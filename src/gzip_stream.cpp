@@ -0,0 +1,151 @@
+// gzip_stream.cpp
+#include "gzip_stream.h"
+#include "arena.h"
+#include <rom/crc.h>
+
+// Drapeaux de l'en-tête gzip (RFC 1952)
+#define GZ_FHCRC 0x02
+#define GZ_FEXTRA 0x04
+#define GZ_FNAME 0x08
+#define GZ_FCOMMENT 0x10
+
+GzipInflateStream::GzipInflateStream(Stream &source) : _source(source) {}
+
+GzipInflateStream::~GzipInflateStream() {
+  if (_arenaWork) return; // libérés avec l'arène
+  free(_inflator);
+  free(_dict);
+}
+
+bool GzipInflateStream::fill() {
+  if (_sourceEnd) return false;
+  size_t n = _source.readBytes((char *)_in, sizeof(_in));
+  if (n == 0) {
+    _sourceEnd = true;
+    return false;
+  }
+  _inPos = 0;
+  _inLen = n;
+  _inTotal += n;
+  if (n >= sizeof(_tail)) {
+    memcpy(_tail, _in + n - sizeof(_tail), sizeof(_tail));
+  } else {
+    memmove(_tail, _tail + n, sizeof(_tail) - n);
+    memcpy(_tail + sizeof(_tail) - n, _in, n);
+  }
+  return true;
+}
+
+int GzipInflateStream::sourceByte() {
+  if (_inPos >= _inLen && !fill()) return -1;
+  return _in[_inPos++];
+}
+
+bool GzipInflateStream::begin(Arena *arena) {
+  if (arena && arena->capacity() - arena->used() >= GZIP_WORK_BYTES + 32) {
+    _inflator = (tinfl_decompressor *)arena->allocate(sizeof(tinfl_decompressor));
+    _dict = (uint8_t *)arena->allocate(TINFL_LZ_DICT_SIZE);
+    _arenaWork = true;
+  } else {
+    _inflator = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+    _dict = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+  }
+  if (!_inflator || !_dict) {
+    _status = TINFL_STATUS_FAILED;
+    return false;
+  }
+  tinfl_init(_inflator);
+  setTimeout(_source.getTimeout());
+
+  uint8_t hdr[10];
+  for (uint8_t i = 0; i < sizeof(hdr); i++) {
+    int c = sourceByte();
+    if (c < 0) { _status = TINFL_STATUS_FAILED; return false; }
+    hdr[i] = c;
+  }
+  // 1F 8B, méthode 8 (deflate)
+  if (hdr[0] != 0x1F || hdr[1] != 0x8B || hdr[2] != 8) {
+    _status = TINFL_STATUS_FAILED;
+    return false;
+  }
+  uint8_t flags = hdr[3];
+  if (flags & GZ_FEXTRA) {
+    int lo = sourceByte(), hi = sourceByte();
+    for (int n = lo | (hi << 8); n > 0; n--) sourceByte();
+  }
+  if (flags & GZ_FNAME) while (sourceByte() > 0) {}
+  if (flags & GZ_FCOMMENT) while (sourceByte() > 0) {}
+  if (flags & GZ_FHCRC) { sourceByte(); sourceByte(); }
+  return true;
+}
+
+// Produit le bloc de sortie suivant dans la fenêtre ; false à la fin ou sur erreur
+bool GzipInflateStream::inflateMore() {
+  while (_status > 0 && _outLen == 0) {
+    if (_status == TINFL_STATUS_NEEDS_MORE_INPUT && _inPos >= _inLen && !fill()) {
+      _status = TINFL_STATUS_FAILED; // flux tronqué
+      break;
+    }
+    size_t inBytes = _inLen - _inPos;
+    size_t outBytes = TINFL_LZ_DICT_SIZE - _dictOfs;
+    _status = tinfl_decompress(_inflator, _in + _inPos, &inBytes, _dict, _dict + _dictOfs, &outBytes,
+                               _sourceEnd ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+    _inPos += inBytes;
+    _outPos = _dictOfs;
+    _outLen = outBytes;
+    _dictOfs = (_dictOfs + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+    _crc = crc32_le(_crc, _dict + _outPos, outBytes);
+    _outTotal += outBytes;
+  }
+  if (_status == TINFL_STATUS_DONE && _outLen == 0 && !_done) readTrailer();
+  return _outLen > 0;
+}
+
+// Pied de page : CRC32 puis taille décompressée modulo 2^32 (ISIZE), les 8 derniers octets
+// du flux. tinfl peut en avoir déjà lu jusqu'à 4 dans son tampon de bits ; ils restent dans
+// _tail, qui garde les 8 derniers octets reçus quelle que soit la position de tinfl. Il doit
+// donc rester de 4 à 8 octets après les données compressées : moins, le flux est tronqué ;
+// plus, des données suivent le flux gzip.
+void GzipInflateStream::readTrailer() {
+  _done = true;
+  uint8_t count = 0;
+  while (count <= sizeof(_tail) && sourceByte() >= 0) count++;
+  if (count < 4 || count > sizeof(_tail)) return;
+  uint32_t crc = _tail[0] | _tail[1] << 8 | _tail[2] << 16 | (uint32_t)_tail[3] << 24;
+  uint32_t size = _tail[4] | _tail[5] << 8 | _tail[6] << 16 | (uint32_t)_tail[7] << 24;
+  _trailerOk = crc == _crc && size == _outTotal;
+}
+
+bool GzipInflateStream::finish() {
+  while (inflateMore()) _outLen = 0; // sortie restante ignorée, mais comptée dans le CRC
+  return _done && _trailerOk;
+}
+
+int GzipInflateStream::available() {
+  if (_outLen == 0) inflateMore();
+  return _outLen;
+}
+
+int GzipInflateStream::read() {
+  if (_outLen == 0 && !inflateMore()) return -1;
+  _outLen--;
+  return _dict[_outPos++];
+}
+
+int GzipInflateStream::peek() {
+  if (_outLen == 0 && !inflateMore()) return -1;
+  return _dict[_outPos];
+}
+
+size_t GzipInflateStream::readBytes(char *buffer, size_t length) {
+  size_t total = 0;
+  while (total < length) {
+    if (_outLen == 0 && !inflateMore()) break;
+    size_t n = min(length - total, _outLen);
+    memcpy(buffer + total, _dict + _outPos, n);
+    _outPos += n;
+    _outLen -= n;
+    total += n;
+  }
+  return total;
+}
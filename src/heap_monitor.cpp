@@ -0,0 +1,101 @@
+// heap_monitor.cpp
+#include "config.h"
+#include "heap_monitor.h"
+#include <esp_heap_caps.h>
+
+static HeapStats gStats = {0, 0, 0, UINT32_MAX, 0, 0};
+static HeapSiteStats gSites[HEAP_SITE_COUNT];
+static uint32_t gTrend[HEAP_TREND_LEN];
+static uint8_t gTrendHead = 0, gTrendCount = 0;
+static unsigned long lastTrendMs = 0;
+static HeapAllocCounterFn gAllocCounter = nullptr;
+
+static const char *const kSiteNames[HEAP_SITE_COUNT] = {"capteurs", "meteo", "telegram", "rendu"};
+
+const char *heapSiteName(HeapSite site) {
+  return site < HEAP_SITE_COUNT ? kSiteNames[site] : "?";
+}
+
+void heapMonitorBegin() {
+  memset(gSites, 0, sizeof(gSites));
+  for (int i = 0; i < HEAP_SITE_COUNT; i++) gSites[i].minFreeAfter = UINT32_MAX;
+  gTrendHead = gTrendCount = 0;
+  heapMonitorSample();
+  lastTrendMs = millis();
+  gTrend[0] = gStats.largestBlock;
+  gTrendHead = 1;
+  gTrendCount = 1;
+}
+
+void heapMonitorSample() {
+  uint32_t total = heap_caps_get_total_size(MALLOC_CAP_8BIT);
+  gStats.freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  gStats.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  gStats.minEverFree = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  if (gStats.largestBlock < gStats.minLargestBlock) gStats.minLargestBlock = gStats.largestBlock;
+  uint32_t used = total - gStats.freeHeap;
+  if (used > gStats.peakUsed) gStats.peakUsed = used;
+  gStats.fragPct = gStats.freeHeap ? (uint8_t)(100 - (uint64_t)gStats.largestBlock * 100 / gStats.freeHeap) : 0;
+
+  if (millis() - lastTrendMs >= HEAP_TREND_PERIOD_MS) {
+    lastTrendMs = millis();
+    gTrend[gTrendHead] = gStats.largestBlock;
+    gTrendHead = (gTrendHead + 1) % HEAP_TREND_LEN;
+    if (gTrendCount < HEAP_TREND_LEN) gTrendCount++;
+    heapMonitorLog();
+  }
+}
+
+const HeapStats &heapMonitorStats() {
+  return gStats;
+}
+
+uint8_t heapMonitorTrend(uint32_t *out, uint8_t maxLen) {
+  uint8_t n = min(gTrendCount, maxLen);
+  uint8_t start = (gTrendHead + HEAP_TREND_LEN - n) % HEAP_TREND_LEN;
+  for (uint8_t i = 0; i < n; i++) out[i] = gTrend[(start + i) % HEAP_TREND_LEN];
+  return n;
+}
+
+const HeapSiteStats &heapMonitorSite(HeapSite site) {
+  return gSites[site < HEAP_SITE_COUNT ? site : 0];
+}
+
+void heapMonitorLog() {
+  Serial.printf("[HEAP] libre=%u bloc_max=%u (min %u) min=%u pic=%u frag=%u%%\n",
+                (unsigned)gStats.freeHeap, (unsigned)gStats.largestBlock, (unsigned)gStats.minLargestBlock,
+                (unsigned)gStats.minEverFree, (unsigned)gStats.peakUsed, gStats.fragPct);
+  for (int i = 0; i < HEAP_SITE_COUNT; i++) {
+    const HeapSiteStats &s = gSites[i];
+    if (s.calls == 0) continue;
+    Serial.printf("[HEAP]   %-8s appels=%u var_libre=%d pire=%d min_sortie=%u", kSiteNames[i],
+                  (unsigned)s.calls, (int)s.lastFreeDelta, (int)s.worstFreeDelta, (unsigned)s.minFreeAfter);
+    if (gAllocCounter) Serial.printf(" allocs=%u (%llu o)", (unsigned)s.allocs, (unsigned long long)s.allocBytes);
+    Serial.println();
+  }
+}
+
+void heapMonitorSetAllocCounter(HeapAllocCounterFn fn) {
+  gAllocCounter = fn;
+}
+
+HeapProbe::HeapProbe(HeapSite site)
+  : _site(site), _freeBefore(heap_caps_get_free_size(MALLOC_CAP_8BIT)), _allocsBefore(0), _bytesBefore(0) {
+  if (gAllocCounter) gAllocCounter(_allocsBefore, _bytesBefore);
+}
+
+HeapProbe::~HeapProbe() {
+  uint32_t freeAfter = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  HeapSiteStats &s = gSites[_site];
+  s.calls++;
+  s.lastFreeDelta = (int32_t)freeAfter - (int32_t)_freeBefore;
+  if (s.lastFreeDelta < s.worstFreeDelta) s.worstFreeDelta = s.lastFreeDelta;
+  if (freeAfter < s.minFreeAfter) s.minFreeAfter = freeAfter;
+  if (gAllocCounter) {
+    uint32_t allocs;
+    uint64_t bytes;
+    gAllocCounter(allocs, bytes);
+    s.allocs += allocs - _allocsBefore;
+    s.allocBytes += bytes - _bytesBefore;
+  }
+}
@@ -0,0 +1,181 @@
+// http_reader.cpp
+#include "config.h"
+#include "http_reader.h"
+
+HttpResponseReader::HttpResponseReader(Client &client, uint32_t timeoutMs)
+  : _client(client), _timeoutMs(timeoutMs) {
+  setTimeout(timeoutMs); // Stream::readBytes (ArduinoJson) attend les octets en retard
+}
+
+// Octet brut du socket, en attendant au plus _timeoutMs
+int HttpResponseReader::rawRead() {
+  uint32_t t0 = millis();
+  while (!_client.available()) {
+    if (!_client.connected() || millis() - t0 >= _timeoutMs) return -1;
+    delay(1);
+  }
+  return _client.read();
+}
+
+int HttpResponseReader::readLine(char *line, uint8_t max) {
+  uint8_t len = 0;
+  while (true) {
+    int c = rawRead();
+    if (c < 0) return -1;
+    if (c == '\n') break;
+    if (c != '\r' && len < max - 1) line[len++] = (char)c; // lignes trop longues tronquées
+  }
+  line[len] = '\0';
+  return len;
+}
+
+// Compare un préfixe d'en-tête sans tenir compte de la casse ; renvoie la valeur
+static const char *headerValue(const char *line, const char *name) {
+  size_t n = strlen(name);
+  if (strncasecmp(line, name, n) != 0 || line[n] != ':') return nullptr;
+  const char *v = line + n + 1;
+  while (*v == ' ' || *v == '\t') v++;
+  return v;
+}
+
+static void copyValue(char *dst, size_t size, const char *src) {
+  strncpy(dst, src, size - 1);
+  dst[size - 1] = '\0';
+}
+
+bool HttpResponseReader::readHeaders() {
+  uint32_t t0 = micros();
+  char line[LINE_MAX];
+  int len = readLine(line, sizeof(line));
+  // "HTTP/1.1 200 OK"
+  if (len < 12 || strncmp(line, "HTTP/1.", 7) != 0) {
+    _state = FAILED;
+    return false;
+  }
+  _status = atoi(line + 9);
+  _keepAlive = (line[7] == '1');
+
+  while (true) {
+    len = readLine(line, sizeof(line));
+    if (len < 0) {
+      _state = FAILED;
+      return false;
+    }
+    if (len == 0) break; // ligne vide : fin des en-têtes
+    const char *v;
+    if ((v = headerValue(line, "Content-Length"))) {
+      _contentLength = atol(v);
+    } else if ((v = headerValue(line, "Transfer-Encoding"))) {
+      _chunked = (strcasestr(v, "chunked") != nullptr);
+    } else if ((v = headerValue(line, "Content-Type"))) {
+      copyValue(_contentType, sizeof(_contentType), v);
+    } else if ((v = headerValue(line, "Content-Encoding"))) {
+      copyValue(_contentEncoding, sizeof(_contentEncoding), v);
+    } else if ((v = headerValue(line, "Connection"))) {
+      _keepAlive = (strcasecmp(v, "close") != 0);
+    }
+  }
+  _headersUs = micros() - t0;
+
+  if (_chunked) {
+    _state = CHUNK_SIZE;
+    if (!nextChunk()) return _state != FAILED;
+  } else if (_contentLength >= 0) {
+    _remaining = _contentLength;
+    _state = _remaining ? BODY : DONE;
+  } else {
+    // Ni longueur ni chunked : le corps se termine à la fermeture (HTTP/1.0)
+    _remaining = UINT32_MAX;
+    _keepAlive = false;
+    _state = BODY;
+  }
+  return true;
+}
+
+// Lit la taille du bloc suivant ; false à la fin du corps ou en cas d'erreur
+bool HttpResponseReader::nextChunk() {
+  char line[LINE_MAX];
+  if (_state == CHUNK_END) {
+    // CRLF qui suit les données d'un bloc
+    if (readLine(line, sizeof(line)) != 0) {
+      _state = FAILED;
+      return false;
+    }
+  }
+  if (readLine(line, sizeof(line)) < 1) {
+    _state = FAILED;
+    return false;
+  }
+  _remaining = strtoul(line, nullptr, 16); // les extensions ";..." sont ignorées
+  if (_remaining == 0) {
+    // Dernier bloc : en-têtes de fin éventuels jusqu'à la ligne vide
+    int len;
+    while ((len = readLine(line, sizeof(line))) > 0) {}
+    _state = (len == 0) ? DONE : FAILED;
+    return false;
+  }
+  _state = CHUNK_DATA;
+  return true;
+}
+
+void HttpResponseReader::consumed(uint32_t n) {
+  _bodyBytes += n;
+  _lastByteUs = micros();
+  if (_remaining != UINT32_MAX) _remaining -= n;
+  if (_remaining != 0) return;
+  if (_state == BODY) {
+    _state = DONE;
+  } else if (_state == CHUNK_DATA) {
+    _state = CHUNK_END;
+  }
+}
+
+int HttpResponseReader::available() {
+  if (_state == CHUNK_END) nextChunk();
+  if (_state != BODY && _state != CHUNK_DATA) return 0;
+  int n = _client.available();
+  return (uint32_t)n < _remaining ? n : (int)_remaining;
+}
+
+int HttpResponseReader::read() {
+  if (_state == CHUNK_END) nextChunk();
+  if (_state != BODY && _state != CHUNK_DATA) return -1;
+  int c = rawRead();
+  if (c < 0) {
+    if (_remaining == UINT32_MAX) {
+      _state = DONE; // fermeture = fin du corps sans longueur
+    }
+    return -1;
+  }
+  consumed(1);
+  return c;
+}
+
+int HttpResponseReader::peek() {
+  if (_state == CHUNK_END) nextChunk();
+  if ((_state != BODY && _state != CHUNK_DATA) || !_client.available()) return -1;
+  return _client.peek();
+}
+
+size_t HttpResponseReader::readBytes(char *buffer, size_t length) {
+  size_t total = 0;
+  while (total < length) {
+    if (_state == CHUNK_END) nextChunk();
+    if (_state != BODY && _state != CHUNK_DATA) break;
+    size_t want = length - total;
+    if (want > _remaining) want = _remaining;
+    int n = _client.available();
+    if (n <= 0) {
+      int c = read(); // attente bornée du prochain octet
+      if (c < 0) break;
+      buffer[total++] = (char)c;
+      continue;
+    }
+    if ((size_t)n < want) want = n;
+    int got = _client.read((uint8_t *)buffer + total, want);
+    if (got <= 0) break;
+    total += got;
+    consumed(got);
+  }
+  return total;
+}
@@ -0,0 +1,69 @@
+// local_api.cpp
+#include "config.h"
+#include "local_api.h"
+#include <WiFi.h>
+#include <WebServer.h>
+#include <LittleFS.h>
+#include "ota.h"
+#include "telemetry_frame.h"
+
+static WebServer *server = nullptr;
+static bool restartPending = false;
+
+// Comparaison en temps constant (la durée ne révèle pas le préfixe correct)
+static bool tokenMatches(const String &given) {
+  const char *expected = OTA_HTTP_TOKEN;
+  size_t n = strlen(expected);
+  uint8_t diff = given.length() != n;
+  for (size_t i = 0; i < n; i++) diff |= (uint8_t)(i < given.length() ? given[i] : 0) ^ (uint8_t)expected[i];
+  return diff == 0;
+}
+
+// POST /ota (url, sha256 en formulaire) ; jeton dans l'en-tête OTA_HTTP_TOKEN_HEADER,
+// jamais dans l'URL (journaux, historique des navigateurs et des mandataires)
+static void handleOta() {
+  if (strncmp(OTA_HTTP_TOKEN, "YOUR_", 5) == 0 || !tokenMatches(server->header(OTA_HTTP_TOKEN_HEADER))) {
+    server->send(403, "text/plain", "Jeton invalide\n");
+    return;
+  }
+  OtaResult r;
+  restartPending = otaRun(server->arg("url").c_str(), server->arg("sha256").c_str(), r);
+  server->send(r.ok ? 200 : 500, "text/plain", otaResultText(r) + "\n");
+}
+
+static void handleTelemetry() {
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  size_t len = telemetryEncode(frame, sizeof(frame));
+  if (!len) {
+    server->send(500, "text/plain", "Trame trop grande\n");
+    return;
+  }
+  server->send_P(200, "application/msgpack", (const char *)frame, len);
+}
+
+static void handleTelemetryLog() {
+  File f = LittleFS.open(TELEMETRY_LOG_FILE, "r");
+  if (!f) {
+    server->send(404, "text/plain", "Journal vide\n");
+    return;
+  }
+  server->streamFile(f, "application/octet-stream");
+  f.close();
+}
+
+void localApiJob() {
+  if (WiFi.status() != WL_CONNECTED) return;
+  if (!server) {
+    server = new WebServer(LOCAL_API_PORT);
+    static const char *headers[] = {OTA_HTTP_TOKEN_HEADER};
+    server->collectHeaders(headers, 1);
+    server->on("/ota", HTTP_POST, handleOta);
+    server->on("/telemetry", HTTP_GET, handleTelemetry);
+    server->on("/telemetry.log", HTTP_GET, handleTelemetryLog);
+    server->begin();
+    Serial.printf("[API] Point d'entree local http://%s:%u (/ota, /telemetry, /telemetry.log)\n",
+                  WiFi.localIP().toString().c_str(), (unsigned)LOCAL_API_PORT);
+  }
+  server->handleClient();
+  if (restartPending) otaRestart(); // réponse déjà envoyée au client
+}
@@ -1,6 +1,57 @@
 // ===============================================
 // Station Météo ESP32-S3
-// Version: 1.0.20-dev
+// Version: 1.0.71-dev
+// v1.0.71-dev - Météo : journal des en-têtes sans String temporaire
+// v1.0.70-dev - Ordonnanceur : schedulerSetPeriod repart de la dernière exécution réelle
+// v1.0.69-dev - Boutons : appui court dès le relâchement, BTN1 + BTN2 pour l'accueil
+// v1.0.68-dev - gzip : CRC32 du pied de page vérifié de nouveau, localisé par les 8 derniers octets du flux
+// v1.0.67-dev - Rendu hôte : une image sans référence fait échouer make render
+// v1.0.66-dev - Surveillance : requêtes d'un cycle plafonnées à la part disponible du budget
+// v1.0.65-dev - Météo : tentatives sans réponse du serveur hors budget journalier
+// v1.0.64-dev - GPS : sonde à GPS_BAUD avant 9600 au démarrage, injection AssistNow trame par trame
+// v1.0.63-dev - Simulateur : images PPM du démarrage et des pages, comparées aux références (make render)
+// v1.0.62-dev - Moniteur du tas : variations du libre nommees comme telles, endurance hote (make soak)
+// v1.0.61-dev - Simulateur hote : setup()/loop() complets sous horloge virtuelle, une semaine en quelques secondes
+// v1.0.60-dev - Tests hôte de la prévision Zambretti (test/host/test_baro_forecast), fin de baroSelfTest
+// v1.0.59-dev - Tests hôte de l'analyseur NMEA (g++), TinyGPSPlus retiré
+// v1.0.58-dev - Mesures au démarrage réservées au firmware de bancs d'essai
+// v1.0.57-dev - Surveillance : suspension 429/401, réserve de la météo principale, requêtes envoyées comptées
+// v1.0.56-dev - Arène : réduction sur place, repli sur le tas si pleine ou absente
+// v1.0.55-dev - Gzip : CRC32 du pied de page retiré (position incertaine)
+// v1.0.54-dev - OTA : CRC gzip non exigé, contrôle ISIZE tolérant
+// v1.0.53-dev - OTA locale : POST avec jeton en en-tête, jeton par défaut dans config.h
+// v1.0.52-dev - OTA : commandes Telegram du chat autorisé seulement, images signées
+// v1.0.51-dev - Alertes : défilement matériel ST7789 limité à la zone de texte
+// v1.0.50-dev - Widgets : nombre de widgets par page vérifié à la compilation
+// v1.0.49-dev - Pré-rendu : une bande par passage, dépassements comptés
+// v1.0.48-dev - Rétroéclairage : mise en veille sans attente bloquante
+// v1.0.47-dev - Polices : glyphes d'une passe épinglés dans le cache
+// v1.0.46-dev - Boutons : fronts CHANGE conservés (réveil light-sleep retiré)
+// v1.0.45-dev - Firmware de micro-bancs d'essai (compteur de cycles) et comparaison de séries
+// v1.0.44-dev - Lieux surveillés récupérés en pipeline sur une connexion TLS, page SURVEILLANCE
+// v1.0.43-dev - Cache météo LRU par maille géographique (stations mobiles)
+// v1.0.42-dev - Arène d'allocation (PSRAM si présente) pour le JSON et la fenêtre gzip des récupérations météo
+// v1.0.41-dev - Pages en widgets retenus : seuls les widgets dont les données changent sont retracés
+// v1.0.40-dev - Trames de télémétrie MessagePack versionnées, journal en flash et point d'entrée local
+// v1.0.39-dev - Rafraîchissement météo adaptatif (évolution, alertes, déplacement, échecs) et budget de requêtes journalier
+// v1.0.38-dev - Prévision barométrique locale (Zambretti) sur 3 h de pression BME280, altitude GPS
+// v1.0.37-dev - Mise à jour OTA compressée en flux (Telegram /ota ou réseau local), SHA-256 et retour arrière
+// v1.0.36-dev - Texte d'alerte complet coupé aux mots (mise en page en cache) et défilement par ligne
+// v1.0.35-dev - Données météo en double tampon publiées atomiquement (instantanés sans verrou)
+// v1.0.34-dev - Requête météo réduite (sans minutely) et corps gzip décompressé en flux
+// v1.0.33-dev - Lecteur de réponse HTTP en flux (Content-Length, chunked), fin du délai d'attente
+// v1.0.32-dev - Reconnexion WiFi rapide (BSSID/canal/bail en cache) et reprise en arrière-plan
+// v1.0.31-dev - Configuration UBX du GPS et assistance AssistNow (premier fix rapide)
+// v1.0.30-dev - Analyseur NMEA GGA/RMC sans allocation, en virgule fixe
+// v1.0.29-dev - Temps CPU par tâche et débit de la boucle principale
+// v1.0.28-dev - Comptabilité du rendu (pixels, surimpression, transactions) et capture d'écran série
+// v1.0.27-dev - Pré-rendu compressé des pages voisines, changement de page en un seul transfert
+// v1.0.26-dev - Rétroéclairage adaptatif (capteur de luminosité, fondu LEDC) et veille écran
+// v1.0.25-dev - Polices U8g2 anti-aliasées avec cache LRU de glyphes (température, titres)
+// v1.0.24-dev - Prévisions 48 h / 8 j en virgule fixe (struct-of-arrays), page défilante et courbe de température
+// v1.0.23-dev - Ordonnanceur à échéances : loop() bloquée jusqu'à la prochaine tâche ou un événement
+// v1.0.22-dev - Boutons sur interruptions (file de fronts horodatés, gestes court/long/double/répétition)
+// v1.0.21-dev - Suivi fragmentation du tas (plus grand bloc libre, minimum historique)
 // v1.0.20-dev - Ajout logs debug détaillés (API météo, clé, HTTP, JSON, affichage)
 // v1.0.19-dev - Réécriture gestion boutons (machine à états robuste, debouncing amélioré)
 // v1.0.18-dev - Fix logique boutons (HIGH->LOW avec pull-up), diagnostic au boot
@@ -18,7 +69,6 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WiFiMulti.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 #include <SPI.h>
@@ -30,177 +80,56 @@
 #include "config.h"
 #include "ui_icons.h"
 #include "weather.h"
+#include "weather_store.h"
 #include "gps.h"
 #include "telemetry.h"
+#include "heap_monitor.h"
+#include "buttons.h"
+#include "scheduler.h"
+#include "font_renderer.h"
+#include "backlight.h"
+#include "data_fields.h"
+#include "page_cache.h"
+#include "render_stats.h"
+#include "wifi_manager.h"
+#include "text_layout.h"
+#include "ota.h"
+#include "baro_forecast.h"
+#include "weather_policy.h"
+#include "local_api.h"
+#include "telemetry_frame.h"
+#include "widgets.h"
+#include "arena.h"
+#include "weather_cache.h"
+#include "watchlist.h"
+#if METEO_BENCH
+#include "bench.h"
+#include "bench_payload.h"
+#include "nmea.h"
+#endif
 
-WiFiMulti wifiMulti;
 
 // TFT et capteurs
 Adafruit_ST7789 tft = Adafruit_ST7789(PIN_TFT_CS, PIN_TFT_DC, PIN_TFT_RST);
 // --- [FIX] Capteur BME280 au lieu de DHT22 ---
 Adafruit_BME280 bme; // Capteur BME280 sur I2C
 
-// --- [FIX] Initialisation explicite des données météo ---
-WeatherData gWeather = {
-  .now = {
-    .tempNow = NAN,
-    .conditionCode = 0,
-    .humidity = NAN,
-    .wind = NAN,
-    .tempMin = NAN,
-    .tempMax = NAN,
-    .hasAlert = false,
-    .alertTitle = "",
-    .alertDesc = "",
-    .alertSeverity = ""
-  },
-  .forecast = {}
-};
 float gTempInt = NAN, gHumInt = NAN;
+BaroForecast gBaro = {};    // prévision locale (pression BME280)
 double gLat = DEFAULT_LAT, gLon = DEFAULT_LON;
 bool gUseDefaultGeo = true;
+GpsFix gGps = {};
 
-enum Page : int { PAGE_HOME, PAGE_FORECAST, PAGE_ALERT, PAGE_SENSORS, PAGE_SYSTEM };
-const int NUM_PAGES = 5;
+enum Page : int { PAGE_HOME, PAGE_FORECAST, PAGE_ALERT, PAGE_WATCH, PAGE_SENSORS, PAGE_SYSTEM };
+const int NUM_PAGES = 6;
 Page currentPage = PAGE_HOME;
 
-unsigned long lastSensorMs=0, lastWeatherMs=0, lastGpsTryMs=0, lastNtpMs=0;
-
-// ====================================================================================
-// --- [REWRITE] Gestion des boutons avec machine à états robuste et debouncing ---
-// ====================================================================================
-enum ButtonEvent {
-  BTN_EVT_NONE,
-  BTN_EVT_1_SHORT,
-  BTN_EVT_2_SHORT
-};
-
-// Machine à états pour chaque bouton
-enum ButtonState {
-  BTN_STATE_IDLE,       // Bouton relâché (HIGH)
-  BTN_STATE_DEBOUNCE,   // En cours de debouncing
-  BTN_STATE_PRESSED,    // Bouton pressé confirmé (LOW stable)
-  BTN_STATE_WAIT_RELEASE // Attente du relâchement
-};
-
-const unsigned long DEBOUNCE_DELAY = 50;        // Temps de stabilisation du signal
-const unsigned long MIN_PRESS_TIME = 20;        // Temps minimum de pression pour valider
-const unsigned long REPEAT_DELAY = 500;         // Délai avant répétition automatique
-
-// --- [REWRITE] Gestion robuste avec vérification de stabilité du signal ---
-ButtonEvent getButtonEvent() {
-  static ButtonState btn1_state = BTN_STATE_IDLE;
-  static ButtonState btn2_state = BTN_STATE_IDLE;
-  static unsigned long btn1_timestamp = 0;
-  static unsigned long btn2_timestamp = 0;
-  static bool btn1_event_sent = false;
-  static bool btn2_event_sent = false;
-
-  ButtonEvent event = BTN_EVT_NONE;
-  unsigned long now = millis();
-
-  // ============== Gestion du Bouton 1 ==============
-  int btn1_reading = digitalRead(PIN_BTN1);
-
-  switch (btn1_state) {
-    case BTN_STATE_IDLE:
-      // Bouton relâché, attente d'une pression
-      if (btn1_reading == LOW) {
-        // Début possible d'une pression, démarrer le debouncing
-        btn1_state = BTN_STATE_DEBOUNCE;
-        btn1_timestamp = now;
-      }
-      break;
-
-    case BTN_STATE_DEBOUNCE:
-      // Vérification de la stabilité du signal
-      if (btn1_reading == HIGH) {
-        // Faux positif (rebondissement), retour à l'état idle
-        btn1_state = BTN_STATE_IDLE;
-      } else if ((now - btn1_timestamp) >= DEBOUNCE_DELAY) {
-        // Signal stable LOW pendant DEBOUNCE_DELAY, pression confirmée
-        btn1_state = BTN_STATE_PRESSED;
-        btn1_timestamp = now;
-        btn1_event_sent = false;
-      }
-      break;
-
-    case BTN_STATE_PRESSED:
-      // Bouton pressé confirmé
-      if (btn1_reading == HIGH) {
-        // Bouton relâché prématurément
-        btn1_state = BTN_STATE_IDLE;
-        btn1_event_sent = false;
-      } else if (!btn1_event_sent && (now - btn1_timestamp) >= MIN_PRESS_TIME) {
-        // Pression valide et suffisamment longue
-        event = BTN_EVT_1_SHORT;
-        btn1_event_sent = true;
-        btn1_state = BTN_STATE_WAIT_RELEASE;
-        Serial.println("[BTN] Bouton 1 presse - Page suivante");
-      }
-      break;
-
-    case BTN_STATE_WAIT_RELEASE:
-      // Attente du relâchement du bouton
-      if (btn1_reading == HIGH) {
-        btn1_state = BTN_STATE_IDLE;
-        btn1_event_sent = false;
-      }
-      break;
-  }
-
-  // ============== Gestion du Bouton 2 ==============
-  int btn2_reading = digitalRead(PIN_BTN2);
-
-  switch (btn2_state) {
-    case BTN_STATE_IDLE:
-      // Bouton relâché, attente d'une pression
-      if (btn2_reading == LOW) {
-        // Début possible d'une pression, démarrer le debouncing
-        btn2_state = BTN_STATE_DEBOUNCE;
-        btn2_timestamp = now;
-      }
-      break;
-
-    case BTN_STATE_DEBOUNCE:
-      // Vérification de la stabilité du signal
-      if (btn2_reading == HIGH) {
-        // Faux positif (rebondissement), retour à l'état idle
-        btn2_state = BTN_STATE_IDLE;
-      } else if ((now - btn2_timestamp) >= DEBOUNCE_DELAY) {
-        // Signal stable LOW pendant DEBOUNCE_DELAY, pression confirmée
-        btn2_state = BTN_STATE_PRESSED;
-        btn2_timestamp = now;
-        btn2_event_sent = false;
-      }
-      break;
-
-    case BTN_STATE_PRESSED:
-      // Bouton pressé confirmé
-      if (btn2_reading == HIGH) {
-        // Bouton relâché prématurément
-        btn2_state = BTN_STATE_IDLE;
-        btn2_event_sent = false;
-      } else if (!btn2_event_sent && (now - btn2_timestamp) >= MIN_PRESS_TIME) {
-        // Pression valide et suffisamment longue
-        event = BTN_EVT_2_SHORT;
-        btn2_event_sent = true;
-        btn2_state = BTN_STATE_WAIT_RELEASE;
-        Serial.println("[BTN] Bouton 2 presse - Page precedente");
-      }
-      break;
-
-    case BTN_STATE_WAIT_RELEASE:
-      // Attente du relâchement du bouton
-      if (btn2_reading == HIGH) {
-        btn2_state = BTN_STATE_IDLE;
-        btn2_event_sent = false;
-      }
-      break;
-  }
-
-  return event;
-}
+// --- [NEW FEATURE] Tâches périodiques gérées par l'ordonnanceur (scheduler.h) ---
+JobId jobSensorsId = SCHED_INVALID_JOB, jobWeatherId = SCHED_INVALID_JOB;
+bool needsRender = false;
+// Mesure de latence d'un changement de page (horodatage du front en ISR -> image complète)
+bool pageSwitchPending = false;
+uint32_t pageSwitchPressMs = 0;
 
 // Buzzer
 static void beepConnected() {
@@ -229,42 +158,53 @@ static uint8_t wifiBars() {
   return 0;
 }
 
-// --- [DEBUG] Barre d'état avec logs de debug ---
-static void drawStatusBar() {
-  tft.fillRect(0,0,TFT_WIDTH,20,0x0000);
+// Valeur avec 'decimals' décimales, tirets si inconnue (NaN)
+static const char *fmtValue(char *buf, size_t size, float v, uint8_t decimals) {
+  if (isnan(v)) strlcpy(buf, decimals ? "--.-" : "--", size);
+  else snprintf(buf, size, "%.*f", decimals, v);
+  return buf;
+}
 
+// --- [REWRITE] Barre d'état : widgets communs en tête de chaque page ---
+static uint32_t drawWifiWidget(Adafruit_GFX &g, const Widget &w, bool partial) {
+  if (partial) widgetClear(g, w);
   // Icône WiFi (UNE seule fois, avec logique inversée)
   bool notConnected = (WiFi.status() != WL_CONNECTED);
-  drawWifiIcon(tft, 2, 1, wifiBars(), notConnected);
+  drawWifiIcon(g, w.x, w.y, wifiBars(), notConnected);
+  return 0;
+}
 
-  // Températures
-  String tPrev = isnan(gWeather.now.tempNow) ? "--.-" : String(gWeather.now.tempNow,1);
-  String tInt  = isnan(gTempInt) ? "--.-" : String(gTempInt,1);
-  String line = "Ext " + tPrev + "C Int " + tInt + "C";
+static void fillStatusTemps(WidgetContent &c) {
+  WeatherSnapshot w;
+  char tPrev[8], tInt[8];
+  fmtValue(tPrev, sizeof(tPrev), w->now.tempNow, 1);
+  fmtValue(tInt, sizeof(tInt), gTempInt, 1);
+  snprintf(c.text, sizeof(c.text), "Ext %sC Int %sC", tPrev, tInt);
 
   // --- [DEBUG] Log barre de statut (seulement si les valeurs ont changé) ---
   static float lastTempExt = NAN;
   static float lastTempInt = NAN;
-  if (gWeather.now.tempNow != lastTempExt || gTempInt != lastTempInt) {
-    Serial.print("[AFFICHAGE] Barre statut - Ext: ");
-    Serial.print(tPrev);
-    Serial.print("C, Int: ");
-    Serial.print(tInt);
-    Serial.print("C, Code meteo: ");
-    Serial.println(gWeather.now.conditionCode);
-    lastTempExt = gWeather.now.tempNow;
+  if (w->now.tempNow != lastTempExt || gTempInt != lastTempInt) {
+    Serial.printf("[AFFICHAGE] Barre statut - Ext: %sC, Int: %sC, Code meteo: %d\n", tPrev, tInt,
+                  w->now.conditionCode);
+    lastTempExt = w->now.tempNow;
     lastTempInt = gTempInt;
   }
+}
 
-  tft.setCursor(32,4);
-  tft.setTextColor(0xFFFF);
-  tft.setTextSize(1);
-  tft.print(line);
-
-  // Icône météo
-  drawWeatherIcon(tft, TFT_WIDTH-26, 0, weatherCodeToIcon(gWeather.now.conditionCode));
+static void fillStatusIcon(WidgetContent &c) {
+  WeatherSnapshot w;
+  strlcpy(c.text, weatherCodeToIcon(w->now.conditionCode).c_str(), sizeof(c.text));
 }
 
+#define STATUS_BAR_WIDGETS                                                                               \
+  widgetCustom(2, 1, 26, 22, DATA_MASK(DATA_WIFI), drawWifiWidget),                                     \
+  widgetValue(32, 4, 180, 8, WFONT_GFX1, 0, 0xFFFF, DATA_MASK(DATA_WEATHER) | DATA_MASK(DATA_INTERIOR), \
+              fillStatusTemps),                                                                         \
+  widgetIcon(TFT_WIDTH - 26, 0, DATA_MASK(DATA_WEATHER), fillStatusIcon)
+#define NAV_WIDGET(text) widgetLabel(10, TFT_HEIGHT - 15, 1, 0xC618, text)
+#define NAV_PAGES "BTN1:Page suiv. BTN2:Page prec."
+
 // --- [NEW FEATURE] Écran d'accueil au démarrage ---
 static void showBootScreen() {
   tft.fillScreen(0x0000); // Fond noir
@@ -316,317 +256,1016 @@ static void updateBootProgress(const String &message, bool success = false) {
 
 // --- [NEW FEATURE] Implémentation complète des pages ---
 
-static void drawPageHome() {
-  tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+// Titre de page en police proportionnelle anti-aliasée (écran de mise à jour)
+static void drawPageTitle(Adafruit_GFX &g, const char *title) {
+  fontDrawText(g, 10, 42, title, FONT_TITLE, 0x07FF, 0x0000);
+}
 
-  // --- [DEBUG] Log des données météo affichées ---
-  Serial.println("\n[AFFICHAGE] Page HOME - Donnees meteo:");
-  Serial.print("[AFFICHAGE] Temp actuelle: ");
-  Serial.print(isnan(gWeather.now.tempNow) ? "NAN" : String(gWeather.now.tempNow, 1));
-  Serial.println(" C");
-  Serial.print("[AFFICHAGE] Code condition: ");
-  Serial.println(gWeather.now.conditionCode);
-  Serial.print("[AFFICHAGE] Humidite: ");
-  Serial.print(isnan(gWeather.now.humidity) ? "NAN" : String(gWeather.now.humidity, 0));
-  Serial.println(" %");
-  Serial.print("[AFFICHAGE] Vent: ");
-  Serial.print(isnan(gWeather.now.wind) ? "NAN" : String(gWeather.now.wind, 1));
-  Serial.println(" m/s");
+// --- [REWRITE] Pages en widgets retenus : chaque widget déclare les données qu'il affiche ---
 
-  // Titre
-  tft.setTextColor(0x07FF);
-  tft.setTextSize(2);
-  tft.setCursor(10, 30);
-  tft.println("METEO ACTUELLE");
+// Météo en ligne récente ; sinon l'accueil s'appuie sur la prévision barométrique locale
+static bool weatherFresh() {
+  return weatherPolicyAgeMs() < WEATHER_STALE_MS;
+}
 
-  // Température principale
-  tft.setTextColor(0xFFE0);
-  tft.setTextSize(4);
-  tft.setCursor(40, 60);
-  if (!isnan(gWeather.now.tempNow)) {
-    tft.print(gWeather.now.tempNow, 1);
-    tft.println(" C");
+// Page HOME
+static void fillHomeTemp(WidgetContent &c) {
+  WeatherSnapshot w;
+  char t[8];
+  snprintf(c.text, sizeof(c.text), "%s C", fmtValue(t, sizeof(t), w->now.tempNow, 1));
+}
+
+static void fillHomeMinMax(WidgetContent &c) {
+  WeatherSnapshot w;
+  char tMin[8], tMax[8];
+  snprintf(c.text, sizeof(c.text), "Min:%sC  Max:%sC", fmtValue(tMin, sizeof(tMin), w->now.tempMin, 1),
+           fmtValue(tMax, sizeof(tMax), w->now.tempMax, 1));
+}
+
+static void fillHomeHumidity(WidgetContent &c) {
+  WeatherSnapshot w;
+  char v[8];
+  snprintf(c.text, sizeof(c.text), "Humidite: %s %%", fmtValue(v, sizeof(v), w->now.humidity, 0));
+}
+
+static void fillHomeWind(WidgetContent &c) {
+  WeatherSnapshot w;
+  char v[8];
+  snprintf(c.text, sizeof(c.text), "Vent: %s m/s", fmtValue(v, sizeof(v), w->now.wind, 1));
+}
+
+static void fillHomeCondition(WidgetContent &c) {
+  WeatherSnapshot w;
+  if (weatherFresh()) {
+    snprintf(c.text, sizeof(c.text), "Code: %d", w->now.conditionCode);
   } else {
-    tft.println("--.-C");
-    Serial.println("[AFFICHAGE] ATTENTION: Temperature NAN affichee");
+    c.color = 0xFD20;
+    strlcpy(c.text, "Hors ligne: prevision locale", sizeof(c.text));
   }
+}
 
-  // Min/Max
-  tft.setTextSize(1);
-  tft.setTextColor(0x07E0);
-  tft.setCursor(10, 110);
-  tft.print("Min:");
-  if (!isnan(gWeather.now.tempMin)) tft.print(gWeather.now.tempMin,1);
-  else tft.print("--.-");
-  tft.print("C  Max:");
-  if (!isnan(gWeather.now.tempMax)) tft.print(gWeather.now.tempMax,1);
-  else tft.print("--.-");
-  tft.println("C");
-
-  // Humidité et vent
-  tft.setTextColor(0xFFFF);
-  tft.setCursor(10, 130);
-  tft.print("Humidite: ");
-  if (!isnan(gWeather.now.humidity)) tft.print(gWeather.now.humidity,0);
-  else tft.print("--");
-  tft.println(" %");
-
-  tft.setCursor(10, 145);
-  tft.print("Vent: ");
-  if (!isnan(gWeather.now.wind)) tft.print(gWeather.now.wind,1);
-  else tft.print("--.-");
-  tft.println(" m/s");
-
-  // Condition météo
-  tft.setCursor(10, 165);
-  tft.setTextColor(0x07FF);
-  tft.print("Code: ");
-  tft.println(gWeather.now.conditionCode);
-
-  // Icône grande
-  drawWeatherIcon(tft, 180, 60, weatherCodeToIcon(gWeather.now.conditionCode));
-
-  // Navigation
-  tft.setTextColor(0xC618);
-  tft.setTextSize(1);
-  tft.setCursor(10, TFT_HEIGHT-15);
-  tft.print("BTN1:Page suiv. BTN2:Page prec.");
+// --- [NEW FEATURE] Prévision barométrique locale (Zambretti) ---
+static void fillHomeBaro(WidgetContent &c) {
+  if (!gBaro.valid) return;
+  if (gBaro.trendValid) snprintf(c.text, sizeof(c.text), "Baro: %.1f hPa %+.1f/3h", gBaro.seaLevelHpa, gBaro.trendHpa3h);
+  else snprintf(c.text, sizeof(c.text), "Baro: %.1f hPa (tendance...)", gBaro.seaLevelHpa);
+}
+
+static void fillHomeLocal(WidgetContent &c) {
+  if (gBaro.valid) snprintf(c.text, sizeof(c.text), "Local: %s", gBaro.text);
 }
 
-static void drawPageForecast() {
-  tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+// Icône grande (prévision locale quand la météo en ligne manque)
+static void fillHomeIcon(WidgetContent &c) {
+  WeatherSnapshot w;
+  if (weatherFresh() || !gBaro.valid) strlcpy(c.text, weatherCodeToIcon(w->now.conditionCode).c_str(), sizeof(c.text));
+  else strlcpy(c.text, gBaro.icon, sizeof(c.text));
+}
 
-  tft.setTextColor(0x07FF);
-  tft.setTextSize(2);
-  tft.setCursor(10, 30);
-  tft.println("PREVISIONS");
+static const Widget kHomeWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("METEO ACTUELLE"),
+  // Température principale (police lissée, glyphes en cache)
+  widgetValue(30, 55, 148, 45, WFONT_TEMP_BIG, 39, 0xFFE0, DATA_MASK(DATA_WEATHER), fillHomeTemp),
+  widgetLine(10, 110, 0x07E0, DATA_MASK(DATA_WEATHER), fillHomeMinMax),
+  widgetLine(10, 130, 0xFFFF, DATA_MASK(DATA_WEATHER), fillHomeHumidity),
+  widgetLine(10, 145, 0xFFFF, DATA_MASK(DATA_WEATHER), fillHomeWind),
+  widgetLine(10, 165, 0x07FF, DATA_MASK(DATA_WEATHER), fillHomeCondition),
+  widgetLine(10, 180, 0xFFFF, DATA_MASK(DATA_INTERIOR), fillHomeBaro),
+  widgetLine(10, 195, 0xFD20, DATA_MASK(DATA_INTERIOR), fillHomeLocal, 2),
+  widgetIcon(180, 60, DATA_MASK(DATA_WEATHER) | DATA_MASK(DATA_INTERIOR), fillHomeIcon),
+  NAV_WIDGET(NAV_PAGES),
+};
 
-  int yPos = 60;
-  if (gWeather.forecast.empty()) {
-    tft.setTextColor(0xF800);
-    tft.setTextSize(1);
-    tft.setCursor(10, yPos);
-    tft.println("Aucune prevision disponible");
+// --- [NEW FEATURE] Courbe de température des prévisions horaires (48 h) ---
+static void drawTempCurve(Adafruit_GFX &g, int16_t x, int16_t y, int16_t w, int16_t h) {
+  WeatherSnapshot wd;
+  const HourlyForecast &hf = wd->hourly;
+  int16_t tMin = INT16_MAX, tMax = INT16_MIN;
+  for (uint8_t i = 0; i < hf.count; i++) {
+    if (hf.temp[i] == FORECAST_TEMP_NONE) continue;
+    tMin = min(tMin, hf.temp[i]);
+    tMax = max(tMax, hf.temp[i]);
+  }
+  g.drawRect(x, y, w, h, 0x4208);
+  if (hf.count < 2 || tMin > tMax) return;
+  if (tMax - tMin < 100) tMax = tMin + 100; // échelle minimale de 1 °C
+
+  // Probabilité de pluie en barres bleues (tiers inférieur du cadre)
+  for (uint8_t i = 0; i < hf.count; i++) {
+    int16_t px = x + 1 + (int32_t)i * (w - 2) / hf.count;
+    int16_t bh = (int32_t)hf.pop[i] * (h / 3) / 100;
+    if (bh > 0) g.drawFastVLine(px, y + h - 1 - bh, bh, 0x001F);
+  }
+
+  // Température
+  int16_t prevX = -1, prevY = -1;
+  for (uint8_t i = 0; i < hf.count; i++) {
+    if (hf.temp[i] == FORECAST_TEMP_NONE) { prevX = -1; continue; }
+    int16_t px = x + 1 + (int32_t)i * (w - 3) / (hf.count - 1);
+    int16_t py = y + h - 2 - (int32_t)(hf.temp[i] - tMin) * (h - 4) / (tMax - tMin);
+    if (prevX >= 0) g.drawLine(prevX, prevY, px, py, 0xFD20);
+    prevX = px;
+    prevY = py;
+  }
+
+  g.setTextSize(1);
+  g.setTextColor(0xC618);
+  g.setCursor(x + 2, y + 2);
+  g.print(centiToTemp(tMax), 0);
+  g.setCursor(x + 2, y + h - 10);
+  g.print(centiToTemp(tMin), 0);
+  g.setCursor(x + w - 20, y + 2);
+  g.print(hf.count);
+  g.print("h");
+}
+
+#define FORECAST_ROWS_VISIBLE 4
+int forecastScroll = 0; // premier jour affiché
+
+// Page PREVISIONS : courbe 48 h (météo) et liste des jours (météo + défilement)
+static uint32_t drawForecastCurve(Adafruit_GFX &g, const Widget &wg, bool partial) {
+  if (partial) widgetClear(g, wg);
+  WeatherSnapshot w;
+  if (w->daily.count == 0 && w->hourly.count == 0) {
+    g.setTextColor(0xF800);
+    g.setTextSize(1);
+    g.setCursor(10, 60);
+    g.println("Aucune prevision disponible");
   } else {
-    tft.setTextSize(1);
-    for (size_t i = 0; i < gWeather.forecast.size() && i < 3; i++) {
-      const Forecast &f = gWeather.forecast[i];
+    drawTempCurve(g, wg.x, wg.y, wg.w, wg.h);
+  }
+  return 0;
+}
+
+static uint32_t drawForecastList(Adafruit_GFX &g, const Widget &wg, bool partial) {
+  if (partial) widgetClear(g, wg);
+  WeatherSnapshot w;
+  const DailyForecast &df = w->daily;
+
+  // Liste des jours (défilante)
+  static const char *const kDays[] = {"Dim", "Lun", "Mar", "Mer", "Jeu", "Ven", "Sam"};
+  forecastScroll = constrain(forecastScroll, 0, max(0, (int)df.count - FORECAST_ROWS_VISIBLE));
+  int yPos = wg.y + 2;
+  g.setTextSize(1);
+  for (int i = forecastScroll; i < df.count && i < forecastScroll + FORECAST_ROWS_VISIBLE; i++) {
+    time_t t = df.startTime + (time_t)i * 86400;
+    struct tm tmv;
+    localtime_r(&t, &tmv);
+
+    g.setTextColor(0xFFE0);
+    g.setCursor(4, yPos + 4);
+    g.print(kDays[tmv.tm_wday]);
+    g.print(" ");
+    g.print(tmv.tm_mday);
+
+    g.setTextColor(0xFFFF);
+    g.setCursor(52, yPos + 4);
+    g.print(centiToTemp(df.tempMax[i]), 1);
+    g.print("/");
+    g.print(centiToTemp(df.tempMin[i]), 1);
+    g.print("C");
+
+    g.setTextColor(0x841F);
+    g.setCursor(52, yPos + 14);
+    g.print("pluie ");
+    g.print(df.pop[i]);
+    g.print("%  vent ");
+    g.print(df.wind[i] / 100.0f, 1);
+    g.print("m/s");
+
+    drawWeatherIcon(g, TFT_WIDTH - 28, yPos, weatherCodeToIcon(df.code[i]));
+    yPos += 25;
+  }
+  return 0;
+}
+
+static const Widget kForecastWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("PREVISIONS"),
+  widgetCustom(4, 46, TFT_WIDTH - 8, 72, DATA_MASK(DATA_WEATHER), drawForecastCurve),
+  widgetCustom(0, 122, TFT_WIDTH, 102, DATA_MASK(DATA_WEATHER) | DATA_MASK(DATA_UI), drawForecastList),
+  NAV_WIDGET("Maintien BTN1/BTN2: defiler"),
+};
+
+// --- [REWRITE] Texte d'alerte complet : mise en page en cache et défilement par ligne ---
+#define ALERT_TEXT_Y 100
+#define ALERT_ROW_H 10
+#define ALERT_ROWS_VISIBLE ((TFT_HEIGHT - 20 - ALERT_TEXT_Y) / ALERT_ROW_H)
+#define ALERT_COLS ((TFT_WIDTH - 20) / 6) // police 6x8, marges de 10 px
+
+static TextLayout alertLayout;
+static uint32_t alertLayoutGen = UINT32_MAX;
+int alertScroll = 0;
+static int16_t alertShownLine[ALERT_ROWS_VISIBLE]; // ligne affichée par rangée de l'écran (-1 : vide)
+static bool alertRowsOnScreen = false;             // alertShownLine reflète l'écran réel
+#define ALERT_ROW_STALE -2                         // rangée au contenu inconnu (entrée par défilement)
+
+// Défilement matériel du ST7789 (VSCRDEF/VSCRSADD) limité à la zone de texte : un pas
+// décale la zone dans la mémoire de l'écran et seules les rangées entrantes sont tracées.
+// Les lignes de la mémoire ne suivent l'ordre de l'écran qu'en rotation 2 (MADCTL sans
+// MY ni MV) ; dans les autres rotations, les rangées modifiées sont retracées.
+#define ALERT_HW_SCROLL (TFT_ROTATION == 2)
+#define ST7789_VSCRDEF 0x33
+#define ST7789_VSCRSADD 0x37
+#define ST7789_FRAME_LINES 320
+static uint8_t alertHwRow = 0;  // rangée de la mémoire affichée en haut de la zone
+static int alertShownScroll = 0;
+
+static void alertHwApply(uint8_t row) {
+  alertHwRow = row;
+#if ALERT_HW_SCROLL
+  uint16_t start = ALERT_TEXT_Y + row * ALERT_ROW_H;
+  uint8_t d[2] = {(uint8_t)(start >> 8), (uint8_t)start};
+  tft.sendCommand(ST7789_VSCRSADD, d, 2);
+#endif
+}
 
-      tft.setTextColor(0xFFE0);
-      tft.setCursor(10, yPos);
-      tft.print("Jour ");
-      tft.println(i+1);
+// Zone de défilement : ALERT_TEXT_Y lignes fixes au-dessus, le reste de la mémoire en dessous
+static void alertScrollBegin() {
+#if ALERT_HW_SCROLL
+  const uint16_t tfa = ALERT_TEXT_Y, vsa = ALERT_ROWS_VISIBLE * ALERT_ROW_H, bfa = ST7789_FRAME_LINES - tfa - vsa;
+  uint8_t d[6] = {(uint8_t)(tfa >> 8), (uint8_t)tfa, (uint8_t)(vsa >> 8), (uint8_t)vsa, (uint8_t)(bfa >> 8), (uint8_t)bfa};
+  tft.sendCommand(ST7789_VSCRDEF, d, 6);
+#endif
+  alertHwApply(0);
+}
 
-      tft.setTextColor(0xFFFF);
-      tft.setCursor(20, yPos+15);
-      tft.print("Journee: ");
-      tft.print(f.tempDay, 1);
-      tft.println("C");
+// Remet la zone dans l'ordre de l'écran avant un tracé qui l'ignore (autre page, cache, OTA)
+static void alertScrollReset() {
+  if (alertHwRow == 0) return;
+  alertHwApply(0);
+  alertRowsOnScreen = false;
+}
 
-      tft.setCursor(20, yPos+30);
-      tft.print("Nuit: ");
-      tft.print(f.tempNight, 1);
-      tft.println("C");
+// Ordonnée de la rangée r de la zone de texte (décalée en mémoire sur l'écran)
+static int16_t alertRowY(Adafruit_GFX &g, int r) {
+  if (&g == &tft) r = (r + alertHwRow) % ALERT_ROWS_VISIBLE;
+  return ALERT_TEXT_Y + r * ALERT_ROW_H;
+}
 
-      tft.setCursor(20, yPos+45);
-      tft.print("Code: ");
-      tft.println(f.conditionCode);
+// Recalcule la mise en page seulement quand une nouvelle météo est publiée
+static void alertLayoutUpdate(const WeatherSnapshot &w) {
+  if (w.generation() == alertLayoutGen) return;
+  alertLayoutGen = w.generation();
+  alertLayout.layout(w->now.hasAlert ? w->now.alertDesc : "", ALERT_COLS);
+  alertScroll = 0;
+  alertRowsOnScreen = false; // indices de lignes de l'ancien texte
+  if (w->now.hasAlert) {
+    Serial.printf("[ALERTE] Mise en page: %u lignes en %u us%s\n", (unsigned)alertLayout.lineCount(),
+                  (unsigned)alertLayout.layoutUs(), alertLayout.truncated() ? " (tronque)" : "");
+  }
+}
 
-      drawWeatherIcon(tft, 180, yPos+10, weatherCodeToIcon(f.conditionCode));
+static bool alertSameRow(int16_t a, int16_t b) {
+  if (a == ALERT_ROW_STALE) return false;
+  if (a == b) return true;
+  uint8_t lenA = (a < 0) ? 0 : alertLayout.lineLen(a);
+  uint8_t lenB = (b < 0) ? 0 : alertLayout.lineLen(b);
+  if (lenA != lenB) return false;
+  return lenA == 0 || memcmp(alertLayout.lineText(a), alertLayout.lineText(b), lenA) == 0;
+}
 
-      yPos += 70;
+// Trace les rangées visibles ; onlyChanged : seulement celles dont le texte diffère
+// de ce qui est à l'écran (défilement sans retracer la page). Renvoie le nombre tracé.
+static uint8_t drawAlertRows(Adafruit_GFX &g, bool onlyChanged) {
+  int maxScroll = max(0, (int)alertLayout.lineCount() - ALERT_ROWS_VISIBLE);
+  alertScroll = constrain(alertScroll, 0, maxScroll);
+  bool onScreen = (&g == &tft);
+
+#if ALERT_HW_SCROLL
+  // Pas de défilement plus court que la zone : décalage matériel, les rangées restées
+  // visibles suivent sans être retracées et les rangées entrantes sont à tracer
+  int delta = alertScroll - alertShownScroll;
+  if (onScreen && onlyChanged && delta != 0 && abs(delta) < ALERT_ROWS_VISIBLE) {
+    alertHwApply((alertHwRow + delta + ALERT_ROWS_VISIBLE) % ALERT_ROWS_VISIBLE);
+    int16_t shifted[ALERT_ROWS_VISIBLE];
+    for (int r = 0; r < ALERT_ROWS_VISIBLE; r++) {
+      int src = r + delta;
+      shifted[r] = (src >= 0 && src < ALERT_ROWS_VISIBLE) ? alertShownLine[src] : ALERT_ROW_STALE;
+    }
+    memcpy(alertShownLine, shifted, sizeof(shifted));
+  }
+#endif
+
+  uint8_t drawn = 0;
+  g.setTextSize(1);
+  g.setTextColor(0xFFFF);
+  g.cp437(true);
+  for (int r = 0; r < ALERT_ROWS_VISIBLE; r++) {
+    int16_t line = (alertScroll + r < alertLayout.lineCount()) ? alertScroll + r : -1;
+    if (onlyChanged && alertSameRow(alertShownLine[r], line)) {
+      alertShownLine[r] = line;
+      continue;
     }
+    int16_t y = alertRowY(g, r);
+    g.fillRect(0, y, TFT_WIDTH - 4, ALERT_ROW_H, 0x0000);
+    if (line >= 0) {
+      g.setCursor(10, y + 1);
+      g.write((const uint8_t *)alertLayout.lineText(line), alertLayout.lineLen(line));
+    }
+    if (onScreen) alertShownLine[r] = line;
+    drawn++;
+  }
+  g.cp437(false);
+  if (onScreen) {
+    alertRowsOnScreen = true;
+    alertShownScroll = alertScroll;
   }
 
-  tft.setTextColor(0xC618);
-  tft.setTextSize(1);
-  tft.setCursor(10, TFT_HEIGHT-15);
-  tft.print("BTN1:Page suiv. BTN2:Page prec.");
+  // Ascenseur à droite quand le texte dépasse l'écran (rangée par rangée : la zone peut
+  // être décalée en mémoire)
+  int16_t trackH = ALERT_ROWS_VISIBLE * ALERT_ROW_H;
+  int16_t thumbH = 0, thumbTop = 0;
+  if (maxScroll > 0) {
+    thumbH = max(6, trackH * ALERT_ROWS_VISIBLE / (int)alertLayout.lineCount());
+    thumbTop = (trackH - thumbH) * alertScroll / maxScroll;
+  }
+  for (int r = 0; r < ALERT_ROWS_VISIBLE; r++) {
+    int16_t y = alertRowY(g, r), top = r * ALERT_ROW_H;
+    g.fillRect(TFT_WIDTH - 4, y, 3, ALERT_ROW_H, 0x0000);
+    int16_t a = max(top, thumbTop), b = min<int16_t>(top + ALERT_ROW_H, thumbTop + thumbH);
+    if (a < b) g.fillRect(TFT_WIDTH - 4, y + a - top, 3, b - a, 0x7BEF);
+  }
+  return drawn;
 }
 
-static void drawPageAlert() {
-  tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+// Page ALERTES : en-tête (titre, niveau) et texte défilant
+static uint32_t drawAlertHeader(Adafruit_GFX &g, const Widget &wg, bool partial) {
+  if (partial) widgetClear(g, wg);
+  WeatherSnapshot w;
+  if (!w->now.hasAlert) return 0;
+  // Titre de l'alerte (accents via le jeu CP437 de la police intégrée)
+  char title[WEATHER_ALERT_TITLE_MAX];
+  utf8ToCp437(w->now.alertTitle, title, sizeof(title));
+  g.setTextColor(0xF800);
+  g.setTextSize(1);
+  g.setCursor(10, 60);
+  g.cp437(true);
+  g.println(title);
+  g.cp437(false);
+
+  // Sévérité
+  g.setTextColor(0xFFE0);
+  g.setCursor(10, 80);
+  g.print("Niveau: ");
+  g.println(w->now.alertSeverity);
+  return 0;
+}
 
-  tft.setTextColor(0x07FF);
-  tft.setTextSize(2);
-  tft.setCursor(10, 30);
-  tft.println("ALERTES METEO");
+// Description complète, coupée aux mots ; BTN maintenu pour défiler. Sur l'écran, seules
+// les rangées dont le texte change sont retracées (pas de retraçage de la page).
+static uint32_t drawAlertText(Adafruit_GFX &g, const Widget &wg, bool partial) {
+  WeatherSnapshot w;
+  alertLayoutUpdate(w);
+  if (!w->now.hasAlert) {
+    if (partial) widgetClear(g, wg);
+    g.setTextColor(0x07E0);
+    g.setTextSize(2);
+    g.setCursor(30, 100);
+    g.println("Pas d'alerte");
+    return 0;
+  }
+  uint8_t rows = drawAlertRows(g, partial && alertRowsOnScreen);
+  if (partial) Serial.printf("[ALERTE] Ligne %d: %u rangees retracees\n", alertScroll, (unsigned)rows);
+  return (uint32_t)rows * ALERT_ROW_H * (TFT_WIDTH - 4) + 3 * ALERT_ROWS_VISIBLE * ALERT_ROW_H;
+}
 
-  if (!gWeather.now.hasAlert) {
-    tft.setTextColor(0x07E0);
-    tft.setTextSize(2);
-    tft.setCursor(30, 100);
-    tft.println("Pas d'alerte");
-  } else {
-    // Titre de l'alerte
-    tft.setTextColor(0xF800);
-    tft.setTextSize(1);
-    tft.setCursor(10, 60);
-    tft.println(gWeather.now.alertTitle);
+static const Widget kAlertWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("ALERTES METEO"),
+  widgetCustom(0, 56, TFT_WIDTH, 34, DATA_MASK(DATA_WEATHER), drawAlertHeader),
+  widgetCustom(0, ALERT_TEXT_Y, TFT_WIDTH, ALERT_ROWS_VISIBLE * ALERT_ROW_H,
+               DATA_MASK(DATA_WEATHER) | DATA_MASK(DATA_UI), drawAlertText),
+  NAV_WIDGET(NAV_PAGES),
+};
 
-    // Sévérité
-    tft.setTextColor(0xFFE0);
-    tft.setCursor(10, 80);
-    tft.print("Niveau: ");
-    tft.println(gWeather.now.alertSeverity);
+// --- [NEW FEATURE] Page SURVEILLANCE : un lieu par rangée (icône, température, détails) ---
+#define WATCH_ROWS_VISIBLE 5
+#define WATCH_ROW_Y(r) (50 + 30 * (r))
+#define WATCH_DEPS (DATA_MASK(DATA_WATCH) | DATA_MASK(DATA_UI))
+int watchScroll = 0; // premier lieu affiché
+
+// Lieu affiché à la rangée r, nullptr si la rangée est vide
+static const WatchEntry *watchRow(uint8_t r, const char **name) {
+  int i = watchScroll + r;
+  if (i >= watchlistCount()) return nullptr;
+  *name = watchlistLocation(i).name;
+  return &watchlistEntry(i);
+}
 
-    // Description (limitée pour tenir sur l'écran)
-    tft.setTextColor(0xFFFF);
-    tft.setCursor(10, 100);
-    String desc = gWeather.now.alertDesc;
-    if (desc.length() > 200) desc = desc.substring(0, 197) + "...";
-    tft.println(desc);
+template <uint8_t R> static void fillWatchIcon(WidgetContent &c) {
+  const char *name;
+  const WatchEntry *e = watchRow(R, &name);
+  if (e && (e->flags & WATCH_VALID)) strlcpy(c.text, weatherCodeToIcon(e->code).c_str(), sizeof(c.text));
+}
+
+template <uint8_t R> static void fillWatchTemp(WidgetContent &c) {
+  const char *name;
+  const WatchEntry *e = watchRow(R, &name);
+  if (!e) return;
+  char t[8];
+  snprintf(c.text, sizeof(c.text), "%-10.10s %sC", name, fmtValue(t, sizeof(t), centiToTemp(e->temp), 1));
+  if (e->flags & WATCH_ALERT) c.color = 0xF800;
+}
+
+template <uint8_t R> static void fillWatchDetails(WidgetContent &c) {
+  const char *name;
+  const WatchEntry *e = watchRow(R, &name);
+  if (!e) return;
+  if (!(e->flags & WATCH_VALID)) {
+    strlcpy(c.text, "En attente de donnees", sizeof(c.text));
+    return;
   }
+  snprintf(c.text, sizeof(c.text), "%u%%  %u.%u m/s  %lu min%s", e->humidity, e->wind / 100, e->wind % 100 / 10,
+           (unsigned long)((millis() - e->fetchedMs) / 60000), (e->flags & WATCH_ALERT) ? "  ALERTE" : "");
+}
 
-  tft.setTextColor(0xC618);
-  tft.setTextSize(1);
-  tft.setCursor(10, TFT_HEIGHT-15);
-  tft.print("BTN1:Page suiv. BTN2:Page prec.");
+// Dernier cycle : nombre de lieux, durée et connexions TLS
+static void fillWatchCycle(WidgetContent &c) {
+  const WatchlistStats &ws = watchlistStats();
+  if (!ws.cycles) {
+    snprintf(c.text, sizeof(c.text), "%u lieux, premier cycle a venir", watchlistCount());
+    return;
+  }
+  // Valeurs bornées : le texte tient toujours dans WIDGET_TEXT_MAX
+  snprintf(c.text, sizeof(c.text), "%u/%u lieux en %u.%u s, %u cnx, il y a %u min",
+           min<unsigned>(ws.lastOk, WATCHLIST_MAX), min<unsigned>(ws.lastCount, WATCHLIST_MAX),
+           min<unsigned>(ws.totalMs / 1000, 999), (unsigned)(ws.totalMs % 1000 / 100), min<unsigned>(ws.connections, 9),
+           min<unsigned>((millis() - ws.lastCycleMs) / 60000, 9999));
+}
+
+#define WATCH_ROW_WIDGETS(r)                                                                            \
+  widgetIcon(4, WATCH_ROW_Y(r), WATCH_DEPS, fillWatchIcon<r>),                                          \
+  widgetValue(34, WATCH_ROW_Y(r), TFT_WIDTH - 34, 16, WFONT_GFX2, 0, 0xFFFF, WATCH_DEPS, fillWatchTemp<r>), \
+  widgetLine(34, WATCH_ROW_Y(r) + 19, 0xC618, WATCH_DEPS | DATA_MASK(DATA_SYSTEM), fillWatchDetails<r>)
+
+static const Widget kWatchWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("SURVEILLANCE"),
+  WATCH_ROW_WIDGETS(0),
+  WATCH_ROW_WIDGETS(1),
+  WATCH_ROW_WIDGETS(2),
+  WATCH_ROW_WIDGETS(3),
+  WATCH_ROW_WIDGETS(4),
+  widgetLine(10, WATCH_ROW_Y(WATCH_ROWS_VISIBLE) + 2, 0x07FF, DATA_MASK(DATA_WATCH) | DATA_MASK(DATA_SYSTEM),
+             fillWatchCycle),
+  NAV_WIDGET("Maintien BTN1/BTN2: defiler"),
+};
+
+// Page CAPTEURS
+// --- [FIX] BME280 au lieu de DHT22 ---
+static void fillSensorTemp(WidgetContent &c) {
+  char v[8];
+  snprintf(c.text, sizeof(c.text), "Temperature: %s C", fmtValue(v, sizeof(v), gTempInt, 1));
 }
 
-static void drawPageSensors() {
-  tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+static void fillSensorHumidity(WidgetContent &c) {
+  char v[8];
+  snprintf(c.text, sizeof(c.text), "Humidite: %s %%", fmtValue(v, sizeof(v), gHumInt, 0));
+}
 
-  tft.setTextColor(0x07FF);
-  tft.setTextSize(2);
-  tft.setCursor(10, 30);
-  tft.println("CAPTEURS LOCAUX");
+static void fillSensorPressure(WidgetContent &c) {
+  if (gBaro.valid) snprintf(c.text, sizeof(c.text), "Pression: %.1f hPa (mer %.1f)", gBaro.stationHpa, gBaro.seaLevelHpa);
+  else strlcpy(c.text, "Pression: --", sizeof(c.text));
+}
 
-  // --- [FIX] BME280 au lieu de DHT22 ---
-  tft.setTextColor(0xFFE0);
-  tft.setTextSize(1);
-  tft.setCursor(10, 60);
-  tft.println("BME280 (Interieur):");
-
-  tft.setTextColor(0xFFFF);
-  tft.setCursor(20, 75);
-  tft.print("Temperature: ");
-  if (!isnan(gTempInt)) tft.print(gTempInt,1);
-  else tft.print("--.-");
-  tft.println(" C");
-
-  tft.setCursor(20, 90);
-  tft.print("Humidite: ");
-  if (!isnan(gHumInt)) tft.print(gHumInt,0);
-  else tft.print("--");
-  tft.println(" %");
-
-  // GPS
-  tft.setTextColor(0xFFE0);
-  tft.setCursor(10, 120);
-  tft.println("GPS:");
-
-  tft.setTextColor(0xFFFF);
-  tft.setCursor(20, 135);
-  tft.print("Lat: ");
-  tft.println(gLat, 5);
-
-  tft.setCursor(20, 150);
-  tft.print("Lon: ");
-  tft.println(gLon, 5);
-
-  tft.setCursor(20, 165);
-  if (gUseDefaultGeo) {
-    tft.setTextColor(0xF800);
-    tft.println("(Position par defaut)");
-  } else {
-    tft.setTextColor(0x07E0);
-    tft.println("(Position GPS)");
-  }
+static void fillSensorLat(WidgetContent &c) {
+  snprintf(c.text, sizeof(c.text), "Lat: %.5f", gLat);
+}
 
-  tft.setTextColor(0xC618);
-  tft.setTextSize(1);
-  tft.setCursor(10, TFT_HEIGHT-15);
-  tft.print("BTN1:Page suiv. BTN2:Page prec.");
+static void fillSensorLon(WidgetContent &c) {
+  snprintf(c.text, sizeof(c.text), "Lon: %.5f", gLon);
 }
 
-static void drawPageSystem() {
-  tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+static void fillSensorGeoSource(WidgetContent &c) {
+  c.color = gUseDefaultGeo ? 0xF800 : 0x07E0;
+  strlcpy(c.text, gUseDefaultGeo ? "(Position par defaut)" : "(Position GPS)", sizeof(c.text));
+}
 
-  tft.setTextColor(0x07FF);
-  tft.setTextSize(2);
-  tft.setCursor(10, 30);
-  tft.println("SYSTEME");
+// Altitude, précision et satellites varient sans déplacement : vérifiés à chaque mesure
+static void fillSensorGps(WidgetContent &c) {
+  if (gUseDefaultGeo) return;
+  snprintf(c.text, sizeof(c.text), "Alt: %ld m  HDOP: %u.%02u  Sat: %u", (long)(gGps.altCm / 100),
+           gGps.hdopX100 / 100, gGps.hdopX100 % 100, gGps.sats);
+}
 
-  // Version
-  tft.setTextColor(0xFFE0);
-  tft.setTextSize(1);
-  tft.setCursor(10, 60);
-  tft.print("Version: ");
-  tft.println(DIAGNOSTIC_VERSION);
+static const Widget kSensorWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("CAPTEURS LOCAUX"),
+  widgetLabel(10, 60, 1, 0xFFE0, "BME280 (Interieur):"),
+  widgetLine(20, 75, 0xFFFF, DATA_MASK(DATA_INTERIOR), fillSensorTemp),
+  widgetLine(20, 90, 0xFFFF, DATA_MASK(DATA_INTERIOR), fillSensorHumidity),
+  widgetLine(20, 105, 0xFFFF, DATA_MASK(DATA_INTERIOR), fillSensorPressure),
+  widgetLabel(10, 120, 1, 0xFFE0, "GPS:"),
+  widgetLine(20, 135, 0xFFFF, DATA_MASK(DATA_GEO), fillSensorLat),
+  widgetLine(20, 150, 0xFFFF, DATA_MASK(DATA_GEO), fillSensorLon),
+  widgetLine(20, 165, 0x07E0, DATA_MASK(DATA_GEO), fillSensorGeoSource),
+  widgetLine(20, 180, 0xFFFF, DATA_MASK(DATA_GEO) | DATA_MASK(DATA_SYSTEM), fillSensorGps),
+  NAV_WIDGET(NAV_PAGES),
+};
+
+// Page SYSTEME
+static void fillSysWifiState(WidgetContent &c) {
+  bool up = (WiFi.status() == WL_CONNECTED);
+  c.color = up ? 0x07E0 : 0xF800;
+  strlcpy(c.text, up ? "Connecte" : "Deconnecte", sizeof(c.text));
+}
 
-  // WiFi
-  tft.setTextColor(0xFFFF);
-  tft.setCursor(10, 80);
-  tft.print("WiFi: ");
+// Connecté : SSID ; coupure en cours : durée et prochain essai
+static void fillSysWifiLine1(WidgetContent &c) {
+  const WifiLinkStats &ws = wifiStats();
   if (WiFi.status() == WL_CONNECTED) {
-    tft.setTextColor(0x07E0);
-    tft.println("Connecte");
-    tft.setTextColor(0xFFFF);
-    tft.setCursor(10, 95);
-    tft.print("SSID: ");
-    tft.println(WiFi.SSID());
-    tft.setCursor(10, 110);
-    tft.print("IP: ");
-    tft.println(WiFi.localIP());
-    tft.setCursor(10, 125);
-    tft.print("RSSI: ");
-    tft.print(WiFi.RSSI());
-    tft.println(" dBm");
-  } else {
-    tft.setTextColor(0xF800);
-    tft.println("Deconnecte");
+    snprintf(c.text, sizeof(c.text), "SSID: %s", WiFi.SSID().c_str());
+  } else if (ws.outageStartMs) {
+    int32_t nextS = ((int32_t)(ws.nextAttemptMs - millis()) + 999) / 1000;
+    snprintf(c.text, sizeof(c.text), "Coupure: %lus  Essai: %lds", (unsigned long)((millis() - ws.outageStartMs) / 1000),
+             (long)max<int32_t>(nextS, 0));
   }
+}
 
-  // Mémoire
-  tft.setTextColor(0xFFFF);
-  tft.setCursor(10, 150);
-  tft.print("RAM libre: ");
-  tft.print(ESP.getFreeHeap() / 1024);
-  tft.println(" KB");
+// --- [NEW FEATURE] Durée de connexion, qualité du lien et dernière coupure ---
+static void fillSysWifiLine2(WidgetContent &c) {
+  if (WiFi.status() != WL_CONNECTED) return;
+  const WifiLinkStats &ws = wifiStats();
+  snprintf(c.text, sizeof(c.text), "IP: %s  Cnx: %lu ms%s", WiFi.localIP().toString().c_str(),
+           (unsigned long)ws.lastConnectMs, ws.fastPath ? "" : "*");
+}
 
-  // Uptime
-  tft.setCursor(10, 165);
-  tft.print("Uptime: ");
+static void fillSysWifiLine3(WidgetContent &c) {
+  if (WiFi.status() != WL_CONNECTED) return;
+  const WifiLinkStats &ws = wifiStats();
+  int n = snprintf(c.text, sizeof(c.text), "RSSI: %d dBm (moy %d)", WiFi.RSSI(), ws.rssiAvg);
+  if (ws.lastOutageMs) snprintf(c.text + n, sizeof(c.text) - n, " Coup.: %lus", (unsigned long)(ws.lastOutageMs / 1000));
+}
+
+// --- [NEW FEATURE] Plus grand bloc libre et minimum historique (fragmentation) ---
+static void fillSysHeap(WidgetContent &c) {
+  const HeapStats &heap = heapMonitorStats();
+  snprintf(c.text, sizeof(c.text), "RAM libre: %u KB  Bloc max: %u KB", (unsigned)(heap.freeHeap / 1024),
+           (unsigned)(heap.largestBlock / 1024));
+}
+
+static void fillSysHeapMin(WidgetContent &c) {
+  const HeapStats &heap = heapMonitorStats();
+  snprintf(c.text, sizeof(c.text), "RAM min: %u KB  Frag: %u %%", (unsigned)(heap.minEverFree / 1024), heap.fragPct);
+}
+
+static void fillSysUptime(WidgetContent &c) {
   unsigned long uptime = millis() / 1000;
-  tft.print(uptime / 3600);
-  tft.print("h ");
-  tft.print((uptime % 3600) / 60);
-  tft.println("m");
+  snprintf(c.text, sizeof(c.text), "Uptime: %luh %lum", uptime / 3600, (uptime % 3600) / 60);
+}
 
-  tft.setTextColor(0xC618);
-  tft.setTextSize(1);
-  tft.setCursor(10, TFT_HEIGHT-15);
-  tft.print("BTN1:Page suiv. BTN2:Page prec.");
+// --- [NEW FEATURE] Temps CPU passé en attente (ordonnanceur) ---
+static void fillSysCpu(WidgetContent &c) {
+  snprintf(c.text, sizeof(c.text), "CPU libre: %u %%", schedulerIdlePct());
+}
+
+static void fillSysCpuBar(WidgetContent &c) {
+  c.level = schedulerIdlePct();
+}
+
+// --- [NEW FEATURE] Rétroéclairage adaptatif et économie estimée ---
+static void fillSysBacklight(WidgetContent &c) {
+  snprintf(c.text, sizeof(c.text), "Ecran: %u%% lum %u%% eco %lu mWh/j", backlightAvgDutyPct(), backlightAmbientPct(),
+           (unsigned long)backlightSavedMwhPerDay());
+}
+
+// --- [NEW FEATURE] Requêtes météo du jour et âge des données ---
+static void fillSysWeather(WidgetContent &c) {
+  const WeatherPolicyStats &wp = weatherPolicyStats();
+  uint32_t ageMs = weatherPolicyAgeMs();
+  char age[16];
+  if (ageMs == UINT32_MAX) strcpy(age, "--");
+  else snprintf(age, sizeof(age), "%lu min", (unsigned long)(ageMs / 60000));
+  snprintf(c.text, sizeof(c.text), "Meteo: %u/%u req.  age %s", wp.callsToday, (unsigned)WEATHER_DAILY_BUDGET, age);
 }
 
+#define SYS_DEPS (DATA_MASK(DATA_WIFI) | DATA_MASK(DATA_SYSTEM))
+
+static const Widget kSystemWidgets[] = {
+  STATUS_BAR_WIDGETS,
+  widgetTitle("SYSTEME"),
+  widgetLabel(10, 60, 1, 0xFFE0, "Version: " DIAGNOSTIC_VERSION),
+  widgetLabel(10, 80, 1, 0xFFFF, "WiFi: "),
+  widgetLine(46, 80, 0x07E0, SYS_DEPS, fillSysWifiState),
+  widgetLine(10, 95, 0xFFFF, SYS_DEPS, fillSysWifiLine1),
+  widgetLine(10, 110, 0xFFFF, SYS_DEPS, fillSysWifiLine2),
+  widgetLine(10, 125, 0xFFFF, SYS_DEPS, fillSysWifiLine3, 2),
+  widgetLine(10, 140, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysHeap),
+  widgetLine(10, 152, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysHeapMin),
+  widgetLine(10, 165, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysUptime),
+  widgetValue(10, 180, 96, 8, WFONT_GFX1, 0, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysCpu),
+  widgetBar(110, 180, 120, 7, 0x07E0, DATA_MASK(DATA_SYSTEM), fillSysCpuBar),
+  widgetLine(10, 195, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysBacklight),
+  widgetLine(10, 210, 0xFFFF, DATA_MASK(DATA_SYSTEM), fillSysWeather),
+  NAV_WIDGET(NAV_PAGES),
+};
+
+static const WidgetPage kPages[NUM_PAGES] = {
+  widgetPage(kHomeWidgets), widgetPage(kForecastWidgets), widgetPage(kAlertWidgets),
+  widgetPage(kWatchWidgets), widgetPage(kSensorWidgets), widgetPage(kSystemWidgets),
+};
+
+// --- [NEW FEATURE] Rétroéclairage piloté par le capteur de luminosité (tâche périodique) ---
 static void updateBacklightAndRgbByLuminosity() {
-  bool lowLum = false; // TODO: remplacer par BH1750/LDR
-  ledcWrite(LEDC_BL_CH, lowLum ? 30 : 200);
+  WeatherSnapshot w;
+  backlightLoop();
+  bool lowLum = backlightIsLowLight() || backlightIsAsleep();
 
   if (lowLum) { setRgb(0,0,0); return; }
-  if (!gWeather.now.hasAlert) { setRgb(0,255,0); return; }
-  if (gWeather.now.alertSeverity=="yellow") setRgb(255,255,0);
-  else if (gWeather.now.alertSeverity=="orange") setRgb(255,140,0);
-  else if (gWeather.now.alertSeverity=="red") setRgb(255,0,0);
+  if (!w->now.hasAlert) { setRgb(0,255,0); return; }
+  if (!strcmp(w->now.alertSeverity, "yellow")) setRgb(255,255,0);
+  else if (!strcmp(w->now.alertSeverity, "orange")) setRgb(255,140,0);
+  else if (!strcmp(w->now.alertSeverity, "red")) setRgb(255,0,0);
   else setRgb(0,255,0);
 }
 
+// --- [DEBUG] Log des données météo affichées (rendu direct de la page HOME uniquement) ---
+static void logHomeData() {
+  WeatherSnapshot w;
+  Serial.println("\n[AFFICHAGE] Page HOME - Donnees meteo:");
+  Serial.print("[AFFICHAGE] Temp actuelle: ");
+  Serial.print(isnan(w->now.tempNow) ? "NAN" : String(w->now.tempNow, 1));
+  Serial.println(" C");
+  Serial.print("[AFFICHAGE] Code condition: ");
+  Serial.println(w->now.conditionCode);
+  Serial.print("[AFFICHAGE] Humidite: ");
+  Serial.print(isnan(w->now.humidity) ? "NAN" : String(w->now.humidity, 0));
+  Serial.println(" %");
+  Serial.print("[AFFICHAGE] Vent: ");
+  Serial.print(isnan(w->now.wind) ? "NAN" : String(w->now.wind, 1));
+  Serial.println(" m/s");
+  if (isnan(w->now.tempNow)) Serial.println("[AFFICHAGE] ATTENTION: Temperature NAN affichee");
+}
+
+// Dessin complet d'une page (barre d'état comprise) sur l'écran ou un canevas hors écran
+static void drawPage(Adafruit_GFX &g, int page) {
+  widgetsDraw(g, kPages[page]);
+}
+
+// Données dont dépend chaque page : union des dépendances de ses widgets
+static uint32_t pageDeps(int page) {
+  return widgetsDeps(kPages[page]);
+}
+
+// Page changée : tracé complet ; sinon seuls les widgets dont les données ont changé
 void renderPage() {
-  drawStatusBar();
-  switch (currentPage) {
-    case PAGE_HOME: drawPageHome(); break;
-    case PAGE_FORECAST: drawPageForecast(); break;
-    case PAGE_ALERT: drawPageAlert(); break;
-    case PAGE_SENSORS: drawPageSensors(); break;
-    case PAGE_SYSTEM: drawPageSystem(); break;
+  HeapProbe probe(HEAP_SITE_RENDER);
+  if (currentPage == PAGE_HOME) logHomeData();
+  widgetsUpdate(tft, kPages[currentPage]);
+}
+
+// --- [FIX] Capteurs intérieurs (BME280) ---
+static void jobSensors() {
+  HeapProbe probe(HEAP_SITE_SENSOR);
+  heapMonitorSample();
+  Serial.println("\n[CAPTEUR] Lecture BME280...");
+  gTempInt = bme.readTemperature();
+  gHumInt = bme.readHumidity();
+  // Pression station -> historique 3 h et prévision locale (altitude GPS si une position a été reçue)
+  baroAddSample(bme.readPressure() / 100.0f, gUseDefaultGeo ? NAN : gGps.altCm / 100.0f, gLat, gBaro);
+
+  Serial.print("[CAPTEUR] Temperature: ");
+  Serial.print(gTempInt);
+  Serial.println(" C");
+  Serial.print("[CAPTEUR] Humidite: ");
+  Serial.print(gHumInt);
+  Serial.println(" %");
+
+  if (isnan(gTempInt) || isnan(gHumInt)) {
+    Serial.println("[CAPTEUR] ATTENTION: Valeurs NaN - capteur non detecte ou erreur");
+  }
+
+  // --- [NEW FEATURE] Invalidation des caches d'affichage seulement si la valeur affichée change ---
+  static int32_t lastShownT = INT32_MIN, lastShownH = INT32_MIN;
+  int32_t shownT = isnan(gTempInt) ? INT32_MIN + 1 : lroundf(gTempInt * 10);
+  int32_t shownH = isnan(gHumInt) ? INT32_MIN + 1 : lroundf(gHumInt);
+  static int32_t lastShownP = INT32_MIN, lastShownTrend = INT32_MIN;
+  static char lastLetter = 0;
+  int32_t shownP = gBaro.valid ? lroundf(gBaro.seaLevelHpa * 10) : INT32_MIN + 1;
+  int32_t shownTrend = gBaro.trendValid ? lroundf(gBaro.trendHpa3h * 10) : INT32_MIN + 1;
+  if (shownT != lastShownT || shownH != lastShownH || shownP != lastShownP || shownTrend != lastShownTrend ||
+      gBaro.letter != lastLetter) {
+    lastShownT = shownT;
+    lastShownH = shownH;
+    lastShownP = shownP;
+    lastShownTrend = shownTrend;
+    lastLetter = gBaro.letter;
+    dataChanged(DATA_INTERIOR);
+  }
+  // Passage en ligne / hors ligne : l'accueil change d'icône et de libellé
+  static bool lastFresh = false;
+  if (weatherFresh() != lastFresh) {
+    lastFresh = !lastFresh;
+    dataChanged(DATA_WEATHER);
+  }
+  static uint8_t lastBars = 0xFF;
+  uint8_t bars = (WiFi.status() == WL_CONNECTED) ? wifiBars() + 1 : 0;
+  if (bars != lastBars) {
+    lastBars = bars;
+    dataChanged(DATA_WIFI);
+  }
+  dataChanged(DATA_SYSTEM);
+
+  if (WiFi.status()==WL_CONNECTED) {
+    if (!isnan(gTempInt) && gTempInt >= TEMP_HIGH_ALERT)
+      telegramSend("Alerte: Temperature interieure elevee (" + String(gTempInt,1) + " C)");
+    if (!isnan(gTempInt) && gTempInt <= TEMP_LOW_ALERT)
+      telegramSend("Alerte: Temperature interieure basse (" + String(gTempInt,1) + " C)");
+  }
+  needsRender = true;
+}
+
+// --- [NEW FEATURE] Récupération dans un tampon privé, publiée seulement si complète ---
+// (chaque requête est comptée dans le budget journalier)
+// Position ramenée au centre de sa maille ; en changeant de maille, les données encore
+// récentes du cache sont publiées sans requête.
+static WeatherCell shownCell;
+static bool shownCellValid = false;
+
+static bool refreshWeather() {
+  WeatherCell cell = weatherCellOf(gLat, gLon);
+  float lat, lon;
+  weatherCellCenter(cell, lat, lon);
+  bool cellChanged = !shownCellValid || cell != shownCell;
+  if (!cellChanged && !weatherPolicyAllow()) {
+    Serial.println("[METEO] Budget journalier atteint : recuperation reportee");
+    return false;
+  }
+  WeatherData *next = weatherBeginUpdate();
+  if (!next) return false;
+
+  uint32_t ageMs;
+  if (cellChanged && weatherCacheLookup(cell, *next, ageMs)) {
+    weatherPublish();
+    shownCell = cell;
+    shownCellValid = true;
+    WeatherSnapshot w;
+    weatherPolicyServed(lat, lon, ageMs, w->now.tempNow, w->now.hasAlert);
+    return true;
+  }
+  if (!weatherPolicyAllow()) {
+    weatherAbortUpdate();
+    Serial.println("[METEO] Budget journalier atteint : recuperation reportee");
+    return false;
+  }
+  bool ok = fetchWeatherOpenWeather(lat, lon, *next);
+  if (ok) {
+    weatherCacheStore(cell, *next);
+    weatherPublish();
+    shownCell = cell;
+    shownCellValid = true;
+  } else {
+    weatherAbortUpdate();
   }
+  WeatherSnapshot w;
+  weatherPolicyRecord(ok, weatherLastHttpStatus(), lat, lon, w->now.tempNow, w->now.hasAlert);
+  return ok;
+}
+
+// Retour dans une maille dont le cache a des données récentes : publication immédiate
+static bool weatherCellCached() {
+  if (!shownCellValid) return false;
+  WeatherCell cell = weatherCellOf(gLat, gLon);
+  return cell != shownCell && weatherCacheHas(cell);
 }
 
+// --- [NEW FEATURE] Prochaine récupération selon l'évolution du temps, les échecs et le budget ---
+static uint32_t weatherNextDelayMs() {
+  return weatherPolicyNextDelayMs(gBaro.trendValid ? gBaro.trendHpa3h : NAN);
+}
+
+// Météo
+static void jobWeather() {
+  HeapProbe probe(HEAP_SITE_WEATHER);
+  Serial.print("\n[LOOP] Appel fetchWeatherOpenWeather (lat=");
+  Serial.print(gLat, 5);
+  Serial.print(", lon=");
+  Serial.print(gLon, 5);
+  Serial.println(")");
+
+  // (l'invalidation des pages suit weatherGeneration() dans loop())
+  if (refreshWeather()) {
+    Serial.println("[LOOP] Meteo recuperee avec succes");
+    WeatherSnapshot w;
+    if (w->now.hasAlert) {
+      telegramSend("Alerte meteo: " + String(w->now.alertTitle) + "\n" + String(w->now.alertDesc));
+    }
+  } else {
+    Serial.println("[LOOP] ECHEC de la recuperation meteo");
+  }
+  schedulerSetNext(jobWeatherId, weatherNextDelayMs());
+}
+
+// Requêtes du jour, efficacité du cache par maille et dernier cycle des lieux surveillés
+static void jobWeatherStats() {
+  weatherPolicyReport();
+  weatherCacheReport();
+  watchlistReport();
+}
+
+// Rapport périodique : temps CPU par tâche, coût des mises à jour de l'écran et pré-rendu
+static void jobReport() {
+  schedulerReport();
+  widgetsReport();
+  pageCacheReport();
+}
+
+// NTP resync
+static void jobNtp() {
+  configTzTime(TZ_STRING, NTP_SERVER);
+}
+
+#if RENDER_BENCH_AT_BOOT
+// --- [NEW FEATURE] Comparaison du coût d'affichage de la grande température ---
+// Police GFX 5x7 agrandie x4 (un fillRect par pixel) vs police U8g2 en cache (cache froid puis chaud)
+static void benchmarkTempRendering() {
+  const char *sample = "23.4 C";
+  uint32_t t0 = micros();
+  tft.setTextColor(0xFFE0);
+  tft.setTextSize(4);
+  tft.setCursor(30, 60);
+  tft.print(sample);
+  uint32_t gfxUs = micros() - t0;
+  tft.fillRect(0, 55, TFT_WIDTH, 45, 0x0000);
+
+  t0 = micros();
+  fontDrawText(tft, 30, 94, sample, FONT_TEMP_BIG, 0xFFE0, 0x0000);
+  uint32_t coldUs = micros() - t0;
+  t0 = micros();
+  fontDrawText(tft, 30, 94, sample, FONT_TEMP_BIG, 0xFFE0, 0x0000);
+  uint32_t warmUs = micros() - t0;
+  tft.fillRect(0, 55, TFT_WIDTH, 45, 0x0000);
+
+  Serial.printf("[FONT] Temperature x4: GFX %u us | U8g2 cache froid %u us | cache chaud %u us\n",
+                (unsigned)gfxUs, (unsigned)coldUs, (unsigned)warmUs);
+}
+#endif
+
+// --- [NEW FEATURE] Écran de progression de la mise à jour OTA ---
+// Appelé par otaRun à chaque bloc écrit ; ne retrace la barre qu'au changement de pourcentage
+static void drawOtaProgress(uint32_t received, int32_t total) {
+  static int lastPct = -1;
+  static uint32_t lastKb = 0;
+  if (received == 0) {
+    backlightNotifyActivity();
+    alertScrollReset();
+    tft.fillRect(0, 20, TFT_WIDTH, TFT_HEIGHT-20, 0x0000);
+    drawPageTitle(tft, "MISE A JOUR");
+    tft.drawRect(10, 110, TFT_WIDTH-20, 16, 0xFFFF);
+    lastPct = -1;
+    lastKb = 0;
+    widgetsScreenInvalidate();
+    needsRender = true; // page normale retracée si la mise à jour échoue
+  }
+  int pct = (total > 0) ? (int)((uint64_t)received * 100 / total) : -1;
+  uint32_t kb = received / 1024;
+  if (pct != lastPct || (pct < 0 && kb >= lastKb + 16)) {
+    lastPct = pct;
+    lastKb = kb;
+    if (pct >= 0) tft.fillRect(12, 112, (TFT_WIDTH-24) * pct / 100, 12, 0x07E0);
+    tft.fillRect(10, 135, TFT_WIDTH-20, 10, 0x0000);
+    tft.setTextSize(1);
+    tft.setTextColor(0xFFFF);
+    tft.setCursor(10, 136);
+    if (pct >= 0) tft.printf("%u / %d Ko  (%d%%)", (unsigned)kb, (int)(total / 1024), pct);
+    else tft.printf("%u Ko recus", (unsigned)kb);
+  }
+  // Un appui réveille l'écran sans changer de page pendant la mise à jour
+  ButtonEvent event;
+  while (buttonsPoll(event)) backlightNotifyActivity();
+}
+
+#if RENDER_BENCH_AT_BOOT
+// --- [NEW FEATURE] Mise en page d'une longue vigilance et coût d'un pas de défilement ---
+// Texte type Météo-France (accents, apostrophes typographiques) : ~1 Ko comme une vraie alerte
+static const char ALERT_SAMPLE[] =
+  "Vigilance orange orages. D\u00e9but d\u2019\u00e9v\u00e9nement : mardi 14 ao\u00fbt \u00e0 16h00. "
+  "Fin d\u2019\u00e9v\u00e9nement pr\u00e9vue : mercredi 15 ao\u00fbt \u00e0 04h00. Situation actuelle : "
+  "une d\u00e9gradation orageuse se d\u00e9veloppe sur le Pays basque et les Landes en d\u00e9but "
+  "d\u2019apr\u00e8s-midi ; elle remonte rapidement vers la Gironde et la Dordogne en soir\u00e9e. "
+  "\u00c9volution pr\u00e9vue : les orages seront localement forts, accompagn\u00e9s de fortes pluies "
+  "(30 \u00e0 50 mm en peu de temps, localement 70 mm), de gr\u00eale de taille centim\u00e9trique et "
+  "de rafales de vent pouvant atteindre 90 \u00e0 100 km/h. L\u2019activit\u00e9 \u00e9lectrique sera "
+  "importante. Cons\u00e9quences possibles : des d\u00e9g\u00e2ts importants sont localement \u00e0 "
+  "craindre sur l\u2019habitat l\u00e9ger et les installations provisoires ; des coupures "
+  "d\u2019\u00e9lectricit\u00e9 et de t\u00e9l\u00e9phone peuvent se produire. Conseils de "
+  "comportement : \u00e0 l\u2019approche d\u2019un orage, mettez en s\u00e9curit\u00e9 vos biens, "
+  "abritez-vous hors des zones bois\u00e9es et \u00e9vitez les d\u00e9placements.";
+
+static void benchmarkAlertLayout() {
+  alertLayout.layout(ALERT_SAMPLE, ALERT_COLS);
+  uint32_t layoutUs = alertLayout.layoutUs();
+  uint16_t lines = alertLayout.lineCount();
+
+  // Page pleine puis un pas de défilement (rangées modifiées seulement)
+  alertScroll = 0;
+  uint32_t t0 = micros();
+  uint8_t fullRows = drawAlertRows(tft, false);
+  uint32_t fullUs = micros() - t0;
+  alertScroll = 1;
+  t0 = micros();
+  uint8_t stepRows = drawAlertRows(tft, true);
+  uint32_t stepUs = micros() - t0;
+  alertScrollReset();
+  tft.fillRect(0, ALERT_TEXT_Y, TFT_WIDTH, ALERT_ROWS_VISIBLE * ALERT_ROW_H, 0x0000);
+
+  Serial.printf("[ALERTE] Texte %u octets: %u lignes en %u us | %u rangees %u us | pas %u rangees %u us\n",
+                (unsigned)strlen(ALERT_SAMPLE), (unsigned)lines, (unsigned)layoutUs,
+                (unsigned)fullRows, (unsigned)fullUs, (unsigned)stepRows, (unsigned)stepUs);
+
+  // La vraie alerte sera remise en page au prochain rendu
+  alertLayoutGen = UINT32_MAX;
+  alertScroll = 0;
+  alertRowsOnScreen = false;
+}
+#endif
+
+#if METEO_BENCH
+// --- [NEW FEATURE] Micro-bancs d'essai (firmware Meteo_Station_bench, résultats "BENCH {...}") ---
+static uint8_t benchCodeIdx = 0;
+static void benchWeatherCodeToIcon() {
+  static const int codes[] = {800, 802, 211, 311, 501, 601, 741, 999}; // une branche par appel
+  volatile size_t len = weatherCodeToIcon(codes[benchCodeIdx++ & 7]).length();
+  (void)len;
+}
+
+static void benchDrawWeatherIcon() {
+  static const String icon("rain");
+  drawWeatherIcon(tft, TFT_WIDTH - 26, 0, icon);
+}
+
+static int benchPage = 0;
+static void benchDrawPage() {
+  drawPage(tft, benchPage);
+}
+
+static void benchFormatWeatherBrief() {
+  WeatherSnapshot w;
+  volatile size_t len = formatWeatherBrief(*w).length();
+  (void)len;
+}
+
+// Analyse complète (document non filtré) de la réponse type : 18 Ko, 48 h, 8 jours
+static void benchJsonParse() {
+  JsonDocument doc;
+  deserializeJson(doc, BENCH_ONECALL_JSON);
+}
+
+static void benchBme280() {
+  volatile float t = bme.readTemperature();
+  volatile float h = bme.readHumidity();
+  volatile float p = bme.readPressure();
+  (void)t;
+  (void)h;
+  (void)p;
+}
+
+// Une seconde utile d'un récepteur u-blox : RMC + GGA
+static const char BENCH_NMEA[] =
+  "$GPRMC,143512.00,A,4450.77412,N,00034.66120,W,0.412,,191026,,,A*6E\r\n"
+  "$GPGGA,143512.00,4450.77412,N,00034.66120,W,1,08,1.02,27.4,M,49.5,M,,*7A\r\n";
+static NmeaParser benchNmea;
+static void benchNmeaDecode() {
+  for (const char *c = BENCH_NMEA; *c; c++) benchNmea.encode(*c);
+}
+
+static const char *const kBenchPageNames[] = {"drawPage:home",  "drawPage:forecast", "drawPage:alert",
+                                              "drawPage:watch", "drawPage:sensors",  "drawPage:system"};
+static_assert(sizeof(kBenchPageNames) / sizeof(kBenchPageNames[0]) == NUM_PAGES, "un nom par page");
+
+static void runMicroBenchmarks() {
+  // Réponse type publiée : les pages sont tracées avec un contenu réaliste (prévisions, alerte)
+  WeatherData *data = weatherBeginUpdate();
+  if (data) {
+    JsonDocument doc;
+    if (!deserializeJson(doc, BENCH_ONECALL_JSON) && weatherFromJson(doc, *data)) weatherPublish();
+    else weatherAbortUpdate();
+  }
+  dataChanged(DATA_WEATHER);
+
+  benchBegin();
+  benchRun("weatherCodeToIcon", benchWeatherCodeToIcon, BENCH_MAX_ITERATIONS);
+  benchRun("drawWeatherIcon", benchDrawWeatherIcon);
+  // Pages complètes sur l'écran (SPI compris) : peu d'itérations
+  for (benchPage = 0; benchPage < NUM_PAGES; benchPage++) benchRun(kBenchPageNames[benchPage], benchDrawPage, 10);
+  benchRun("formatWeatherBrief", benchFormatWeatherBrief);
+  benchRun("json_parse_onecall", benchJsonParse, 20);
+  benchRun("bme280_read", benchBme280, 20);
+  benchRun("nmea_decode_rmc_gga", benchNmeaDecode);
+  benchEnd();
+
+  widgetsScreenInvalidate();
+  needsRender = true;
+}
+#endif
+
 unsigned long bootPauseUntil = 0;
 
 void setup() {
   Serial.begin(115200);
+  weatherStoreBegin();
 
   // --- [NEW FEATURE] Configuration des pins et périphériques ---
   pinMode(PIN_LED_R, OUTPUT);
@@ -639,11 +1278,9 @@ void setup() {
   ledcSetup(LEDC_BUZ_CH, LEDC_BUZ_FREQ, LEDC_BUZ_RES);
   ledcAttachPin(PIN_BUZZER, LEDC_BUZ_CH);
 
-  // --- [FIX] Configuration des pins des boutons ---
-  // GPIO 34 (BTN1) : INPUT-ONLY sans pull-up interne, pull-up externe requise
-  // GPIO 27 (BTN2) : GPIO normal, peut utiliser pull-up interne
-  pinMode(PIN_BTN1, INPUT);          // Pull-up externe sur le hardware
-  pinMode(PIN_BTN2, INPUT_PULLUP);   // Pull-up interne activée
+  // --- [REWRITE] Boutons sur interruptions (configuration des pins dans buttonsBegin) ---
+  schedulerBegin(); // les ISR (boutons, PPS) réveillent la tâche de loop()
+  buttonsBegin();
 
   // Test diagnostic des boutons au démarrage
   delay(100); // Laisser les pins se stabiliser
@@ -663,12 +1300,22 @@ void setup() {
 
   tft.init(TFT_WIDTH, TFT_HEIGHT);
   tft.setRotation(TFT_ROTATION); // --- [FIX] Rotation 90° (pins en haut)
+  alertScrollBegin();
+  fontBegin(tft);
 
   // Afficher l'écran d'accueil
   showBootScreen();
   bootPauseUntil = millis() + 1000; // Pause non-bloquante
   while (millis() < bootPauseUntil) { /* attendre */ }
 
+  // --- [NEW FEATURE] Moniteur du tas : référence et premier point de tendance avant les réservations ---
+  heapMonitorBegin();
+  weatherLogFootprint();
+#if WEATHER_ARENA
+  // --- [NEW FEATURE] Arène des récupérations réservée avant le WiFi et TLS (tas encore d'un seul tenant) ---
+  fetchArena.begin(ARENA_PSRAM_BYTES, ARENA_INTERNAL_BYTES);
+#endif
+
   // --- [FIX] Initialisation BME280 au lieu de DHT ---
   updateBootProgress("Init I2C/BME280...");
   Wire.begin(I2C_SDA, I2C_SCL);
@@ -681,17 +1328,16 @@ void setup() {
     updateBootProgress("Init BME280", true);
   }
 
-  updateBootProgress("Connexion WiFi...");
-  wifiMulti.addAP(WIFI_SSID1, WIFI_PASS1);
-  wifiMulti.addAP(WIFI_SSID2, WIFI_PASS2);
+#if METEO_BENCH
+  // Firmware de mesure : ni réseau ni tâches périodiques, seulement les micro-bancs d'essai
+  updateBootProgress("Micro-bancs d'essai...");
+  runMicroBenchmarks();
+  return;
+#endif
 
-  for (int i=0;i<15;i++) {
-    wifiMulti.run();
-    if (WiFi.status()==WL_CONNECTED) break;
-    delay(400);
-  }
-
-  if (WiFi.status()==WL_CONNECTED) {
+  updateBootProgress("Connexion WiFi...");
+  // --- [NEW FEATURE] AP en cache (BSSID/canal/bail), balayage seulement en secours ---
+  if (wifiBegin()) {
     updateBootProgress("WiFi connecte", true);
     beepConnected();
   } else {
@@ -703,14 +1349,15 @@ void setup() {
   updateBootProgress("Config NTP", true);
 
   updateBootProgress("Init GPS...");
-  gpsBegin();
+  gpsBegin(gLat, gLon);
   updateBootProgress("Init GPS", true);
 
   // --- [FIX] Récupération météo initiale au démarrage ---
+  weatherPolicyBegin();
   if (WiFi.status()==WL_CONNECTED) {
     updateBootProgress("Recuperation meteo...");
     Serial.println("\n[SETUP] Premiere recuperation meteo...");
-    if (fetchWeatherOpenWeather(gLat, gLon, gWeather)) {
+    if (refreshWeather()) {
       updateBootProgress("Meteo OK", true);
       Serial.println("[SETUP] Meteo initiale recuperee");
     } else {
@@ -726,108 +1373,164 @@ void setup() {
   bootPauseUntil = millis() + 1500; // Pause non-bloquante pour lire l'écran
   while (millis() < bootPauseUntil) { /* attendre */ }
 
+#if RENDER_BENCH_AT_BOOT
+  benchmarkTempRendering();
+  benchmarkAlertLayout();
+#endif
+#if TELEMETRY_BENCH_AT_BOOT
+  telemetryBenchmark();
+#endif
   renderPage();
+  backlightBegin(tft);
+  otaBegin(drawOtaProgress);
+  pageCacheBegin(drawPage, pageDeps);
+#if RENDER_STATS_AT_BOOT
+  renderStatsReportAll(drawPage, NUM_PAGES, RENDER_FRAME_DUMP);
+#endif
   updateBacklightAndRgbByLuminosity(); // Allumer l'écran et la LED immédiatement
 
+  // --- [NEW FEATURE] Enregistrement des tâches périodiques ---
+  jobSensorsId = schedulerAdd("capteurs", jobSensors, REFRESH_SENSOR_MS);
+  jobWeatherId = schedulerAdd("meteo", jobWeather, WEATHER_INTERVAL_MAX_MS, weatherNextDelayMs());
+  schedulerAdd("ntp", jobNtp, NTP_RESYNC_MS, NTP_RESYNC_MS);
+  schedulerAdd("telegram", telegramLoop, TELEGRAM_POLL_MS);
+  schedulerAdd("wifi", wifiJob, WIFI_CHECK_MS, WIFI_CHECK_MS);
+  schedulerAdd("eclairage", updateBacklightAndRgbByLuminosity, BACKLIGHT_SAMPLE_MS);
+  schedulerAdd("rapport", jobReport, SCHED_REPORT_MS, SCHED_REPORT_MS);
+  schedulerAdd("gps_stats", gpsLogStats, SCHED_REPORT_MS, SCHED_REPORT_MS);
+  schedulerAdd("meteo_stats", jobWeatherStats, SCHED_REPORT_MS, SCHED_REPORT_MS);
+  schedulerAdd("api_local", localApiJob, LOCAL_API_POLL_MS);
+  schedulerAdd("ota_valid", otaValidateJob, OTA_VALIDATE_POLL_MS);
+  schedulerAdd("telemetrie", telemetryLogJob, TELEMETRY_LOG_MS, TELEMETRY_LOG_MS);
+  schedulerAdd("surveillance", watchlistJob, WATCHLIST_REFRESH_MS, WATCHLIST_FIRST_DELAY_MS);
+
   Serial.println("\n[SETUP] === Initialisation terminee ===");
   Serial.println("[SETUP] Station meteo prete\n");
 }
 
 void loop() {
+#if METEO_BENCH
+  // Un appui sur un bouton relance la série ; sinon la tâche reste bloquée
+  ButtonEvent benchEvent;
+  bool rerun = false;
+  while (buttonsPoll(benchEvent)) rerun = true;
+  if (rerun) runMicroBenchmarks();
+  if (needsRender) {
+    needsRender = false;
+    renderPage();
+  }
+  schedulerWait();
+  return;
+#endif
   // --- Gestion des événements ---
-  bool needsRender = false;
-
-  // 1. Gérer les pressions de boutons
-  ButtonEvent event = getButtonEvent();
-  if (event != BTN_EVT_NONE) {
-    if (event == BTN_EVT_1_SHORT) {
-      int oldPage = (int)currentPage;
-      currentPage = (Page)(((int)currentPage + 1) % NUM_PAGES);
-      Serial.print("[BTN] Changement page ");
-      Serial.print(oldPage);
-      Serial.print(" -> ");
-      Serial.println((int)currentPage);
-    } else if (event == BTN_EVT_2_SHORT) {
-      int oldPage = (int)currentPage;
-      currentPage = (Page)(((int)currentPage - 1 + NUM_PAGES) % NUM_PAGES);
-      Serial.print("[BTN] Changement page ");
-      Serial.print(oldPage);
-      Serial.print(" -> ");
-      Serial.println((int)currentPage);
+  // 1. Gérer les gestes des boutons (fronts capturés en interruption)
+  ButtonEvent event;
+  while (buttonsPoll(event)) {
+    // Un appui pendant la veille ne fait que réveiller l'écran
+    if (backlightNotifyActivity()) {
+      needsRender = true;
+      continue;
+    }
+    int oldPage = (int)currentPage;
+    bool held = (event.gesture == BTN_GESTURE_LONG || event.gesture == BTN_GESTURE_REPEAT);
+    if (held && currentPage == PAGE_FORECAST) {
+      // Maintien sur la page prévisions : défilement des jours
+      forecastScroll += (event.button == 0) ? 1 : -1;
+      dataChanged(DATA_UI);
+      needsRender = true;
+      continue;
     }
+    if (held && currentPage == PAGE_ALERT) {
+      // Maintien sur la page alertes : défilement d'une ligne ; le widget de texte ne
+      // retrace que les rangées dont le texte change (pas de rendu complet de la page)
+      WeatherSnapshot w;
+      if (!w->now.hasAlert) continue;
+      alertScroll += (event.button == 0) ? 1 : -1;
+      dataChanged(DATA_UI);
+      needsRender = true;
+      continue;
+    }
+    if (held && currentPage == PAGE_WATCH) {
+      // Maintien sur la page surveillance : défilement des lieux
+      int maxScroll = max(0, (int)watchlistCount() - WATCH_ROWS_VISIBLE);
+      watchScroll = constrain(watchScroll + ((event.button == 0) ? 1 : -1), 0, maxScroll);
+      dataChanged(DATA_UI);
+      needsRender = true;
+      continue;
+    }
+    if (event.gesture == BTN_GESTURE_CHORD) {
+      currentPage = PAGE_HOME; // BTN1 + BTN2 ensemble : retour à l'accueil
+    } else if (event.gesture == BTN_GESTURE_LONG && event.button == 1) {
+      Serial.println("[BTN] Rafraichissement meteo force");
+      schedulerTrigger(jobWeatherId);
+      continue;
+    } else if (event.gesture == BTN_GESTURE_SHORT || event.gesture == BTN_GESTURE_REPEAT) {
+      int step = (event.button == 0) ? 1 : NUM_PAGES - 1;
+      currentPage = (Page)(((int)currentPage + step) % NUM_PAGES);
+    } else {
+      continue;
+    }
+    Serial.print("[BTN] Changement page ");
+    Serial.print(oldPage);
+    Serial.print(" -> ");
+    Serial.println((int)currentPage);
     needsRender = true;
+    alertRowsOnScreen = false; // la page affichée peut venir du cache
+    if (!pageSwitchPending) {
+      pageSwitchPending = true;
+      pageSwitchPressMs = event.timeMs;
+    }
   }
-  
-  // 2. Gérer le GPS
-  static GpsFix fix{false, DEFAULT_LAT, DEFAULT_LON, 0, false};
-  gpsLoop(fix);
-  if (fix.hasFix) {
+
+  // 2. Gérer le GPS (réveil sur réception UART et PPS)
+  gpsLoop(gGps);
+  if (gGps.hasFix) {
     // Note: On ne redessine pas l'écran à chaque fix GPS pour éviter le clignotement
-    gLat = fix.lat;
-    gLon = fix.lon;
+    // (la page CAPTEURS affiche 5 décimales : invalider son cache seulement au-delà)
+    double lat = gGps.latE7 * 1e-7;
+    double lon = gGps.lonE7 * 1e-7;
+    if (gUseDefaultGeo || fabs(lat - gLat) >= 1e-5 || fabs(lon - gLon) >= 1e-5) dataChanged(DATA_GEO);
+    gLat = lat;
+    gLon = lon;
     gUseDefaultGeo = false;
+    if (weatherPolicyMoved(gLat, gLon) || weatherCellCached()) schedulerTrigger(jobWeatherId);
   }
 
-  // --- [FIX] Capteurs intérieurs (BME280) ---
-  if (millis() - lastSensorMs > REFRESH_SENSOR_MS) {
-    lastSensorMs = millis();
-    Serial.println("\n[CAPTEUR] Lecture BME280...");
-    gTempInt = bme.readTemperature();
-    gHumInt = bme.readHumidity();
-
-    Serial.print("[CAPTEUR] Temperature: ");
-    Serial.print(gTempInt);
-    Serial.println(" C");
-    Serial.print("[CAPTEUR] Humidite: ");
-    Serial.print(gHumInt);
-    Serial.println(" %");
-
-    if (isnan(gTempInt) || isnan(gHumInt)) {
-      Serial.println("[CAPTEUR] ATTENTION: Valeurs NaN - capteur non detecte ou erreur");
-    }
+  // 3. Tâches périodiques arrivées à échéance (capteurs, météo, NTP, Telegram)
+  schedulerRunDue();
 
-    if (WiFi.status()==WL_CONNECTED) {
-      if (!isnan(gTempInt) && gTempInt >= TEMP_HIGH_ALERT)
-        telegramSend("Alerte: Temperature interieure elevee (" + String(gTempInt,1) + " C)");
-      if (!isnan(gTempInt) && gTempInt <= TEMP_LOW_ALERT)
-        telegramSend("Alerte: Temperature interieure basse (" + String(gTempInt,1) + " C)");
-    }
+  // Nouvelle publication météo : invalider les pages qui l'affichent
+  static uint32_t seenWeatherGen = 0;
+  uint32_t weatherGen = weatherGeneration();
+  if (weatherGen != seenWeatherGen) {
+    seenWeatherGen = weatherGen;
+    dataChanged(DATA_WEATHER);
     needsRender = true;
   }
 
-  // Météo
-  if (millis() - lastWeatherMs > REFRESH_WEATHER_MS) {
-    lastWeatherMs = millis();
-    Serial.print("\n[LOOP] Appel fetchWeatherOpenWeather (lat=");
-    Serial.print(gLat, 5);
-    Serial.print(", lon=");
-    Serial.print(gLon, 5);
-    Serial.println(")");
-
-    if (fetchWeatherOpenWeather(gLat, gLon, gWeather)) {
-      Serial.println("[LOOP] Meteo recuperee avec succes");
-      if (gWeather.now.hasAlert) {
-        telegramSend("Alerte meteo: " + String(gWeather.now.alertTitle) + "\n" + String(gWeather.now.alertDesc));
-      }
-      needsRender = true;
-    } else {
-      Serial.println("[LOOP] ECHEC de la recuperation meteo");
-    }
-  }
-
   // --- Rafraîchissement de l'affichage ---
-  if (needsRender) {
-    renderPage();
-  }
-
-  // NTP resync
-  if (millis() - lastNtpMs > NTP_RESYNC_MS) {
-    lastNtpMs = millis();
-    configTzTime(TZ_STRING, NTP_SERVER);
+  // (écran en veille : le rendu attend le réveil)
+  if (needsRender && !backlightIsAsleep()) {
+    needsRender = false;
+    // --- [NEW FEATURE] Changement de page depuis le cache pré-rendu (un seul transfert) ---
+    uint32_t t0 = micros();
+    // Zone de défilement des alertes remise dans l'ordre avant un tracé qui l'ignore
+    if (pageSwitchPending || currentPage != PAGE_ALERT) alertScrollReset();
+    bool fromCache = pageSwitchPending && pageCacheBlit(tft, currentPage);
+    if (fromCache) widgetsScreenSync(kPages[currentPage]);
+    else renderPage();
+    if (pageSwitchPending) {
+      pageSwitchPending = false;
+      Serial.printf("[UI] Latence appui->image: %u ms (%s, trace %u us)\n",
+                    (unsigned)(millis() - pageSwitchPressMs), fromCache ? "cache" : "direct",
+                    (unsigned)(micros() - t0));
+    }
   }
 
-  // Telegram commandes
-  telegramLoop();
+  // Pré-rendu des pages voisines pendant le temps libre (une bande par passage)
+  bool prerenderPending = !backlightIsAsleep() && pageCachePrerender(currentPage, NUM_PAGES);
 
-  // delay(10); // [FIX] Supprimé pour une réactivité maximale
+  // --- [NEW FEATURE] Attente bloquante jusqu'à la prochaine échéance ou un événement ---
+  // (remplace la boucle active : le cœur reste au repos, moins de chaleur près du BME280)
+  schedulerWait(prerenderPending ? 0 : buttonsMsUntilNextDeadline());
 }
@@ -0,0 +1,160 @@
+// nmea.cpp
+#include "nmea.h"
+
+// Nature de chaque champ, par trame (index = numéro de champ NMEA)
+enum FieldKind : uint8_t { F_NONE, F_TIME, F_LAT, F_NS, F_LON, F_EW, F_QUALITY, F_SATS, F_HDOP, F_ALT, F_STATUS, F_DATE };
+
+struct SentenceRule {
+  const char *type;       // sans le préfixe d'émetteur (GP, GN, GL...)
+  const uint8_t *fields;
+  uint8_t fieldCount;
+};
+
+static const uint8_t GGA_FIELDS[] = {F_NONE, F_TIME, F_LAT, F_NS, F_LON, F_EW, F_QUALITY, F_SATS, F_HDOP, F_ALT};
+static const uint8_t RMC_FIELDS[] = {F_NONE, F_TIME, F_STATUS, F_LAT, F_NS, F_LON, F_EW, F_NONE, F_NONE, F_DATE};
+
+enum : uint8_t { SENT_GGA, SENT_RMC, SENT_NONE = 0xFF };
+static const SentenceRule SENTENCES[] = {
+  {"GGA", GGA_FIELDS, sizeof(GGA_FIELDS)},
+  {"RMC", RMC_FIELDS, sizeof(RMC_FIELDS)},
+};
+
+static uint8_t hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return 0xFF;
+}
+
+// "123.45" -> 12345 pour decimals = 2 (décimales en trop tronquées, manquantes complétées)
+static int32_t parseFixed(const char *s, uint8_t decimals) {
+  bool neg = (*s == '-');
+  if (neg) s++;
+  int32_t v = 0;
+  while (*s >= '0' && *s <= '9') v = v * 10 + (*s++ - '0');
+  if (*s == '.') s++;
+  for (uint8_t d = 0; d < decimals; d++) {
+    v *= 10;
+    if (*s >= '0' && *s <= '9') v += *s++ - '0';
+  }
+  return neg ? -v : v;
+}
+
+// ddmm.mmmmm (ou dddmm.mmmmm) -> degrés x 1e7
+static int32_t parseAngle(const char *s, uint8_t degDigits) {
+  int32_t deg = 0;
+  for (uint8_t i = 0; i < degDigits && *s; i++) deg = deg * 10 + (*s++ - '0');
+  int32_t minE5 = parseFixed(s, 5);       // minutes x 1e5
+  return deg * 10000000L + minE5 * 10 / 6; // minutes / 60 x 1e7
+}
+
+static int32_t twoDigits(const char *s) {
+  return (s[0] - '0') * 10 + (s[1] - '0');
+}
+
+void NmeaParser::decodeField(uint8_t kind) {
+  if (_len == 0) {
+    // Champ vide : pas de fix pour cette trame
+    if (kind == F_QUALITY) _pending.quality = 0;
+    return;
+  }
+  switch (kind) {
+    case F_TIME:
+      if (_len >= 6) {
+        _pending.utcMs = (twoDigits(_buf) * 3600UL + twoDigits(_buf + 2) * 60UL + twoDigits(_buf + 4)) * 1000UL
+                         + (_len > 7 ? parseFixed(_buf + 6, 3) : 0);
+      }
+      break;
+    case F_LAT:     _pending.latE7 = parseAngle(_buf, 2); break;
+    case F_LON:     _pending.lonE7 = parseAngle(_buf, 3); break;
+    case F_NS:      if (_buf[0] == 'S') _pending.latE7 = -_pending.latE7; break;
+    case F_EW:      if (_buf[0] == 'W') _pending.lonE7 = -_pending.lonE7; break;
+    case F_QUALITY: _pending.quality = _buf[0] - '0'; break;
+    case F_SATS:    _pending.sats = (uint8_t)parseFixed(_buf, 0); break;
+    case F_HDOP:    _pending.hdopX100 = (uint16_t)parseFixed(_buf, 2); break;
+    case F_ALT:     _pending.altCm = parseFixed(_buf, 2); break;
+    case F_STATUS:  _pending.rmcValid = (_buf[0] == 'A'); break;
+    case F_DATE:    if (_len >= 6) _pending.dateDmy = parseFixed(_buf, 0); break;
+    default: break;
+  }
+}
+
+void NmeaParser::endField() {
+  _buf[_len] = '\0';
+  if (_field == 0) {
+    // En-tête : talker (2 lettres) + type ; les trames inutiles sont abandonnées ici
+    _sentence = SENT_NONE;
+    if (_len == 5) {
+      for (uint8_t i = 0; i < sizeof(SENTENCES) / sizeof(SENTENCES[0]); i++) {
+        const char *t = SENTENCES[i].type;
+        if (_buf[2] == t[0] && _buf[3] == t[1] && _buf[4] == t[2]) _sentence = i;
+      }
+    }
+    if (_sentence == SENT_NONE) {
+      sentencesSkipped++;
+      _state = SKIP;
+    }
+  } else {
+    const SentenceRule &rule = SENTENCES[_sentence];
+    if (_field < rule.fieldCount) decodeField(rule.fields[_field]);
+  }
+  _field++;
+  _len = 0;
+}
+
+bool NmeaParser::encode(char c) {
+  if (c == '$') {
+    _state = BODY;
+    _sum = 0;
+    _field = 0;
+    _len = 0;
+    _pending = _fix;
+    return false;
+  }
+
+  switch (_state) {
+    case BODY:
+      if (c == '*') {
+        endField();
+        if (_state == BODY) _state = CHECK1;
+      } else if (c == ',') {
+        _sum ^= c;
+        endField();
+      } else if (c == '\r' || c == '\n') {
+        _state = IDLE; // trame sans somme de contrôle : refusée
+      } else {
+        _sum ^= c;
+        if (_len < FIELD_MAX) _buf[_len++] = c;
+      }
+      return false;
+
+    case CHECK1: {
+      uint8_t hi = hexValue(c);
+      _rxSum = hi << 4;
+      _state = (hi == 0xFF) ? IDLE : CHECK2;
+      if (hi == 0xFF) checksumErrors++;
+      return false;
+    }
+
+    case CHECK2: {
+      _state = IDLE;
+      uint8_t lo = hexValue(c);
+      if (lo == 0xFF || (uint8_t)(_rxSum | lo) != _sum) {
+        checksumErrors++;
+        return false;
+      }
+      // Le GGA porte la qualité du fix, le RMC son propre statut
+      if (_sentence == SENT_RMC && !_pending.rmcValid) return false;
+      if (_sentence == SENT_GGA && _pending.quality == 0) {
+        _fix.quality = 0;
+        _fix.sats = _pending.sats;
+        return false;
+      }
+      _fix = _pending;
+      sentencesOk++;
+      return true;
+    }
+
+    default:
+      return false; // IDLE / SKIP : attendre le prochain '$'
+  }
+}
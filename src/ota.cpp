@@ -0,0 +1,260 @@
+// ota.cpp
+#include "config.h"
+#include "ota.h"
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include <esp_heap_caps.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/pk.h>
+#include "http_reader.h"
+#include "gzip_stream.h"
+
+static OtaProgressFn progressFn = nullptr;
+static bool pendingVerify = false; // image démarrée pour la première fois, pas encore validée
+
+// Le cœur Arduino valide sinon la nouvelle image dès initArduino() : la validation
+// est repoussée à otaValidateJob pour garder le retour arrière en cas d'échec.
+extern "C" bool verifyRollbackLater() { return true; }
+
+void otaBegin(OtaProgressFn progress) {
+  progressFn = progress;
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  const esp_partition_t *next = esp_ota_get_next_update_partition(nullptr);
+  esp_ota_img_states_t state;
+  pendingVerify = esp_ota_get_state_partition(running, &state) == ESP_OK && state == ESP_OTA_IMG_PENDING_VERIFY;
+  Serial.printf("[OTA] Partition active %s, prochaine %s (%u Ko)%s\n", running->label,
+                next ? next->label : "-", next ? (unsigned)(next->size / 1024) : 0,
+                pendingVerify ? ", premier demarrage a valider" : "");
+}
+
+static bool fail(OtaResult &r, const char *msg) {
+  strlcpy(r.error, msg, sizeof(r.error));
+  Serial.printf("[OTA] ERREUR: %s\n", msg);
+  return false;
+}
+
+static int hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static bool parseSha256(const char *hex, uint8_t out[32]) {
+  if (strlen(hex) != 64) return false;
+  for (int i = 0; i < 32; i++) {
+    int hi = hexNibble(hex[2 * i]), lo = hexNibble(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0) return false;
+    out[i] = (hi << 4) | lo;
+  }
+  return true;
+}
+
+// http[s]://hote[:port]/chemin -> composants ; le chemin pointe dans 'url'
+static bool parseUrl(const char *url, bool &tls, char *host, size_t hostSize, uint16_t &port, const char *&path) {
+  const char *p;
+  if (strncmp(url, "https://", 8) == 0) {
+    tls = true;
+    port = 443;
+    p = url + 8;
+  } else if (strncmp(url, "http://", 7) == 0) {
+    tls = false;
+    port = 80;
+    p = url + 7;
+  } else {
+    return false;
+  }
+  size_t hostLen = strcspn(p, ":/");
+  if (hostLen == 0 || hostLen >= hostSize) return false;
+  memcpy(host, p, hostLen);
+  host[hostLen] = '\0';
+  p += hostLen;
+  if (*p == ':') {
+    port = (uint16_t)strtoul(p + 1, (char **)&p, 10);
+    if (port == 0) return false;
+  }
+  path = (*p == '/') ? p : "/";
+  return true;
+}
+
+// Image gzip : annoncée par le serveur ou fichier .gz servi tel quel
+static bool isGzipPath(const char *path) {
+  size_t len = strcspn(path, "?#");
+  return len >= 3 && strncmp(path + len - 3, ".gz", 3) == 0;
+}
+
+// Requête GET minimale (connexion déjà ouverte)
+static void sendGet(Client &client, const char *host, const char *path, bool acceptGzip) {
+  client.print(String("GET ") + path + " HTTP/1.1\r\nHost: " + host + "\r\n");
+  if (acceptGzip) client.print("Accept-Encoding: gzip\r\n");
+  client.print("Connection: close\r\n\r\n");
+}
+
+// Signature détachée de l'image : même URL suffixée de ".sig" (avant la requête éventuelle)
+static bool fetchSignature(const char *url, uint8_t *sig, size_t maxLen, size_t &sigLen) {
+  char sigUrl[OTA_URL_MAX];
+  size_t base = strcspn(url, "?#");
+  if (snprintf(sigUrl, sizeof(sigUrl), "%.*s.sig%s", (int)base, url, url + base) >= (int)sizeof(sigUrl)) return false;
+  bool tls;
+  char host[64];
+  uint16_t port;
+  const char *path;
+  if (!parseUrl(sigUrl, tls, host, sizeof(host), port, path)) return false;
+  WiFiClient plainClient;
+  WiFiClientSecure tlsClient;
+  tlsClient.setInsecure(); // authenticité garantie par la clé publique, pas par le certificat
+  Client &client = tls ? (Client &)tlsClient : (Client &)plainClient;
+  if (!client.connect(host, port)) return false;
+  sendGet(client, host, path, false);
+  HttpResponseReader http(client);
+  if (!http.readHeaders() || http.status() != 200) return false;
+  sigLen = http.readBytes((char *)sig, maxLen);
+  bool complete = http.finished();
+  client.stop();
+  return complete && sigLen > 0;
+}
+
+// Signature (ECDSA ou RSA, DER) du SHA-256 de l'image décompressée par la clé OTA_SIGNING_PUBKEY
+static bool signatureValid(const uint8_t digest[32], const uint8_t *sig, size_t sigLen) {
+  mbedtls_pk_context pk;
+  mbedtls_pk_init(&pk);
+  int rc = mbedtls_pk_parse_public_key(&pk, (const unsigned char *)OTA_SIGNING_PUBKEY, sizeof(OTA_SIGNING_PUBKEY));
+  if (rc != 0) Serial.printf("[OTA] ERREUR: cle publique OTA illisible (-0x%04x)\n", -rc);
+  else rc = mbedtls_pk_verify(&pk, MBEDTLS_MD_SHA256, digest, 32, sig, sigLen);
+  mbedtls_pk_free(&pk);
+  return rc == 0;
+}
+
+bool otaRun(const char *url, const char *sha256Hex, OtaResult &r) {
+  memset(&r, 0, sizeof(r));
+  uint8_t expected[32];
+  if (!parseSha256(sha256Hex, expected)) return fail(r, "SHA-256 attendu invalide (64 hex)");
+  bool tls;
+  char host[64];
+  uint16_t port;
+  const char *path;
+  if (!parseUrl(url, tls, host, sizeof(host), port, path)) return fail(r, "URL invalide");
+  if (strstr(OTA_SIGNING_PUBKEY, "YOUR_") || sizeof(OTA_SIGNING_PUBKEY) <= 1) {
+    return fail(r, "cle publique OTA_SIGNING_PUBKEY non configuree");
+  }
+  if (WiFi.status() != WL_CONNECTED) return fail(r, "WiFi non connecte");
+
+  // Signature d'abord : rien n'est écrit en flash pour une image non signée
+  uint8_t sig[OTA_SIG_MAX];
+  size_t sigLen = 0;
+  if (!fetchSignature(url, sig, sizeof(sig), sigLen)) return fail(r, "signature (.sig) introuvable");
+
+  Serial.printf("[OTA] Telechargement %s\n", url);
+  uint32_t t0 = millis();
+  WiFiClient plainClient;
+  WiFiClientSecure tlsClient;
+  tlsClient.setInsecure(); // authenticité garantie par la signature, pas par le certificat
+  Client &client = tls ? (Client &)tlsClient : (Client &)plainClient;
+  if (!client.connect(host, port)) return fail(r, "connexion au serveur impossible");
+
+  bool gzipAllowed = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) >= GZIP_WORK_BYTES + OTA_GZIP_HEAP_MARGIN;
+  sendGet(client, host, path, gzipAllowed);
+
+  HttpResponseReader http(client);
+  if (!http.readHeaders()) return fail(r, "en-tetes HTTP non recus");
+  if (http.status() != 200) {
+    snprintf(r.error, sizeof(r.error), "HTTP %d", http.status());
+    Serial.printf("[OTA] ERREUR: %s\n", r.error);
+    return false;
+  }
+  r.gzip = strstr(http.contentEncoding(), "gzip") != nullptr || isGzipPath(path);
+  GzipInflateStream gz(http); // fenêtre allouée seulement si l'image est compressée
+  if (r.gzip && !gz.begin()) return fail(r, "decompression gzip impossible (memoire ou en-tete)");
+  Stream &body = r.gzip ? (Stream &)gz : (Stream &)http;
+
+  // Taille décompressée inconnue à l'avance pour une image gzip
+  size_t imageSize = (!r.gzip && http.contentLength() > 0) ? http.contentLength() : UPDATE_SIZE_UNKNOWN;
+  if (!Update.begin(imageSize)) return fail(r, Update.errorString());
+
+  mbedtls_sha256_context sha;
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts_ret(&sha, 0);
+
+  if (progressFn) progressFn(0, http.contentLength());
+  uint32_t uiMs = millis();
+  uint8_t buf[1024];
+  bool writeOk = true;
+  while (true) {
+    size_t n = body.readBytes((char *)buf, sizeof(buf));
+    if (n == 0) break;
+    if (Update.write(buf, n) != n) {
+      writeOk = false;
+      break;
+    }
+    mbedtls_sha256_update_ret(&sha, buf, n);
+    r.imageBytes += n;
+
+    // Réactivité : temps passé en réception, décompression et écriture flash entre deux rafraîchissements
+    uint32_t gap = millis() - uiMs;
+    if (gap > r.maxUiGapMs) r.maxUiGapMs = gap;
+    if (progressFn) progressFn(http.bodyBytes(), http.contentLength());
+    uiMs = millis();
+  }
+  uint8_t digest[32];
+  mbedtls_sha256_finish_ret(&sha, digest);
+  mbedtls_sha256_free(&sha);
+  r.downloadBytes = http.bodyBytes();
+  r.durationMs = millis() - t0;
+  client.stop();
+
+  if (!writeOk) {
+    Update.abort();
+    return fail(r, Update.errorString());
+  }
+  bool complete = r.gzip ? (gz.finished() && gz.trailerOk()) : http.finished();
+  if (!complete) {
+    Update.abort();
+    return fail(r, r.gzip ? "flux gzip incomplet, CRC32 ou taille differents" : "telechargement incomplet");
+  }
+  if (memcmp(digest, expected, sizeof(digest)) != 0) {
+    Update.abort();
+    return fail(r, "SHA-256 different : image rejetee");
+  }
+  if (!signatureValid(digest, sig, sigLen)) {
+    Update.abort();
+    return fail(r, "signature invalide : image rejetee");
+  }
+  // Image complète et vérifiée : partition de démarrage basculée
+  if (!Update.end(true)) return fail(r, Update.errorString());
+  r.ok = true;
+  Serial.printf("[OTA] %s\n", otaResultText(r).c_str());
+  return true;
+}
+
+String otaResultText(const OtaResult &r) {
+  String s = r.ok ? "Mise a jour OK" : String("Mise a jour ECHEC: ") + r.error;
+  if (r.imageBytes == 0) return s;
+  s += "\n" + String(r.downloadBytes / 1024) + " Ko recus" + (r.gzip ? " (gzip)" : "") + " -> " +
+       String(r.imageBytes / 1024) + " Ko ecrits";
+  s += "\nDuree " + String(r.durationMs / 1000.0f, 1) + " s, " +
+       String(r.durationMs ? r.downloadBytes / r.durationMs : 0) + " Ko/s, ecran bloque max " +
+       String(r.maxUiGapMs) + " ms";
+  return s;
+}
+
+void otaRestart() {
+  Serial.println("[OTA] Redemarrage sur la nouvelle image");
+  delay(500);
+  esp_restart();
+}
+
+void otaValidateJob() {
+  if (!pendingVerify) return;
+  if (WiFi.status() == WL_CONNECTED) {
+    // Démarrage complet et réseau joignable : l'image devient définitive
+    esp_ota_mark_app_valid_cancel_rollback();
+    pendingVerify = false;
+    Serial.printf("[OTA] Nouvelle image validee apres %lu s\n", (unsigned long)(millis() / 1000));
+  } else if (millis() > OTA_VALIDATE_MS) {
+    Serial.println("[OTA] Nouvelle image non validee (pas de WiFi) : retour a la version precedente");
+    delay(100);
+    esp_ota_mark_app_invalid_rollback_and_reboot();
+  }
+}
@@ -0,0 +1,244 @@
+// page_cache.cpp
+#include "config.h"
+#include "page_cache.h"
+
+// Canevas d'une bande horizontale de l'écran : les primitives hors bande sont ignorées
+class BandCanvas : public Adafruit_GFX {
+public:
+  BandCanvas() : Adafruit_GFX(TFT_WIDTH, TFT_HEIGHT) {}
+  uint16_t *buf = nullptr;
+  int16_t y0 = 0;
+
+  void drawPixel(int16_t x, int16_t y, uint16_t c) override {
+    if (x < 0 || x >= TFT_WIDTH || y < y0 || y >= y0 + PAGE_CACHE_BAND_H) return;
+    buf[(y - y0) * TFT_WIDTH + x] = c;
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c) override {
+    int16_t x1 = max<int16_t>(x, 0), x2 = min<int16_t>(x + w, TFT_WIDTH);
+    int16_t y1 = max<int16_t>(y, y0), y2 = min<int16_t>(y + h, y0 + PAGE_CACHE_BAND_H);
+    for (int16_t yy = y1; yy < y2; yy++) {
+      uint16_t *row = buf + (yy - y0) * TFT_WIDTH;
+      for (int16_t xx = x1; xx < x2; xx++) row[xx] = c;
+    }
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) override { fillRect(x, y, w, 1, c); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) override { fillRect(x, y, 1, h, c); }
+  void fillScreen(uint16_t c) override { fillRect(0, 0, TFT_WIDTH, TFT_HEIGHT, c); }
+};
+
+struct CachedPage {
+  int page;           // -1 = libre
+  bool valid;
+  bool tooComplex;    // dépasse PAGE_CACHE_BYTES pour ces générations de données
+  bool building;      // rendu en cours (une bande par passage)
+  uint32_t gens[DATA_FIELD_COUNT];
+  uint8_t *rle;       // suites [longueur-1][couleur LSB][couleur MSB]
+  uint32_t len;
+  // État du rendu incrémental : bande suivante et suite RLE en cours
+  int16_t nextY;
+  uint16_t runColor;
+  uint16_t runLen;
+  uint32_t renderUs;
+};
+
+static BandCanvas canvas;
+static CachedPage slots[2];
+static PageRenderFn renderFn = nullptr;
+static PageDepsFn depsFn = nullptr;
+static PageCacheStats stats = {};
+
+void pageCacheBegin(PageRenderFn render, PageDepsFn deps) {
+  renderFn = render;
+  depsFn = deps;
+  // Tampons réservés une fois pour toutes (pas d'allocation au fil des rendus)
+  canvas.buf = (uint16_t *)malloc(TFT_WIDTH * PAGE_CACHE_BAND_H * sizeof(uint16_t));
+  for (CachedPage &c : slots) {
+    c.page = -1;
+    c.valid = false;
+    c.tooComplex = false;
+    c.building = false;
+    c.rle = (uint8_t *)malloc(PAGE_CACHE_BYTES);
+  }
+  if (!canvas.buf || !slots[0].rle || !slots[1].rle) {
+    Serial.println("[CACHE] ERREUR: memoire insuffisante, pre-rendu desactive");
+    renderFn = nullptr;
+  }
+}
+
+PageRenderFn pageCacheRenderer() {
+  return renderFn;
+}
+
+static bool gensMatch(const CachedPage &c) {
+  uint32_t mask = depsFn(c.page);
+  for (uint8_t f = 0; f < DATA_FIELD_COUNT; f++) {
+    if ((mask & DATA_MASK(f)) && c.gens[f] != dataGeneration((DataField)f)) return false;
+  }
+  return true;
+}
+
+static bool isFresh(const CachedPage &c) {
+  return c.valid && gensMatch(c);
+}
+
+// Début du rendu d'une page dans le slot ; générations relevées au départ
+static void renderStart(CachedPage &c, int page) {
+  c.page = page;
+  c.valid = false;
+  c.tooComplex = false;
+  c.building = true;
+  for (uint8_t f = 0; f < DATA_FIELD_COUNT; f++) c.gens[f] = dataGeneration((DataField)f);
+  c.len = 0;
+  c.nextY = 0;
+  c.runLen = 0;
+  c.renderUs = 0;
+}
+
+static bool pushRun(CachedPage &c) {
+  if (c.len + 3 > PAGE_CACHE_BYTES) return false;
+  c.rle[c.len++] = c.runLen - 1;
+  c.rle[c.len++] = c.runColor & 0xFF;
+  c.rle[c.len++] = c.runColor >> 8;
+  return true;
+}
+
+// Rend et compresse la bande suivante du slot ; renvoie true quand le rendu est terminé
+// (page valide, ou abandonnée car trop complexe)
+static bool renderStep(CachedPage &c) {
+  // Donnée modifiée entre deux bandes : l'image mélangerait deux états, on recommence
+  if (!gensMatch(c)) {
+    stats.restarts++;
+    renderStart(c, c.page);
+  }
+  uint32_t t0 = micros();
+  canvas.y0 = c.nextY;
+  for (int i = 0; i < TFT_WIDTH * PAGE_CACHE_BAND_H; i++) canvas.buf[i] = 0x0000;
+  renderFn(canvas, c.page);
+  stats.bands++;
+
+  // Les suites continuent d'une ligne (et d'une bande) à l'autre
+  bool overflow = false;
+  for (int i = 0; i < TFT_WIDTH * PAGE_CACHE_BAND_H && !overflow; i++) {
+    uint16_t px = canvas.buf[i];
+    if (c.runLen > 0 && (px != c.runColor || c.runLen == 256)) {
+      overflow = !pushRun(c);
+      c.runLen = 0;
+    }
+    c.runColor = px;
+    c.runLen++;
+  }
+  c.nextY += PAGE_CACHE_BAND_H;
+  if (!overflow && c.nextY >= TFT_HEIGHT) overflow = !pushRun(c); // dernière suite
+  c.renderUs += micros() - t0;
+
+  if (overflow) {
+    // Page ignorée jusqu'au prochain changement de ses données (gens conservées)
+    c.building = false;
+    c.tooComplex = true;
+    stats.overflows++;
+    Serial.printf("[CACHE] Page %d trop complexe pour le cache (> %u o, %lu depassement(s))\n", c.page,
+                  PAGE_CACHE_BYTES, (unsigned long)stats.overflows);
+    return true;
+  }
+  if (c.nextY < TFT_HEIGHT) return false;
+  c.building = false;
+  c.valid = true;
+  stats.pages++;
+  if (c.renderUs > stats.maxPageUs) stats.maxPageUs = c.renderUs;
+  Serial.printf("[CACHE] Page %d pre-rendue: %u o (%u us en %u bandes)\n", c.page, (unsigned)c.len,
+                (unsigned)c.renderUs, (unsigned)((TFT_HEIGHT + PAGE_CACHE_BAND_H - 1) / PAGE_CACHE_BAND_H));
+  return true;
+}
+
+// Rendu complet immédiat (diagnostic)
+static bool renderInto(CachedPage &c, int page) {
+  renderStart(c, page);
+  while (!renderStep(c)) {}
+  return c.valid;
+}
+
+bool pageCacheBlit(Adafruit_SPITFT &tft, int page) {
+  if (!renderFn) return false;
+  const CachedPage *c = nullptr;
+  for (const CachedPage &s : slots) {
+    if (s.page == page && isFresh(s)) c = &s;
+  }
+  if (!c) return false;
+
+  // Une seule fenêtre d'adresse, décompression vers un tampon de ligne
+  static uint16_t line[TFT_WIDTH];
+  uint16_t n = 0;
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, TFT_WIDTH, TFT_HEIGHT);
+  for (uint32_t i = 0; i < c->len; i += 3) {
+    uint16_t count = c->rle[i] + 1;
+    uint16_t color = c->rle[i + 1] | (c->rle[i + 2] << 8);
+    while (count--) {
+      line[n++] = color;
+      if (n == TFT_WIDTH) {
+        tft.writePixels(line, n);
+        n = 0;
+      }
+    }
+  }
+  if (n) tft.writePixels(line, n);
+  tft.endWrite();
+  return true;
+}
+
+bool pageCachePrerender(int currentPage, int numPages) {
+  if (!renderFn) return false;
+  int wanted[2] = {(currentPage + 1) % numPages, (currentPage + numPages - 1) % numPages};
+  // Rendu en cours : une bande par passage, tant que la page reste voisine
+  for (CachedPage &s : slots) {
+    if (!s.building) continue;
+    if (s.page == wanted[0] || s.page == wanted[1]) {
+      renderStep(s);
+      return true;
+    }
+    s.building = false; // page plus voisine : abandon, slot réutilisable
+    s.page = -1;
+  }
+  for (int w : wanted) {
+    CachedPage *hit = nullptr;
+    for (CachedPage &s : slots) {
+      if (s.page == w) hit = &s;
+    }
+    if (hit && (isFresh(*hit) || (hit->tooComplex && gensMatch(*hit)))) continue;
+    if (!hit) {
+      // Réutiliser un slot qui ne contient pas une page voisine
+      for (CachedPage &s : slots) {
+        if (s.page != wanted[0] && s.page != wanted[1]) { hit = &s; break; }
+      }
+    }
+    if (!hit) continue;
+    renderStart(*hit, w);
+    renderStep(*hit);
+    return true; // une bande par passage pour ne pas retarder les événements
+  }
+  return false;
+}
+
+const uint8_t *pageCacheEncode(int page, uint32_t &len) {
+  if (!renderFn) return nullptr;
+  CachedPage *c = &slots[0];
+  for (CachedPage &s : slots) {
+    if (s.page == page) c = &s;
+  }
+  if (!isFresh(*c) || c->page != page) {
+    if (!renderInto(*c, page)) return nullptr;
+  }
+  len = c->len;
+  return c->rle;
+}
+
+const PageCacheStats &pageCacheStats() {
+  return stats;
+}
+
+void pageCacheReport() {
+  Serial.printf("[CACHE] %lu pages pre-rendues (%lu bandes, max %lu us par page), %lu reprises, "
+                "%lu depassement(s) de %u o\n",
+                (unsigned long)stats.pages, (unsigned long)stats.bands, (unsigned long)stats.maxPageUs,
+                (unsigned long)stats.restarts, (unsigned long)stats.overflows, PAGE_CACHE_BYTES);
+}
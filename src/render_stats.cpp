@@ -0,0 +1,110 @@
+// render_stats.cpp
+#include "config.h"
+#include "render_stats.h"
+#include <rom/crc.h>
+
+// Canevas de comptage : chaque pixel écrit est compté, un bit par pixel mémorise
+// ceux déjà touchés (surimpression = écrits - distincts).
+class CountingCanvas : public Adafruit_GFX {
+public:
+  CountingCanvas(uint8_t *touched) : Adafruit_GFX(TFT_WIDTH, TFT_HEIGHT), _touched(touched) {}
+  RenderStats stats = {};
+
+  void startWrite() override {
+    if (_depth++ == 0) stats.transactions++;
+  }
+  void endWrite() override {
+    if (_depth > 0) _depth--;
+  }
+  void drawPixel(int16_t x, int16_t y, uint16_t c) override {
+    standalone();
+    touch(x, y, 1, 1);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c) override {
+    standalone();
+    touch(x, y, w, h);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) override {
+    standalone();
+    touch(x, y, w, 1);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) override {
+    standalone();
+    touch(x, y, 1, h);
+  }
+  void fillScreen(uint16_t c) override { fillRect(0, 0, TFT_WIDTH, TFT_HEIGHT, c); }
+
+private:
+  uint8_t *_touched;
+  uint8_t _depth = 0;
+
+  // Primitive appelée hors startWrite : une transaction à elle seule sur Adafruit_SPITFT
+  void standalone() {
+    stats.primitives++;
+    if (_depth == 0) stats.transactions++;
+  }
+  void touch(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int16_t x1 = max<int16_t>(x, 0), x2 = min<int16_t>(x + w, TFT_WIDTH);
+    int16_t y1 = max<int16_t>(y, 0), y2 = min<int16_t>(y + h, TFT_HEIGHT);
+    for (int16_t yy = y1; yy < y2; yy++) {
+      for (int16_t xx = x1; xx < x2; xx++) {
+        uint32_t i = (uint32_t)yy * TFT_WIDTH + xx;
+        stats.pixelsWritten++;
+        if (!(_touched[i >> 3] & (1 << (i & 7)))) {
+          _touched[i >> 3] |= 1 << (i & 7);
+          stats.pixelsDistinct++;
+        }
+      }
+    }
+  }
+};
+
+bool renderStatsMeasure(PageRenderFn render, int page, RenderStats &out) {
+  const size_t bitmapBytes = TFT_WIDTH * TFT_HEIGHT / 8;
+  uint8_t *touched = (uint8_t *)calloc(bitmapBytes, 1);
+  if (!touched) return false;
+
+  CountingCanvas canvas(touched);
+  uint32_t t0 = micros();
+  render(canvas, page);
+  canvas.stats.renderUs = micros() - t0;
+  free(touched);
+
+  uint32_t len = 0;
+  const uint8_t *rle = pageCacheEncode(page, len);
+  canvas.stats.rleOverflow = !rle;
+  canvas.stats.crc = rle ? crc32_le(0, rle, len) : 0;
+  out = canvas.stats;
+  return true;
+}
+
+static void dumpFrame(int page) {
+  uint32_t len = 0;
+  const uint8_t *rle = pageCacheEncode(page, len);
+  if (!rle) return;
+  // Format : [FRAME] page=N w=W h=H rle=LEN puis lignes hexadécimales, terminé par [FRAME] fin
+  Serial.printf("[FRAME] page=%d w=%d h=%d rle=%u\n", page, TFT_WIDTH, TFT_HEIGHT, (unsigned)len);
+  for (uint32_t i = 0; i < len; i += 48) {
+    for (uint32_t j = i; j < len && j < i + 48; j++) Serial.printf("%02x", rle[j]);
+    Serial.println();
+  }
+  Serial.println("[FRAME] fin");
+}
+
+void renderStatsReportAll(PageRenderFn render, int numPages, bool dumpFrames) {
+  Serial.println("[RENDU] page pixels distincts surimpression transactions primitives us crc");
+  for (int p = 0; p < numPages; p++) {
+    RenderStats st;
+    if (!renderStatsMeasure(render, p, st)) {
+      Serial.println("[RENDU] ERREUR: memoire insuffisante");
+      return;
+    }
+    uint32_t overdrawPct = st.pixelsDistinct ? (st.pixelsWritten - st.pixelsDistinct) * 100 / st.pixelsDistinct : 0;
+    char crc[9] = "overflow";
+    if (!st.rleOverflow) snprintf(crc, sizeof(crc), "%08x", (unsigned)st.crc);
+    Serial.printf("[RENDU] %d %u %u %u%% %u %u %u %s\n", p, (unsigned)st.pixelsWritten,
+                  (unsigned)st.pixelsDistinct, (unsigned)overdrawPct, (unsigned)st.transactions,
+                  (unsigned)st.primitives, (unsigned)st.renderUs, crc);
+    if (dumpFrames) dumpFrame(p);
+  }
+}
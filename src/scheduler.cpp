@@ -0,0 +1,175 @@
+// scheduler.cpp
+#include "config.h"
+#include "scheduler.h"
+
+struct Job {
+  const char *name;
+  JobFn fn;
+  uint32_t periodMs;
+  uint32_t nextDue;
+  uint32_t lastRun;  // début de la dernière exécution (ajout de la tâche avant la première)
+  // Comptabilité depuis le dernier rapport
+  uint32_t runs;
+  uint32_t totalUs;
+  uint32_t maxUs;
+  // Cumul depuis le démarrage
+  uint32_t allRuns;
+  uint64_t allUs;
+  uint32_t allMaxUs;
+};
+
+static Job jobs[SCHED_MAX_JOBS];
+static uint8_t jobCount = 0;
+static TaskHandle_t loopTask = nullptr;
+
+// Comptabilité du temps bloqué
+static uint32_t windowStartUs = 0;
+static uint32_t idleUsInWindow = 0;
+static uint8_t idlePct = 0;
+
+// Rapport par tâche (période SCHED_REPORT_MS)
+static uint32_t reportStartUs = 0;
+static uint32_t reportIdleUs = 0;
+static uint32_t reportLoops = 0;
+static uint32_t totalLoops = 0;
+
+void schedulerBegin() {
+  loopTask = xTaskGetCurrentTaskHandle();
+  windowStartUs = micros();
+  reportStartUs = windowStartUs;
+}
+
+JobId schedulerAdd(const char *name, JobFn fn, uint32_t periodMs, uint32_t firstDelayMs) {
+  if (jobCount >= SCHED_MAX_JOBS) {
+    Serial.printf("[SCHED] ERREUR: trop de taches (%s ignoree)\n", name);
+    return SCHED_INVALID_JOB;
+  }
+  jobs[jobCount] = {name, fn, periodMs, (uint32_t)millis() + firstDelayMs, (uint32_t)millis(), 0, 0, 0, 0, 0, 0};
+  return jobCount++;
+}
+
+void schedulerSetPeriod(JobId id, uint32_t periodMs) {
+  if (id >= jobCount) return;
+  Job &j = jobs[id];
+  // Reprogrammer depuis la dernière exécution si l'échéance qui en résulte est plus
+  // proche (une exécution demandée par schedulerTrigger/schedulerSetNext est conservée)
+  j.periodMs = periodMs;
+  if ((int32_t)(j.lastRun + periodMs - j.nextDue) < 0) j.nextDue = j.lastRun + periodMs;
+}
+
+void schedulerTrigger(JobId id) {
+  if (id >= jobCount) return;
+  jobs[id].nextDue = millis();
+}
+
+void schedulerSetNext(JobId id, uint32_t delayMs) {
+  if (id >= jobCount) return;
+  jobs[id].nextDue = millis() + delayMs;
+}
+
+void schedulerRunDue() {
+  for (uint8_t i = 0; i < jobCount; i++) {
+    Job &j = jobs[i];
+    uint32_t now = millis();
+    if ((int32_t)(now - j.nextDue) < 0) continue;
+    // Échéance suivante sans dérive ; si on a pris trop de retard, repartir de maintenant
+    j.nextDue += j.periodMs;
+    if ((int32_t)(now - j.nextDue) >= 0) j.nextDue = now + j.periodMs;
+    j.lastRun = now;
+    uint32_t t0 = micros();
+    j.fn();
+    uint32_t us = micros() - t0;
+    j.runs++;
+    j.totalUs += us;
+    if (us > j.maxUs) j.maxUs = us;
+    j.allRuns++;
+    j.allUs += us;
+    if (us > j.allMaxUs) j.allMaxUs = us;
+  }
+}
+
+void schedulerWait(uint32_t maxWaitMs) {
+  uint32_t now = millis();
+  uint32_t waitMs = maxWaitMs;
+  for (uint8_t i = 0; i < jobCount; i++) {
+    int32_t left = (int32_t)(jobs[i].nextDue - now);
+    uint32_t w = left > 0 ? (uint32_t)left : 0;
+    if (w < waitMs) waitMs = w;
+  }
+
+  if (waitMs > 0) {
+    uint32_t t0 = micros();
+    ulTaskNotifyTake(pdTRUE, waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs));
+    uint32_t idleUs = micros() - t0;
+    idleUsInWindow += idleUs;
+    reportIdleUs += idleUs;
+  }
+  reportLoops++;
+  totalLoops++;
+
+  uint32_t elapsed = micros() - windowStartUs;
+  if (elapsed >= SCHED_IDLE_WINDOW_MS * 1000UL) {
+    idlePct = (uint8_t)min((uint64_t)100, (uint64_t)idleUsInWindow * 100 / elapsed);
+    idleUsInWindow = 0;
+    windowStartUs = micros();
+  }
+}
+
+void schedulerNotify() {
+  if (loopTask) xTaskNotifyGive(loopTask);
+}
+
+void IRAM_ATTR schedulerNotifyFromISR() {
+  if (!loopTask) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(loopTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+uint8_t schedulerIdlePct() {
+  return idlePct;
+}
+
+void schedulerReport() {
+  uint32_t elapsedUs = micros() - reportStartUs;
+  if (elapsedUs == 0) return;
+  // Temps actif hors tâches : boutons, GPS, rendu et pré-rendu dans loop()
+  uint32_t jobsUs = 0;
+  for (uint8_t i = 0; i < jobCount; i++) jobsUs += jobs[i].totalUs;
+  uint32_t busyUs = elapsedUs - min(reportIdleUs, elapsedUs);
+  uint32_t loopUs = busyUs - min(jobsUs, busyUs);
+
+  Serial.printf("[SCHED] Rapport sur %lu s : %lu iterations (%lu/s), inactif %u%%\n",
+                (unsigned long)(elapsedUs / 1000000UL), (unsigned long)reportLoops,
+                (unsigned long)((uint64_t)reportLoops * 1000000ULL / elapsedUs),
+                (unsigned)((uint64_t)reportIdleUs * 100 / elapsedUs));
+  for (uint8_t i = 0; i < jobCount; i++) {
+    Job &j = jobs[i];
+    Serial.printf("[SCHED]   %-10s %5lu exec, moy %6lu us, max %7lu us, %3u.%u%% CPU\n", j.name,
+                  (unsigned long)j.runs, (unsigned long)(j.runs ? j.totalUs / j.runs : 0), (unsigned long)j.maxUs,
+                  (unsigned)((uint64_t)j.totalUs * 100 / elapsedUs), (unsigned)((uint64_t)j.totalUs * 1000 / elapsedUs % 10));
+    j.runs = 0;
+    j.totalUs = 0;
+    j.maxUs = 0;
+  }
+  Serial.printf("[SCHED]   %-10s %lu us actifs, %3u.%u%% CPU\n", "boucle", (unsigned long)loopUs,
+                (unsigned)((uint64_t)loopUs * 100 / elapsedUs), (unsigned)((uint64_t)loopUs * 1000 / elapsedUs % 10));
+  reportIdleUs = 0;
+  reportLoops = 0;
+  reportStartUs = micros();
+}
+
+uint8_t schedulerJobCount() {
+  return jobCount;
+}
+
+bool schedulerJobTotals(JobId id, SchedJobTotals &out) {
+  if (id >= jobCount) return false;
+  const Job &j = jobs[id];
+  out = {j.name, j.allRuns, j.allUs, j.allMaxUs};
+  return true;
+}
+
+uint32_t schedulerLoopCount() {
+  return totalLoops;
+}
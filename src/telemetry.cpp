@@ -3,14 +3,19 @@
 #include "telemetry.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <ArduinoJson.h>
 #include "weather.h"
+#include "heap_monitor.h"
+#include "weather_store.h"
+#include "ota.h"
+#include "baro_forecast.h"
 
-extern WeatherData gWeather;
 extern float gTempInt;
 extern float gHumInt;
 extern double gLat;
 extern double gLon;
 extern bool gUseDefaultGeo;
+extern BaroForecast gBaro;
 
 void telegramSend(const String &msg) {
   if (WiFi.status()!=WL_CONNECTED) return;
@@ -24,50 +29,126 @@ void telegramSend(const String &msg) {
 }
 
 String formatWeatherBrief() {
-  String s = "Meteo: " + String(gWeather.now.tempNow,1) + "°C, ";
-  s += "hum " + String(gWeather.now.humidity,0) + "%, vent " + String(gWeather.now.wind,1) + " m/s\n";
-  s += "Prévision: min " + String(gWeather.now.tempMin,1) + "°C / max " + String(gWeather.now.tempMax,1) + "°C\n";
-  if (gWeather.now.hasAlert) {
-    s += "Alerte: " + gWeather.now.alertTitle + " (" + gWeather.now.alertSeverity + ")\n";
+  WeatherSnapshot w;
+  String s = "Meteo: " + String(w->now.tempNow,1) + "°C, ";
+  s += "hum " + String(w->now.humidity,0) + "%, vent " + String(w->now.wind,1) + " m/s\n";
+  s += "Prévision: min " + String(w->now.tempMin,1) + "°C / max " + String(w->now.tempMax,1) + "°C\n";
+  if (w->now.hasAlert) {
+    s += "Alerte: " + String(w->now.alertTitle) + " (" + w->now.alertSeverity + ")\n";
   } else {
     s += "Pas d’alerte.\n";
   }
   s += "Intérieur: " + String(gTempInt,1) + "°C, " + String(gHumInt,0) + "%\n";
+  if (gBaro.valid) {
+    s += "Local: " + String(gBaro.text) + " (" + String(gBaro.seaLevelHpa,1) + " hPa";
+    if (gBaro.trendValid) s += ", " + String(gBaro.trendHpa3h,1) + " hPa/3h";
+    s += ")\n";
+  }
   s += "Geo: " + String(gLat,5) + ", " + String(gLon,5) + (gUseDefaultGeo ? " (défaut Bordeaux)" : " (GPS)");
   return s;
 }
 
-static unsigned long lastPoll = 0;
+// Chat autorisé : identifiant numérique exact du message (TELEGRAM_CHAT_ID non renseigné : aucun)
+static bool chatAuthorized(JsonVariantConst chatId) {
+  const char *cfg = TELEGRAM_CHAT_ID;
+  char *end;
+  long long allowed = strtoll(cfg, &end, 10);
+  if (end == cfg || *end != '\0') return false;
+  return chatId.is<long long>() && chatId.as<long long>() == allowed;
+}
+
+// --- [NEW FEATURE] /ota <url> <sha256> : mise à jour du firmware (image signée, voir ota.h) ---
+static void telegramOta(const char *args) {
+  String a(args);
+  a.trim();
+  int sp = a.indexOf(' ');
+  if (sp < 0) {
+    telegramSend("Usage: /ota <url> <sha256>");
+    return;
+  }
+  String otaUrl = a.substring(0, sp);
+  String sha = a.substring(sp + 1);
+  sha.trim();
+  telegramSend("Mise a jour: telechargement de " + otaUrl);
+  OtaResult r;
+  bool ok = otaRun(otaUrl.c_str(), sha.c_str(), r);
+  telegramSend(otaResultText(r));
+  if (ok) otaRestart();
+}
+
+static bool isCommand(const char *text, const char *cmd) {
+  size_t n = strlen(cmd);
+  return strncmp(text, cmd, n) == 0 && (text[n] == '\0' || text[n] == ' ' || text[n] == '@');
+}
 
+// Commande d'un message du chat autorisé
+static void telegramCommand(const char *text) {
+  if (isCommand(text, "/meteo")) telegramSend(formatWeatherBrief());
+  else if (isCommand(text, "/temp")) telegramSend("Temp interieur: " + String(gTempInt,1) + "°C");
+  else if (isCommand(text, "/hygro")) telegramSend("Hygrometrie: " + String(gHumInt,0) + "%");
+  else if (isCommand(text, "/alertes")) {
+    WeatherSnapshot w;
+    if (w->now.hasAlert) telegramSend("Alerte: " + String(w->now.alertTitle) + "\n" + w->now.alertDesc);
+    else telegramSend("Pas d’alerte en cours.");
+  } else if (isCommand(text, "/geo")) {
+    telegramSend("Position: " + String(gLat,5) + ", " + String(gLon,5) + (gUseDefaultGeo ? " (défaut Bordeaux)" : " (GPS)"));
+  } else if (isCommand(text, "/ota")) {
+    telegramOta(text + 4);
+  } else if (isCommand(text, "/reboot")) {
+    telegramSend("Redémarrage demandé.");
+    delay(500);
+    esp_restart();
+  }
+}
+
+// Filtre construit une fois : identifiant, chat et texte de chaque message
+static const JsonDocument &updatesFilter() {
+  static JsonDocument filter;
+  if (filter.isNull()) {
+    filter["result"][0]["update_id"] = true;
+    filter["result"][0]["message"]["chat"]["id"] = true;
+    filter["result"][0]["message"]["text"] = true;
+  }
+  return filter;
+}
+
+// Appelée périodiquement par l'ordonnanceur (TELEGRAM_POLL_MS)
 void telegramLoop() {
   if (WiFi.status()!=WL_CONNECTED) return;
-  if (millis() - lastPoll < 2500) return;
-  lastPoll = millis();
+  HeapProbe probe(HEAP_SITE_TELEGRAM);
 
   // Get updates (polling simple)
+  // offset : les messages déjà traités sont acquittés et ne reviennent plus
+  static long nextUpdateId = 0;
   HTTPClient http;
   String url = "https://api.telegram.org/bot" + String(TELEGRAM_BOT_TOKEN) + "/getUpdates";
+  if (nextUpdateId) url += "?offset=" + String(nextUpdateId);
   http.begin(url);
   int code = http.GET();
   if (code!=200) { http.end(); return; }
   String resp = http.getString();
   http.end();
-
-  // Minimal parse for text commands
-  // For robust behavior, track update_id and offset; here we simplify.
-  if (resp.indexOf("/meteo")>=0) telegramSend(formatWeatherBrief());
-  if (resp.indexOf("/temp")>=0) telegramSend("Temp interieur: " + String(gTempInt,1) + "°C");
-  if (resp.indexOf("/hygro")>=0) telegramSend("Hygrometrie: " + String(gHumInt,0) + "%");
-  if (resp.indexOf("/alertes")>=0) {
-    if (gWeather.now.hasAlert) telegramSend("Alerte: " + gWeather.now.alertTitle + "\n" + gWeather.now.alertDesc);
-    else telegramSend("Pas d’alerte en cours.");
+  // Acquittement sur le texte brut : un lot illisible ne revient pas en boucle
+  for (int i = resp.indexOf("\"update_id\":"); i >= 0; i = resp.indexOf("\"update_id\":", i + 1)) {
+    long id = atol(resp.c_str() + i + 12);
+    if (id >= nextUpdateId) nextUpdateId = id + 1;
   }
-  if (resp.indexOf("/geo")>=0) {
-    telegramSend("Position: " + String(gLat,5) + ", " + String(gLon,5) + (gUseDefaultGeo ? " (défaut Bordeaux)" : " (GPS)"));
+
+  // Chaque message est traité seul : la commande et l'auteur viennent du même message
+  JsonDocument doc;
+  DeserializationError err = deserializeJson(doc, resp, DeserializationOption::Filter(updatesFilter()));
+  if (err) {
+    Serial.printf("[TELEGRAM] Reponse getUpdates illisible: %s\n", err.c_str());
+    return;
   }
-  if (resp.indexOf("/reboot")>=0) {
-    telegramSend("Redémarrage demandé.");
-    delay(500);
-    esp_restart();
+  for (JsonVariant update : doc["result"].as<JsonArray>()) {
+    JsonVariant msg = update["message"];
+    const char *text = msg["text"] | "";
+    if (text[0] != '/') continue;
+    if (!chatAuthorized(msg["chat"]["id"])) {
+      Serial.printf("[TELEGRAM] Commande ignoree (chat %lld non autorise)\n", msg["chat"]["id"] | 0LL);
+      continue;
+    }
+    telegramCommand(text);
   }
 }
@@ -0,0 +1,152 @@
+// telemetry_frame.cpp
+#include "config.h"
+#include "telemetry_frame.h"
+#include <WiFi.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include "telemetry.h"
+#include "weather_store.h"
+#include "weather_policy.h"
+#include "baro_forecast.h"
+#include "gps.h"
+#include "heap_monitor.h"
+#include "scheduler.h"
+#include "wifi_manager.h"
+
+extern float gTempInt;
+extern float gHumInt;
+extern bool gUseDefaultGeo;
+extern BaroForecast gBaro;
+extern GpsFix gGps;
+
+// Valeur en virgule fixe, nil si inconnue
+static void addFixed(JsonArray a, float v, float scale) {
+  if (isnan(v)) a.add(nullptr);
+  else a.add((int32_t)lroundf(v * scale));
+}
+
+static void buildSnapshot(JsonDocument &doc) {
+  JsonArray root = doc.to<JsonArray>();
+  root.add(TELEMETRY_SCHEMA_VERSION);
+  time_t now = time(nullptr);
+  if (now > 1577836800) root.add((uint32_t)now); // heure connue (après 2020)
+  else root.add(nullptr);
+  root.add((uint32_t)(millis() / 1000));
+
+  JsonArray in = root.add<JsonArray>();
+  addFixed(in, gTempInt, 100);
+  addFixed(in, gHumInt, 10);
+  if (gBaro.valid) {
+    addFixed(in, gBaro.stationHpa, 10);
+    addFixed(in, gBaro.seaLevelHpa, 10);
+    if (gBaro.trendValid) addFixed(in, gBaro.trendHpa3h, 10);
+    else in.add(nullptr);
+    char letter[2] = {gBaro.letter, '\0'};
+    in.add(letter);
+  } else {
+    for (uint8_t i = 0; i < 4; i++) in.add(nullptr);
+  }
+
+  JsonArray out = root.add<JsonArray>();
+  uint32_t ageMs = weatherPolicyAgeMs();
+  if (ageMs == UINT32_MAX) {
+    for (uint8_t i = 0; i < 8; i++) out.add(nullptr);
+  } else {
+    WeatherSnapshot w;
+    addFixed(out, w->now.tempNow, 100);
+    addFixed(out, w->now.humidity, 1);
+    addFixed(out, w->now.wind, 100);
+    out.add(w->now.conditionCode);
+    addFixed(out, w->now.tempMin, 100);
+    addFixed(out, w->now.tempMax, 100);
+    if (w->now.hasAlert) {
+      char severity[sizeof(w->now.alertSeverity)]; // copié dans le document (l'instantané est relâché avant l'encodage)
+      strlcpy(severity, w->now.alertSeverity, sizeof(severity));
+      out.add(severity);
+    } else {
+      out.add(nullptr);
+    }
+    out.add(ageMs / 1000);
+  }
+
+  JsonArray gps = root.add<JsonArray>();
+  if (gUseDefaultGeo) {
+    for (uint8_t i = 0; i < 5; i++) gps.add(nullptr);
+    gps.add(false);
+  } else {
+    gps.add(gGps.latE7);
+    gps.add(gGps.lonE7);
+    gps.add(gGps.altCm);
+    gps.add(gGps.sats);
+    gps.add(gGps.hdopX100);
+    gps.add(true);
+  }
+
+  JsonArray sys = root.add<JsonArray>();
+  const HeapStats &heap = heapMonitorStats();
+  sys.add(heap.freeHeap);
+  sys.add(heap.largestBlock);
+  sys.add(schedulerIdlePct());
+  if (WiFi.status() == WL_CONNECTED) sys.add(WiFi.RSSI());
+  else sys.add(nullptr);
+  sys.add(wifiStats().disconnects);
+  sys.add(weatherPolicyStats().callsToday);
+}
+
+size_t telemetryEncode(uint8_t *buf, size_t size) {
+  JsonDocument doc;
+  buildSnapshot(doc);
+  if (doc.overflowed() || measureMsgPack(doc) > size) return 0;
+  return serializeMsgPack(doc, buf, size);
+}
+
+void telemetryLogJob() {
+  static bool mounted = false;
+  if (!mounted && !(mounted = LittleFS.begin(true))) return;
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  size_t len = telemetryEncode(frame, sizeof(frame));
+  if (!len) return;
+
+  File f = LittleFS.open(TELEMETRY_LOG_FILE, "a");
+  if (!f) return;
+  if (f.size() + len + 2 > TELEMETRY_LOG_MAX_BYTES) {
+    // Rotation : le journal courant devient .old (le précédent est écrasé)
+    f.close();
+    LittleFS.remove(TELEMETRY_LOG_FILE ".old");
+    LittleFS.rename(TELEMETRY_LOG_FILE, TELEMETRY_LOG_FILE ".old");
+    f = LittleFS.open(TELEMETRY_LOG_FILE, "a");
+    if (!f) return;
+  }
+  uint8_t hdr[2] = {(uint8_t)(len >> 8), (uint8_t)len};
+  f.write(hdr, sizeof(hdr));
+  f.write(frame, len);
+  f.close();
+}
+
+void telemetryBenchmark() {
+  const uint8_t runs = 20;
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  size_t packLen = 0, jsonLen = 0, textLen = 0;
+
+  uint32_t t0 = micros();
+  for (uint8_t i = 0; i < runs; i++) packLen = telemetryEncode(frame, sizeof(frame));
+  uint32_t packUs = (micros() - t0) / runs;
+
+  // Même document en JSON, puis texte Telegram concaténé en String
+  char json[512];
+  t0 = micros();
+  for (uint8_t i = 0; i < runs; i++) {
+    JsonDocument doc;
+    buildSnapshot(doc);
+    jsonLen = serializeJson(doc, json, sizeof(json));
+  }
+  uint32_t jsonUs = (micros() - t0) / runs;
+
+  t0 = micros();
+  for (uint8_t i = 0; i < runs; i++) textLen = formatWeatherBrief().length();
+  uint32_t textUs = (micros() - t0) / runs;
+
+  Serial.printf("[TELEM] Schema %u: MessagePack %u o en %u us | JSON %u o en %u us | texte %u o en %u us\n",
+                (unsigned)TELEMETRY_SCHEMA_VERSION, (unsigned)packLen, (unsigned)packUs, (unsigned)jsonLen,
+                (unsigned)jsonUs, (unsigned)textLen, (unsigned)textUs);
+}
@@ -0,0 +1,101 @@
+// text_layout.cpp
+#include "text_layout.h"
+
+// Latin-1 U+00A0..U+00FF -> CP437 ; lettres sans glyphe CP437 ramenées à leur base (À -> A)
+static const uint8_t LATIN1_TO_CP437[96] = {
+  0x20, 0xAD, 0x9B, 0x9C, 0x3F, 0x9D, 0x3F, 0x3F, 0x3F, 0x3F, 0xA6, 0xAE,
+  0xAA, 0x3F, 0x3F, 0x3F, 0xF8, 0xF1, 0xFD, 0x3F, 0x3F, 0xE6, 0x3F, 0xFA,
+  0x3F, 0x3F, 0xA7, 0xAF, 0xAC, 0xAB, 0x3F, 0xA8, 0x41, 0x41, 0x41, 0x41,
+  0x8E, 0x8F, 0x92, 0x80, 0x45, 0x90, 0x45, 0x45, 0x49, 0x49, 0x49, 0x49,
+  0x3F, 0xA5, 0x4F, 0x4F, 0x4F, 0x4F, 0x99, 0x3F, 0x3F, 0x55, 0x55, 0x55,
+  0x9A, 0x59, 0x3F, 0xE1, 0x85, 0xA0, 0x83, 0x61, 0x84, 0x86, 0x91, 0x87,
+  0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B, 0x3F, 0xA4, 0x95, 0xA2,
+  0x93, 0x6F, 0x94, 0xF6, 0x3F, 0x97, 0xA3, 0x96, 0x81, 0x79, 0x3F, 0x98,
+};
+
+// Ponctuation typographique courante dans les bulletins (apostrophes, tirets, points de suspension)
+static const char *typographic(uint32_t cp) {
+  switch (cp) {
+    case 0x2018: case 0x2019: return "'";
+    case 0x201C: case 0x201D: return "\"";
+    case 0x2013: case 0x2014: return "-";
+    case 0x2026: return "...";
+    case 0x0152: return "OE";
+    case 0x0153: return "oe";
+    case 0x202F: return " "; // espace fine insécable
+    default: return "?";
+  }
+}
+
+size_t utf8ToCp437(const char *src, char *dst, size_t dstSize) {
+  size_t n = 0;
+  const uint8_t *s = (const uint8_t *)src;
+  while (*s && n + 1 < dstSize) {
+    uint32_t cp;
+    uint8_t extra;
+    if (*s < 0x80) { cp = *s; extra = 0; }
+    else if ((*s & 0xE0) == 0xC0) { cp = *s & 0x1F; extra = 1; }
+    else if ((*s & 0xF0) == 0xE0) { cp = *s & 0x0F; extra = 2; }
+    else if ((*s & 0xF8) == 0xF0) { cp = *s & 0x07; extra = 3; }
+    else { s++; continue; } // octet de continuation isolé
+    s++;
+    for (; extra > 0; extra--, s++) {
+      if ((*s & 0xC0) != 0x80) break; // séquence tronquée
+      cp = (cp << 6) | (*s & 0x3F);
+    }
+    if (extra) continue;
+
+    if (cp == '\r') continue;
+    if (cp < 0x80) {
+      dst[n++] = (char)cp;
+    } else if (cp >= 0xA0 && cp <= 0xFF) {
+      dst[n++] = (char)LATIN1_TO_CP437[cp - 0xA0];
+    } else {
+      for (const char *r = typographic(cp); *r && n + 1 < dstSize; r++) dst[n++] = *r;
+    }
+  }
+  dst[n] = '\0';
+  return n;
+}
+
+void TextLayout::layout(const char *utf8, uint8_t maxCols) {
+  uint32_t t0 = micros();
+  uint16_t n = utf8ToCp437(utf8, _text, sizeof(_text));
+  _count = 0;
+  _truncated = false;
+
+  uint16_t pos = 0;
+  while (pos < n) {
+    if (_count >= TEXT_LAYOUT_MAX_LINES) {
+      _truncated = true;
+      break;
+    }
+    while (pos < n && _text[pos] == ' ') pos++; // pas d'espace en début de ligne
+    uint16_t start = pos;
+    int32_t lastSpace = -1;
+    uint16_t i = pos;
+    while (i < n && _text[i] != '\n' && i - start < maxCols) {
+      if (_text[i] == ' ') lastSpace = i;
+      i++;
+    }
+
+    uint16_t end, next;
+    if (i >= n || _text[i] == '\n') {
+      end = i;
+      next = i + 1;
+    } else if (_text[i] == ' ') {
+      end = i;
+      next = i + 1;
+    } else if (lastSpace > start) {
+      end = lastSpace; // coupure au dernier espace
+      next = lastSpace + 1;
+    } else {
+      end = i;         // mot plus long qu'une ligne : coupure franche
+      next = i;
+    }
+    while (end > start && _text[end - 1] == ' ') end--;
+    _lines[_count++] = {start, (uint8_t)(end - start)};
+    pos = next;
+  }
+  _layoutUs = micros() - t0;
+}
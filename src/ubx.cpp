@@ -0,0 +1,92 @@
+// ubx.cpp
+#include "ubx.h"
+
+void ubxSend(Stream &port, uint8_t cls, uint8_t id, const uint8_t *payload, uint16_t len) {
+  uint8_t head[6] = {0xB5, 0x62, cls, id, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+  // Somme de Fletcher 8 bits sur classe, id, longueur et charge utile
+  uint8_t ckA = 0, ckB = 0;
+  for (uint8_t i = 2; i < 6; i++) { ckA += head[i]; ckB += ckA; }
+  for (uint16_t i = 0; i < len; i++) { ckA += payload[i]; ckB += ckA; }
+  port.write(head, sizeof(head));
+  if (len) port.write(payload, len);
+  port.write(ckA);
+  port.write(ckB);
+}
+
+bool ubxWaitAck(Stream &port, uint8_t cls, uint8_t id, uint32_t timeoutMs) {
+  // Motif attendu : B5 62 05 (00|01) 02 00 cls id ; seul l'octet 3 varie
+  const uint8_t pattern[8] = {0xB5, 0x62, UBX_CLASS_ACK, 0x00, 0x02, 0x00, cls, id};
+  uint8_t pos = 0;
+  bool ack = false;
+  uint32_t t0 = millis();
+  while (millis() - t0 < timeoutMs) {
+    if (port.available() <= 0) {
+      delay(1);
+      continue;
+    }
+    uint8_t b = port.read();
+    if (pos == 3) {
+      if (b > 0x01) { pos = 0; continue; }
+      ack = (b == 0x01);
+      pos++;
+    } else if (b == pattern[pos]) {
+      pos++;
+    } else {
+      pos = (b == 0xB5) ? 1 : 0;
+      continue;
+    }
+    if (pos == sizeof(pattern)) return ack;
+  }
+  return false;
+}
+
+static bool setMessageRate(HardwareSerial &port, uint8_t nmeaId, uint8_t rate) {
+  const uint8_t payload[3] = {0xF0, nmeaId, rate}; // classe 0xF0 = NMEA standard
+  ubxSend(port, UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+  return ubxWaitAck(port, UBX_CLASS_CFG, UBX_CFG_MSG, 300);
+}
+
+bool ubxProbe(HardwareSerial &port, uint32_t baud, uint32_t timeoutMs) {
+  port.updateBaudRate(baud);
+  while (port.available() > 0) port.read(); // octets reçus à un autre débit
+  // Deux essais : le premier en-tête peut tomber au milieu d'une trame NMEA
+  for (uint8_t attempt = 0; attempt < 2; attempt++) {
+    ubxSend(port, UBX_CLASS_CFG, UBX_CFG_RATE, nullptr, 0);
+    if (ubxWaitAck(port, UBX_CLASS_CFG, UBX_CFG_RATE, timeoutMs)) return true;
+  }
+  return false;
+}
+
+bool ubxConfigure(HardwareSerial &port, uint32_t baud, uint16_t measRateMs) {
+  uint32_t fromBaud = port.baudRate();
+  // CFG-PRT UART1 : 8N1, entrées et sorties UBX+NMEA. L'ACK part déjà au nouveau débit.
+  uint8_t prt[20] = {0};
+  prt[0] = 1;                                  // portID = UART1
+  prt[4] = 0xD0; prt[5] = 0x08;                // mode : 8 bits, sans parité, 1 stop
+  prt[8] = baud & 0xFF; prt[9] = (baud >> 8) & 0xFF; prt[10] = (baud >> 16) & 0xFF; prt[11] = baud >> 24;
+  prt[12] = 0x03;                              // inProtoMask : UBX | NMEA
+  prt[14] = 0x03;                              // outProtoMask : UBX | NMEA
+  ubxSend(port, UBX_CLASS_CFG, UBX_CFG_PRT, prt, sizeof(prt));
+  port.flush();
+  delay(50);
+  port.updateBaudRate(baud);
+
+  // Trames NMEA inutiles pour la station : GLL, GSA, GSV, VTG
+  const uint8_t unused[] = {0x01, 0x02, 0x03, 0x05};
+  uint8_t acks = 0;
+  for (uint8_t id : unused) acks += setMessageRate(port, id, 0);
+  if (acks == 0) {
+    Serial.printf("[GPS] ERREUR: pas de reponse UBX a %u bauds, retour a %u\n", (unsigned)baud,
+                  (unsigned)fromBaud);
+    port.updateBaudRate(fromBaud);
+    return false;
+  }
+
+  uint8_t rate[6] = {(uint8_t)(measRateMs & 0xFF), (uint8_t)(measRateMs >> 8), 1, 0, 1, 0}; // navRate 1, temps GPS
+  ubxSend(port, UBX_CLASS_CFG, UBX_CFG_RATE, rate, sizeof(rate));
+  bool rateOk = ubxWaitAck(port, UBX_CLASS_CFG, UBX_CFG_RATE, 300);
+
+  Serial.printf("[GPS] UBX: %u bauds, %u/%u trames coupees, periode %u ms %s\n", (unsigned)baud, acks,
+                (unsigned)sizeof(unused), measRateMs, rateOk ? "OK" : "refusee");
+  return true;
+}
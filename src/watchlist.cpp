@@ -0,0 +1,195 @@
+// watchlist.cpp
+#include "config.h"
+#include "watchlist.h"
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <ArduinoJson.h>
+#include "weather.h"
+#include "weather_policy.h"
+#include "data_fields.h"
+#include "http_reader.h"
+#include "arena.h"
+
+#define WATCH_HOST "api.openweathermap.org"
+#define WATCH_MAX_CONNECTIONS 3 // reprises après une fermeture du serveur en cours de pipeline
+
+static const WatchLocation locations[] = WATCHLIST_LOCATIONS;
+#define LOCATION_COUNT (sizeof(locations) / sizeof(locations[0]))
+static_assert(LOCATION_COUNT <= WATCHLIST_MAX, "WATCHLIST_LOCATIONS : au plus WATCHLIST_MAX lieux");
+
+static WatchEntry entries[LOCATION_COUNT];
+static WatchlistStats stats = {};
+
+uint8_t watchlistCount() {
+  return LOCATION_COUNT;
+}
+
+const WatchLocation &watchlistLocation(uint8_t i) {
+  return locations[i];
+}
+
+const WatchEntry &watchlistEntry(uint8_t i) {
+  return entries[i];
+}
+
+const WatchlistStats &watchlistStats() {
+  return stats;
+}
+
+// Filtre construit une fois : météo actuelle et présence d'alertes seulement
+static const JsonDocument &watchFilter() {
+  static JsonDocument filter;
+  if (filter.isNull()) {
+    JsonObject current = filter["current"].to<JsonObject>();
+    current["temp"] = true;
+    current["humidity"] = true;
+    current["wind_speed"] = true;
+    current["weather"][0]["id"] = true;
+    filter["alerts"][0]["event"] = true;
+  }
+  return filter;
+}
+
+// Requête complète d'un lieu en une seule écriture (un enregistrement TLS) ; false si rien n'est parti
+static bool sendRequest(Client &client, uint8_t i, bool last) {
+  char req[320];
+  int n = snprintf(req, sizeof(req),
+                   "GET /data/2.5/onecall?lat=%.4f&lon=%.4f&exclude=minutely,hourly,daily&units=metric&appid=%s "
+                   "HTTP/1.1\r\nHost: " WATCH_HOST "\r\nConnection: %s\r\n\r\n",
+                   locations[i].lat, locations[i].lon, TOKEN_OPENWEATHER, last ? "close" : "keep-alive");
+  return client.write((const uint8_t *)req, min<size_t>(n, sizeof(req) - 1)) > 0;
+}
+
+// Refus du fournisseur (quota ou clé) : inutile de lire ou renvoyer les requêtes suivantes
+static bool refused(int status) {
+  return status == 429 || status == 401 || status == 403;
+}
+
+static bool parseEntry(HttpResponseReader &http, WatchEntry &e) {
+  if (http.status() != 200) return false;
+#if WEATHER_ARENA
+  fetchArena.reset();
+  ArenaJsonAllocator jsonAllocator(fetchArena);
+  JsonDocument doc(&jsonAllocator);
+#else
+  JsonDocument doc;
+#endif
+  if (deserializeJson(doc, http, DeserializationOption::Filter(watchFilter()))) return false;
+  JsonObject current = doc["current"];
+  if (current.isNull()) return false;
+  e.temp = tempToCenti(current["temp"] | NAN);
+  e.code = current["weather"][0]["id"] | 0;
+  e.humidity = current["humidity"] | 0;
+  e.wind = (uint16_t)lroundf((current["wind_speed"] | 0.0f) * 100.0f);
+  e.flags = WATCH_VALID | (doc["alerts"].size() ? WATCH_ALERT : 0);
+  e.fetchedMs = millis();
+  return true;
+}
+
+// maxRequests : plafond des requêtes du cycle, renvois compris (part du budget disponible)
+static void runCycle(uint16_t maxRequests) {
+  uint8_t n = LOCATION_COUNT;
+  uint8_t next = 0; // prochain lieu dont la réponse est attendue
+  uint8_t ok = 0;
+  uint16_t sent = 0;     // requêtes écrites, renvois après fermeture compris (décomptées du budget)
+  int refusedStatus = 0; // 429, 401 ou 403 reçu pendant le cycle
+  uint32_t t0 = millis();
+  stats.connections = 0;
+  stats.connectMs = 0;
+
+  while (next < n && !refusedStatus && stats.connections < WATCH_MAX_CONNECTIONS && sent < maxRequests) {
+    WiFiClientSecure client;
+    client.setInsecure(); // pas de vérification du certificat (comme la météo principale)
+    uint32_t c0 = millis();
+    if (!client.connect(WATCH_HOST, 443)) {
+      Serial.println("[SURV] ERREUR: connexion a " WATCH_HOST " impossible");
+      break;
+    }
+    if (stats.connections++ == 0) stats.connectMs = millis() - c0;
+
+    // Les requêtes restantes partent avant la lecture de la première réponse, dans la
+    // limite du plafond : un renvoi après fermeture ne dépasse jamais la part du budget
+    uint8_t end = min<uint16_t>(n, next + (maxRequests - sent));
+    for (uint8_t i = next; i < end; i++) {
+      if (sendRequest(client, i, i == end - 1)) sent++;
+    }
+
+    // Réponses dans l'ordre des requêtes ; chaque corps est lu jusqu'à sa fin exacte
+    while (next < end) {
+      HttpResponseReader http(client);
+      if (!http.readHeaders()) break;
+      WatchEntry e = entries[next];
+      bool good = parseEntry(http, e);
+      while (http.read() >= 0) {} // reste du corps (erreur API, blancs)
+      if (!http.finished()) break; // corps tronqué : la suite du flux est désynchronisée
+      if (good) {
+        entries[next] = e;
+        ok++;
+      } else {
+        Serial.printf("[SURV] %s : HTTP %d, reponse ignoree\n", locations[next].name, http.status());
+        if (refused(http.status())) refusedStatus = http.status();
+      }
+      stats.readyMs[next++] = millis() - t0;
+      if (refusedStatus) break;
+      if (!http.keepAlive()) break; // le serveur ferme : requêtes suivantes renvoyées
+    }
+    client.stop();
+  }
+#if WEATHER_ARENA
+  fetchArena.reset();
+#endif
+
+  stats.cycles++;
+  stats.lastCount = n;
+  stats.lastReceived = next;
+  stats.lastOk = ok;
+  stats.lastSent = sent;
+  stats.totalMs = millis() - t0;
+  stats.lastCycleMs = millis();
+  weatherPolicyCount(sent, sent - ok, refusedStatus);
+}
+
+void watchlistJob() {
+  if (LOCATION_COUNT == 0 || WiFi.status() != WL_CONNECTED) return;
+  uint32_t holdMs = weatherPolicyHoldMs();
+  if (holdMs) {
+    Serial.printf("[SURV] Requetes suspendues (quota ou cle) encore %lu min : cycle reporte\n",
+                  (unsigned long)(holdMs / 60000 + 1));
+    return;
+  }
+  // Au moins une requête par lieu ; les renvois après fermeture puisent dans le reste de la
+  // part disponible, jamais dans la réserve de la météo principale
+  uint16_t spare = weatherPolicySpare();
+  if (spare < LOCATION_COUNT) {
+    Serial.printf("[SURV] Budget insuffisant hors reserve de la meteo principale (%u disponibles) : "
+                  "cycle reporte\n", spare);
+    return;
+  }
+  runCycle(spare);
+  dataChanged(DATA_WATCH);
+  watchlistReport();
+}
+
+void watchlistReport() {
+  if (!stats.cycles) {
+    Serial.println("[SURV] Aucun cycle de recuperation");
+    return;
+  }
+  // Courbe : durée écoulée quand k lieux sont reçus
+  char curve[WATCHLIST_MAX * 14];
+  size_t len = 0;
+  curve[0] = '\0';
+  for (uint8_t k = 0; k < stats.lastReceived && len < sizeof(curve); k++) {
+    len += snprintf(curve + len, sizeof(curve) - len, "%s%u:%lu", k ? " " : "", k + 1,
+                    (unsigned long)stats.readyMs[k]);
+  }
+  // Pipeline : coût marginal d'un lieu ; sans pipeline : une connexion et un aller-retour par lieu
+  uint32_t perExtra = stats.lastReceived > 1
+                        ? (stats.readyMs[stats.lastReceived - 1] - stats.readyMs[0]) / (stats.lastReceived - 1)
+                        : 0;
+  uint32_t sequentialMs = stats.lastReceived ? stats.readyMs[0] * stats.lastCount : 0;
+  Serial.printf("[SURV] %u lieux (%u requetes, %u recus, %u valides) en %lu ms, %u connexion(s) TLS (premiere %lu ms) ; "
+                "recus apres [%s] ms ; +%lu ms par lieu, ~%lu ms avec une connexion par lieu\n",
+                stats.lastCount, stats.lastSent, stats.lastReceived, stats.lastOk, (unsigned long)stats.totalMs, stats.connections,
+                (unsigned long)stats.connectMs, curve, (unsigned long)perExtra, (unsigned long)sequentialMs);
+}
@@ -2,6 +2,10 @@
 #include "config.h"
 #include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
+#include "http_reader.h"
+#include "gzip_stream.h"
+#include "arena.h"
+#include <esp_heap_caps.h>
 
 // Convertit un code OpenWeather (int) en code d'icône (String)
 String weatherCodeToIcon(int code) {
@@ -15,9 +19,62 @@ String weatherCodeToIcon(int code) {
     return "clouds"; // par défaut
 }
 
+static int lastHttpStatus = 0;
+
+int weatherLastHttpStatus() {
+    return lastHttpStatus;
+}
+
+#if WEATHER_ARENA
+// --- [NEW FEATURE] Allocations d'une récupération dans l'arène, libérées d'un coup en sortie ---
+// (déclarée en premier dans la fonction : détruite après le document et le flux gzip)
+class FetchArenaScope {
+public:
+    FetchArenaScope() { fetchArena.reset(); }
+    ~FetchArenaScope() {
+        if (fetchArena.ready()) {
+            Serial.printf("[ARENA] Recuperation: %u/%u o utilises (max %u depuis le boot), %u refus, bloc max du tas %u o\n",
+                          (unsigned)fetchArena.peak(), (unsigned)fetchArena.capacity(), (unsigned)fetchArena.highWater(),
+                          (unsigned)fetchArena.failures(), (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        }
+        fetchArena.reset();
+    }
+};
+
+// Seuls les champs lus ci-dessous sont conservés : le document tient dans l'arène en RAM interne
+static void buildWeatherFilter(JsonDocument &filter) {
+    JsonObject current = filter["current"].to<JsonObject>();
+    current["temp"] = true;
+    current["humidity"] = true;
+    current["wind_speed"] = true;
+    current["weather"][0]["id"] = true;
+    JsonObject day = filter["daily"][0].to<JsonObject>();
+    day["dt"] = true;
+    day["temp"] = true; // day, night, min, max (et les autres moments, peu nombreux)
+    day["weather"][0]["id"] = true;
+    day["pop"] = true;
+    day["wind_speed"] = true;
+    JsonObject hour = filter["hourly"][0].to<JsonObject>();
+    hour["dt"] = true;
+    hour["temp"] = true;
+    hour["weather"][0]["id"] = true;
+    hour["pop"] = true;
+    hour["wind_speed"] = true;
+    JsonObject alert = filter["alerts"][0].to<JsonObject>();
+    alert["event"] = true;
+    alert["description"] = true;
+    alert["severity"] = true;
+}
+#endif
+
 // --- [DEBUG] Ajout de logs détaillés pour le débogage ---
 bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
+#if WEATHER_ARENA
+    FetchArenaScope arenaScope;
+    ArenaJsonAllocator jsonAllocator(fetchArena);
+#endif
     Serial.println("\n=== [METEO] Debut recuperation donnees OpenWeather ===");
+    lastHttpStatus = 0;
 
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("[METEO] ERREUR: WiFi non connecte");
@@ -28,17 +85,15 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
     Serial.println(WiFi.localIP());
 
     // --- [DEBUG] Vérifier la clé API ---
-    String apiKey = String(TOKEN_OPENWEATHER);
-    Serial.print("[METEO] Cle API (longueur): ");
-    Serial.print(apiKey.length());
-    Serial.println(" caracteres");
-    if (apiKey.length() < 10 || apiKey.startsWith("YOUR_")) {
+    const char *apiKey = TOKEN_OPENWEATHER;
+    size_t keyLen = strlen(apiKey);
+    Serial.printf("[METEO] Cle API (longueur): %u caracteres\n", (unsigned)keyLen);
+    if (keyLen < 10 || strncmp(apiKey, "YOUR_", 5) == 0) {
         Serial.println("[METEO] ERREUR: Cle API non configuree !");
         Serial.println("[METEO] Editez include/secrets.h avec votre vraie cle OpenWeather");
         return false;
     }
-    Serial.print("[METEO] Cle API (debut): ");
-    Serial.println(apiKey.substring(0, min(8, (int)apiKey.length())) + "...");
+    Serial.printf("[METEO] Cle API (debut): %.8s...\n", apiKey);
 
     Serial.print("[METEO] Connexion a api.openweathermap.org:443...");
     WiFiClientSecure client;
@@ -50,51 +105,55 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
     }
     Serial.println(" OK");
 
-    String url = "/data/2.5/onecall?lat=" + String(lat, 6) +
-                 "&lon=" + String(lon, 6) +
-                 "&units=metric&lang=fr&appid=" + apiKey;
+    // Requête dans un tampon de pile (pas de String temporaires sur le tas)
+    char url[192];
+    snprintf(url, sizeof(url), "/data/2.5/onecall?lat=%.6f&lon=%.6f&exclude=minutely&units=metric&lang=fr&appid=%s",
+             lat, lon, apiKey); // minutely (60 entrées) inutilisé
 
     Serial.print("[METEO] URL: ");
     Serial.println(url);
 
-    client.println("GET " + url + " HTTP/1.1");
+    client.printf("GET %s HTTP/1.1\r\n", url);
     client.println("Host: api.openweathermap.org");
+    // --- [NEW FEATURE] Corps compressé si la fenêtre de décompression (32 Ko) tient en mémoire ---
+    // (dans l'arène quand elle a la place en plus du document JSON, sinon sur le tas)
+#if WEATHER_ARENA
+    bool gzipInArena = fetchArena.capacity() >= GZIP_WORK_BYTES + WEATHER_ARENA_JSON_BYTES;
+#else
+    bool gzipInArena = false;
+#endif
+    bool gzipAllowed = gzipInArena ||
+                       heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) >= GZIP_WORK_BYTES + WEATHER_GZIP_HEAP_MARGIN;
+    if (gzipAllowed) client.println("Accept-Encoding: gzip");
     client.println("Connection: close");
     client.println();
 
-    // Lire la réponse HTTP
+    // --- [REWRITE] Réponse lue en flux : en-têtes dans des tampons fixes, corps borné ---
     Serial.println("[METEO] Lecture reponse HTTP...");
-    String payload;
-    int httpCode = 0;
-    bool headersRead = false;
-
-    // --- [DEBUG] Lire le code de statut HTTP et tous les headers ---
-    while (client.connected() || client.available()) {
-        String line = client.readStringUntil('\n');
-        if (line.startsWith("HTTP/1.1")) {
-            httpCode = line.substring(9, 12).toInt();
-            Serial.print("[METEO] Code HTTP: ");
-            Serial.print(httpCode);
-            Serial.print(" - ");
-            Serial.println(line);
-        }
-        // Afficher les headers importants pour debug
-        if (line.startsWith("Content-Type:") || line.startsWith("Content-Length:")) {
-            Serial.print("[METEO] Header: ");
-            Serial.println(line);
-        }
-        if (line == "\r") {
-            headersRead = true;
-            break; // fin des headers
-        }
-    }
-
-    if (!headersRead) {
+    uint32_t requestUs = micros();
+    HttpResponseReader http(client);
+    if (!http.readHeaders()) {
         Serial.println("[METEO] ERREUR: Headers HTTP non recus");
         return false;
     }
+    int httpCode = http.status();
+    lastHttpStatus = httpCode;
+    if (http.chunked()) {
+        Serial.printf("[METEO] Code HTTP: %d, Content-Type: %s, chunked\n", httpCode, http.contentType());
+    } else {
+        Serial.printf("[METEO] Code HTTP: %d, Content-Type: %s, Content-Length: %ld\n", httpCode, http.contentType(),
+                      (long)http.contentLength());
+    }
 
     // --- [DEBUG] Vérifier le code HTTP ---
+    if (httpCode != 200) {
+        // Début du corps d'erreur de l'API (cod/message) pour le diagnostic
+        char errBody[160];
+        size_t n = http.readBytes(errBody, sizeof(errBody) - 1);
+        errBody[n] = '\0';
+        Serial.print("[METEO] Erreur API: ");
+        Serial.println(errBody);
+    }
     if (httpCode == 401) {
         Serial.println("[METEO] ERREUR 401: Cle API invalide ou expiree");
         Serial.println("[METEO] Verifiez TOKEN_OPENWEATHER dans secrets.h");
@@ -117,50 +176,26 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
         return false;
     }
 
-    // Lire le corps de la réponse
-    while (client.available()) {
-        payload += client.readString();
-    }
-
-    if (payload.isEmpty()) {
-        Serial.println("[METEO] ERREUR: Reponse vide");
-        return false;
-    }
-
-    Serial.print("[METEO] Payload recu (");
-    Serial.print(payload.length());
-    Serial.println(" octets)");
-
-    // --- [DEBUG] Afficher les premiers caractères pour debug ---
-    Serial.print("[METEO] Premiers 500 caracteres: ");
-    Serial.println(payload.substring(0, min(500, (int)payload.length())));
-
-    // --- [DEBUG] Vérifier si c'est une erreur JSON de l'API ---
-    if (payload.indexOf("\"cod\":") >= 0 && payload.indexOf("\"message\":") >= 0) {
-        Serial.println("[METEO] *** ATTENTION: Reponse contient un message d'erreur API ***");
-
-        // Extraire le code et le message d'erreur
-        int codPos = payload.indexOf("\"cod\":");
-        int msgPos = payload.indexOf("\"message\":");
-        if (codPos >= 0 && msgPos >= 0) {
-            String errorSnippet = payload.substring(codPos, min(msgPos + 100, (int)payload.length()));
-            Serial.print("[METEO] Erreur API: ");
-            Serial.println(errorSnippet);
-        }
-
-        // Cas courants d'erreurs
-        if (payload.indexOf("401") >= 0 || payload.indexOf("Invalid API key") >= 0) {
-            Serial.println("[METEO] >>> Cle API invalide ou expiree <<<");
-        }
-        if (payload.indexOf("subscription") >= 0 || payload.indexOf("upgrade") >= 0) {
-            Serial.println("[METEO] >>> Abonnement requis pour cette API <<<");
-        }
-    }
-
     // --- [FIX] ArduinoJson 7 : utilisation de JsonDocument au lieu de DynamicJsonDocument ---
+    // Analyse directement depuis le flux : pas de copie du corps en String
     Serial.println("[METEO] Parsing JSON...");
+    bool gzip = strstr(http.contentEncoding(), "gzip") != nullptr;
+    GzipInflateStream gz(http); // fenêtre allouée seulement si la réponse est compressée
+    if (gzip && !gz.begin(gzipInArena ? &fetchArena : nullptr)) {
+        Serial.println("[METEO] ERREUR: decompression gzip impossible (memoire ou en-tete)");
+        return false;
+    }
+    Stream &body = gzip ? (Stream &)gz : (Stream &)http;
+#if WEATHER_ARENA
+    JsonDocument filter(&jsonAllocator);
+    buildWeatherFilter(filter);
+    JsonDocument doc(&jsonAllocator);
+    DeserializationError err = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+#else
     JsonDocument doc;
-    DeserializationError err = deserializeJson(doc, payload);
+    DeserializationError err = deserializeJson(doc, body);
+#endif
+    uint32_t parseEndUs = micros();
     if (err) {
         Serial.print("[METEO] ERREUR JSON: ");
         Serial.println(err.c_str());
@@ -169,7 +204,29 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
         return false;
     }
     Serial.println("[METEO] Parsing JSON - OK");
+    // L'analyse s'arrête à l'accolade finale : fin du flux et pied de page (CRC32, taille)
+    if (gzip && !gz.finish()) {
+        Serial.println("[METEO] ERREUR: flux gzip incomplet, CRC32 ou taille differents");
+        return false;
+    }
+    // Temps mort : dernier octet reçu -> fin de l'analyse (l'analyse suit la réception)
+    Serial.printf("[HTTP] %u o en %lu ms (en-tetes %lu us), dernier octet -> fin d'analyse %ld us%s\n",
+                  (unsigned)http.bodyBytes(), (unsigned long)((parseEndUs - requestUs) / 1000),
+                  (unsigned long)http.headersUs(),
+                  (long)(parseEndUs - http.lastByteUs()), http.chunked() ? " (chunked)" : "");
+    // Octets reçus, JSON équivalent non compressé et énergie radio estimée de la récupération
+    uint32_t fetchMs = (parseEndUs - requestUs) / 1000;
+    uint32_t jsonBytes = gzip ? gz.outBytes() : http.bodyBytes();
+    Serial.printf("[METEO] Transfert: %u o recus%s, %u o de JSON (-%u%%), %lu ms, ~%lu mJ radio\n",
+                  (unsigned)http.bodyBytes(), gzip ? " (gzip, CRC32 OK)" : "",
+                  (unsigned)jsonBytes, (unsigned)(jsonBytes ? 100 - (uint64_t)http.bodyBytes() * 100 / jsonBytes : 0),
+                  (unsigned long)fetchMs, (unsigned long)(fetchMs * WIFI_ACTIVE_MW / 1000));
+
+    return weatherFromJson(doc, out);
+}
 
+// Réponse OneCall déjà analysée -> WeatherData (récupération et bancs d'essai)
+bool weatherFromJson(JsonDocument &doc, WeatherData &out) {
     // --- [FIX] Extraction et validation des données actuelles ---
     Serial.println("[METEO] Extraction donnees actuelles...");
 
@@ -220,9 +277,9 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
         if (!alerts.isNull() && alerts.size() > 0) {
             JsonObject a0 = alerts[0];
             out.now.hasAlert = true;
-            out.now.alertTitle = !a0["event"].isNull() ? a0["event"].as<String>() : "Alerte météo";
-            out.now.alertDesc  = !a0["description"].isNull() ? a0["description"].as<String>() : "Voir détails";
-            out.now.alertSeverity = !a0["severity"].isNull() ? a0["severity"].as<String>() : "unknown";
+            strlcpy(out.now.alertTitle, a0["event"] | "Alerte météo", sizeof(out.now.alertTitle));
+            strlcpy(out.now.alertDesc, a0["description"] | "Voir détails", sizeof(out.now.alertDesc));
+            strlcpy(out.now.alertSeverity, a0["severity"] | "unknown", sizeof(out.now.alertSeverity));
             Serial.print("[METEO] Alerte detectee: ");
             Serial.println(out.now.alertTitle);
         }
@@ -230,29 +287,44 @@ bool fetchWeatherOpenWeather(float lat, float lon, WeatherData &out) {
         Serial.println("[METEO] Pas d'alerte meteo");
     }
 
-    // Prévisions (exemple sur 3 jours)
-    out.forecast.clear();
+    // --- [REWRITE] Prévisions journalières (8 j) et horaires (48 h) en virgule fixe ---
+    out.daily.count = 0;
     if (!doc["daily"].isNull()) {
         JsonArray daily = doc["daily"].as<JsonArray>();
-        Serial.print("[METEO] Nombre de previsions: ");
+        Serial.print("[METEO] Nombre de previsions journalieres: ");
         Serial.println(daily.size());
-        for (int i = 0; i < 3 && i < daily.size(); i++) {
-            JsonObject d = daily[i];
-            Forecast f;
-            f.tempDay = d["temp"]["day"].as<float>();
-            f.tempNight = d["temp"]["night"].as<float>();
-            f.conditionCode = d["weather"][0]["id"].as<int>();
-            out.forecast.push_back(f);
-            Serial.print("[METEO] Jour ");
-            Serial.print(i+1);
-            Serial.print(": ");
-            Serial.print(f.tempDay);
-            Serial.print("C / ");
-            Serial.print(f.tempNight);
-            Serial.println("C");
+        DailyForecast &df = out.daily;
+        df.startTime = daily[0]["dt"].as<uint32_t>();
+        for (JsonObject d : daily) {
+            if (df.count >= FORECAST_DAILY_MAX) break;
+            uint8_t i = df.count++;
+            df.tempDay[i] = tempToCenti(d["temp"]["day"] | NAN);
+            df.tempNight[i] = tempToCenti(d["temp"]["night"] | NAN);
+            df.tempMin[i] = tempToCenti(d["temp"]["min"] | NAN);
+            df.tempMax[i] = tempToCenti(d["temp"]["max"] | NAN);
+            df.code[i] = d["weather"][0]["id"] | 0;
+            df.pop[i] = (uint8_t)lroundf((d["pop"] | 0.0f) * 100.0f);
+            df.wind[i] = (uint16_t)lroundf((d["wind_speed"] | 0.0f) * 100.0f);
         }
     }
 
+    out.hourly.count = 0;
+    if (!doc["hourly"].isNull()) {
+        JsonArray hourly = doc["hourly"].as<JsonArray>();
+        HourlyForecast &hf = out.hourly;
+        hf.startTime = hourly[0]["dt"].as<uint32_t>();
+        for (JsonObject h : hourly) {
+            if (hf.count >= FORECAST_HOURLY_MAX) break;
+            uint8_t i = hf.count++;
+            hf.temp[i] = tempToCenti(h["temp"] | NAN);
+            hf.code[i] = h["weather"][0]["id"] | 0;
+            hf.pop[i] = (uint8_t)lroundf((h["pop"] | 0.0f) * 100.0f);
+            hf.wind[i] = (uint16_t)lroundf((h["wind_speed"] | 0.0f) * 100.0f);
+        }
+        Serial.print("[METEO] Previsions horaires: ");
+        Serial.println(hf.count);
+    }
+
     Serial.println("[METEO] === Meteo mise a jour avec succes ===\n");
     return true;
 }
@@ -272,22 +344,37 @@ String formatWeatherBrief(const WeatherData &data) {
 
     // Alerte météo
     if (data.now.hasAlert) {
-        msg += "⚠️ " + data.now.alertTitle + "\n";
-        msg += data.now.alertDesc + "\n";
-        msg += "Niveau: " + data.now.alertSeverity + "\n";
+        msg += "⚠️ " + String(data.now.alertTitle) + "\n";
+        msg += String(data.now.alertDesc) + "\n";
+        msg += "Niveau: " + String(data.now.alertSeverity) + "\n";
     }
 
-    // Prévisions
-    if (!data.forecast.empty()) {
+    // Prévisions (3 premiers jours)
+    if (data.daily.count > 0) {
         msg += "📅 Prévisions:\n";
-        for (size_t i = 0; i < data.forecast.size(); i++) {
-            const Forecast &f = data.forecast[i];
+        for (uint8_t i = 0; i < data.daily.count && i < 3; i++) {
             msg += "Jour " + String(i+1) + ": ";
-            msg += String(f.tempDay, 1) + "°C / ";
-            msg += String(f.tempNight, 1) + "°C, code ";
-            msg += String(f.conditionCode) + "\n";
+            msg += String(centiToTemp(data.daily.tempDay[i]), 1) + "°C / ";
+            msg += String(centiToTemp(data.daily.tempNight[i]), 1) + "°C, code ";
+            msg += String(data.daily.code[i]) + ", pluie ";
+            msg += String(data.daily.pop[i]) + "%\n";
         }
     }
 
     return msg;
 }
+
+
+// Empreinte mémoire des prévisions : virgule fixe (SoA) vs mêmes champs en float dans des std::vector
+void weatherLogFootprint() {
+    struct FloatHourly { float temp; int code; float pop; float wind; };
+    struct FloatDaily { float tempDay, tempNight, tempMin, tempMax; int code; float pop; float wind; };
+    const size_t vectorHeader = 3 * sizeof(void *);
+    const size_t heapHeader = 8; // en-tête d'allocation du tas ESP-IDF (approx.)
+    const size_t floatHourly = vectorHeader + heapHeader + FORECAST_HOURLY_MAX * sizeof(FloatHourly);
+    const size_t floatDaily = vectorHeader + heapHeader + FORECAST_DAILY_MAX * sizeof(FloatDaily);
+    Serial.printf("[METEO] Empreinte previsions (virgule fixe): horaire %u o + journalier %u o, 0 allocation/fetch\n",
+                  (unsigned)sizeof(HourlyForecast), (unsigned)sizeof(DailyForecast));
+    Serial.printf("[METEO] Empreinte previsions (float+vector): horaire %u o + journalier %u o, 2 allocations/fetch\n",
+                  (unsigned)floatHourly, (unsigned)floatDaily);
+}
@@ -0,0 +1,91 @@
+// weather_cache.cpp
+#include "config.h"
+#include "weather_cache.h"
+
+struct CacheEntry {
+  bool used;
+  WeatherCell cell;
+  uint32_t fetchedMs; // millis() de la récupération
+  uint32_t lastUse;   // horloge logique LRU (pas de millis() : deux accès dans la même ms)
+  WeatherData data;
+};
+
+static CacheEntry entries[WEATHER_CACHE_SLOTS];
+static uint32_t useClock = 0;
+static WeatherCacheStats stats = {};
+
+WeatherCell weatherCellOf(double lat, double lon) {
+  return WeatherCell{(int32_t)floor(lat / WEATHER_CELL_DEG), (int32_t)floor(lon / WEATHER_CELL_DEG)};
+}
+
+void weatherCellCenter(const WeatherCell &cell, float &lat, float &lon) {
+  lat = (float)((cell.latIdx + 0.5) * WEATHER_CELL_DEG);
+  lon = (float)((cell.lonIdx + 0.5) * WEATHER_CELL_DEG);
+}
+
+static bool fresh(const CacheEntry &e) {
+  return e.used && millis() - e.fetchedMs < WEATHER_CACHE_MAX_AGE_MS;
+}
+
+static CacheEntry *find(const WeatherCell &cell) {
+  for (CacheEntry &e : entries) {
+    if (e.used && e.cell == cell) return &e;
+  }
+  return nullptr;
+}
+
+bool weatherCacheLookup(const WeatherCell &cell, WeatherData &out, uint32_t &ageMs) {
+  stats.lookups++;
+  CacheEntry *e = find(cell);
+  if (!e || !fresh(*e)) return false;
+  stats.hits++;
+  e->lastUse = ++useClock;
+  ageMs = millis() - e->fetchedMs;
+  out = e->data;
+  Serial.printf("[METEO] Cache: maille (%ld, %ld) servie, donnees de %lu min\n", (long)cell.latIdx,
+                (long)cell.lonIdx, (unsigned long)(ageMs / 60000));
+  return true;
+}
+
+bool weatherCacheHas(const WeatherCell &cell) {
+  CacheEntry *e = find(cell);
+  return e && fresh(*e);
+}
+
+void weatherCacheStore(const WeatherCell &cell, const WeatherData &data) {
+  CacheEntry *slot = find(cell);
+  if (!slot) {
+    // Emplacement libre, sinon la maille la moins récemment utilisée
+    for (CacheEntry &e : entries) {
+      if (!e.used) {
+        slot = &e;
+        break;
+      }
+      if (!slot || e.lastUse < slot->lastUse) slot = &e;
+    }
+    if (slot->used) stats.evictions++;
+  }
+  slot->used = true;
+  slot->cell = cell;
+  slot->fetchedMs = millis();
+  slot->lastUse = ++useClock;
+  slot->data = data;
+  stats.stores++;
+}
+
+const WeatherCacheStats &weatherCacheStats() {
+  return stats;
+}
+
+void weatherCacheReport() {
+  uint8_t cells = 0, freshCells = 0;
+  for (const CacheEntry &e : entries) {
+    if (e.used) cells++;
+    if (fresh(e)) freshCells++;
+  }
+  Serial.printf("[METEO] Cache mailles (%.3f deg): %lu/%lu changements de maille servis (%u%%), "
+                "%lu requetes evitees, %u/%u mailles dont %u recentes, %lu remplacees\n",
+                (double)WEATHER_CELL_DEG, (unsigned long)stats.hits, (unsigned long)stats.lookups,
+                (unsigned)(stats.lookups ? stats.hits * 100 / stats.lookups : 0), (unsigned long)stats.hits, cells,
+                (unsigned)WEATHER_CACHE_SLOTS, freshCells, (unsigned long)stats.evictions);
+}
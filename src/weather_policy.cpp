@@ -0,0 +1,250 @@
+// weather_policy.cpp
+#include "config.h"
+#include "weather_policy.h"
+#include <time.h>
+
+#define WEATHER_BUDGET_MAGIC 0x57425544 // "WBUD"
+#define DAY_MS 86400000UL
+
+// Compteurs du jour en mémoire RTC : une mise à jour OTA ou un plantage ne remet pas le budget à zéro
+struct BudgetState {
+  uint32_t magic;
+  int32_t dayKey;    // année x 1000 + jour de l'année, -1 si l'heure était inconnue
+  uint16_t calls;
+  uint16_t failures;
+};
+RTC_DATA_ATTR static BudgetState budget;
+
+static WeatherPolicyStats stats = {0, 0, 0, 0, 0, "", 0, 0.0f};
+static uint32_t windowStartMs = 0; // sans heure valide : fenêtre de 24 h depuis le démarrage
+static float lastTemp = NAN;
+static bool alertActive = false;
+static double fetchLat = 0, fetchLon = 0;
+static bool moveSignaled = false;
+static uint32_t holdStartMs = 0, holdMs = 0; // suspension après 429 ou clé refusée (toutes requêtes)
+
+static bool localTime(struct tm &tmv) {
+  time_t now = time(nullptr);
+  localtime_r(&now, &tmv);
+  return tmv.tm_year + 1900 >= 2020;
+}
+
+// Changement de jour : bilan de la veille puis remise à zéro des compteurs
+static void rollDay() {
+  struct tm tmv;
+  bool reset = false;
+  if (localTime(tmv)) {
+    int32_t key = (tmv.tm_year + 1900) * 1000 + tmv.tm_yday;
+    if (budget.dayKey < 0) {
+      budget.dayKey = key; // heure obtenue (NTP) : les requêtes déjà faites comptent pour aujourd'hui
+    } else if (key != budget.dayKey) {
+      budget.dayKey = key;
+      reset = true;
+    }
+  } else if (millis() - windowStartMs >= DAY_MS) {
+    windowStartMs = millis();
+    reset = true;
+  }
+  if (reset) {
+    Serial.printf("[METEO] Bilan 24 h: %u requetes (%u echecs) / budget %u\n", budget.calls, budget.failures,
+                  (unsigned)WEATHER_DAILY_BUDGET);
+    budget.calls = 0;
+    budget.failures = 0;
+  }
+  stats.callsToday = budget.calls;
+  stats.failuresToday = budget.failures;
+}
+
+static uint32_t msUntilDayEnd() {
+  struct tm tmv;
+  if (localTime(tmv)) {
+    uint32_t elapsedS = tmv.tm_hour * 3600 + tmv.tm_min * 60 + tmv.tm_sec;
+    return (86400 - elapsedS) * 1000UL;
+  }
+  return DAY_MS - (millis() - windowStartMs);
+}
+
+// Réponse de refus du fournisseur : plus aucune requête (principale ou surveillance) pendant un temps
+static void holdFor(int httpStatus) {
+  uint32_t ms;
+  if (httpStatus == 429) ms = WEATHER_QUOTA_BACKOFF_MS;
+  else if (httpStatus == 401 || httpStatus == 403) ms = WEATHER_BACKOFF_MAX_MS;
+  else return;
+  if (weatherPolicyHoldMs() >= ms) return;
+  holdStartMs = millis();
+  holdMs = ms;
+  Serial.printf("[METEO] HTTP %d : requetes suspendues %lu min\n", httpStatus, (unsigned long)(ms / 60000));
+}
+
+// Requêtes prévues pour la récupération principale d'ici la fin du jour (intervalle minimal)
+static uint16_t mainReserve() {
+  return (msUntilDayEnd() + WEATHER_INTERVAL_MIN_MS - 1) / WEATHER_INTERVAL_MIN_MS;
+}
+
+void weatherPolicyBegin() {
+  if (budget.magic != WEATHER_BUDGET_MAGIC) budget = {WEATHER_BUDGET_MAGIC, -1, 0, 0};
+  windowStartMs = millis();
+  rollDay();
+  Serial.printf("[METEO] Budget: %u/%u requetes deja utilisees aujourd'hui\n", budget.calls,
+                (unsigned)WEATHER_DAILY_BUDGET);
+}
+
+bool weatherPolicyAllow() {
+  rollDay();
+  return budget.calls < WEATHER_DAILY_BUDGET;
+}
+
+uint32_t weatherPolicyBudgetWaitMs() {
+  return weatherPolicyAllow() ? 0 : msUntilDayEnd() + 60000;
+}
+
+uint16_t weatherPolicyRemaining() {
+  rollDay();
+  return budget.calls < WEATHER_DAILY_BUDGET ? WEATHER_DAILY_BUDGET - budget.calls : 0;
+}
+
+uint16_t weatherPolicySpare() {
+  uint16_t remaining = weatherPolicyRemaining();
+  uint16_t reserve = mainReserve();
+  return remaining > reserve ? remaining - reserve : 0;
+}
+
+uint32_t weatherPolicyHoldMs() {
+  uint32_t elapsed = millis() - holdStartMs;
+  return elapsed < holdMs ? holdMs - elapsed : 0;
+}
+
+void weatherPolicyCount(uint16_t calls, uint16_t failures, int refusedStatus) {
+  rollDay();
+  budget.calls += calls;
+  budget.failures += failures;
+  stats.callsToday = budget.calls;
+  stats.failuresToday = budget.failures;
+  holdFor(refusedStatus);
+}
+
+void weatherPolicyRecord(bool ok, int httpStatus, float lat, float lon, float tempNow, bool hasAlert) {
+  rollDay();
+  // Sans réponse (WiFi, TLS, clé absente, en-têtes perdus) la requête n'a pas été décomptée
+  // par le fournisseur : échec pour le délai, mais pas sur le budget
+  if (httpStatus != 0) budget.calls++;
+  stats.callsToday = budget.calls;
+  stats.lastHttpStatus = httpStatus;
+  if (!ok) {
+    budget.failures++;
+    stats.failuresToday = budget.failures;
+    if (stats.consecutiveFailures < 255) stats.consecutiveFailures++;
+    holdFor(httpStatus);
+    return;
+  }
+  holdMs = 0; // réponse valide : la clé et le quota sont de nouveau bons
+  uint32_t now = millis();
+  // Vitesse d'évolution de la température extérieure entre deux récupérations
+  if (stats.lastOkMs && !isnan(lastTemp) && !isnan(tempNow) && now - stats.lastOkMs >= 300000) {
+    stats.tempRateCph = (tempNow - lastTemp) * 3600000.0f / (now - stats.lastOkMs);
+  }
+  lastTemp = tempNow;
+  stats.lastOkMs = now;
+  stats.consecutiveFailures = 0;
+  alertActive = hasAlert;
+  fetchLat = lat;
+  fetchLon = lon;
+  moveSignaled = false;
+}
+
+void weatherPolicyServed(float lat, float lon, uint32_t ageMs, float tempNow, bool hasAlert) {
+  // Âge et point de référence des données affichées, sans compter de requête
+  stats.lastOkMs = millis() - ageMs;
+  lastTemp = tempNow;
+  alertActive = hasAlert;
+  fetchLat = lat;
+  fetchLon = lon;
+  moveSignaled = false;
+}
+
+uint32_t weatherPolicyNextDelayMs(float pressureTrendHpa3h) {
+  uint32_t delayMs;
+  const char *reason;
+  if (stats.consecutiveFailures) {
+    uint8_t shift = min<uint8_t>(stats.consecutiveFailures - 1, 16);
+    uint32_t base = min<uint32_t>((uint32_t)WEATHER_BACKOFF_MIN_MS << shift, WEATHER_BACKOFF_MAX_MS);
+    reason = "echec";
+    if (stats.lastHttpStatus == 429) {
+      base = max<uint32_t>(base, WEATHER_QUOTA_BACKOFF_MS);
+      reason = "quota API (429)";
+    } else if (stats.lastHttpStatus == 401 || stats.lastHttpStatus == 403) {
+      base = WEATHER_BACKOFF_MAX_MS;
+      reason = "cle API refusee";
+    }
+    // Gigue : moitié fixe, moitié aléatoire
+    delayMs = base / 2 + esp_random() % (base / 2 + 1);
+  } else {
+    // 0 = temps stable (intervalle max) .. 1 = évolution rapide (intervalle min)
+    float activity = fabsf(stats.tempRateCph) / WEATHER_FAST_DT_CPH;
+    if (!isnan(pressureTrendHpa3h)) activity = max(activity, fabsf(pressureTrendHpa3h) / WEATHER_FAST_DP_HPA3H);
+    activity = min(activity, 1.0f);
+    delayMs = WEATHER_INTERVAL_MAX_MS - (uint32_t)((WEATHER_INTERVAL_MAX_MS - WEATHER_INTERVAL_MIN_MS) * activity);
+    reason = (activity >= 0.5f) ? "evolution rapide" : "temps stable";
+    if (alertActive && delayMs > WEATHER_INTERVAL_MIN_MS) {
+      delayMs = WEATHER_INTERVAL_MIN_MS;
+      reason = "alerte en cours";
+    }
+  }
+
+  // Suspension en cours (429 ou clé refusée, y compris sur une requête des lieux surveillés)
+  uint32_t hold = weatherPolicyHoldMs();
+  if (hold > delayMs) {
+    delayMs = hold;
+    reason = "suspension";
+  }
+
+  // Le budget restant est réparti sur la fin de la journée
+  rollDay();
+  uint16_t remaining = (budget.calls < WEATHER_DAILY_BUDGET) ? WEATHER_DAILY_BUDGET - budget.calls : 0;
+  uint32_t untilEnd = msUntilDayEnd();
+  if (remaining == 0) {
+    delayMs = untilEnd + 60000;
+    reason = "budget epuise";
+  } else if (untilEnd / remaining > delayMs) {
+    delayMs = untilEnd / remaining;
+    reason = "budget";
+  }
+  stats.intervalMs = delayMs;
+  stats.reason = reason;
+  Serial.printf("[METEO] Prochaine recuperation dans %lu min (%s)\n", (unsigned long)(delayMs / 60000), reason);
+  return delayMs;
+}
+
+bool weatherPolicyMoved(double lat, double lon) {
+  if (!stats.lastOkMs || moveSignaled) return false;
+  // Approximation équirectangulaire : suffisante à l'échelle de quelques kilomètres
+  double dy = (lat - fetchLat) * 111.32;
+  double dx = (lon - fetchLon) * 111.32 * cos(fetchLat * M_PI / 180.0);
+  if (dx * dx + dy * dy < (double)WEATHER_MOVE_KM * WEATHER_MOVE_KM) return false;
+  moveSignaled = true;
+  Serial.printf("[METEO] Station deplacee de %.1f km : recuperation anticipee\n", sqrt(dx * dx + dy * dy));
+  return true;
+}
+
+uint32_t weatherPolicyAgeMs() {
+  return stats.lastOkMs ? millis() - stats.lastOkMs : UINT32_MAX;
+}
+
+const WeatherPolicyStats &weatherPolicyStats() {
+  rollDay();
+  return stats;
+}
+
+void weatherPolicyReport() {
+  rollDay();
+  // Projection : requêtes déjà faites + rythme actuel jusqu'à la fin de la journée
+  uint32_t projected = budget.calls + (stats.intervalMs ? msUntilDayEnd() / stats.intervalMs : 0);
+  uint32_t ageMs = weatherPolicyAgeMs();
+  char age[16];
+  if (ageMs == UINT32_MAX) strcpy(age, "aucune");
+  else snprintf(age, sizeof(age), "%lu min", (unsigned long)(ageMs / 60000));
+  Serial.printf("[METEO] Requetes: %u aujourd'hui (%u echecs) / budget %u, projection %lu/jour, "
+                "intervalle %lu min (%s), donnees: %s\n",
+                budget.calls, budget.failures, (unsigned)WEATHER_DAILY_BUDGET, (unsigned long)projected,
+                (unsigned long)(stats.intervalMs / 60000), stats.reason, age);
+}
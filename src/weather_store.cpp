@@ -0,0 +1,85 @@
+// weather_store.cpp
+#include "weather_store.h"
+#include <atomic>
+
+#define WEATHER_WRITER_WAIT_MS 100
+
+static WeatherData buffers[2];
+static std::atomic<uint8_t> publishedIdx{0};
+static std::atomic<uint16_t> readers[2];
+static std::atomic<uint32_t> publishGeneration{0};
+static int8_t writingIdx = -1;
+
+static void initData(WeatherData &d) {
+  d.now.tempNow = NAN;
+  d.now.conditionCode = 0;
+  d.now.humidity = NAN;
+  d.now.wind = NAN;
+  d.now.tempMin = NAN;
+  d.now.tempMax = NAN;
+  d.now.hasAlert = false;
+  d.now.alertTitle[0] = '\0';
+  d.now.alertDesc[0] = '\0';
+  d.now.alertSeverity[0] = '\0';
+  d.hourly.count = 0;
+  d.daily.count = 0;
+}
+
+void weatherStoreBegin() {
+  initData(buffers[0]);
+  initData(buffers[1]);
+}
+
+WeatherSnapshot::WeatherSnapshot() {
+  // Réserver le tampon publié puis vérifier qu'il l'est toujours : sinon le producteur
+  // a pu le reprendre entre-temps, recommencer avec le nouveau.
+  // Génération lue en premier : au pire elle est plus ancienne que les données (rendu en trop)
+  while (true) {
+    _generation = publishGeneration.load(std::memory_order_acquire);
+    uint8_t i = publishedIdx.load(std::memory_order_acquire);
+    readers[i].fetch_add(1, std::memory_order_acq_rel);
+    if (publishedIdx.load(std::memory_order_acquire) == i) {
+      _idx = i;
+      break;
+    }
+    readers[i].fetch_sub(1, std::memory_order_release);
+  }
+  _data = &buffers[_idx];
+}
+
+WeatherSnapshot::~WeatherSnapshot() {
+  readers[_idx].fetch_sub(1, std::memory_order_release);
+}
+
+WeatherData *weatherBeginUpdate() {
+  uint8_t current = publishedIdx.load(std::memory_order_acquire);
+  uint8_t target = 1 - current;
+  // Un lecteur de l'avant-dernière publication peut encore tenir ce tampon
+  uint32_t t0 = millis();
+  while (readers[target].load(std::memory_order_acquire) != 0) {
+    if (millis() - t0 > WEATHER_WRITER_WAIT_MS) {
+      Serial.println("[METEO] ERREUR: tampon meteo encore lu, mise a jour reportee");
+      return nullptr;
+    }
+    delay(1);
+  }
+  // Les champs absents de la prochaine réponse gardent leur dernière valeur
+  buffers[target] = buffers[current];
+  writingIdx = target;
+  return &buffers[target];
+}
+
+void weatherPublish() {
+  if (writingIdx < 0) return;
+  publishedIdx.store((uint8_t)writingIdx, std::memory_order_release);
+  publishGeneration.fetch_add(1, std::memory_order_acq_rel);
+  writingIdx = -1;
+}
+
+void weatherAbortUpdate() {
+  writingIdx = -1;
+}
+
+uint32_t weatherGeneration() {
+  return publishGeneration.load(std::memory_order_acquire);
+}
@@ -0,0 +1,173 @@
+// widgets.cpp
+#include "widgets.h"
+#include "font_renderer.h"
+#include "ui_icons.h"
+
+// Page actuellement à l'écran et contenu affiché par chacun de ses widgets
+static const Widget *screenItems = nullptr;
+static uint32_t shownHash[WIDGETS_PER_PAGE_MAX]; // pages bornées à la compilation (widgetPage)
+static uint32_t shownGen[DATA_FIELD_COUNT];
+static WidgetStats stats = {};
+
+static const FontSpec *u8g2Font(uint8_t font) {
+  switch (font) {
+    case WFONT_TITLE: return &FONT_TITLE;
+    case WFONT_TEMP_BIG: return &FONT_TEMP_BIG;
+    default: return nullptr;
+  }
+}
+
+// Empreinte FNV-1a du contenu : deux contenus identiques donnent le même tracé
+static uint32_t contentHash(const WidgetContent &c) {
+  uint32_t h = 2166136261u;
+  for (const char *p = c.text; *p; p++) h = (h ^ (uint8_t)*p) * 16777619u;
+  h = (h ^ c.color) * 16777619u;
+  return (h ^ c.level) * 16777619u;
+}
+
+static void fillContent(const Widget &w, WidgetContent &c) {
+  c.text[0] = '\0';
+  c.color = w.color;
+  c.level = 0;
+  if (w.fill) w.fill(c);
+}
+
+static void drawText(Adafruit_GFX &g, const Widget &w, const char *text, uint16_t color) {
+  if (!*text) return;
+  const FontSpec *font = u8g2Font(w.font);
+  if (font) {
+    fontDrawText(g, w.x, w.y + w.textDy, text, *font, color, WIDGET_BG);
+    return;
+  }
+  g.setTextSize(w.font);
+  g.setTextColor(color);
+  g.setCursor(w.x, w.y + w.textDy);
+  g.print(text);
+}
+
+// Trace un widget avec un contenu déjà calculé ; renvoie les pixels envoyés
+static uint32_t drawWidget(Adafruit_GFX &g, const Widget &w, const WidgetContent &c, bool partial) {
+  uint32_t box = (uint32_t)w.w * w.h;
+  if (w.kind == WIDGET_CUSTOM) {
+    uint32_t px = w.draw ? w.draw(g, w, partial) : 0;
+    return px ? px : box;
+  }
+  if (partial) widgetClear(g, w);
+  switch (w.kind) {
+    case WIDGET_LABEL: drawText(g, w, w.text, w.color); break;
+    case WIDGET_VALUE: drawText(g, w, c.text, c.color); break;
+    case WIDGET_ICON:
+      if (c.text[0]) drawWeatherIcon(g, w.x, w.y, String(c.text));
+      break;
+    case WIDGET_BAR: {
+      g.drawRect(w.x, w.y, w.w, w.h, 0x4208);
+      int16_t fillW = (int32_t)(w.w - 2) * min<uint8_t>(c.level, 100) / 100;
+      if (fillW > 0) g.fillRect(w.x + 1, w.y + 1, fillW, w.h - 2, c.color);
+      break;
+    }
+    default: break;
+  }
+  return box;
+}
+
+void widgetClear(Adafruit_GFX &g, const Widget &w) {
+  g.fillRect(w.x, w.y, w.w, w.h, WIDGET_BG);
+}
+
+// Tracé complet ; record : mémorise le contenu affiché (écran)
+static void drawAll(Adafruit_GFX &g, const WidgetPage &page, bool record) {
+  g.fillRect(0, 0, TFT_WIDTH, TFT_HEIGHT, WIDGET_BG);
+  WidgetContent c;
+  for (uint8_t i = 0; i < page.count; i++) {
+    const Widget &w = page.items[i];
+    fillContent(w, c);
+    if (record) shownHash[i] = contentHash(c);
+    drawWidget(g, w, c, false);
+  }
+}
+
+void widgetsDraw(Adafruit_GFX &g, const WidgetPage &page) {
+  drawAll(g, page, false);
+}
+
+uint32_t widgetsDeps(const WidgetPage &page) {
+  uint32_t deps = 0;
+  for (uint8_t i = 0; i < page.count; i++) deps |= page.items[i].deps;
+  return deps;
+}
+
+static void recordGenerations() {
+  for (uint8_t f = 0; f < DATA_FIELD_COUNT; f++) shownGen[f] = dataGeneration((DataField)f);
+}
+
+void widgetsScreenSync(const WidgetPage &page) {
+  screenItems = page.items;
+  recordGenerations();
+  WidgetContent c;
+  for (uint8_t i = 0; i < page.count; i++) {
+    fillContent(page.items[i], c);
+    shownHash[i] = contentHash(c);
+  }
+}
+
+void widgetsScreenInvalidate() {
+  screenItems = nullptr;
+}
+
+void widgetsUpdate(Adafruit_GFX &screen, const WidgetPage &page) {
+  if (page.items != screenItems) {
+    // Générations relevées avant le tracé : un changement pendant celui-ci sera repris
+    screenItems = page.items;
+    recordGenerations();
+    drawAll(screen, page, true);
+    stats.fullPaints++;
+    return;
+  }
+
+  uint32_t changed = 0;
+  for (uint8_t f = 0; f < DATA_FIELD_COUNT; f++) {
+    uint32_t gen = dataGeneration((DataField)f);
+    if (gen != shownGen[f]) {
+      shownGen[f] = gen;
+      changed |= DATA_MASK(f);
+    }
+  }
+  stats.updates++;
+  stats.lastInvalidated = 0;
+  stats.lastRedrawn = 0;
+  stats.lastPixels = 0;
+  if (!changed) return;
+
+  WidgetContent c;
+  for (uint8_t i = 0; i < page.count; i++) {
+    const Widget &w = page.items[i];
+    if (!(w.deps & changed)) continue;
+    stats.lastInvalidated++;
+    if (w.kind != WIDGET_CUSTOM) {
+      fillContent(w, c);
+      uint32_t h = contentHash(c);
+      if (h == shownHash[i]) continue; // donnée changée, affichage identique (arrondi)
+      shownHash[i] = h;
+    }
+    stats.lastPixels += drawWidget(screen, w, c, true);
+    stats.lastRedrawn++;
+  }
+  stats.invalidated += stats.lastInvalidated;
+  stats.redrawn += stats.lastRedrawn;
+  stats.pixels += stats.lastPixels;
+}
+
+const WidgetStats &widgetsStats() {
+  return stats;
+}
+
+void widgetsReport() {
+  uint32_t screenPx = (uint32_t)TFT_WIDTH * TFT_HEIGHT;
+  Serial.printf("[WIDGET] %lu mises a jour, %lu traces complets : %lu widgets invalides, %lu retraces, "
+                "moy %lu px/maj (%u.%u%% de l'ecran)\n",
+                (unsigned long)stats.updates, (unsigned long)stats.fullPaints, (unsigned long)stats.invalidated,
+                (unsigned long)stats.redrawn, (unsigned long)(stats.updates ? stats.pixels / stats.updates : 0),
+                (unsigned)(stats.updates ? (uint64_t)stats.pixels * 100 / stats.updates / screenPx : 0),
+                (unsigned)(stats.updates ? (uint64_t)stats.pixels * 1000 / stats.updates / screenPx % 10 : 0));
+  stats = {};
+}
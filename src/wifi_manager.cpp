@@ -0,0 +1,209 @@
+// wifi_manager.cpp
+#include "config.h"
+#include "wifi_manager.h"
+#include <WiFi.h>
+#include <WiFiMulti.h>
+#include <Preferences.h>
+#include "data_fields.h"
+
+#define WIFI_CACHE_MAGIC 0x57494643 // "WIFC"
+
+struct WifiCache {
+  uint32_t magic;
+  uint8_t ssidIdx;     // 0 = WIFI_SSID1, 1 = WIFI_SSID2
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip, gateway, mask, dns;
+  uint32_t leaseEpoch; // heure d'obtention du bail (0 si heure inconnue)
+};
+
+static const char *const SSIDS[2] = {WIFI_SSID1, WIFI_SSID2};
+static const char *const PASSES[2] = {WIFI_PASS1, WIFI_PASS2};
+
+// La mémoire RTC survit aux redémarrages logiciels, la NVS aux coupures d'alimentation
+RTC_DATA_ATTR static WifiCache rtcCache;
+static WiFiMulti wifiMulti;
+static WifiLinkStats stats = {0, 0, 0, 0, 0, 0, 0, false};
+
+static bool connecting = false;
+static bool usingLease = false;   // IP statique reprise du bail en cache
+static uint32_t attemptStartMs = 0;
+static uint32_t backoffMs = WIFI_BACKOFF_MIN_MS;
+static uint8_t attempt = 0;
+static uint32_t leaseConnectedMs = 0;
+
+static bool cacheValid() {
+  return rtcCache.magic == WIFI_CACHE_MAGIC && rtcCache.ssidIdx < 2 && rtcCache.channel > 0;
+}
+
+static void loadCache() {
+  if (cacheValid()) return;
+  Preferences prefs;
+  if (!prefs.begin("wifi", true)) return;
+  if (prefs.getBytesLength("cache") == sizeof(WifiCache)) prefs.getBytes("cache", &rtcCache, sizeof(WifiCache));
+  prefs.end();
+}
+
+// Mémorise l'AP courant ; la NVS n'est réécrite que si l'AP ou le bail change
+static void saveCache() {
+  WifiCache c = {};
+  c.magic = WIFI_CACHE_MAGIC;
+  c.ssidIdx = (WiFi.SSID() == SSIDS[1]) ? 1 : 0;
+  memcpy(c.bssid, WiFi.BSSID(), 6);
+  c.channel = WiFi.channel();
+  c.ip = WiFi.localIP();
+  c.gateway = WiFi.gatewayIP();
+  c.mask = WiFi.subnetMask();
+  c.dns = WiFi.dnsIP();
+  time_t now = time(nullptr);
+  c.leaseEpoch = (now > 1600000000) ? (uint32_t)now : 0;
+  if (usingLease) c.leaseEpoch = rtcCache.leaseEpoch; // bail repris, pas renouvelé
+
+  bool same = cacheValid() && c.ssidIdx == rtcCache.ssidIdx && !memcmp(c.bssid, rtcCache.bssid, 6) &&
+              c.channel == rtcCache.channel && c.ip == rtcCache.ip;
+  rtcCache = c;
+  if (same) return;
+  Preferences prefs;
+  if (prefs.begin("wifi", false)) {
+    prefs.putBytes("cache", &rtcCache, sizeof(WifiCache));
+    prefs.end();
+  }
+}
+
+// Le bail n'est repris que si l'heure permet d'en vérifier l'âge
+static bool leaseUsable() {
+  time_t now = time(nullptr);
+  return WIFI_LEASE_REUSE_S > 0 && rtcCache.leaseEpoch > 0 && now > (time_t)rtcCache.leaseEpoch &&
+         (uint32_t)(now - rtcCache.leaseEpoch) < WIFI_LEASE_REUSE_S && rtcCache.ip != 0;
+}
+
+static void useDhcp() {
+  WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+  usingLease = false;
+}
+
+// Tentative directe sur l'AP en cache (pas de balayage)
+static void beginCached() {
+  usingLease = leaseUsable();
+  if (usingLease) {
+    WiFi.config(IPAddress(rtcCache.ip), IPAddress(rtcCache.gateway), IPAddress(rtcCache.mask), IPAddress(rtcCache.dns));
+  } else {
+    useDhcp();
+  }
+  WiFi.begin(SSIDS[rtcCache.ssidIdx], PASSES[rtcCache.ssidIdx], rtcCache.channel, rtcCache.bssid);
+}
+
+static void onConnected(bool fast) {
+  uint32_t now = millis();
+  stats.lastConnectMs = now - attemptStartMs;
+  stats.fastPath = fast;
+  if (stats.outageStartMs) {
+    stats.lastOutageMs = now - stats.outageStartMs;
+    stats.outageStartMs = 0;
+  }
+  connecting = false;
+  attempt = 0;
+  backoffMs = WIFI_BACKOFF_MIN_MS;
+  leaseConnectedMs = now;
+  saveCache();
+  dataChanged(DATA_WIFI);
+  Serial.printf("[WIFI] Connecte a %s (canal %d, %s%s) en %lu ms", WiFi.SSID().c_str(), (int)WiFi.channel(),
+                fast ? "cache" : "balayage", usingLease ? ", bail repris" : "", (unsigned long)stats.lastConnectMs);
+  if (stats.lastOutageMs) Serial.printf(", coupure %lu s", (unsigned long)(stats.lastOutageMs / 1000));
+  Serial.println();
+}
+
+bool wifiBegin() {
+  WiFi.mode(WIFI_STA);
+  WiFi.persistent(false);     // le cache est géré ici, pas par la NVS du pilote
+  WiFi.setAutoReconnect(false); // reprise pilotée par wifiJob (délai exponentiel)
+  wifiMulti.addAP(WIFI_SSID1, WIFI_PASS1);
+  wifiMulti.addAP(WIFI_SSID2, WIFI_PASS2);
+  loadCache();
+
+  attemptStartMs = millis();
+  if (cacheValid()) {
+    beginCached();
+    while (WiFi.status() != WL_CONNECTED && millis() - attemptStartMs < WIFI_FAST_TIMEOUT_MS) delay(20);
+    if (WiFi.status() == WL_CONNECTED) {
+      onConnected(true);
+      return true;
+    }
+    Serial.println("[WIFI] AP en cache injoignable, balayage complet");
+    WiFi.disconnect();
+    useDhcp();
+  }
+
+  for (int i = 0; i < 15; i++) {
+    wifiMulti.run();
+    if (WiFi.status() == WL_CONNECTED) break;
+    delay(400);
+  }
+  if (WiFi.status() == WL_CONNECTED) {
+    onConnected(false);
+    return true;
+  }
+  stats.outageStartMs = attemptStartMs ? attemptStartMs : 1;
+  stats.nextAttemptMs = millis() + backoffMs;
+  return false;
+}
+
+void wifiJob() {
+  uint32_t now = millis();
+
+  if (WiFi.status() == WL_CONNECTED) {
+    if (connecting) onConnected(attempt <= WIFI_CACHED_ATTEMPTS && cacheValid());
+
+    // Qualité du lien : moyenne glissante (1/8) et minimum
+    int8_t rssi = WiFi.RSSI();
+    stats.rssiAvg = stats.rssiAvg ? (int8_t)((stats.rssiAvg * 7 + rssi) / 8) : rssi;
+    if (stats.rssiMin == 0 || rssi < stats.rssiMin) stats.rssiMin = rssi;
+
+    // Un bail repris n'est jamais renouvelé : repasser en DHCP avant son expiration
+    // (la reconnexion immédiate vise l'AP en cache, en DHCP)
+    if (usingLease && now - leaseConnectedMs > WIFI_LEASE_REUSE_S * 1000UL) {
+      Serial.println("[WIFI] Renouvellement DHCP du bail repris");
+      rtcCache.leaseEpoch = 0;
+      WiFi.disconnect();
+    }
+    return;
+  }
+
+  if (!stats.outageStartMs) {
+    // Début de coupure : première tentative immédiate
+    stats.outageStartMs = now ? now : 1;
+    stats.disconnects++;
+    stats.nextAttemptMs = now;
+    connecting = false;
+    dataChanged(DATA_WIFI);
+    Serial.println("[WIFI] Lien perdu");
+  }
+
+  if (connecting) {
+    if (now - attemptStartMs < WIFI_ATTEMPT_TIMEOUT_MS) return;
+    connecting = false;
+    WiFi.disconnect();
+    stats.nextAttemptMs = now + backoffMs;
+    Serial.printf("[WIFI] Echec tentative %u, prochaine dans %lu s\n", attempt, (unsigned long)(backoffMs / 1000));
+    backoffMs = min<uint32_t>(backoffMs * 2, WIFI_BACKOFF_MAX_MS);
+    dataChanged(DATA_WIFI);
+    return;
+  }
+
+  if ((int32_t)(now - stats.nextAttemptMs) < 0) return;
+  // Les premières tentatives visent l'AP en cache, ensuite le pilote balaie lui-même
+  attempt++;
+  attemptStartMs = now;
+  connecting = true;
+  if (cacheValid() && attempt <= WIFI_CACHED_ATTEMPTS) {
+    beginCached();
+  } else {
+    useDhcp();
+    uint8_t idx = attempt % 2;
+    WiFi.begin(SSIDS[idx], PASSES[idx]);
+  }
+}
+
+const WifiLinkStats &wifiStats() {
+  return stats;
+}
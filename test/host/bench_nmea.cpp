@@ -0,0 +1,77 @@
+// bench_nmea.cpp
+// Débit de l'analyseur GGA/RMC sur les journaux de fixtures/gps (rejoués jusqu'à ~16 Mo),
+// et de TinyGPSPlus sur les mêmes octets si ses sources sont fournies (make bench TINYGPS=...)
+#include <Arduino.h>
+#include <chrono>
+#include <dirent.h>
+#include <string>
+#include "nmea.h"
+#ifdef HAVE_TINYGPS
+#include <TinyGPS++.h>
+#endif
+
+static const char *FIXTURE_DIR = "fixtures/gps";
+static const size_t TARGET_BYTES = 16u << 20;
+
+static std::string loadFixtures() {
+  std::string all;
+  if (DIR *d = opendir(FIXTURE_DIR)) {
+    while (dirent *e = readdir(d)) {
+      std::string n = e->d_name;
+      if (n.size() <= 5 || n.compare(n.size() - 5, 5, ".nmea") != 0) continue;
+      if (FILE *fp = fopen((std::string(FIXTURE_DIR) + "/" + n).c_str(), "rb")) {
+        char buf[4096];
+        size_t got;
+        while ((got = fread(buf, 1, sizeof(buf), fp)) > 0) all.append(buf, got);
+        fclose(fp);
+      }
+    }
+    closedir(d);
+  }
+  return all;
+}
+
+template <typename Fn> static double secondsFor(Fn fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void report(const char *name, size_t bytes, double s, unsigned long fixes) {
+  printf("%-12s %8.1f Mo/s  %6.2f ns/octet  %lu positions\n", name, bytes / s / 1e6, s * 1e9 / bytes, fixes);
+}
+
+int main() {
+  std::string log = loadFixtures();
+  if (log.empty()) {
+    printf("bench_nmea : aucun journal dans %s\n", FIXTURE_DIR);
+    return 1;
+  }
+  size_t rounds = TARGET_BYTES / log.size() + 1;
+  size_t bytes = rounds * log.size();
+  printf("bench_nmea : %zu octets de journaux x %zu = %zu octets\n", log.size(), rounds, bytes);
+
+  unsigned long fixes = 0;
+  NmeaParser parser;
+  double s = secondsFor([&] {
+    for (size_t r = 0; r < rounds; r++) {
+      for (char c : log) fixes += parser.encode(c);
+    }
+  });
+  report("NmeaParser", bytes, s, fixes);
+
+#ifdef HAVE_TINYGPS
+  TinyGPSPlus tiny;
+  fixes = 0;
+  s = secondsFor([&] {
+    for (size_t r = 0; r < rounds; r++) {
+      for (char c : log) {
+        // lat() lit la position et remet isUpdated() à false, comme gpsLoop le ferait
+        if (tiny.encode(c) && tiny.location.isUpdated() && tiny.location.lat() != 0.0) fixes++;
+      }
+    }
+  });
+  report("TinyGPSPlus", bytes, s, fixes);
+#endif
+  return 0;
+}
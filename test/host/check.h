@@ -0,0 +1,44 @@
+// check.h (tests hôte)
+#pragma once
+#include <cstdio>
+
+// Vérifications sans framework : chaque échec est affiché avec sa ligne, le programme
+// continue, et checkSummary() donne le code de sortie (0 si tout est passé)
+static int checkCount = 0;
+static int checkFailures = 0;
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    checkCount++;                                                            \
+    if (!(cond)) {                                                           \
+      checkFailures++;                                                       \
+      printf("ECHEC %s:%d : %s\n", __FILE__, __LINE__, #cond);               \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                       \
+  do {                                                                       \
+    checkCount++;                                                            \
+    long long va_ = (long long)(a), vb_ = (long long)(b);                    \
+    if (va_ != vb_) {                                                        \
+      checkFailures++;                                                       \
+      printf("ECHEC %s:%d : %s = %lld, attendu %lld\n", __FILE__, __LINE__, \
+             #a, va_, vb_);                                                  \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                                \
+  do {                                                                       \
+    checkCount++;                                                            \
+    double va_ = (double)(a), vb_ = (double)(b);                             \
+    if (!(va_ - vb_ <= (tol) && vb_ - va_ <= (tol))) {                       \
+      checkFailures++;                                                       \
+      printf("ECHEC %s:%d : %s = %g, attendu %g (+/- %g)\n", __FILE__,      \
+             __LINE__, #a, va_, vb_, (double)(tol));                         \
+    }                                                                        \
+  } while (0)
+
+static int checkSummary(const char *name) {
+  printf("%s : %d verifications, %d echec(s)\n", name, checkCount, checkFailures);
+  return checkFailures ? 1 : 0;
+}
@@ -0,0 +1,2 @@
+// Adafruit_SPIDevice.h (hôte) : inclus par Adafruit_GFX.h, sans usage ici
+#pragma once
@@ -0,0 +1,42 @@
+// Adafruit_SPITFT.h (hôte)
+#pragma once
+#include <Adafruit_GFX.h>
+#include <vector>
+
+// Écran SPI simulé sur le vrai Adafruit_GFX : la mémoire du contrôleur (ST7789 :
+// 240 x 320 lignes) reçoit les pixels de la fenêtre d'adressage, et chaque transaction,
+// commande et pixel est compté. Le temps de transfert SPI est ajouté à l'horloge
+// virtuelle (voir hal/display.cpp), les durées de rendu restent donc réalistes.
+class Adafruit_SPITFT : public Adafruit_GFX {
+public:
+  Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst = -1);
+  ~Adafruit_SPITFT();
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void startWrite() override;
+  void endWrite() override;
+  void writePixel(int16_t x, int16_t y, uint16_t color) override;
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void invertDisplay(bool i) override;
+
+  virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+  void writePixels(uint16_t *colors, uint32_t len, bool block = true, bool bigEndian = false);
+  void writeColor(uint16_t color, uint32_t len);
+  void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = nullptr, uint8_t numDataBytes = 0);
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+protected:
+  // Fenêtre d'adressage en coordonnées de la mémoire et position d'écriture
+  int16_t _winX = 0, _winY = 0, _winW = 0, _winH = 0;
+  uint32_t _winPos = 0;
+  uint8_t _depth = 0;
+  void memWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+  void memFill(uint16_t color, uint32_t len);
+};
@@ -0,0 +1,13 @@
+// Adafruit_ST7789.h (hôte)
+#pragma once
+#include <Adafruit_ST77xx.h>
+
+class Adafruit_ST7789 : public Adafruit_ST77xx {
+public:
+  Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst) : Adafruit_ST77xx(240, 320, cs, dc, rst) {}
+  void init(uint16_t width, uint16_t height, uint8_t spiMode = 0);
+  void setRotation(uint8_t m) override;
+
+private:
+  uint16_t _panelW = 240, _panelH = 320;
+};
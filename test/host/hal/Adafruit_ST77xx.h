@@ -0,0 +1,35 @@
+// Adafruit_ST77xx.h (hôte)
+#pragma once
+#include <Adafruit_SPITFT.h>
+
+#define ST77XX_NOP 0x00
+#define ST77XX_SWRESET 0x01
+#define ST77XX_SLPIN 0x10
+#define ST77XX_SLPOUT 0x11
+#define ST77XX_INVOFF 0x20
+#define ST77XX_INVON 0x21
+#define ST77XX_DISPOFF 0x28
+#define ST77XX_DISPON 0x29
+#define ST77XX_CASET 0x2A
+#define ST77XX_RASET 0x2B
+#define ST77XX_RAMWR 0x2C
+#define ST77XX_MADCTL 0x36
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+class Adafruit_ST77xx : public Adafruit_SPITFT {
+public:
+  Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst = -1)
+    : Adafruit_SPITFT(w, h, cs, dc, rst) {}
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+  void enableDisplay(bool enable) { sendCommand(enable ? ST77XX_DISPON : ST77XX_DISPOFF); }
+  void enableSleep(bool enable) { sendCommand(enable ? ST77XX_SLPIN : ST77XX_SLPOUT); }
+};
@@ -0,0 +1,2 @@
+// Adafruit_Sensor.h (hôte) : interface unifiée non utilisée par le firmware
+#pragma once
@@ -0,0 +1,615 @@
+// Arduino.cpp (hôte)
+#include "hal.h"
+#include <cctype>
+#include <strings.h>
+#include <sys/time.h>
+
+// --- Horloge virtuelle ---
+static uint64_t realUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static const uint64_t bootRealUs = realUs();
+static uint64_t skippedUs = 0;
+static time_t epochAtBoot = 0;
+static time_t ntpEpochAtBoot = 0;
+static uint32_t millisCostUs = 0;
+static const uint32_t kBusyWaitCalls = 10000;
+static uint32_t millisStreak = 0; // appels à millis() depuis la dernière avance de l'horloge
+static void (*busyWaitFn)() = nullptr;
+static void (*advanceFn)(uint64_t) = nullptr;
+
+uint64_t halMicros64() {
+  return realUs() - bootRealUs + skippedUs;
+}
+
+void halAdvanceUs(uint64_t us) {
+  static bool advancing = false;
+  if (advanceFn && !advancing) {
+    uint64_t until = halMicros64() + us;
+    advancing = true;
+    advanceFn(until);
+    advancing = false;
+    uint64_t now = halMicros64();
+    us = until > now ? until - now : 0;
+  }
+  skippedUs += us;
+  millisStreak = 0;
+}
+
+uint64_t halSkippedUs() {
+  return skippedUs;
+}
+
+void halSetEpoch(time_t epoch) {
+  epochAtBoot = epoch;
+}
+
+void halSetNtpEpoch(time_t epoch) {
+  ntpEpochAtBoot = epoch;
+}
+
+void halSetMillisCostUs(uint32_t us) {
+  millisCostUs = us;
+}
+
+void halOnBusyWait(void (*fn)()) {
+  busyWaitFn = fn;
+  millisStreak = 0;
+}
+
+void halOnAdvance(void (*fn)(uint64_t)) {
+  advanceFn = fn;
+}
+
+unsigned long millis() {
+  skippedUs += millisCostUs;
+  if (++millisStreak == kBusyWaitCalls && busyWaitFn) busyWaitFn();
+  return (unsigned long)(uint32_t)(halMicros64() / 1000); // 32 bits comme sur la cible
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)halMicros64();
+}
+
+void delay(uint32_t ms) {
+  halAdvanceUs((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  halAdvanceUs(us);
+}
+
+void yield() {}
+
+// Heure murale : 0 (1970, « heure inconnue ») tant que halSetEpoch n'a pas été appelé,
+// comme la cible avant la synchronisation NTP
+extern "C" time_t time(time_t *out) noexcept {
+  time_t now = epochAtBoot + (time_t)(halMicros64() / 1000000);
+  if (out) *out = now;
+  return now;
+}
+
+extern "C" int gettimeofday(struct timeval *tv, void *) noexcept {
+  uint64_t us = halMicros64();
+  tv->tv_sec = epochAtBoot + (time_t)(us / 1000000);
+  tv->tv_usec = (suseconds_t)(us % 1000000);
+  return 0;
+}
+
+// Fuseau appliqué tout de suite ; l'heure NTP (halSetNtpEpoch) arrive sans délai réseau
+void configTzTime(const char *tz, const char *, const char *, const char *) {
+  setenv("TZ", tz, 1);
+  tzset();
+  if (ntpEpochAtBoot) epochAtBoot = ntpEpochAtBoot;
+}
+
+// Comme le cœur : attend au plus ms une heure postérieure à 2016
+bool getLocalTime(struct tm *info, uint32_t ms) {
+  uint32_t t0 = millis();
+  time_t now;
+  while ((now = time(nullptr)) < 1451606400) {
+    if (millis() - t0 >= ms) return false;
+    delay(10);
+  }
+  localtime_r(&now, info);
+  return true;
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+extern "C" size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t used = strnlen(dst, size);
+  return used == size ? size + strlen(src) : used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return inMax == inMin ? outMin : (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// --- Broches ---
+#define HAL_PINS 40
+struct PinState {
+  uint8_t mode;
+  int level;
+  uint16_t analog;
+  void (*isr)();
+  int edge;
+};
+static PinState pins[HAL_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= HAL_PINS) return;
+  pins[pin].mode = mode;
+  if (mode == INPUT_PULLUP && pins[pin].level == LOW) pins[pin].level = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < HAL_PINS) pins[pin].level = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < HAL_PINS ? pins[pin].level : LOW;
+}
+
+uint16_t analogRead(uint8_t pin) {
+  return pin < HAL_PINS ? pins[pin].analog : 0;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  if (pin >= HAL_PINS) return;
+  pins[pin].isr = isr;
+  pins[pin].edge = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < HAL_PINS) pins[pin].isr = nullptr;
+}
+
+void halSetPin(uint8_t pin, int level) {
+  if (pin >= HAL_PINS) return;
+  PinState &p = pins[pin];
+  int old = p.level;
+  p.level = level ? HIGH : LOW;
+  if (!p.isr || old == p.level) return;
+  bool rising = p.level == HIGH;
+  if (p.edge == CHANGE || (p.edge == RISING && rising) || (p.edge == FALLING && !rising)) p.isr();
+}
+
+void halSetAnalog(uint8_t pin, uint16_t value) {
+  if (pin < HAL_PINS) pins[pin].analog = value;
+}
+
+int halPinLevel(uint8_t pin) {
+  return pin < HAL_PINS ? pins[pin].level : LOW;
+}
+
+void analogReadResolution(uint8_t) {}
+void analogSetPinAttenuation(uint8_t, adc_attenuation_t) {}
+
+// --- LEDC : 16 canaux, 0..7 rapides et 8..15 lents comme sur l'ESP32 ---
+#define HAL_LEDC_CHANNELS 16
+static uint32_t ledcDuty[HAL_LEDC_CHANNELS];
+
+double ledcSetup(uint8_t, double freq, uint8_t) {
+  return freq;
+}
+
+void ledcAttachPin(uint8_t, uint8_t) {}
+
+void ledcWrite(uint8_t channel, uint32_t duty) {
+  if (channel < HAL_LEDC_CHANNELS) ledcDuty[channel] = duty;
+}
+
+double ledcWriteTone(uint8_t channel, double freq) {
+  ledcWrite(channel, freq > 0 ? 1 : 0);
+  return freq;
+}
+
+uint32_t halLedcDuty(uint8_t channel) {
+  return channel < HAL_LEDC_CHANNELS ? ledcDuty[channel] : 0;
+}
+
+// --- Aléatoire reproductible (xorshift32) : deux exécutions donnent la même simulation ---
+static uint32_t rngState = 0x2545F491;
+
+extern "C" uint32_t esp_random() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed) rngState = (uint32_t)seed;
+}
+
+long random(long howbig) {
+  return howbig > 0 ? (long)(esp_random() % (uint32_t)howbig) : 0;
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+// --- String ---
+String::String(const char *s) {
+  if (s) concat(s, strlen(s));
+}
+
+String::String(const String &s) {
+  concat(s.c_str(), s._len);
+}
+
+String::String(String &&s) noexcept : _buf(s._buf), _len(s._len), _cap(s._cap) {
+  s._buf = nullptr;
+  s._len = s._cap = 0;
+}
+
+String::String(char c) {
+  concat(&c, 1);
+}
+
+static void formatInteger(char *out, size_t size, unsigned long v, bool neg, unsigned char base) {
+  char tmp[66];
+  size_t n = 0;
+  if (base < 2 || base > 36) base = 10;
+  do {
+    unsigned d = v % base;
+    tmp[n++] = d < 10 ? '0' + d : 'a' + d - 10;
+    v /= base;
+  } while (v);
+  size_t i = 0;
+  if (neg && i + 1 < size) out[i++] = '-';
+  while (n && i + 1 < size) out[i++] = tmp[--n];
+  out[i] = '\0';
+}
+
+String::String(int v, unsigned char base) : String((long)v, base) {}
+String::String(unsigned int v, unsigned char base) : String((unsigned long)v, base) {}
+
+String::String(long v, unsigned char base) {
+  char buf[68];
+  bool neg = v < 0 && base == 10;
+  formatInteger(buf, sizeof(buf), neg ? 0UL - (unsigned long)v : (unsigned long)v, neg, base);
+  concat(buf, strlen(buf));
+}
+
+String::String(unsigned long v, unsigned char base) {
+  char buf[68];
+  formatInteger(buf, sizeof(buf), v, false, base);
+  concat(buf, strlen(buf));
+}
+
+String::String(float v, unsigned int decimals) : String((double)v, decimals) {}
+
+String::String(double v, unsigned int decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+  concat(buf, strlen(buf));
+}
+
+String::~String() {
+  free(_buf);
+}
+
+String &String::operator=(const String &s) {
+  if (this != &s) {
+    _len = 0;
+    if (_buf) _buf[0] = '\0';
+    concat(s.c_str(), s._len);
+  }
+  return *this;
+}
+
+String &String::operator=(String &&s) noexcept {
+  if (this != &s) {
+    free(_buf);
+    _buf = s._buf;
+    _len = s._len;
+    _cap = s._cap;
+    s._buf = nullptr;
+    s._len = s._cap = 0;
+  }
+  return *this;
+}
+
+String &String::operator=(const char *s) {
+  _len = 0;
+  if (_buf) _buf[0] = '\0';
+  if (s) concat(s, strlen(s));
+  return *this;
+}
+
+bool String::reserve(unsigned int size) {
+  if (_buf && _cap >= size) return true;
+  char *p = (char *)realloc(_buf, size + 1);
+  if (!p) return false;
+  if (!_buf) p[0] = '\0';
+  _buf = p;
+  _cap = size;
+  return true;
+}
+
+bool String::concat(const char *s, unsigned int n) {
+  if (!reserve(_len + n)) return false;
+  memmove(_buf + _len, s, n); // s peut pointer dans ce même tampon
+  _len += n;
+  _buf[_len] = '\0';
+  return true;
+}
+
+bool String::equalsIgnoreCase(const String &s) const {
+  return _len == s._len && strcasecmp(c_str(), s.c_str()) == 0;
+}
+
+bool String::startsWith(const String &prefix) const {
+  return prefix._len <= _len && memcmp(c_str(), prefix.c_str(), prefix._len) == 0;
+}
+
+bool String::endsWith(const String &suffix) const {
+  return suffix._len <= _len && memcmp(c_str() + _len - suffix._len, suffix.c_str(), suffix._len) == 0;
+}
+
+char &String::operator[](unsigned int i) {
+  static char dummy;
+  if (i >= _len) {
+    dummy = 0;
+    return dummy;
+  }
+  return _buf[i];
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= _len) return -1;
+  const char *p = (const char *)memchr(_buf + from, c, _len - from);
+  return p ? (int)(p - _buf) : -1;
+}
+
+int String::indexOf(const String &s, unsigned int from) const {
+  if (from >= _len) return -1;
+  const char *p = strstr(_buf + from, s.c_str());
+  return p ? (int)(p - _buf) : -1;
+}
+
+int String::lastIndexOf(char c) const {
+  for (int i = (int)_len - 1; i >= 0; i--) {
+    if (_buf[i] == c) return i;
+  }
+  return -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= _len) return String();
+  if (to > _len) to = _len;
+  String out;
+  out.concat(_buf + from, to - from);
+  return out;
+}
+
+void String::replace(char find, char with) {
+  for (unsigned int i = 0; i < _len; i++) {
+    if (_buf[i] == find) _buf[i] = with;
+  }
+}
+
+void String::replace(const String &find, const String &with) {
+  if (!_len || !find._len) return;
+  String out;
+  unsigned int i = 0;
+  while (i < _len) {
+    const char *p = strstr(_buf + i, find.c_str());
+    if (!p) break;
+    out.concat(_buf + i, (unsigned int)(p - (_buf + i)));
+    out.concat(with);
+    i = (unsigned int)(p - _buf) + find._len;
+  }
+  out.concat(_buf + i, _len - i);
+  *this = static_cast<String &&>(out);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= _len) return;
+  if (count > _len - index) count = _len - index;
+  memmove(_buf + index, _buf + index + count, _len - index - count + 1);
+  _len -= count;
+}
+
+void String::toLowerCase() {
+  for (unsigned int i = 0; i < _len; i++) _buf[i] = (char)tolower((unsigned char)_buf[i]);
+}
+
+void String::toUpperCase() {
+  for (unsigned int i = 0; i < _len; i++) _buf[i] = (char)toupper((unsigned char)_buf[i]);
+}
+
+void String::trim() {
+  if (!_len) return;
+  unsigned int b = 0, e = _len;
+  while (b < e && isspace((unsigned char)_buf[b])) b++;
+  while (e > b && isspace((unsigned char)_buf[e - 1])) e--;
+  _len = e - b;
+  memmove(_buf, _buf + b, _len);
+  _buf[_len] = '\0';
+}
+
+String operator+(const String &a, const String &b) {
+  String r(a);
+  r.concat(b);
+  return r;
+}
+
+String operator+(const String &a, const char *b) {
+  String r(a);
+  r.concat(b);
+  return r;
+}
+
+String operator+(const char *a, const String &b) {
+  String r(a);
+  r.concat(b);
+  return r;
+}
+
+String operator+(const String &a, char b) {
+  String r(a);
+  r.concat(b);
+  return r;
+}
+
+String operator+(const String &a, int b) { return a + String(b); }
+String operator+(const String &a, unsigned int b) { return a + String(b); }
+String operator+(const String &a, long b) { return a + String(b); }
+String operator+(const String &a, unsigned long b) { return a + String(b); }
+String operator+(const String &a, float b) { return a + String(b); }
+String operator+(const String &a, double b) { return a + String(b); }
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(buf);
+}
+
+// --- Print / Stream ---
+size_t Print::write(const uint8_t *buf, size_t n) {
+  size_t done = 0;
+  while (n--) done += write(*buf++);
+  return done;
+}
+
+size_t Print::print(long v, int base) {
+  return print(String(v, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long v, int base) {
+  return print(String(v, (unsigned char)base));
+}
+
+size_t Print::print(double v, int decimals) {
+  return print(String(v, (unsigned int)decimals));
+}
+
+size_t Print::printf(const char *fmt, ...) {
+  char small[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(small, sizeof(small), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if ((size_t)n < sizeof(small)) return write((const uint8_t *)small, n);
+  char *big = (char *)malloc(n + 1);
+  if (!big) return 0;
+  va_start(ap, fmt);
+  vsnprintf(big, n + 1, fmt, ap);
+  va_end(ap);
+  size_t done = write((const uint8_t *)big, n);
+  free(big);
+  return done;
+}
+
+// Sans horloge qui avance pendant l'attente, un octet absent ne viendra jamais : pas de délai
+int Stream::timedRead() {
+  return available() > 0 ? read() : -1;
+}
+
+size_t Stream::readBytes(char *buf, size_t n) {
+  size_t i = 0;
+  while (i < n) {
+    int c = timedRead();
+    if (c < 0) break;
+    buf[i++] = (char)c;
+  }
+  return i;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String s;
+  int c;
+  while ((c = timedRead()) >= 0 && c != terminator) s.concat((char)c);
+  return s;
+}
+
+String Stream::readString() {
+  String s;
+  int c;
+  while ((c = timedRead()) >= 0) s.concat((char)c);
+  return s;
+}
+
+// --- HardwareSerial ---
+static bool consoleEcho = true;
+
+void halConsoleEcho(bool on) {
+  consoleEcho = on;
+}
+
+HardwareSerial::HardwareSerial(int uart) : _uart(uart) {
+  setRxBufferSize(256); // taille par défaut du pilote UART
+}
+
+HardwareSerial::~HardwareSerial() {
+  free(_rx);
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t, int8_t, int8_t) {
+  _baud = baud;
+}
+
+size_t HardwareSerial::setRxBufferSize(size_t size) {
+  uint8_t *p = (uint8_t *)realloc(_rx, size);
+  if (!p) return 0;
+  _rx = p;
+  _rxSize = size;
+  _head = _count = 0;
+  return size;
+}
+
+void HardwareSerial::onReceive(void (*fn)(), bool) {
+  _onReceive = fn;
+}
+
+int HardwareSerial::available() {
+  return (int)_count;
+}
+
+int HardwareSerial::read() {
+  if (!_count) return -1;
+  uint8_t c = _rx[_head];
+  _head = (_head + 1) % _rxSize;
+  _count--;
+  return c;
+}
+
+int HardwareSerial::peek() {
+  return _count ? _rx[_head] : -1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t n) {
+  _txBytes += n;
+  if (_uart == 0 && consoleEcho) fwrite(buf, 1, n, stdout);
+  if (_uart != 0 && _onTransmit) _onTransmit(buf, n);
+  return n;
+}
+
+size_t HardwareSerial::halReceive(const uint8_t *data, size_t n) {
+  size_t taken = 0;
+  for (; taken < n && _count < _rxSize; taken++, _count++) _rx[(_head + _count) % _rxSize] = data[taken];
+  _overflow += n - taken;
+  if (taken && _onReceive) _onReceive();
+  return taken;
+}
+
+HardwareSerial Serial(0);
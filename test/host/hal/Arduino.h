@@ -0,0 +1,323 @@
+// Arduino.h (hôte)
+#pragma once
+
+// ====================================================================================
+// Cœur Arduino sur Linux pour les tests et le simulateur hôte (test/host)
+// Seule l'interface utilisée par le firmware est reproduite, avec la sémantique du
+// cœur ESP32 2.0.x. millis()/micros() suivent l'horloge virtuelle de hal.h, Serial
+// écrit sur la sortie standard et les autres UART reçoivent ce que le simulateur leur
+// fournit (flux NMEA). Les broches sont des niveaux en mémoire pilotés par halSetPin.
+// ====================================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include "pgmspace.h"
+
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+#define ARDUINO 10812
+#define ESP32 1
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define DRAM_ATTR
+#define F(s) (s)
+class __FlashStringHelper;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+#define SERIAL_8N1 0x800001c
+
+// glibc < 2.38 : pas de strlcpy/strlcat (newlib les fournit sur la cible)
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+extern "C" size_t strlcpy(char *dst, const char *src, size_t size);
+extern "C" size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+
+// --- Temps (horloge virtuelle, voir hal.h) ---
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// --- Broches ---
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+typedef enum { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db } adc_attenuation_t;
+void analogReadResolution(uint8_t bits);
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t attenuation);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+
+// PWM LEDC (rapport cyclique relu par halLedcDuty)
+double ledcSetup(uint8_t channel, double freq, uint8_t resolutionBits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+double ledcWriteTone(uint8_t channel, double freq);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+extern "C" uint32_t esp_random();
+
+// --- Chaînes ---
+class String {
+public:
+  String(const char *s = "");
+  String(const String &s);
+  String(String &&s) noexcept;
+  explicit String(char c);
+  explicit String(int v, unsigned char base = 10);
+  explicit String(unsigned int v, unsigned char base = 10);
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2);
+  explicit String(double v, unsigned int decimals = 2);
+  ~String();
+
+  String &operator=(const String &s);
+  String &operator=(String &&s) noexcept;
+  String &operator=(const char *s);
+
+  bool reserve(unsigned int size);
+  unsigned int length() const { return _len; }
+  bool isEmpty() const { return _len == 0; }
+  const char *c_str() const { return _buf ? _buf : ""; }
+
+  bool concat(const String &s) { return concat(s.c_str(), s._len); }
+  bool concat(const char *s) { return s && concat(s, strlen(s)); }
+  bool concat(const char *s, unsigned int n);
+  bool concat(char c) { return concat(&c, 1); }
+  bool concat(int v) { return concat(String(v)); }
+  bool concat(unsigned int v) { return concat(String(v)); }
+  bool concat(long v) { return concat(String(v)); }
+  bool concat(unsigned long v) { return concat(String(v)); }
+  bool concat(float v) { return concat(String(v)); }
+  bool concat(double v) { return concat(String(v)); }
+  template <typename T> String &operator+=(const T &v) {
+    concat(v);
+    return *this;
+  }
+
+  bool equals(const String &s) const { return _len == s._len && memcmp(c_str(), s.c_str(), _len) == 0; }
+  bool equals(const char *s) const { return strcmp(c_str(), s ? s : "") == 0; }
+  bool equalsIgnoreCase(const String &s) const;
+  bool operator==(const String &s) const { return equals(s); }
+  bool operator==(const char *s) const { return equals(s); }
+  bool operator!=(const String &s) const { return !equals(s); }
+  bool operator!=(const char *s) const { return !equals(s); }
+  bool operator<(const String &s) const { return strcmp(c_str(), s.c_str()) < 0; }
+  bool startsWith(const String &prefix) const;
+  bool endsWith(const String &suffix) const;
+
+  char charAt(unsigned int i) const { return i < _len ? _buf[i] : 0; }
+  void setCharAt(unsigned int i, char c) {
+    if (i < _len) _buf[i] = c;
+  }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char &operator[](unsigned int i);
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String &s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  String substring(unsigned int from) const { return substring(from, _len); }
+  String substring(unsigned int from, unsigned int to) const;
+
+  void replace(char find, char with);
+  void replace(const String &find, const String &with);
+  void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return (float)atof(c_str()); }
+  double toDouble() const { return atof(c_str()); }
+
+private:
+  char *_buf = nullptr;
+  unsigned int _len = 0;
+  unsigned int _cap = 0;
+};
+
+String operator+(const String &a, const String &b);
+String operator+(const String &a, const char *b);
+String operator+(const char *a, const String &b);
+String operator+(const String &a, char b);
+String operator+(const String &a, int b);
+String operator+(const String &a, unsigned int b);
+String operator+(const String &a, long b);
+String operator+(const String &a, unsigned long b);
+String operator+(const String &a, float b);
+String operator+(const String &a, double b);
+
+// --- Adresses IPv4 ---
+class IPAddress {
+public:
+  IPAddress() : _addr(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+  IPAddress(uint32_t addr) : _addr(addr) {}
+  operator uint32_t() const { return _addr; }
+  uint8_t operator[](int i) const { return (_addr >> (8 * i)) & 0xFF; }
+  bool operator==(const IPAddress &o) const { return _addr == o._addr; }
+  String toString() const;
+
+private:
+  uint32_t _addr;
+};
+
+// --- Sorties et flux ---
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n);
+  size_t write(const char *s) { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+  size_t write(const char *s, size_t n) { return write((const uint8_t *)s, n); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str(), s.length()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(double v, int decimals = 2);
+  size_t print(const IPAddress &ip) { return print(ip.toString()); }
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(const T &v) { return print(v) + println(); }
+  template <typename T> size_t println(const T &v, int fmt) { return print(v, fmt) + println(); }
+
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { _timeout = ms; }
+  unsigned long getTimeout() const { return _timeout; }
+  virtual size_t readBytes(char *buf, size_t n);
+  size_t readBytes(uint8_t *buf, size_t n) { return readBytes((char *)buf, n); }
+  String readStringUntil(char terminator);
+  String readString();
+
+protected:
+  int timedRead();
+  unsigned long _timeout = 1000;
+};
+
+// UART 0 : console (sortie standard) ; autres UART : réception alimentée par l'hôte
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int uart);
+  ~HardwareSerial();
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+  void end() {}
+  void updateBaudRate(unsigned long baud) { _baud = baud; }
+  unsigned long baudRate() const { return _baud; }
+  size_t setRxBufferSize(size_t size);
+  void onReceive(void (*fn)(), bool onlyOnTimeout = false);
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t n) override;
+  using Print::write;
+  operator bool() const { return true; }
+
+  // Hôte : octets arrivés sur la ligne RX (ceux qui ne tiennent pas dans le tampon sont perdus)
+  size_t halReceive(const uint8_t *data, size_t n);
+  // Hôte : octets émis sur la ligne TX (UART autres que la console), par exemple vers un récepteur simulé
+  void halOnTransmit(void (*fn)(const uint8_t *data, size_t n)) { _onTransmit = fn; }
+  uint32_t halOverflowBytes() const { return _overflow; }
+  uint32_t halTxBytes() const { return _txBytes; }
+
+private:
+  int _uart;
+  unsigned long _baud = 0;
+  uint8_t *_rx = nullptr;
+  size_t _rxSize = 0, _head = 0, _count = 0;
+  uint32_t _overflow = 0, _txBytes = 0;
+  void (*_onReceive)() = nullptr;
+  void (*_onTransmit)(const uint8_t *, size_t) = nullptr;
+};
+
+extern HardwareSerial Serial;
+
+// --- Système ---
+// Tas et fréquence d'un ESP32-WROOM (tas modélisé, voir hal/system.cpp)
+class EspClass {
+public:
+  uint32_t getHeapSize();
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount();
+  void restart();
+};
+extern EspClass ESP;
+bool psramFound();
+
+// Heure : configTzTime applique le fuseau et l'heure NTP fournie par le simulateur
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+#include "freertos/FreeRTOS.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
@@ -0,0 +1,61 @@
+// FS.h (hôte)
+#pragma once
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+
+// Système de fichiers en mémoire (contenu perdu à la fin du programme, comme un
+// LittleFS fraîchement formaté au premier démarrage)
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+public:
+  File() = default;
+  File(std::shared_ptr<std::string> data, const char *path, bool writable, size_t pos);
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  size_t read(uint8_t *buf, size_t size);
+  int peek() override;
+  void flush() override {}
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const { return _pos; }
+  size_t size() const { return _data ? _data->size() : 0; }
+  const char *name() const { return _name.c_str(); }
+  const char *path() const { return _path.c_str(); }
+  bool isDirectory() const { return false; }
+  void close() { _data.reset(); }
+  operator bool() const { return (bool)_data; }
+
+private:
+  std::shared_ptr<std::string> _data;
+  std::string _path, _name;
+  bool _writable = false;
+  size_t _pos = 0;
+};
+
+class FS {
+public:
+  File open(const char *path, const char *mode = "r", bool create = false);
+  File open(const String &path, const char *mode = "r", bool create = false) { return open(path.c_str(), mode, create); }
+  bool exists(const char *path) { return _files.count(path) > 0; }
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path) { return _files.erase(path) > 0; }
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+
+protected:
+  std::map<std::string, std::shared_ptr<std::string>> _files;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,36 @@
+// HTTPClient.h (hôte)
+#pragma once
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <memory>
+
+#define HTTP_CODE_OK 200
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+// Requête unique par begin()/end() (Connection: close), corps de réponse lu en entier
+class HTTPClient {
+public:
+  bool begin(const String &url);
+  void end();
+  void setTimeout(uint16_t ms) { _timeoutMs = ms; }
+  void addHeader(const String &name, const String &value);
+  int GET();
+  int POST(const String &payload);
+  int getSize() { return (int)_body.length(); }
+  String getString() { return _body; }
+  int writeToStream(Stream *stream);
+  static String errorToString(int error);
+
+private:
+  int sendRequest(const char *method, const String &payload);
+
+  std::unique_ptr<WiFiClient> _client;
+  String _host, _path, _headers, _body;
+  uint16_t _port = 80;
+  bool _secure = false;
+  uint16_t _timeoutMs = 5000;
+};
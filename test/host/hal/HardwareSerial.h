@@ -0,0 +1,3 @@
+// HardwareSerial.h (hôte)
+#pragma once
+#include <Arduino.h>
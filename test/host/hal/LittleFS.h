@@ -0,0 +1,16 @@
+// LittleFS.h (hôte)
+#pragma once
+#include <FS.h>
+
+class LittleFSFS : public fs::FS {
+public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char *partitionLabel = "spiffs") {
+    return true;
+  }
+  void end() {}
+  size_t totalBytes() { return 1408 * 1024; } // partition de la table par défaut (4 Mo)
+  size_t usedBytes();
+};
+
+extern LittleFSFS LittleFS;
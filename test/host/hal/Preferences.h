@@ -0,0 +1,25 @@
+// Preferences.h (hôte)
+#pragma once
+#include <Arduino.h>
+#include <string>
+
+// NVS en mémoire ; comme sur la cible, un espace absent ne s'ouvre pas en lecture seule
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+  void end() { _ns.clear(); }
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+  size_t putBytes(const char *key, const void *value, size_t len);
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+  size_t putUInt(const char *key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+  size_t putString(const char *key, const String &value) { return putBytes(key, value.c_str(), value.length()); }
+  String getString(const char *key, const String &defaultValue = String());
+
+private:
+  std::string _ns;
+  bool _readOnly = false;
+};
@@ -0,0 +1,3 @@
+// Print.h (hôte)
+#pragma once
+#include <Arduino.h>
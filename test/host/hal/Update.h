@@ -0,0 +1,26 @@
+// Update.h (hôte)
+#pragma once
+#include <Arduino.h>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+
+// Écriture d'image sans flash : octets comptés, taille vérifiée à end()
+class UpdateClass {
+public:
+  bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH, int ledPin = -1, uint8_t ledOn = LOW,
+             const char *label = nullptr);
+  size_t write(uint8_t *data, size_t len);
+  bool end(bool evenIfRemaining = false);
+  void abort();
+  bool isRunning() const { return _running; }
+  bool hasError() const { return _error != nullptr; }
+  const char *errorString() const { return _error ? _error : "No Error"; }
+
+private:
+  size_t _size = 0, _written = 0;
+  bool _running = false;
+  const char *_error = nullptr;
+};
+
+extern UpdateClass Update;
@@ -0,0 +1,29 @@
+// WebServer.h (hôte)
+#pragma once
+#include <WiFi.h>
+#include <FS.h>
+
+// Point d'entrée local sans client : les routes sont enregistrées, aucune requête n'arrive
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+class WebServer {
+public:
+  typedef void (*THandlerFunction)();
+  explicit WebServer(int port = 80) : _port(port) {}
+  void on(const String &uri, THandlerFunction handler) {}
+  void on(const String &uri, HTTPMethod method, THandlerFunction handler) {}
+  void collectHeaders(const char *headerKeys[], size_t count) {}
+  void begin() {}
+  void handleClient() {}
+  String arg(const String &name) { return String(); }
+  bool hasArg(const String &name) { return false; }
+  String header(const String &name) { return String(); }
+  void sendHeader(const String &name, const String &value, bool first = false) {}
+  void setContentLength(size_t length) {}
+  void send(int code, const char *contentType = nullptr, const String &content = String()) {}
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t length) {}
+  template <typename T> size_t streamFile(T &file, const String &contentType, int code = 200) { return 0; }
+
+private:
+  int _port;
+};
@@ -0,0 +1,87 @@
+// WiFi.h (hôte)
+#pragma once
+#include <Arduino.h>
+#include <Client.h>
+#include <memory>
+
+// ====================================================================================
+// Station WiFi et sockets simulés (hal/net.cpp)
+// Les points d'accès viennent de halWifiAddAp ; une connexion aboutit après une latence
+// (plus courte sur un AP désigné par BSSID et canal, sans balayage) si le lien est
+// établi (halWifiLink). Les sockets dialoguent avec les serveurs enregistrés par
+// halHttpRoute : requêtes HTTP/1.1 analysées à l'écriture, en file (pipeline), et
+// réponses disponibles après leur latence sur l'horloge virtuelle.
+// ====================================================================================
+
+typedef enum {
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t m);
+  bool persistent(bool on) { return true; }
+  bool setAutoReconnect(bool on) { return true; }
+  bool setSleep(bool on) { return true; }
+  wl_status_t begin(const char *ssid, const char *pass = nullptr, int32_t channel = 0, const uint8_t *bssid = nullptr,
+                    bool connect = true);
+  bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+              IPAddress dns2 = IPAddress());
+  bool disconnect(bool wifiOff = false, bool eraseAp = false);
+  bool reconnect();
+  wl_status_t status();
+  bool isConnected() { return status() == WL_CONNECTED; }
+
+  String SSID();
+  uint8_t *BSSID();
+  int32_t channel();
+  int8_t RSSI();
+  IPAddress localIP();
+  IPAddress gatewayIP();
+  IPAddress subnetMask();
+  IPAddress dnsIP(uint8_t i = 0);
+  String macAddress() { return String("24:0A:C4:00:00:01"); }
+};
+
+extern WiFiClass WiFi;
+
+struct HalSocket;
+
+class WiFiClient : public Client {
+public:
+  WiFiClient();
+  ~WiFiClient() override;
+  WiFiClient(const WiFiClient &) = delete;
+  WiFiClient &operator=(const WiFiClient &) = delete;
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char *host, uint16_t port) override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  void stop() override;
+  uint8_t connected() override;
+  operator bool() override { return connected(); }
+  void setTimeout(uint32_t seconds) { Stream::setTimeout(seconds * 1000); }
+  using Print::write;
+
+protected:
+  bool _secure = false;
+
+private:
+  std::unique_ptr<HalSocket> _sock;
+};
+
+class WiFiUDP; // non utilisé
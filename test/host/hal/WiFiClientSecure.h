@@ -0,0 +1,12 @@
+// WiFiClientSecure.h (hôte)
+#pragma once
+#include <WiFi.h>
+
+// Même socket simulé, avec la latence de la poignée de main TLS à la connexion
+class WiFiClientSecure : public WiFiClient {
+public:
+  WiFiClientSecure() { _secure = true; }
+  void setInsecure() {}
+  void setCACert(const char *rootCA) {}
+  void setHandshakeTimeout(unsigned long seconds) {}
+};
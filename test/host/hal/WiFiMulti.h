@@ -0,0 +1,15 @@
+// WiFiMulti.h (hôte)
+#pragma once
+#include <WiFi.h>
+#include <string>
+#include <vector>
+
+// Balayage puis connexion bloquante à l'AP connu de meilleur RSSI
+class WiFiMulti {
+public:
+  bool addAP(const char *ssid, const char *pass = nullptr);
+  uint8_t run(uint32_t connectTimeoutMs = 5000);
+
+private:
+  std::vector<std::pair<std::string, std::string>> _aps;
+};
@@ -0,0 +1,11 @@
+// Wire.h (hôte)
+#pragma once
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+  void end() {}
+};
+
+extern TwoWire Wire;
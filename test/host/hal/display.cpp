@@ -0,0 +1,205 @@
+// display.cpp (hôte)
+#include "hal.h"
+#include <Adafruit_ST7789.h>
+
+// Mémoire du contrôleur en coordonnées logiques : en rotation 2 (celle du firmware,
+// MADCTL sans MX/MY/MV) les lignes de la mémoire suivent celles de l'écran, ce qui
+// donne aussi le bon résultat au défilement matériel (VSCRDEF/VSCRSADD).
+static const int16_t kMemW = 240, kMemH = 320;
+static const uint32_t kSpiMHz = 40; // SPI_DEFAULT_FREQ du pilote ST7789 sur ESP32
+
+static Adafruit_SPITFT *panel = nullptr;
+static std::vector<uint16_t> mem(kMemW * kMemH, 0);
+static HalDisplayStats stats = {};
+static uint16_t scrollTfa = 0, scrollVsa = kMemH, scrollSsa = 0;
+static bool inverted = false;
+static uint64_t spiBits = 0;
+
+// Durée de la ligne SPI : ajoutée à l'horloge par µs entières
+static void spiTransfer(uint64_t bits) {
+  spiBits += bits;
+  if (spiBits >= kSpiMHz) {
+    halAdvanceUs(spiBits / kSpiMHz);
+    spiBits %= kSpiMHz;
+  }
+}
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t, int8_t, int8_t) : Adafruit_GFX(w, h) {
+  panel = this;
+}
+
+Adafruit_SPITFT::~Adafruit_SPITFT() {
+  if (panel == this) panel = nullptr;
+}
+
+void Adafruit_SPITFT::startWrite() {
+  if (_depth++ == 0) stats.transactions++;
+}
+
+void Adafruit_SPITFT::endWrite() {
+  if (_depth > 0) _depth--;
+}
+
+// CASET/RASET : 2 commandes de 4 octets, puis RAMWR
+void Adafruit_SPITFT::memWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+  _winX = x;
+  _winY = y;
+  _winW = w;
+  _winH = h;
+  _winPos = 0;
+  spiTransfer(3 * 8 + 8 * 8);
+}
+
+void Adafruit_SPITFT::memFill(uint16_t color, uint32_t len) {
+  stats.pixels += len;
+  spiTransfer((uint64_t)len * 16);
+  uint32_t area = (uint32_t)_winW * _winH;
+  for (uint32_t i = 0; i < len && _winPos < area; i++, _winPos++) {
+    int16_t x = _winX + _winPos % _winW, y = _winY + _winPos / _winW;
+    if (x >= 0 && x < kMemW && y >= 0 && y < kMemH) mem[y * kMemW + x] = color;
+  }
+}
+
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  setAddrWindow(x, y, 1, 1);
+  memFill(color, 1);
+}
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  startWrite();
+  writePixel(x, y, color);
+  endWrite();
+}
+
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  int16_t x2 = min<int16_t>(x + w, _width), y2 = min<int16_t>(y + h, _height);
+  x = max<int16_t>(x, 0);
+  y = max<int16_t>(y, 0);
+  if (x2 <= x || y2 <= y) return;
+  setAddrWindow(x, y, x2 - x, y2 - y);
+  memFill(color, (uint32_t)(x2 - x) * (y2 - y));
+}
+
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  writeFillRect(x, y, w, h, color);
+  endWrite();
+}
+
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool, bool bigEndian) {
+  stats.pixels += len;
+  spiTransfer((uint64_t)len * 16);
+  uint32_t area = (uint32_t)_winW * _winH;
+  for (uint32_t i = 0; i < len && _winPos < area; i++, _winPos++) {
+    int16_t x = _winX + _winPos % _winW, y = _winY + _winPos / _winW;
+    uint16_t c = bigEndian ? (uint16_t)(colors[i] << 8 | colors[i] >> 8) : colors[i];
+    if (x >= 0 && x < kMemW && y >= 0 && y < kMemH) mem[y * kMemW + x] = c;
+  }
+}
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+  memFill(color, len);
+}
+
+void Adafruit_SPITFT::invertDisplay(bool i) {
+  sendCommand(i ? ST77XX_INVON : ST77XX_INVOFF);
+}
+
+void Adafruit_SPITFT::sendCommand(uint8_t cmd, const uint8_t *data, uint8_t n) {
+  stats.commands++;
+  stats.transactions++;
+  spiTransfer(8 + 8 * n);
+  switch (cmd) {
+    case ST77XX_SLPIN:
+      if (!stats.asleep) stats.sleeps++;
+      stats.asleep = true;
+      delay(5);
+      break;
+    case ST77XX_SLPOUT:
+      stats.asleep = false;
+      delay(120); // réveil : 120 ms avant la commande suivante (fiche technique)
+      break;
+    case ST77XX_DISPOFF: stats.on = false; break;
+    case ST77XX_DISPON: stats.on = true; break;
+    case ST77XX_INVOFF: inverted = false; break;
+    case ST77XX_INVON: inverted = true; break;
+    case 0x33: // VSCRDEF
+      if (n == 6) {
+        scrollTfa = data[0] << 8 | data[1];
+        scrollVsa = data[2] << 8 | data[3];
+      }
+      break;
+    case 0x37: // VSCRSADD
+      if (n == 2) scrollSsa = data[0] << 8 | data[1];
+      break;
+  }
+}
+
+void Adafruit_ST77xx::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  memWindow(x, y, w, h);
+}
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t) {
+  _panelW = width;
+  _panelH = height;
+  delay(150 + 10 + 10 + 10 + 500); // SWRESET, SLPOUT, NORON, DISPON de la séquence d'init
+  stats.commands += 8;
+  stats.on = true;
+  std::fill(mem.begin(), mem.end(), 0);
+  setRotation(0);
+}
+
+void Adafruit_ST7789::setRotation(uint8_t m) {
+  rotation = m & 3;
+  _width = rotation & 1 ? _panelH : _panelW;
+  _height = rotation & 1 ? _panelW : _panelH;
+  sendCommand(ST77XX_MADCTL);
+}
+
+// --- Commandes hôte ---
+const HalDisplayStats &halDisplayStats() {
+  return stats;
+}
+
+uint16_t halDisplayPixel(int16_t x, int16_t y) {
+  if (x < 0 || y < 0 || x >= kMemW || y >= kMemH) return 0;
+  // Zone de défilement : la ligne affichée y montre la ligne tfa + (y - tfa + ssa - tfa) mod vsa
+  if (scrollVsa && y >= scrollTfa && y < scrollTfa + scrollVsa) {
+    y = scrollTfa + ((y - scrollTfa) + (scrollSsa - scrollTfa) + scrollVsa) % scrollVsa;
+  }
+  uint16_t c = mem[y * kMemW + x];
+  return inverted ? ~c : c;
+}
+
+int16_t halDisplayWidth() {
+  return panel ? panel->width() : 0;
+}
+
+int16_t halDisplayHeight() {
+  return panel ? panel->height() : 0;
+}
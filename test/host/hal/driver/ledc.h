@@ -0,0 +1,15 @@
+// ledc.h (hôte)
+#pragma once
+#include <cstdint>
+#include "esp_system.h"
+
+// Pilote LEDC de l'IDF : un fondu fixe directement la consigne finale (halLedcDuty)
+#define SOC_LEDC_SUPPORT_HS_MODE 1
+
+typedef enum { LEDC_HIGH_SPEED_MODE = 0, LEDC_LOW_SPEED_MODE = 1 } ledc_mode_t;
+typedef enum { LEDC_CHANNEL_0 = 0, LEDC_CHANNEL_7 = 7 } ledc_channel_t;
+typedef enum { LEDC_FADE_NO_WAIT = 0, LEDC_FADE_WAIT_DONE = 1 } ledc_fade_mode_t;
+
+esp_err_t ledc_fade_func_install(int intrAllocFlags);
+esp_err_t ledc_set_fade_with_time(ledc_mode_t mode, ledc_channel_t channel, uint32_t targetDuty, int maxFadeTimeMs);
+esp_err_t ledc_fade_start(ledc_mode_t mode, ledc_channel_t channel, ledc_fade_mode_t fadeMode);
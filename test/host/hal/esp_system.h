@@ -0,0 +1,13 @@
+// esp_system.h (hôte)
+#pragma once
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+extern "C" {
+void esp_restart(void); // rappel halOnRestart puis fin du programme
+const char *esp_get_idf_version(void);
+uint32_t esp_random(void);
+}
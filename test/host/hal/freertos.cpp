@@ -0,0 +1,88 @@
+// freertos.cpp (hôte)
+#include "hal.h"
+#include <deque>
+#include <vector>
+
+static int loopTask; // seule tâche : son adresse sert de poignée
+static uint32_t notifyCount = 0;
+static void (*idleFn)(uint64_t) = nullptr;
+
+void halOnIdle(void (*fn)(uint64_t untilUs)) {
+  idleFn = fn;
+}
+
+// Laisse le monde avancer jusqu'à ce que ready() soit vrai ou que l'échéance passe
+template <typename Ready> static bool waitFor(TickType_t ticks, Ready ready) {
+  if (ready() || ticks == 0) return ready();
+  uint64_t until = ticks == portMAX_DELAY ? UINT64_MAX : halMicros64() + (uint64_t)ticks * 1000;
+  while (!ready()) {
+    uint64_t now = halMicros64();
+    if (now >= until) return false;
+    if (idleFn) idleFn(until);
+    // Rappel absent ou sans effet : attente jusqu'à l'échéance (jamais bloquée sans borne)
+    if (!ready() && halMicros64() == now) {
+      if (until == UINT64_MAX) return false;
+      halAdvanceUs(until - now);
+    }
+  }
+  return true;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return &loopTask;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t) {
+  notifyCount++;
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *woken) {
+  notifyCount++;
+  if (woken) *woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+  waitFor(ticksToWait, [] { return notifyCount > 0; });
+  uint32_t value = notifyCount;
+  if (value) notifyCount = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks * portTICK_PERIOD_MS);
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(halMicros64() / 1000);
+}
+
+// --- Files d'attente ---
+struct HalQueue {
+  size_t length;
+  size_t itemSize;
+  std::deque<std::vector<uint8_t>> items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  return new HalQueue{length, itemSize, {}}; // jamais détruite, comme sur la cible
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken) {
+  if (!q || q->items.size() >= q->length) return errQUEUE_FULL;
+  const uint8_t *p = (const uint8_t *)item;
+  q->items.emplace_back(p, p + q->itemSize);
+  if (woken) *woken = pdFALSE; // la tâche de loop() est réveillée par sa notification
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticksToWait) {
+  if (!q || !waitFor(ticksToWait, [q] { return !q->items.empty(); })) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  return q ? (UBaseType_t)q->items.size() : 0;
+}
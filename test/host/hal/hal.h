@@ -0,0 +1,130 @@
+// hal.h (hôte)
+#pragma once
+#include <Arduino.h>
+#include <string>
+
+// ====================================================================================
+// Commandes de la couche matérielle hôte, réservées aux tests et au simulateur
+// Horloge virtuelle : micros() = temps réel écoulé depuis le lancement + avances
+// cumulées. Le code exécuté consomme donc son vrai temps CPU (durées des tâches
+// mesurables), et le simulateur saute les attentes avec halAdvanceUs.
+// ====================================================================================
+
+// Horloge virtuelle (µs depuis le démarrage simulé, sur 64 bits : pas de rebouclage)
+uint64_t halMicros64();
+// Avance l'horloge sans attendre (delay() l'utilise aussi)
+void halAdvanceUs(uint64_t us);
+// Cumul des avances : temps simulé sans exécution
+uint64_t halSkippedUs();
+// Avance ajoutée par chaque appel à millis() (0 par défaut) : les attentes actives du
+// firmware (while (millis() < fin)) se terminent sans consommer de temps réel
+void halSetMillisCostUs(uint32_t us);
+// Rappel au début de chaque attente active : 10000 appels à millis() sans autre avance
+// de l'horloge (delay, transfert SPI, attente de la boucle)
+void halOnBusyWait(void (*fn)());
+// Rappel à chaque avance de l'horloge : il peut livrer des événements échus avant
+// untilUs en avançant lui-même l'horloge jusqu'à leur instant (sans nouvel appel)
+void halOnAdvance(void (*fn)(uint64_t untilUs));
+
+// Attente bloquante de la tâche de loop() (ulTaskNotifyTake, xQueueReceive) sans
+// notification : le rappel fait avancer le monde jusqu'à untilUs au plus (UINT64_MAX :
+// sans borne) et peut notifier la tâche. Sans rappel, l'horloge saute à l'échéance.
+void halOnIdle(void (*fn)(uint64_t untilUs));
+
+// Heure murale UTC correspondant au démarrage simulé (time(), gettimeofday)
+void halSetEpoch(time_t epochAtBoot);
+// Heure que donnera le serveur NTP à configTzTime (même convention ; 0 : pas de réponse)
+void halSetNtpEpoch(time_t epochAtBoot);
+
+// esp_restart() : rappel (rapport du simulateur) puis fin du programme
+void halOnRestart(void (*fn)());
+
+// Niveau d'une broche d'entrée ; déclenche l'interruption attachée sur le front demandé
+void halSetPin(uint8_t pin, int level);
+// Valeur rendue par analogRead (0..4095)
+void halSetAnalog(uint8_t pin, uint16_t value);
+// Dernier niveau écrit par digitalWrite
+int halPinLevel(uint8_t pin);
+// Rapport cyclique d'un canal LEDC (ledcWrite, fondus du pilote)
+uint32_t halLedcDuty(uint8_t channel);
+
+// --- Tas simulé (hal/system.cpp) ---
+// Cumul des allocations placées dans le tas simulé depuis la première lecture du tas ;
+// failures : allocations pour lesquelles la cible n'aurait pas eu de bloc assez grand
+struct HalHeapCounters {
+  uint32_t allocs;
+  uint64_t bytes;
+  uint32_t failures;
+};
+const HalHeapCounters &halHeapCounters();
+
+// Portée dont les allocations n'appartiennent pas au tas de la cible (pile réseau et
+// serveurs simulés, contenu de la flash, monde du simulateur)
+class HalHeapExempt {
+public:
+  HalHeapExempt();
+  ~HalHeapExempt();
+  HalHeapExempt(const HalHeapExempt &) = delete;
+  HalHeapExempt &operator=(const HalHeapExempt &) = delete;
+};
+
+// Console (Serial) : false coupe l'écho sur la sortie standard (les octets restent comptés)
+void halConsoleEcho(bool on);
+
+// --- Réseau (hal/net.cpp) ---
+// Points d'accès visibles ; halWifiLink(false) coupe le lien (AP hors service)
+void halWifiAddAp(const char *ssid, const char *pass, uint8_t channel, int8_t rssi);
+void halWifiLink(bool up);
+
+struct HalHttpRequest {
+  std::string host;
+  std::string method;
+  std::string path;    // chemin et paramètres
+  std::string headers; // lignes d'en-têtes brutes (CRLF)
+  std::string body;
+};
+
+struct HalHttpResponse {
+  int status = 200;
+  std::string contentType = "application/json";
+  std::string body;
+  uint32_t latencyMs = 0; // requête reçue -> premier octet de la réponse
+  bool close = false;     // le serveur ferme après cette réponse
+};
+
+// Serveur d'un hôte : false si la requête reste sans réponse (délai dépassé côté firmware).
+// Un hôte sans serveur refuse les connexions.
+typedef bool (*HalHttpHandler)(const HalHttpRequest &req, HalHttpResponse &resp);
+void halHttpRoute(const char *host, HalHttpHandler handler);
+// Latence de connexion TCP et de la poignée de main TLS
+void halNetLatency(uint32_t connectMs, uint32_t tlsMs);
+
+struct HalNetStats {
+  uint32_t wifiJoins;
+  uint32_t wifiJoinFailures;
+  uint32_t connects;
+  uint32_t connectFailures;
+  uint32_t requests;
+  uint64_t bytesSent;
+  uint64_t bytesReceived;
+};
+const HalNetStats &halNetStats();
+
+// --- Capteurs ---
+// Grandeurs rendues par le BME280 simulé (Adafruit_BME280)
+void halBme280(float tempC, float humidityPct, float pressureHpa);
+
+// --- Écran (hal/display.cpp) ---
+struct HalDisplayStats {
+  uint32_t transactions; // startWrite de premier niveau et commandes isolées
+  uint32_t commands;
+  uint64_t pixels; // pixels envoyés sur la ligne SPI
+  uint32_t sleeps; // passages en SLPIN
+  bool asleep;
+  bool on;
+};
+const HalDisplayStats &halDisplayStats();
+// Pixel visible (RGB565) après défilement matériel et inversion
+uint16_t halDisplayPixel(int16_t x, int16_t y);
+int16_t halDisplayWidth();
+int16_t halDisplayHeight();
@@ -0,0 +1,21 @@
+// pk.h (hôte)
+#pragma once
+#include <cstddef>
+
+// Pas de cryptographie asymétrique sur l'hôte : toute clé est refusée (OTA impossible)
+#define MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE -0x3980
+
+typedef struct {
+  void *pk_info;
+  void *pk_ctx;
+} mbedtls_pk_context;
+
+typedef enum { MBEDTLS_MD_NONE = 0, MBEDTLS_MD_SHA256 = 6 } mbedtls_md_type_t;
+
+extern "C" {
+void mbedtls_pk_init(mbedtls_pk_context *ctx);
+void mbedtls_pk_free(mbedtls_pk_context *ctx);
+int mbedtls_pk_parse_public_key(mbedtls_pk_context *ctx, const unsigned char *key, size_t keylen);
+int mbedtls_pk_verify(mbedtls_pk_context *ctx, mbedtls_md_type_t md_alg, const unsigned char *hash, size_t hash_len,
+                      const unsigned char *sig, size_t sig_len);
+}
@@ -0,0 +1,19 @@
+// sha256.h (hôte)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// SHA-256 complet (empreinte des images OTA) ; API _ret de mbed TLS 2.x (IDF 4.4)
+typedef struct {
+  uint32_t state[8];
+  uint64_t total;
+  uint8_t buffer[64];
+} mbedtls_sha256_context;
+
+extern "C" {
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx);
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224);
+int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t len);
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32]);
+}
@@ -0,0 +1,482 @@
+// net.cpp (hôte)
+#include "hal.h"
+#include <HTTPClient.h>
+#include <WiFiMulti.h>
+#include <esp_heap_caps.h>
+#include <deque>
+#include <map>
+#include <strings.h>
+
+// Latences d'un WiFi domestique : association directe (BSSID et canal connus) ou après un
+// balayage complet, bail DHCP, débit descendant d'une connexion ADSL moyenne
+static const uint32_t kScanMs = 2200;
+static const uint32_t kAssociateMs = 180;
+static const uint32_t kDhcpMs = 350;
+static const uint32_t kLinkBytesPerMs = 1000;
+static uint32_t connectMs = 40, tlsMs = 260;
+static const size_t kTlsHeapBytes = 26 * 1024;
+
+static HalNetStats stats = {};
+
+const HalNetStats &halNetStats() {
+  return stats;
+}
+
+void halNetLatency(uint32_t tcpMs, uint32_t handshakeMs) {
+  connectMs = tcpMs;
+  tlsMs = handshakeMs;
+}
+
+// --- Station WiFi ---
+struct HalAp {
+  std::string ssid, pass;
+  uint8_t channel;
+  int8_t rssi;
+  uint8_t bssid[6];
+};
+
+static std::vector<HalAp> aps;
+static bool linkUp = true;
+static wl_status_t wifiStatus = WL_DISCONNECTED;
+static const int kUnknownAp = -2;
+static int joining = -1, joined = -1; // index dans aps, -1 : aucun
+static uint64_t joinDoneUs = 0;
+static bool staticIp = false;
+static IPAddress ipLocal, ipGateway, ipMask, ipDns;
+static uint32_t rssiNoise = 0x9E3779B9; // bruit propre : n'avance pas le générateur du firmware
+
+WiFiClass WiFi;
+
+void halWifiAddAp(const char *ssid, const char *pass, uint8_t channel, int8_t rssi) {
+  HalAp ap = {ssid, pass ? pass : "", channel, rssi, {0x24, 0x0A, 0xC4, 0x10, 0x20, (uint8_t)aps.size()}};
+  aps.push_back(ap);
+}
+
+void halWifiLink(bool up) {
+  linkUp = up;
+  if (!up && wifiStatus == WL_CONNECTED) wifiStatus = WL_CONNECTION_LOST;
+}
+
+bool WiFiClass::mode(wifi_mode_t) {
+  return true;
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *pass, int32_t channel, const uint8_t *bssid, bool) {
+  joining = kUnknownAp;
+  joined = -1;
+  wifiStatus = WL_DISCONNECTED;
+  uint32_t ms = kScanMs;
+  for (size_t i = 0; i < aps.size(); i++) {
+    const HalAp &ap = aps[i];
+    if (ap.ssid != ssid || ap.pass != (pass ? pass : "")) continue;
+    joining = (int)i;
+    // AP désigné par BSSID et canal : association sans balayage
+    if (bssid && channel == ap.channel && !memcmp(bssid, ap.bssid, 6)) ms = kAssociateMs;
+  }
+  if (!staticIp) ms += kDhcpMs;
+  joinDoneUs = halMicros64() + (uint64_t)ms * 1000;
+  return wifiStatus;
+}
+
+bool WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress) {
+  staticIp = (uint32_t)local != 0;
+  if (staticIp) {
+    ipLocal = local;
+    ipGateway = gateway;
+    ipMask = subnet;
+    ipDns = dns1;
+  }
+  return true;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+  joining = joined = -1;
+  wifiStatus = WL_DISCONNECTED;
+  return true;
+}
+
+bool WiFiClass::reconnect() {
+  if (joined < 0) return false;
+  const HalAp &ap = aps[joined];
+  begin(ap.ssid.c_str(), ap.pass.c_str(), ap.channel, ap.bssid);
+  return true;
+}
+
+wl_status_t WiFiClass::status() {
+  if (joining != -1 && halMicros64() >= joinDoneUs) {
+    if (joining >= 0 && linkUp) {
+      joined = joining;
+      wifiStatus = WL_CONNECTED;
+      stats.wifiJoins++;
+      if (!staticIp) {
+        ipLocal = IPAddress(192, 168, 1, 42);
+        ipGateway = ipDns = IPAddress(192, 168, 1, 1);
+        ipMask = IPAddress(255, 255, 255, 0);
+      }
+    } else {
+      wifiStatus = WL_NO_SSID_AVAIL; // lien coupé, SSID ou mot de passe inconnu
+      stats.wifiJoinFailures++;
+    }
+    joining = -1;
+  }
+  return wifiStatus;
+}
+
+String WiFiClass::SSID() {
+  return String(status() == WL_CONNECTED ? aps[joined].ssid.c_str() : "");
+}
+
+uint8_t *WiFiClass::BSSID() {
+  static uint8_t none[6];
+  return status() == WL_CONNECTED ? aps[joined].bssid : none;
+}
+
+int32_t WiFiClass::channel() {
+  return status() == WL_CONNECTED ? aps[joined].channel : 0;
+}
+
+int8_t WiFiClass::RSSI() {
+  if (status() != WL_CONNECTED) return 0;
+  rssiNoise = rssiNoise * 1664525 + 1013904223;
+  return aps[joined].rssi + (int8_t)((rssiNoise >> 24) % 7) - 3;
+}
+
+IPAddress WiFiClass::localIP() {
+  return status() == WL_CONNECTED ? ipLocal : IPAddress();
+}
+
+IPAddress WiFiClass::gatewayIP() {
+  return status() == WL_CONNECTED ? ipGateway : IPAddress();
+}
+
+IPAddress WiFiClass::subnetMask() {
+  return status() == WL_CONNECTED ? ipMask : IPAddress();
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t) {
+  return status() == WL_CONNECTED ? ipDns : IPAddress();
+}
+
+bool WiFiMulti::addAP(const char *ssid, const char *pass) {
+  _aps.emplace_back(ssid, pass ? pass : "");
+  return true;
+}
+
+// Balayage (bloquant), puis connexion à l'AP connu le plus fort dans le délai imparti
+uint8_t WiFiMulti::run(uint32_t connectTimeoutMs) {
+  if (WiFi.status() == WL_CONNECTED) return WL_CONNECTED;
+  delay(kScanMs);
+  const HalAp *best = nullptr;
+  for (const HalAp &ap : aps) {
+    for (const auto &known : _aps) {
+      if (ap.ssid == known.first && (!best || ap.rssi > best->rssi)) best = &ap;
+    }
+  }
+  if (!best || !linkUp) return WL_NO_SSID_AVAIL;
+  WiFi.begin(best->ssid.c_str(), best->pass.c_str());
+  uint32_t t0 = millis();
+  while (WiFi.status() != WL_CONNECTED && millis() - t0 < connectTimeoutMs) delay(10);
+  return WiFi.status();
+}
+
+// --- Sockets ---
+static std::map<std::string, HalHttpHandler> routes;
+
+void halHttpRoute(const char *host, HalHttpHandler handler) {
+  routes[host] = handler;
+}
+
+// Réponse en file : premier octet à startUs, dernier à endUs (débit kLinkBytesPerMs)
+struct HalPending {
+  std::string bytes;
+  uint64_t startUs, endUs;
+  size_t sent;
+  bool close;
+};
+
+struct HalSocket {
+  std::unique_ptr<char[]> tls; // tampons mbedTLS, dans le tas de la cible
+  std::string host;
+  HalHttpHandler handler;
+  std::string inbox;                // octets écrits par le firmware, pas encore analysés
+  std::deque<HalPending> responses; // réponses pas encore entièrement arrivées
+  std::string rx;                   // octets arrivés, lus par read()
+  size_t rxPos = 0;
+  uint64_t lastEndUs = 0;
+  bool peerClosed = false;
+};
+
+static const char *reasonPhrase(int status) {
+  switch (status) {
+  case 200: return "OK";
+  case 401: return "Unauthorized";
+  case 403: return "Forbidden";
+  case 404: return "Not Found";
+  case 429: return "Too Many Requests";
+  default: return status >= 500 ? "Server Error" : "Status";
+  }
+}
+
+static bool headerIs(const std::string &headers, const char *name, const char *value) {
+  size_t n = strlen(name);
+  for (size_t pos = 0; pos < headers.size();) {
+    size_t eol = headers.find("\r\n", pos);
+    if (eol == std::string::npos) eol = headers.size();
+    if (eol - pos > n && !strncasecmp(headers.c_str() + pos, name, n) && headers[pos + n] == ':') {
+      std::string v = headers.substr(pos + n + 1, eol - pos - n - 1);
+      size_t b = v.find_first_not_of(" \t");
+      return b != std::string::npos && !strncasecmp(v.c_str() + b, value, strlen(value));
+    }
+    pos = eol + 2;
+  }
+  return false;
+}
+
+static long headerNumber(const std::string &headers, const char *name) {
+  size_t n = strlen(name);
+  for (size_t pos = 0; pos < headers.size();) {
+    size_t eol = headers.find("\r\n", pos);
+    if (eol == std::string::npos) eol = headers.size();
+    if (eol - pos > n && !strncasecmp(headers.c_str() + pos, name, n) && headers[pos + n] == ':')
+      return atol(headers.c_str() + pos + n + 1);
+    pos = eol + 2;
+  }
+  return 0;
+}
+
+// Analyse les requêtes complètes reçues et met leurs réponses en file
+static void serve(HalSocket &s) {
+  while (!s.peerClosed) {
+    size_t end = s.inbox.find("\r\n\r\n");
+    if (end == std::string::npos) return;
+    size_t lineEnd = s.inbox.find("\r\n");
+    std::string line = s.inbox.substr(0, lineEnd);
+    std::string headers = lineEnd < end ? s.inbox.substr(lineEnd + 2, end - lineEnd) : std::string();
+    size_t bodyLen = (size_t)max(0L, headerNumber(headers, "Content-Length"));
+    if (s.inbox.size() < end + 4 + bodyLen) return;
+
+    HalHttpRequest req;
+    req.host = s.host;
+    size_t sp1 = line.find(' '), sp2 = line.rfind(' ');
+    req.method = line.substr(0, sp1);
+    req.path = sp1 < sp2 ? line.substr(sp1 + 1, sp2 - sp1 - 1) : std::string();
+    req.headers = headers;
+    req.body = s.inbox.substr(end + 4, bodyLen);
+    s.inbox.erase(0, end + 4 + bodyLen);
+    stats.requests++;
+
+    HalHttpResponse resp;
+    if (!s.handler(req, resp)) continue; // sans réponse : le firmware attendra son délai
+    bool close = resp.close || headerIs(headers, "Connection", "close");
+    char head[256];
+    snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %u\r\nConnection: %s\r\n\r\n",
+             resp.status, reasonPhrase(resp.status), resp.contentType.c_str(), (unsigned)resp.body.size(),
+             close ? "close" : "keep-alive");
+    HalPending p;
+    p.bytes = head + resp.body;
+    p.startUs = max(halMicros64() + (uint64_t)resp.latencyMs * 1000, s.lastEndUs);
+    p.endUs = p.startUs + (uint64_t)p.bytes.size() * 1000 / kLinkBytesPerMs;
+    p.sent = 0;
+    p.close = close;
+    s.lastEndUs = p.endUs;
+    s.responses.push_back(std::move(p));
+    if (close) s.peerClosed = true; // requêtes suivantes ignorées
+  }
+}
+
+// Octets arrivés d'après l'horloge virtuelle
+static void pump(HalSocket &s) {
+  uint64_t now = halMicros64();
+  while (!s.responses.empty()) {
+    HalPending &p = s.responses.front();
+    if (now < p.startUs) return;
+    size_t arrived = now >= p.endUs ? p.bytes.size()
+                                    : (size_t)((now - p.startUs) * p.bytes.size() / (p.endUs - p.startUs + 1));
+    if (arrived > p.sent) {
+      if (s.rxPos == s.rx.size()) {
+        s.rx.clear();
+        s.rxPos = 0;
+      }
+      s.rx.append(p.bytes, p.sent, arrived - p.sent);
+      stats.bytesReceived += arrived - p.sent;
+      p.sent = arrived;
+    }
+    if (p.sent < p.bytes.size()) return;
+    s.responses.pop_front();
+  }
+}
+
+WiFiClient::WiFiClient() = default;
+
+WiFiClient::~WiFiClient() {
+  stop();
+}
+
+int WiFiClient::connect(IPAddress, uint16_t) {
+  stats.connectFailures++; // adresses brutes : pas de serveur simulé
+  return 0;
+}
+
+int WiFiClient::connect(const char *host, uint16_t) {
+  stop();
+  auto route = routes.find(host);
+  if (WiFi.status() != WL_CONNECTED || route == routes.end()) {
+    delay(connectMs);
+    stats.connectFailures++;
+    return 0;
+  }
+  delay(connectMs + (_secure ? tlsMs : 0));
+  // Tampons d'enregistrement TLS (16 Ko en entrée, 4 Ko en sortie), contexte et certificat
+  // du serveur : pris dans le tas pendant toute la connexion ; sans bloc assez grand, la
+  // poignée de main échoue comme sur la cible (MBEDTLS_ERR_SSL_ALLOC_FAILED)
+  std::unique_ptr<char[]> tls;
+  if (_secure) {
+    if (heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < kTlsHeapBytes) {
+      stats.connectFailures++;
+      return 0;
+    }
+    tls.reset(new char[kTlsHeapBytes]);
+  }
+  HalHeapExempt stack; // pile réseau et serveur simulés
+  _sock.reset(new HalSocket());
+  _sock->tls = std::move(tls);
+  _sock->host = host;
+  _sock->handler = route->second;
+  stats.connects++;
+  return 1;
+}
+
+size_t WiFiClient::write(const uint8_t *buf, size_t size) {
+  if (!_sock || _sock->peerClosed || WiFi.status() != WL_CONNECTED) return 0;
+  HalHeapExempt stack;
+  _sock->inbox.append((const char *)buf, size);
+  stats.bytesSent += size;
+  serve(*_sock);
+  return size;
+}
+
+int WiFiClient::available() {
+  if (!_sock) return 0;
+  HalHeapExempt stack;
+  pump(*_sock);
+  return (int)(_sock->rx.size() - _sock->rxPos);
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size) {
+  size_t n = min((size_t)max(available(), 0), size);
+  if (!n) return -1;
+  memcpy(buf, _sock->rx.data() + _sock->rxPos, n);
+  _sock->rxPos += n;
+  return (int)n;
+}
+
+int WiFiClient::peek() {
+  return available() > 0 ? (uint8_t)_sock->rx[_sock->rxPos] : -1;
+}
+
+void WiFiClient::stop() {
+  _sock.reset();
+}
+
+// Ouvert tant que le serveur n'a pas fermé ou que des octets restent à lire
+uint8_t WiFiClient::connected() {
+  if (!_sock) return 0;
+  if (WiFi.status() != WL_CONNECTED) return 0;
+  return available() > 0 || !_sock->peerClosed || !_sock->responses.empty();
+}
+
+// --- HTTPClient ---
+bool HTTPClient::begin(const String &url) {
+  end();
+  String u = url;
+  _secure = u.startsWith("https://");
+  if (!_secure && !u.startsWith("http://")) return false;
+  u = u.substring(_secure ? 8 : 7);
+  int slash = u.indexOf('/');
+  _host = slash < 0 ? u : u.substring(0, slash);
+  _path = slash < 0 ? String("/") : u.substring(slash);
+  _port = _secure ? 443 : 80;
+  int colon = _host.indexOf(':');
+  if (colon >= 0) {
+    _port = (uint16_t)_host.substring(colon + 1).toInt();
+    _host = _host.substring(0, colon);
+  }
+  return true;
+}
+
+void HTTPClient::end() {
+  _client.reset();
+  _headers = "";
+  _body = "";
+}
+
+void HTTPClient::addHeader(const String &name, const String &value) {
+  _headers += name + ": " + value + "\r\n";
+}
+
+int HTTPClient::GET() {
+  return sendRequest("GET", String());
+}
+
+int HTTPClient::POST(const String &payload) {
+  return sendRequest("POST", payload);
+}
+
+int HTTPClient::sendRequest(const char *method, const String &payload) {
+  _client.reset(_secure ? new WiFiClientSecure() : new WiFiClient());
+  if (!_client->connect(_host.c_str(), _port)) return HTTPC_ERROR_CONNECTION_REFUSED;
+  String req = String(method) + " " + _path + " HTTP/1.1\r\nHost: " + _host + "\r\n" + _headers +
+               "Connection: close\r\nContent-Length: " + String(payload.length()) + "\r\n\r\n" + payload;
+  if (_client->write((const uint8_t *)req.c_str(), req.length()) != req.length()) return HTTPC_ERROR_SEND_HEADER_FAILED;
+
+  // Statut et en-têtes, puis corps jusqu'à Content-Length ou la fermeture
+  std::string head;
+  uint32_t t0 = millis();
+  while (head.find("\r\n\r\n") == std::string::npos) {
+    int c = _client->read();
+    if (c >= 0) {
+      head += (char)c;
+      continue;
+    }
+    if (!_client->connected()) return HTTPC_ERROR_CONNECTION_LOST;
+    if (millis() - t0 >= _timeoutMs) return HTTPC_ERROR_READ_TIMEOUT;
+    delay(1);
+  }
+  int code = atoi(head.c_str() + 9);
+  long length = headerNumber(head, "Content-Length");
+  _body = "";
+  char buf[512];
+  t0 = millis();
+  while ((long)_body.length() < length) {
+    int n = _client->read((uint8_t *)buf, min(sizeof(buf), (size_t)(length - _body.length())));
+    if (n > 0) {
+      _body.concat(buf, n);
+      t0 = millis();
+      continue;
+    }
+    if (!_client->connected()) break;
+    if (millis() - t0 >= _timeoutMs) return HTTPC_ERROR_READ_TIMEOUT;
+    delay(1);
+  }
+  return code;
+}
+
+int HTTPClient::writeToStream(Stream *stream) {
+  if (!stream) return -1;
+  return (int)stream->write((const uint8_t *)_body.c_str(), _body.length());
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+  case HTTPC_ERROR_CONNECTION_REFUSED: return String("connection refused");
+  case HTTPC_ERROR_SEND_HEADER_FAILED: return String("send header failed");
+  case HTTPC_ERROR_CONNECTION_LOST: return String("connection lost");
+  case HTTPC_ERROR_READ_TIMEOUT: return String("read Timeout");
+  default: return String();
+  }
+}
@@ -0,0 +1,35 @@
+// peripherals.cpp (hôte)
+#include "hal.h"
+#include <Adafruit_BME280.h>
+#include <SPI.h>
+#include <Wire.h>
+
+SPIClass SPI;
+TwoWire Wire;
+
+// --- BME280 ---
+static float bmeTempC = 21.0f, bmeHumidity = 50.0f, bmePressureHpa = 1013.25f;
+
+void halBme280(float tempC, float humidityPct, float pressureHpa) {
+  bmeTempC = tempC;
+  bmeHumidity = humidityPct;
+  bmePressureHpa = pressureHpa;
+}
+
+bool Adafruit_BME280::begin(uint8_t addr, TwoWire *wire) {
+  delay(2); // lecture des coefficients de calibration
+  _ok = addr == 0x76 || addr == 0x77;
+  return _ok;
+}
+
+float Adafruit_BME280::readTemperature() {
+  return _ok ? bmeTempC : NAN;
+}
+
+float Adafruit_BME280::readHumidity() {
+  return _ok ? bmeHumidity : NAN;
+}
+
+float Adafruit_BME280::readPressure() {
+  return _ok ? bmePressureHpa * 100.0f : NAN;
+}
@@ -0,0 +1,20 @@
+// pgmspace.h (hôte)
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// Pas de mémoire programme séparée sur l'ESP32 : lectures directes, comme le cœur 2.0.x
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(a) (*(const uint8_t *)(a))
+#define pgm_read_word(a) (*(const uint16_t *)(a))
+#define pgm_read_dword(a) (*(const uint32_t *)(a))
+#define pgm_read_float(a) (*(const float *)(a))
+#define pgm_read_ptr(a) (*(void *const *)(a))
+#define pgm_read_pointer(a) pgm_read_ptr(a) // pointeurs de 64 bits sur l'hôte
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcpy_P strcpy
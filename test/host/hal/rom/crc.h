@@ -0,0 +1,6 @@
+// crc.h (hôte)
+#pragma once
+#include <cstdint>
+
+// CRC-32 IEEE 802.3 réfléchi, même convention que la ROM (crc32_le(0, ...) = CRC habituel)
+extern "C" uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
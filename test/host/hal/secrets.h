@@ -0,0 +1,4 @@
+// secrets.h (hôte)
+#pragma once
+// Tests et simulateur sans secrets.h local : valeurs d'exemple
+#include "../../../include/secrets_example.h"
@@ -0,0 +1,176 @@
+// storage.cpp (hôte)
+#include "hal.h"
+#include <LittleFS.h>
+#include <Preferences.h>
+#include <Update.h>
+
+// --- Fichiers ---
+namespace fs {
+
+File::File(std::shared_ptr<std::string> data, const char *path, bool writable, size_t pos)
+  : _data(std::move(data)), _path(path), _writable(writable), _pos(pos) {
+  const char *slash = strrchr(path, '/');
+  _name = slash ? slash + 1 : path;
+}
+
+size_t File::write(const uint8_t *buf, size_t size) {
+  if (!_data || !_writable) return 0;
+  HalHeapExempt flash; // contenu en flash sur la cible
+  if (_pos > _data->size()) _data->resize(_pos);
+  _data->replace(_pos, min(size, _data->size() - _pos), (const char *)buf, size);
+  _pos += size;
+  return size;
+}
+
+int File::available() {
+  return _data && _pos < _data->size() ? (int)(_data->size() - _pos) : 0;
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+  size_t n = min(size, (size_t)available());
+  if (n) memcpy(buf, _data->data() + _pos, n);
+  _pos += n;
+  return n;
+}
+
+int File::peek() {
+  return available() ? (uint8_t)(*_data)[_pos] : -1;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_data) return false;
+  size_t base = mode == SeekCur ? _pos : mode == SeekEnd ? _data->size() : 0;
+  if (base + pos > _data->size()) return false;
+  _pos = base + pos;
+  return true;
+}
+
+File FS::open(const char *path, const char *mode, bool) {
+  auto it = _files.find(path);
+  if (mode[0] == 'r' && mode[1] != '+') {
+    return it == _files.end() ? File() : File(it->second, path, false, 0);
+  }
+  HalHeapExempt flash; // contenu en flash sur la cible
+  if (it == _files.end() || mode[0] == 'w') {
+    // Écriture : un nouveau contenu ; les lecteurs déjà ouverts gardent l'ancien
+    it = _files.insert_or_assign(path, std::make_shared<std::string>()).first;
+  }
+  return File(it->second, path, true, mode[0] == 'a' ? it->second->size() : 0);
+}
+
+bool FS::rename(const char *from, const char *to) {
+  auto it = _files.find(from);
+  if (it == _files.end()) return false;
+  HalHeapExempt flash;
+  auto data = it->second;
+  _files.erase(it);
+  _files[to] = data;
+  return true;
+}
+
+} // namespace fs
+
+LittleFSFS LittleFS;
+
+size_t LittleFSFS::usedBytes() {
+  size_t used = 0;
+  for (const auto &f : _files) used += (f.second->size() + 4095) / 4096 * 4096; // blocs de 4 Ko
+  return used;
+}
+
+// --- NVS ---
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+bool Preferences::begin(const char *name, bool readOnly, const char *) {
+  if (readOnly && !nvs.count(name)) return false;
+  HalHeapExempt flash;
+  _ns = name;
+  _readOnly = readOnly;
+  nvs[_ns];
+  return true;
+}
+
+bool Preferences::clear() {
+  if (_ns.empty() || _readOnly) return false;
+  nvs[_ns].clear();
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  return !_ns.empty() && !_readOnly && nvs[_ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  return !_ns.empty() && nvs[_ns].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  if (_ns.empty() || _readOnly) return 0;
+  HalHeapExempt flash;
+  nvs[_ns][key].assign((const char *)value, len);
+  return len;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  return isKey(key) ? nvs[_ns][key].size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if (!len || len > maxLen) return 0;
+  memcpy(buf, nvs[_ns][key].data(), len);
+  return len;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+  uint32_t v;
+  return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : defaultValue;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+  if (!isKey(key)) return defaultValue;
+  const std::string &v = nvs[_ns][key];
+  String s;
+  s.concat(v.data(), v.size());
+  return s;
+}
+
+// --- Image OTA ---
+UpdateClass Update;
+
+bool UpdateClass::begin(size_t size, int, int, uint8_t, const char *) {
+  _size = size;
+  _written = 0;
+  _error = nullptr;
+  _running = true;
+  return true;
+}
+
+size_t UpdateClass::write(uint8_t *, size_t len) {
+  if (!_running) return 0;
+  _written += len;
+  return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+  if (!_running) {
+    _error = "Not Running";
+    return false;
+  }
+  _running = false;
+  if (!evenIfRemaining && _size != UPDATE_SIZE_UNKNOWN && _written != _size) {
+    _error = "Bad Size Given";
+    return false;
+  }
+  return true;
+}
+
+void UpdateClass::abort() {
+  _running = false;
+  _error = "Aborted";
+}
@@ -0,0 +1,498 @@
+// system.cpp (hôte)
+#include "hal.h"
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <driver/gpio.h>
+#include <driver/ledc.h>
+#include <esp_ota_ops.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/sha256.h>
+#include <rom/crc.h>
+#include <rom/miniz.h>
+
+// --- Tas ---
+// Tas interne d'un ESP32-WROOM après le démarrage du cœur Arduino et du WiFi, reproduit
+// par un tas fantôme : à partir de la première lecture (le simulateur la fait avant
+// setup()), chaque allocation de l'hôte y reçoit une place au plus juste (approche le
+// TLSF d'ESP-IDF), avec en-tête et alignement de 4 octets. Le libre, le plus grand bloc
+// (fragmentation) et le minimum sont donc ceux qu'aurait la cible pour la même suite
+// d'allocations. Les allocations faites sous HalHeapExempt (pile réseau et serveurs
+// simulés, fichiers en flash) n'y figurent pas.
+#define HAL_HEAP_TOTAL (320u * 1024)
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+// Allocateur de glibc remplacé (interposition documentée)
+extern "C" {
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void *__libc_memalign(size_t, size_t);
+void __libc_free(void *);
+}
+
+namespace {
+const uint32_t kHeader = 4, kMinBlock = 16;
+const size_t kMaxFree = 8192;      // segments libres (triés par adresse)
+const size_t kSlots = 1u << 17;    // allocations vivantes (adressage ouvert)
+
+struct Span {
+  uint32_t off, len;
+};
+struct Slot {
+  uintptr_t ptr; // 0 : vide
+  Span span;
+};
+
+bool tracking = false;
+int exemptDepth = 0;
+Span freeSpans[kMaxFree];
+size_t freeCount = 0;
+Slot slots[kSlots];
+uint32_t usedBytes = 0, minFree = HAL_HEAP_TOTAL;
+HalHeapCounters counters = {};
+
+size_t slotOf(uintptr_t p) {
+  return (size_t)((p >> 4) * 0x9E3779B97F4A7C15ull >> 47) & (kSlots - 1);
+}
+
+// Au plus juste ; false si aucun segment ne convient (la cible rendrait NULL)
+bool shadowAlloc(size_t size, Span &out) {
+  uint32_t need = (uint32_t)((size + kHeader + 3) & ~(size_t)3);
+  if (need < kMinBlock) need = kMinBlock;
+  size_t best = freeCount;
+  for (size_t i = 0; i < freeCount; i++) {
+    if (freeSpans[i].len >= need && (best == freeCount || freeSpans[i].len < freeSpans[best].len)) best = i;
+  }
+  if (best == freeCount) return false;
+  Span &f = freeSpans[best];
+  out = {f.off, need};
+  if (f.len - need < kMinBlock) { // reste trop petit : donné avec le bloc
+    out.len = f.len;
+    memmove(&freeSpans[best], &freeSpans[best + 1], (freeCount - best - 1) * sizeof(Span));
+    freeCount--;
+  } else {
+    f.off += need;
+    f.len -= need;
+  }
+  usedBytes += out.len;
+  if (HAL_HEAP_TOTAL - usedBytes < minFree) minFree = HAL_HEAP_TOTAL - usedBytes;
+  return true;
+}
+
+// Rend un bloc et le fusionne avec ses voisins
+void shadowFree(Span s) {
+  usedBytes -= s.len;
+  size_t i = 0, hi = freeCount;
+  while (i < hi) { // premier segment après s
+    size_t mid = (i + hi) / 2;
+    if (freeSpans[mid].off < s.off) i = mid + 1;
+    else hi = mid;
+  }
+  bool joinPrev = i > 0 && freeSpans[i - 1].off + freeSpans[i - 1].len == s.off;
+  bool joinNext = i < freeCount && s.off + s.len == freeSpans[i].off;
+  if (joinPrev && joinNext) {
+    freeSpans[i - 1].len += s.len + freeSpans[i].len;
+    memmove(&freeSpans[i], &freeSpans[i + 1], (freeCount - i - 1) * sizeof(Span));
+    freeCount--;
+  } else if (joinPrev) {
+    freeSpans[i - 1].len += s.len;
+  } else if (joinNext) {
+    freeSpans[i].off = s.off;
+    freeSpans[i].len += s.len;
+  } else if (freeCount < kMaxFree) {
+    memmove(&freeSpans[i + 1], &freeSpans[i], (freeCount - i) * sizeof(Span));
+    freeSpans[i] = s;
+    freeCount++;
+  } // sinon : segment perdu (jamais atteint en pratique)
+}
+
+void track(void *p, size_t size) {
+  if (!p || !tracking || exemptDepth) return;
+  Span span;
+  if (!shadowAlloc(size, span)) {
+    counters.failures++;
+    return;
+  }
+  size_t i = slotOf((uintptr_t)p);
+  for (size_t n = 0; slots[i].ptr && n < kSlots; n++) i = (i + 1) & (kSlots - 1);
+  if (slots[i].ptr) { // table pleine
+    shadowFree(span);
+    return;
+  }
+  slots[i] = {(uintptr_t)p, span};
+  counters.allocs++;
+  counters.bytes += size;
+}
+
+// Retire p du tas fantôme ; false s'il n'y figurait pas
+bool untrack(void *p) {
+  if (!p || !tracking) return false;
+  size_t i = slotOf((uintptr_t)p);
+  while (slots[i].ptr && slots[i].ptr != (uintptr_t)p) i = (i + 1) & (kSlots - 1);
+  if (!slots[i].ptr) return false;
+  shadowFree(slots[i].span);
+  // Suppression par décalage arrière (sondage linéaire sans marqueurs)
+  for (size_t j = (i + 1) & (kSlots - 1); slots[j].ptr; j = (j + 1) & (kSlots - 1)) {
+    size_t home = slotOf(slots[j].ptr);
+    if (((j - home) & (kSlots - 1)) >= ((j - i) & (kSlots - 1))) {
+      slots[i] = slots[j];
+      i = j;
+    }
+  }
+  slots[i].ptr = 0;
+  return true;
+}
+
+void startTracking() {
+  if (tracking) return;
+  freeSpans[0] = {0, HAL_HEAP_TOTAL};
+  freeCount = 1;
+  tracking = true;
+}
+
+size_t largestFree() {
+  uint32_t largest = 0;
+  for (size_t i = 0; i < freeCount; i++) largest = max(largest, freeSpans[i].len);
+  return largest > kHeader ? largest - kHeader : 0;
+}
+} // namespace
+
+extern "C" {
+void *malloc(size_t n) {
+  void *p = __libc_malloc(n);
+  track(p, n);
+  return p;
+}
+void *calloc(size_t n, size_t size) {
+  void *p = __libc_calloc(n, size);
+  track(p, n * size);
+  return p;
+}
+void *realloc(void *p, size_t n) {
+  void *q = __libc_realloc(p, n);
+  if (!q && n) return nullptr; // échec : l'ancien bloc reste alloué
+  // Un bloc hors du tas simulé le reste quand il grandit
+  if ((!p || untrack(p)) && n) track(q, n);
+  return q;
+}
+void free(void *p) {
+  untrack(p);
+  __libc_free(p);
+}
+void *memalign(size_t align, size_t n) {
+  void *p = __libc_memalign(align, n);
+  track(p, n);
+  return p;
+}
+void *aligned_alloc(size_t align, size_t n) {
+  return memalign(align, n);
+}
+int posix_memalign(void **out, size_t align, size_t n) {
+  void *p = memalign(align, n);
+  if (!p) return ENOMEM;
+  *out = p;
+  return 0;
+}
+void *valloc(size_t n) {
+  return memalign(sysconf(_SC_PAGESIZE), n);
+}
+}
+
+HalHeapExempt::HalHeapExempt() {
+  exemptDepth++;
+}
+
+HalHeapExempt::~HalHeapExempt() {
+  exemptDepth--;
+}
+
+const HalHeapCounters &halHeapCounters() {
+  return counters;
+}
+
+static size_t heapFree() {
+  startTracking();
+  return HAL_HEAP_TOTAL - usedBytes;
+}
+
+static size_t heapMinFree() {
+  startTracking();
+  return minFree;
+}
+
+static size_t heapLargestFree() {
+  startTracking();
+  return largestFree();
+}
+#else
+// Sanitizers : ils fournissent leur propre allocateur ; tas non modélisé (entièrement libre)
+static HalHeapCounters counters = {};
+
+HalHeapExempt::HalHeapExempt() {}
+HalHeapExempt::~HalHeapExempt() {}
+
+const HalHeapCounters &halHeapCounters() {
+  return counters;
+}
+
+static size_t heapFree() {
+  return HAL_HEAP_TOTAL;
+}
+
+static size_t heapMinFree() {
+  return HAL_HEAP_TOTAL;
+}
+
+static size_t heapLargestFree() {
+  return HAL_HEAP_TOTAL;
+}
+#endif
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return nullptr; // pas de PSRAM sur le module simulé
+  return size <= heapLargestFree() ? malloc(size) : nullptr;
+}
+
+void heap_caps_free(void *ptr) {
+  free(ptr);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : HAL_HEAP_TOTAL;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : heapFree();
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : heapMinFree();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? 0 : heapLargestFree();
+}
+
+bool psramFound() {
+  return false;
+}
+
+EspClass ESP;
+
+uint32_t EspClass::getHeapSize() {
+  return HAL_HEAP_TOTAL;
+}
+
+uint32_t EspClass::getFreeHeap() {
+  return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  return heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+  return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)(halMicros64() * 240);
+}
+
+void EspClass::restart() {
+  esp_restart();
+}
+
+// --- Redémarrage ---
+static void (*restartFn)() = nullptr;
+
+void halOnRestart(void (*fn)()) {
+  restartFn = fn;
+}
+
+extern "C" void esp_restart() {
+  fflush(stdout);
+  if (restartFn) restartFn();
+  exit(0);
+}
+
+extern "C" const char *esp_get_idf_version() {
+  return "v4.4.7-hote";
+}
+
+// --- OTA : image en cours validée, pas de retour arrière en attente ---
+static const esp_partition_t partitions[2] = {{0x10000, 0x1E0000, "app0"}, {0x1F0000, 0x1E0000, "app1"}};
+
+extern "C" const esp_partition_t *esp_ota_get_running_partition() {
+  return &partitions[0];
+}
+
+extern "C" const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *) {
+  return &partitions[1];
+}
+
+extern "C" esp_err_t esp_ota_get_state_partition(const esp_partition_t *, esp_ota_img_states_t *state) {
+  *state = ESP_OTA_IMG_VALID;
+  return ESP_OK;
+}
+
+extern "C" esp_err_t esp_ota_mark_app_valid_cancel_rollback() {
+  return ESP_OK;
+}
+
+extern "C" esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() {
+  esp_restart();
+  return ESP_FAIL;
+}
+
+// --- CRC-32 (bit à bit : seules les trames de télémétrie l'utilisent) ---
+extern "C" uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
+
+// --- tinfl : voir rom/miniz.h ---
+extern "C" tinfl_status tinfl_decompress(tinfl_decompressor *, const uint8_t *, size_t *inSize, uint8_t *, uint8_t *,
+                                         size_t *outSize, const uint32_t) {
+  *inSize = 0;
+  *outSize = 0;
+  return TINFL_STATUS_FAILED;
+}
+
+// --- SHA-256 (FIPS 180-4) ---
+static const uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static inline uint32_t ror(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static void sha256Block(uint32_t st[8], const uint8_t *p) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) w[i] = (uint32_t)p[4 * i] << 24 | p[4 * i + 1] << 16 | p[4 * i + 2] << 8 | p[4 * i + 3];
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = ror(w[i - 15], 7) ^ ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = ror(w[i - 2], 17) ^ ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  uint32_t a = st[0], b = st[1], c = st[2], d = st[3], e = st[4], f = st[5], g = st[6], h = st[7];
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + K256[i] + w[i];
+    uint32_t t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  st[0] += a;
+  st[1] += b;
+  st[2] += c;
+  st[3] += d;
+  st[4] += e;
+  st[5] += f;
+  st[6] += g;
+  st[7] += h;
+}
+
+extern "C" void mbedtls_sha256_init(mbedtls_sha256_context *ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+extern "C" void mbedtls_sha256_free(mbedtls_sha256_context *ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+extern "C" int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224) {
+  if (is224) return -1;
+  static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  memcpy(ctx->state, init, sizeof(init));
+  ctx->total = 0;
+  return 0;
+}
+
+extern "C" int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t len) {
+  while (len) {
+    size_t used = ctx->total % 64;
+    size_t n = min(len, 64 - used);
+    memcpy(ctx->buffer + used, input, n);
+    ctx->total += n;
+    input += n;
+    len -= n;
+    if (used + n == 64) sha256Block(ctx->state, ctx->buffer);
+  }
+  return 0;
+}
+
+extern "C" int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32]) {
+  uint64_t bits = ctx->total * 8;
+  uint8_t pad[72] = {0x80};
+  size_t padLen = (ctx->total % 64 < 56 ? 56 : 120) - ctx->total % 64;
+  for (int i = 0; i < 8; i++) pad[padLen + i] = (uint8_t)(bits >> (56 - 8 * i));
+  mbedtls_sha256_update_ret(ctx, pad, padLen + 8);
+  for (int i = 0; i < 8; i++) {
+    output[4 * i] = ctx->state[i] >> 24;
+    output[4 * i + 1] = ctx->state[i] >> 16;
+    output[4 * i + 2] = ctx->state[i] >> 8;
+    output[4 * i + 3] = ctx->state[i];
+  }
+  return 0;
+}
+
+// --- Clés publiques : voir mbedtls/pk.h ---
+extern "C" void mbedtls_pk_init(mbedtls_pk_context *ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+extern "C" void mbedtls_pk_free(mbedtls_pk_context *) {}
+
+extern "C" int mbedtls_pk_parse_public_key(mbedtls_pk_context *, const unsigned char *, size_t) {
+  return MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE;
+}
+
+extern "C" int mbedtls_pk_verify(mbedtls_pk_context *, mbedtls_md_type_t, const unsigned char *, size_t,
+                                 const unsigned char *, size_t) {
+  return MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE;
+}
+
+// --- GPIO et LEDC (pilotes IDF) ---
+int gpio_get_level(gpio_num_t gpio) {
+  return digitalRead((uint8_t)gpio);
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) {
+  return ESP_OK;
+}
+
+esp_err_t ledc_fade_func_install(int) {
+  return ESP_OK;
+}
+
+static uint32_t fadeTarget[2][8];
+
+esp_err_t ledc_set_fade_with_time(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty, int) {
+  fadeTarget[mode & 1][channel & 7] = duty;
+  return ESP_OK;
+}
+
+esp_err_t ledc_fade_start(ledc_mode_t mode, ledc_channel_t channel, ledc_fade_mode_t) {
+  // Canaux 0..7 du cœur Arduino en vitesse rapide, 8..15 en vitesse lente
+  ledcWrite((mode == LEDC_HIGH_SPEED_MODE ? 0 : 8) + (channel & 7), fadeTarget[mode & 1][channel & 7]);
+  return ESP_OK;
+}
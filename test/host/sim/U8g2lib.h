@@ -0,0 +1,11 @@
+// U8g2lib.h (simulateur)
+#pragma once
+#include <stdint.h>
+
+// Polices seulement : le firmware lit les tableaux U8g2 lui-même (font_renderer.cpp).
+// Les définitions sont extraites de u8g2_fonts.c par le Makefile (cible sim), le reste
+// de la bibliothèque (pilotes d'écran, tampons) n'est pas compilé.
+extern "C" {
+extern const uint8_t u8g2_font_logisoso58_tr[];
+extern const uint8_t u8g2_font_helvB24_tf[];
+}
@@ -0,0 +1,189 @@
+// render.cpp (simulateur)
+#include "render.h"
+#include "config.h"
+#include "page_cache.h"
+#include "render_stats.h"
+#include <Adafruit_ST7789.h>
+#include <sys/stat.h>
+#include <vector>
+
+extern Adafruit_ST7789 tft;
+
+// Ordre de l'énumération Page de main.cpp
+static const char *const kPageNames[] = {"page_accueil",     "page_previsions", "page_alerte",
+                                         "page_surveillance", "page_capteurs",   "page_systeme"};
+static const int kPageCount = sizeof(kPageNames) / sizeof(kPageNames[0]);
+
+struct Frame {
+  std::string name;
+  int16_t w, h;
+  std::vector<uint16_t> px;  // RGB565
+  uint32_t transactions;     // transactions SPI vers l'écran pendant le tracé
+  uint64_t pixels;           // pixels envoyés à l'écran
+  uint64_t spiUs;            // durée de la ligne SPI (40 MHz)
+  bool measured;             // tracé d'une page : stats du canevas de comptage
+  RenderStats canvas;
+};
+
+static std::string outDir, refDir;
+static std::vector<Frame> bootFrames;
+static HalDisplayStats mark = {};
+
+static void capture(Frame &f) {
+  f.w = halDisplayWidth();
+  f.h = halDisplayHeight();
+  f.px.resize((size_t)f.w * f.h);
+  for (int16_t y = 0; y < f.h; y++) {
+    for (int16_t x = 0; x < f.w; x++) f.px[(size_t)y * f.w + x] = halDisplayPixel(x, y);
+  }
+}
+
+// Écran de démarrage : ce qui reste affiché pendant l'attente
+static void onBusyWait() {
+  HalHeapExempt host;
+  const HalDisplayStats &d = halDisplayStats();
+  Frame f = {};
+  f.name = "demarrage" + std::to_string(bootFrames.size() + 1);
+  f.transactions = d.transactions - mark.transactions;
+  f.pixels = d.pixels - mark.pixels;
+  capture(f);
+  bootFrames.push_back(std::move(f));
+  mark = d;
+}
+
+void renderBegin(const char *out, const char *ref) {
+  outDir = out;
+  refDir = ref ? ref : "";
+  mkdir(out, 0755); // déjà présent : sans effet
+  mark = halDisplayStats();
+  halOnBusyWait(onBusyWait);
+}
+
+void renderBootDone() {
+  halOnBusyWait(nullptr);
+}
+
+static void rgb888(uint16_t c, uint8_t *out) {
+  out[0] = (uint8_t)((c >> 11 & 0x1f) * 255 / 31);
+  out[1] = (uint8_t)((c >> 5 & 0x3f) * 255 / 63);
+  out[2] = (uint8_t)((c & 0x1f) * 255 / 31);
+}
+
+static bool writePpm(const std::string &path, const Frame &f) {
+  FILE *fp = fopen(path.c_str(), "wb");
+  if (!fp) return false;
+  fprintf(fp, "P6\n%d %d\n255\n", f.w, f.h);
+  for (uint16_t c : f.px) {
+    uint8_t rgb[3];
+    rgb888(c, rgb);
+    fwrite(rgb, 1, 3, fp);
+  }
+  return fclose(fp) == 0;
+}
+
+// Comparaison à l'image de référence de même nom ; résultat en clair dans 'verdict'
+static bool matchesReference(const Frame &f, std::string &verdict) {
+  if (refDir.empty()) return true;
+  FILE *fp = fopen((refDir + "/" + f.name + ".ppm").c_str(), "rb");
+  if (!fp) {
+    verdict = "reference absente";
+    return false;
+  }
+  int w = 0, h = 0, maxval = 0;
+  bool header = fscanf(fp, "P6 %d %d %d", &w, &h, &maxval) == 3 && fgetc(fp) != EOF;
+  std::vector<uint8_t> ref((size_t)w * h * 3);
+  bool ok = header && maxval == 255 && fread(ref.data(), 1, ref.size(), fp) == ref.size();
+  fclose(fp);
+  if (!ok || w != f.w || h != f.h) {
+    verdict = "reference illisible ou d'une autre taille";
+    return false;
+  }
+  uint32_t diff = 0;
+  int x0 = f.w, y0 = f.h, x1 = -1, y1 = -1;
+  for (int y = 0; y < f.h; y++) {
+    for (int x = 0; x < f.w; x++) {
+      uint8_t rgb[3];
+      rgb888(f.px[(size_t)y * f.w + x], rgb);
+      if (!memcmp(rgb, &ref[((size_t)y * f.w + x) * 3], 3)) continue;
+      diff++;
+      x0 = min(x0, x);
+      y0 = min(y0, y);
+      x1 = max(x1, x);
+      y1 = max(y1, y);
+    }
+  }
+  if (!diff) {
+    verdict = "identique";
+    return true;
+  }
+  char buf[80];
+  snprintf(buf, sizeof(buf), "%u pixels differents dans (%d,%d)-(%d,%d)", (unsigned)diff, x0, y0, x1, y1);
+  verdict = buf;
+  return false;
+}
+
+// Écrit l'image, la compare et affiche sa ligne du bilan ; false si elle diffère
+static bool reportFrame(const Frame &f) {
+  std::string path = outDir + "/" + f.name + ".ppm";
+  if (!writePpm(path, f)) {
+    printf("%-18s ERREUR: ecriture de %s impossible\n", f.name.c_str(), path.c_str());
+    return false;
+  }
+  std::string verdict;
+  bool same = matchesReference(f, verdict);
+  if (f.measured) {
+    const RenderStats &st = f.canvas;
+    uint32_t overdrawPct = st.pixelsDistinct ? (st.pixelsWritten - st.pixelsDistinct) * 100 / st.pixelsDistinct : 0;
+    printf("%-18s %8u %8u %5u%% %6u %6u", f.name.c_str(), (unsigned)st.pixelsWritten, (unsigned)st.pixelsDistinct,
+           (unsigned)overdrawPct, (unsigned)st.primitives, (unsigned)st.transactions);
+  } else {
+    printf("%-18s %8s %8s %6s %6s %6s", f.name.c_str(), "-", "-", "-", "-", "-");
+  }
+  printf(" %8u %9llu", (unsigned)f.transactions, (unsigned long long)f.pixels);
+  if (f.measured) printf(" %7.1f", f.spiUs / 1e3);
+  else printf(" %7s", "-");
+  printf("  %s\n", verdict.c_str());
+  return same;
+}
+
+int renderPages() {
+  HalHeapExempt host;
+  PageRenderFn render = pageCacheRenderer();
+  if (!render) {
+    printf("[RENDU] ERREUR: pas de fonction de rendu (cache des pages desactive)\n");
+    return -1;
+  }
+  printf("\n==================== Rendu des ecrans ====================\n");
+  printf("%-18s %8s %8s %6s %6s %6s %8s %9s %7s  %s\n", "image", "pixels", "distinct", "surimp", "prim.",
+         "trans.", "trans.", "pixels", "SPI", refDir.empty() ? "" : "reference");
+  printf("%-18s %35s %8s %9s %7s\n", "", "(canevas de comptage)", "(ecran)", "(ecran)", "(ms)");
+
+  int mismatches = 0;
+  for (const Frame &f : bootFrames) mismatches += !reportFrame(f);
+  for (int p = 0; p < kPageCount; p++) {
+    Frame f = {};
+    f.name = kPageNames[p];
+    f.measured = renderStatsMeasure(render, p, f.canvas);
+    // Tracé complet sur l'écran simulé, depuis un écran noir comme le cache des pages
+    tft.fillScreen(ST77XX_BLACK);
+    HalDisplayStats before = halDisplayStats();
+    uint64_t skipped = halSkippedUs();
+    render(tft, p);
+    const HalDisplayStats &after = halDisplayStats();
+    f.transactions = after.transactions - before.transactions;
+    f.pixels = after.pixels - before.pixels;
+    f.spiUs = halSkippedUs() - skipped;
+    capture(f);
+    mismatches += !reportFrame(f);
+  }
+  printf("Images dans %s/", outDir.c_str());
+  if (!refDir.empty()) printf(", %d differente(s) de %s/ ou sans reference", mismatches, refDir.c_str());
+  printf("\n");
+  struct stat st;
+  if (!refDir.empty() && stat(refDir.c_str(), &st) != 0) {
+    printf("ERREUR: aucune image de reference dans %s/ : les enregistrer avec make render-ref, "
+           "bibliotheques de PlatformIO\n", refDir.c_str());
+  }
+  fflush(stdout);
+  return mismatches;
+}
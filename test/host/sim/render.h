@@ -0,0 +1,18 @@
+// render.h (simulateur)
+#pragma once
+#include "hal.h"
+
+// ====================================================================================
+// Images de rendu (--rendu DIR) : l'écran simulé est capturé à chaque attente active du
+// démarrage (showBootScreen, puis la progression), puis chaque page est tracée avec les
+// données reçues du monde. Une image PPM par écran, coût de chaque tracé (pixels,
+// surimpression, transactions SPI) et comparaison aux images de référence.
+// ====================================================================================
+
+// Avant setup() : captures de l'écran pendant les attentes actives
+void renderBegin(const char *outDir, const char *refDir);
+// Après setup() : enregistre les écrans de démarrage
+void renderBootDone();
+// Trace et enregistre chaque page ; nombre d'images différentes de leur référence ou
+// sans référence (-1 : rendu impossible)
+int renderPages();
@@ -0,0 +1,23 @@
+// secrets.h (simulateur)
+#pragma once
+// Jetons factices : le firmware refuse les valeurs d'exemple (YOUR_...) et n'interroge
+// alors aucun service ; les serveurs simulés (sim/world.cpp) acceptent ceux-ci.
+#define WIFI_SSID1 "maison"
+#define WIFI_PASS1 "mot-de-passe-maison"
+#define WIFI_SSID2 "atelier"
+#define WIFI_PASS2 "mot-de-passe-atelier"
+
+#define TOKEN_METEOCONSULT "sim-meteoconsult"
+#define TOKEN_OPENWEATHER "sim0123456789abcdef0123456789abcd"
+#define TOKEN_WEATHERBIT "sim-weatherbit"
+#define TOKEN_WEATHERBIT_ALT "sim-weatherbit-alt"
+#define TOKEN_ACCUWEATHER "sim-accuweather"
+#define ACCU_LOCATION_KEY "sim-location"
+
+#define TOKEN_UBLOX_AGPS "sim-ublox-token"
+
+#define TELEGRAM_BOT_TOKEN "123456:sim-telegram-token"
+#define TELEGRAM_CHAT_ID "424242"
+
+#define OTA_HTTP_TOKEN "sim-ota-token"
+#define OTA_SIGNING_PUBKEY ""
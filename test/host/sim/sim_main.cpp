@@ -0,0 +1,196 @@
+// sim_main.cpp (simulateur)
+// Exécute setup() puis loop() du firmware, inchangés, sous l'horloge virtuelle de la
+// couche hôte : chaque attente de la boucle (ulTaskNotifyTake) saute directement au
+// prochain événement du monde (sim/world.cpp). Une semaine simulée dure quelques
+// secondes ; le bilan donne le débit de la boucle, le temps de chaque tâche et le tas.
+// --tas (make soak) relève en plus le tas chaque jour à minuit et estime sa dérive.
+// --gps-configure (make gps-chaud) : récepteur déjà à GPS_BAUD, comme après un redémarrage
+// de l'ESP32 seul. Code retour 1 si le récepteur est illisible à la fin.
+// --rendu DIR (make render) capture le démarrage puis trace chaque page (sim/render.cpp).
+//
+//   make sim SIM_ARGS="--jours 7 --graine 3 --bavard"
+//   make soak SIM_ARGS="--jours 60"
+//   make render
+#include "hal.h"
+#include "heap_monitor.h"
+#include "render.h"
+#include "scheduler.h"
+#include "world.h"
+#include <chrono>
+#include <vector>
+
+void setup();
+void loop();
+
+static std::chrono::steady_clock::time_point hostStart;
+static uint64_t idleUs = 0;    // temps simulé passé en attente dans la boucle
+static uint32_t idleCalls = 0;
+
+// Relevé quotidien du tas (--tas), pris dans l'attente de la boucle : aucune tâche en cours
+struct HeapDay {
+  uint32_t freeHeap, largest, minFree, allocs;
+};
+static bool heapDaily = false;
+static std::vector<HeapDay> heapDays;
+
+static void sampleHeapDay() {
+  uint32_t day = (uint32_t)(halMicros64() / 86400000000ULL);
+  if (day <= heapDays.size()) return;
+  HeapDay d = {ESP.getFreeHeap(), ESP.getMaxAllocHeap(), ESP.getMinFreeHeap(), halHeapCounters().allocs};
+  heapDays.push_back(d);
+  printf("[TAS] jour %u : libre %u o, plus grand bloc %u o, minimum %u o, %u allocations\n", (unsigned)day,
+         (unsigned)d.freeHeap, (unsigned)d.largest, (unsigned)d.minFree, (unsigned)d.allocs);
+  fflush(stdout);
+}
+
+static void onIdle(uint64_t untilUs) {
+  HalHeapExempt world; // le monde simulé n'est pas dans le tas de la cible
+  uint64_t before = halMicros64();
+  worldAdvance(untilUs);
+  idleUs += halMicros64() - before;
+  idleCalls++;
+  if (heapDaily) sampleHeapDay();
+}
+
+static void allocCounter(uint32_t &allocs, uint64_t &bytes) {
+  allocs = halHeapCounters().allocs;
+  bytes = halHeapCounters().bytes;
+}
+
+// Pente (octets par jour) des relevés quotidiens par moindres carrés ; le premier relevé
+// est pris au premier minuit, après le démarrage
+static double heapDrift(uint32_t HeapDay::*field) {
+  size_t n = heapDays.size();
+  if (n < 3) return 0;
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (size_t i = 0; i < n; i++) {
+    double x = (double)i, y = heapDays[i].*field;
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+static void heapReport() {
+  const HeapStats &h = heapMonitorStats();
+  const HalHeapCounters &c = halHeapCounters();
+  printf("Tas : %u o libres, plus grand bloc %u o (min %u o), minimum %u o, pic d'utilisation %u o\n",
+         (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMaxAllocHeap(), (unsigned)h.minLargestBlock,
+         (unsigned)ESP.getMinFreeHeap(), (unsigned)h.peakUsed);
+  printf("  %u allocations (%llu o), %u sans bloc assez grand sur la cible\n", (unsigned)c.allocs,
+         (unsigned long long)c.bytes, (unsigned)c.failures);
+  uint32_t trend[HEAP_TREND_LEN];
+  uint8_t n = heapMonitorTrend(trend, HEAP_TREND_LEN);
+  printf("  plus grand bloc, 1 point par heure :");
+  for (uint8_t i = 0; i < n; i++) printf(" %u", (unsigned)trend[i]);
+  printf("\n  %-9s %8s %11s %13s %10s %10s %11s\n", "site", "appels", "allocations", "octets", "par appel",
+         "pire var.", "min sortie");
+  for (uint8_t i = 0; i < HEAP_SITE_COUNT; i++) {
+    const HeapSiteStats &s = heapMonitorSite((HeapSite)i);
+    if (!s.calls) continue;
+    printf("  %-9s %8u %11u %13llu %10.1f %10d %11u\n", heapSiteName((HeapSite)i), (unsigned)s.calls,
+           (unsigned)s.allocs, (unsigned long long)s.allocBytes, (double)s.allocs / s.calls, (int)s.worstFreeDelta,
+           (unsigned)s.minFreeAfter);
+  }
+  if (heapDaily && heapDays.size() >= 3) {
+    printf("  derive sur %u jours : libre %+.0f o/jour, plus grand bloc %+.0f o/jour\n", (unsigned)heapDays.size(),
+           heapDrift(&HeapDay::freeHeap), heapDrift(&HeapDay::largest));
+  }
+}
+
+static void report() {
+  double hostS = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+  uint64_t simUs = halMicros64();
+  double simS = simUs / 1e6;
+  uint32_t loops = schedulerLoopCount();
+
+  fflush(stdout);
+  halConsoleEcho(true);
+  printf("\n==================== Bilan du simulateur ====================\n");
+  printf("Temps simule : %.2f jours (%.0f s) en %.2f s sur l'hote (x%.0f)\n", simS / 86400, simS, hostS,
+         hostS > 0 ? simS / hostS : 0);
+  printf("Boucle : %u iterations, %.2f /s simulee, %.0f /s hote ; %u attentes, %.1f %% du temps en attente\n",
+         (unsigned)loops, simS > 0 ? loops / simS : 0, hostS > 0 ? loops / hostS : 0, (unsigned)idleCalls,
+         simUs ? 100.0 * idleUs / simUs : 0);
+
+  // Temps (horloge virtuelle) par tâche : inclut les latences réseau simulées
+  uint64_t jobsUs = 0;
+  printf("%-14s %9s %12s %10s %9s\n", "tache", "passages", "total (ms)", "moy (us)", "max (ms)");
+  for (uint8_t i = 0; i < schedulerJobCount(); i++) {
+    SchedJobTotals t;
+    if (!schedulerJobTotals(i, t)) continue;
+    jobsUs += t.totalUs;
+    printf("%-14s %9u %12.1f %10.0f %9.1f\n", t.name, (unsigned)t.runs, t.totalUs / 1e3,
+           t.runs ? (double)t.totalUs / t.runs : 0, t.maxUs / 1e3);
+  }
+  uint64_t busyUs = simUs - idleUs;
+  printf("%-14s %9s %12.1f\n", "boucle", "-", busyUs > jobsUs ? (busyUs - jobsUs) / 1e3 : 0);
+
+  const HalNetStats &n = halNetStats();
+  printf("Reseau : %u connexions WiFi (%u echecs), %u connexions TCP (%u echecs), %u requetes, %llu o emis, %llu o recus\n",
+         (unsigned)n.wifiJoins, (unsigned)n.wifiJoinFailures, (unsigned)n.connects, (unsigned)n.connectFailures,
+         (unsigned)n.requests, (unsigned long long)n.bytesSent, (unsigned long long)n.bytesReceived);
+  const HalDisplayStats &d = halDisplayStats();
+  printf("Ecran : %u transactions SPI, %u commandes, %llu pixels, %u mises en veille\n", (unsigned)d.transactions,
+         (unsigned)d.commands, (unsigned long long)d.pixels, (unsigned)d.sleeps);
+  heapReport();
+  worldReport();
+  fflush(stdout);
+}
+
+// Images de rendu : météo, position et liste de surveillance reçues, alerte en cours
+static const uint64_t kRenderAtUs = 300000000ULL;
+
+int main(int argc, char **argv) {
+  WorldConfig cfg = {1759730400, 7, 1, false, false, false}; // lundi 6 octobre 2025, 8 h (heure de Paris)
+  const char *renderDir = nullptr, *referenceDir = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--jours") && i + 1 < argc) cfg.days = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--graine") && i + 1 < argc) cfg.seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+    else if (!strcmp(argv[i], "--bavard")) cfg.verbose = true;
+    else if (!strcmp(argv[i], "--tas")) heapDaily = true;
+    else if (!strcmp(argv[i], "--gps-configure")) cfg.gpsConfigured = true;
+    else if (!strcmp(argv[i], "--rendu") && i + 1 < argc) renderDir = argv[++i];
+    else if (!strcmp(argv[i], "--reference") && i + 1 < argc) referenceDir = argv[++i];
+    else {
+      fprintf(stderr, "usage: %s [--jours N] [--graine N] [--bavard] [--tas] [--gps-configure]\n"
+              "       [--rendu DIR [--reference DIR]]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+  if (!cfg.days) cfg.days = 1;
+  cfg.alertNow = renderDir != nullptr;
+
+  hostStart = std::chrono::steady_clock::now();
+  halConsoleEcho(cfg.verbose);
+  // Les attentes actives (while (millis() < fin)) du firmware avancent l'horloge
+  halSetMillisCostUs(1);
+  halOnIdle(onIdle);
+  halOnRestart(report);
+  {
+    HalHeapExempt world;
+    if (!worldBegin(cfg)) return 1;
+  }
+  ESP.getFreeHeap(); // début du tas simulé, avant setup()
+  heapMonitorSetAllocCounter(allocCounter);
+
+  uint64_t endUs = renderDir ? kRenderAtUs : cfg.days * 86400000000ULL;
+  if (renderDir) renderBegin(renderDir, referenceDir);
+  setup();
+  if (renderDir) renderBootDone();
+  while (halMicros64() < endUs) {
+    loop();
+    HalHeapExempt world;
+    worldPump();
+  }
+  if (renderDir) return renderPages() ? 1 : 0;
+  report();
+  if (!worldGpsOk()) {
+    printf("ERREUR: recepteur GPS illisible ou non configure\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,585 @@
+// world.cpp (simulateur)
+#include "world.h"
+#include "config.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+extern HardwareSerial GPS; // src/gps.cpp
+
+static WorldConfig cfg;
+static uint32_t rng = 1;
+static uint64_t endUs = 0;
+
+// Pseudo-aléatoire déterministe (LCG) : [0, 1)
+static float frand() {
+  rng = rng * 1664525u + 1013904223u;
+  return (rng >> 8) / 16777216.0f;
+}
+
+static time_t worldEpoch() {
+  return cfg.startEpoch + (time_t)(halMicros64() / 1000000);
+}
+
+// Heure locale en heures décimales (fuseau du firmware)
+static double localHours(time_t t) {
+  struct tm lt;
+  localtime_r(&t, &lt);
+  return lt.tm_hour + lt.tm_min / 60.0 + lt.tm_sec / 3600.0;
+}
+
+// Instant (µs depuis le démarrage) d'une heure locale du jour day du scénario
+static uint64_t localAt(uint32_t day, int hour, int minute, int second = 0) {
+  time_t t = cfg.startEpoch;
+  struct tm lt;
+  localtime_r(&t, &lt);
+  lt.tm_mday += day;
+  lt.tm_hour = hour;
+  lt.tm_min = minute;
+  lt.tm_sec = second;
+  lt.tm_isdst = -1;
+  time_t at = mktime(&lt);
+  return at > cfg.startEpoch ? (uint64_t)(at - cfg.startEpoch) * 1000000 : 0;
+}
+
+static std::string loadFile(const char *path) {
+  std::string s;
+  if (FILE *fp = fopen(path, "rb")) {
+    char buf[4096];
+    size_t got;
+    while ((got = fread(buf, 1, sizeof(buf), fp)) > 0) s.append(buf, got);
+    fclose(fp);
+  }
+  return s;
+}
+
+// ====================================================================================
+// Événements programmés : boutons, coupures WiFi
+// ====================================================================================
+enum EventKind : uint8_t { EV_PIN, EV_WIFI };
+struct Event {
+  uint64_t us;
+  EventKind kind;
+  uint8_t pin;
+  int level;
+};
+static std::vector<Event> events;
+static size_t nextEvent = 0;
+// Fronts des boutons à part : livrés aussi pendant les attentes bloquantes du firmware
+static std::vector<Event> pinEvents;
+static size_t nextPinEvent = 0;
+static void deliverPins(uint64_t untilUs);
+
+static struct {
+  uint32_t presses;
+  uint32_t outages;
+  uint32_t gpsSentences;
+  uint32_t gpsBytes;
+  uint32_t gpsDropped; // débit de l'UART différent de celui du récepteur
+  uint32_t ppsPulses;
+  uint32_t ubxAcks;
+  uint32_t aidBytes;
+  uint64_t fixUs;
+  uint32_t owmFull, owmCurrent, owmRefused;
+  uint32_t agpsDownloads;
+  uint32_t tgPolls, tgSent, tgCommands;
+} stats = {};
+
+static void press(uint64_t us, uint8_t pin, uint32_t holdMs, bool bounce = false) {
+  if (us < endUs) stats.presses++;
+  pinEvents.push_back({us, EV_PIN, pin, LOW});
+  if (bounce) {
+    // Rebonds du contact : deux fronts parasites dans les 3 ms
+    pinEvents.push_back({us + 1000, EV_PIN, pin, HIGH});
+    pinEvents.push_back({us + 2500, EV_PIN, pin, LOW});
+  }
+  pinEvents.push_back({us + holdMs * 1000ULL, EV_PIN, pin, HIGH});
+}
+
+static void outage(uint64_t us, uint32_t minutes) {
+  events.push_back({us, EV_WIFI, 0, 0});
+  events.push_back({us + minutes * 60000000ULL, EV_WIFI, 0, 1});
+}
+
+// Une journée type : consultation le matin, rafraîchissement forcé à midi, prévisions
+// et alertes le soir ; coupure du point d'accès chaque nuit, longue le troisième jour
+static void scheduleDay(uint32_t d) {
+  uint64_t t = localAt(d, 7, 30);
+  press(t, PIN_BTN1, 150, true); // réveil de l'écran
+  for (int i = 1; i <= 5; i++) press(t + i * 4000000ULL, PIN_BTN1, 120, i == 3);
+  press(t + 24000000ULL, PIN_BTN1, 80);  // deux appuis rapides : deux pages
+  press(t + 24180000ULL, PIN_BTN1, 80);
+  press(t + 28000000ULL, PIN_BTN1, 300); // BTN1 + BTN2 ensemble : retour à l'accueil
+  press(t + 28100000ULL, PIN_BTN2, 150);
+
+  t = localAt(d, 12, 30);
+  press(t, PIN_BTN2, 150);
+  press(t + 3000000ULL, PIN_BTN2, 1500); // appui long : météo forcée
+
+  t = localAt(d, 19, 0);
+  press(t, PIN_BTN1, 150);
+  press(t + 3000000ULL, PIN_BTN1, 120);  // page prévisions
+  press(t + 6000000ULL, PIN_BTN1, 2500); // maintien : défilement des jours
+  press(t + 12000000ULL, PIN_BTN1, 120); // page alertes
+  press(t + 15000000ULL, PIN_BTN1, 1200);
+
+  outage(localAt(d, 3, 10), 15);
+  if (d == 2) outage(localAt(d, 14, 0), 120);
+}
+
+// ====================================================================================
+// Récepteur GPS (GT-U7, u-blox 7)
+// ====================================================================================
+static const double kTrueLat = 44.84120, kTrueLon = -0.57450, kTrueAltM = 38.5;
+
+static struct {
+  uint32_t baud = 9600;
+  bool gll = true, gsa = true, gsv = true, vtg = true;
+  uint16_t rateMs = 1000;
+  uint32_t ephemerides = 0; // AID-EPH reçus
+  uint64_t fixAtUs = 0;
+  uint64_t nextUs = 1000000;
+  std::vector<uint8_t> rx; // trame UBX en cours de réception
+} gps;
+
+static void gpsSend(const uint8_t *data, size_t n) {
+  if (GPS.baudRate() != gps.baud) {
+    stats.gpsDropped += n; // octets illisibles à un autre débit
+    return;
+  }
+  GPS.halReceive(data, n);
+  stats.gpsBytes += n;
+}
+
+static void gpsSentence(const char *body) {
+  uint8_t cs = 0;
+  for (const char *p = body; *p; p++) cs ^= (uint8_t)*p;
+  char line[128];
+  int n = snprintf(line, sizeof(line), "$%s*%02X\r\n", body, cs);
+  gpsSend((const uint8_t *)line, n);
+  stats.gpsSentences++;
+}
+
+static void ubxAck(uint8_t cls, uint8_t id) {
+  uint8_t f[10] = {0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, cls, id, 0, 0};
+  for (int i = 2; i < 8; i++) {
+    f[8] += f[i];
+    f[9] += f[8];
+  }
+  gpsSend(f, sizeof(f));
+  stats.ubxAcks++;
+}
+
+static void ubxMessage(uint8_t cls, uint8_t id, const uint8_t *p, uint16_t len) {
+  if (cls == 0x06) { // CFG
+    if (id == 0x00 && len >= 12) {
+      // CFG-PRT : l'ACK part déjà au nouveau débit
+      gps.baud = p[8] | p[9] << 8 | p[10] << 16 | (uint32_t)p[11] << 24;
+    } else if (id == 0x01 && len >= 3 && p[0] == 0xF0) {
+      bool on = p[2] != 0;
+      if (p[1] == 0x01) gps.gll = on;
+      if (p[1] == 0x02) gps.gsa = on;
+      if (p[1] == 0x03) gps.gsv = on;
+      if (p[1] == 0x05) gps.vtg = on;
+    } else if (id == 0x08 && len >= 2) {
+      gps.rateMs = p[0] | p[1] << 8;
+    }
+    ubxAck(cls, id);
+  } else if (cls == 0x0B) { // AID : pas d'ACK sur u-blox 7
+    stats.aidBytes += len + 8;
+    if (id == 0x31 && ++gps.ephemerides == 4 && !stats.fixUs) {
+      // Éphémérides et position approchée : fix en quelques secondes au lieu d'un démarrage à froid
+      gps.fixAtUs = std::min(gps.fixAtUs, halMicros64() + (uint64_t)(5000 + frand() * 3000) * 1000);
+    }
+  }
+}
+
+// Octets émis par le firmware sur l'UART du GPS
+static void gpsOnTransmit(const uint8_t *data, size_t n) {
+  if (GPS.baudRate() != gps.baud) return;
+  for (size_t i = 0; i < n; i++) {
+    std::vector<uint8_t> &rx = gps.rx;
+    uint8_t b = data[i];
+    if ((rx.empty() && b != 0xB5) || (rx.size() == 1 && b != 0x62)) {
+      rx.clear();
+      continue;
+    }
+    rx.push_back(b);
+    if (rx.size() < 6) continue;
+    uint16_t len = rx[4] | rx[5] << 8;
+    if (rx.size() < 8u + len) continue;
+    uint8_t a = 0, c = 0;
+    for (size_t k = 2; k < 6u + len; k++) {
+      a += rx[k];
+      c += a;
+    }
+    if (a == rx[6 + len] && c == rx[7 + len]) ubxMessage(rx[2], rx[3], rx.data() + 6, len);
+    rx.clear();
+  }
+}
+
+static void formatCoord(char *out, size_t size, double v, bool lat) {
+  double a = fabs(v);
+  int deg = (int)a;
+  snprintf(out, size, lat ? "%02d%08.5f,%c" : "%03d%08.5f,%c", deg, (a - deg) * 60.0,
+           lat ? (v >= 0 ? 'N' : 'S') : (v >= 0 ? 'E' : 'W'));
+}
+
+// Une époque de navigation : PPS (avec fix), puis les trames activées
+static void gpsEpoch() {
+  time_t t = worldEpoch();
+  struct tm u;
+  gmtime_r(&t, &u);
+  char hms[16], dmy[8], body[120];
+  strftime(hms, sizeof(hms), "%H%M%S.00", &u);
+  strftime(dmy, sizeof(dmy), "%d%m%y", &u);
+  bool fix = halMicros64() >= gps.fixAtUs;
+  if (fix && !stats.fixUs) stats.fixUs = halMicros64();
+
+  if (fix) {
+    halSetPin(PIN_GPS_PPS, HIGH); // impulsion de 100 ms : seul le front montant compte
+    halSetPin(PIN_GPS_PPS, LOW);
+    stats.ppsPulses++;
+    char lat[24], lon[24];
+    formatCoord(lat, sizeof(lat), kTrueLat + (frand() - 0.5f) * 2e-5, true);
+    formatCoord(lon, sizeof(lon), kTrueLon + (frand() - 0.5f) * 2e-5, false);
+    int sats = 7 + (int)(frand() * 4);
+    float hdop = 0.9f + frand() * 0.4f;
+    snprintf(body, sizeof(body), "GPRMC,%s,A,%s,%s,0.%03d,,%s,,,A", hms, lat, lon, (int)(frand() * 200), dmy);
+    gpsSentence(body);
+    if (gps.vtg) gpsSentence("GPVTG,,T,,M,0.051,N,0.094,K,A");
+    snprintf(body, sizeof(body), "GPGGA,%s,%s,%s,1,%02d,%.2f,%.1f,M,49.1,M,,", hms, lat, lon, sats, hdop,
+             kTrueAltM + (frand() - 0.5f) * 3);
+    gpsSentence(body);
+    if (gps.gsa) gpsSentence("GPGSA,A,3,05,13,15,18,20,24,29,,,,,,1.71,1.02,1.37");
+    if (gps.gsv) {
+      gpsSentence("GPGSV,3,1,10,05,42,305,38,13,31,061,33,15,58,098,41,18,22,290,29");
+      gpsSentence("GPGSV,3,2,10,20,48,164,43,24,15,038,24,29,69,242,44,02,07,347,");
+      gpsSentence("GPGSV,3,3,10,10,03,126,,23,11,203,");
+    }
+    if (gps.gll) {
+      snprintf(body, sizeof(body), "GPGLL,%s,%s,%s,A,A", lat, lon, hms);
+      gpsSentence(body);
+    }
+  } else {
+    snprintf(body, sizeof(body), "GPRMC,%s,V,,,,,,,%s,,,N", hms, dmy);
+    gpsSentence(body);
+    if (gps.vtg) gpsSentence("GPVTG,,,,,,,,,N");
+    snprintf(body, sizeof(body), "GPGGA,%s,,,,,0,00,99.99,,,,,,", hms);
+    gpsSentence(body);
+    if (gps.gsa) gpsSentence("GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99");
+    if (gps.gsv) gpsSentence("GPGSV,1,1,00");
+    if (gps.gll) {
+      snprintf(body, sizeof(body), "GPGLL,,,,,%s,V,N", hms);
+      gpsSentence(body);
+    }
+  }
+}
+
+// ====================================================================================
+// Capteurs : BME280 intérieur et lumière ambiante
+// ====================================================================================
+static uint64_t envNextUs = 0;
+
+static void environment() {
+  double days = halMicros64() / 86400e6;
+  double h = localHours(worldEpoch());
+  double day = cos(2 * PI * (h - 17) / 24); // maximum en fin d'après-midi
+  float temp = 20.5f + 1.2f * day + (frand() - 0.5f) * 0.1f;
+  float hum = 48.0f - 6.0f * day + (frand() - 0.5f) * 0.8f;
+  // Pression mer : ondulation synoptique, dépression au 4e jour, marée semi-diurne ;
+  // la station est à ~40 m (-4.8 hPa)
+  double sea = 1016 + 9 * sin(2 * PI * days / 4.2) - 14 * exp(-pow((days - 3.5) / 0.6, 2)) +
+               0.6 * cos(4 * PI * (h - 10) / 24);
+  halBme280(temp, hum, (float)(sea - 4.8 + (frand() - 0.5) * 0.1));
+
+  // Lumière : jour (lever 7h45, coucher 19h15), lampe le soir jusqu'à 23h
+  uint16_t adc;
+  if (h > 7.75 && h < 19.25) adc = (uint16_t)(600 + 3400 * sin(PI * (h - 7.75) / 11.5));
+  else if (h >= 19.25 && h < 23.0) adc = 800;
+  else adc = 40;
+  halSetAnalog(PIN_LIGHT_SENSOR, adc + (uint16_t)(frand() * 30));
+}
+
+// ====================================================================================
+// Serveurs HTTP
+// ====================================================================================
+static std::string onecallFull, onecallCurrent, alertJson;
+static time_t fixtureEpoch = 0; // current.dt des fixtures
+
+// Décale les dates des fixtures (dt, lever et coucher, début et fin d'alerte)
+static std::string shiftTimes(std::string s, long long offset) {
+  static const char *const keys[] = {"\"dt\":", "\"sunrise\":", "\"sunset\":", "\"moonrise\":",
+                                     "\"moonset\":", "\"start\":", "\"end\":"};
+  for (const char *key : keys) {
+    size_t klen = strlen(key);
+    for (size_t i = s.find(key); i != std::string::npos; i = s.find(key, i + 1)) {
+      size_t b = i + klen, e = b;
+      while (e < s.size() && isdigit((unsigned char)s[e])) e++;
+      if (e == b) continue;
+      s.replace(b, e - b, std::to_string(atoll(s.substr(b, e - b).c_str()) + offset));
+    }
+  }
+  return s;
+}
+
+static bool queryHas(const std::string &path, const char *param) {
+  return path.find(param) != std::string::npos;
+}
+
+// Alerte active du 2e jour midi au 3e jour 6 h (dès le démarrage avec alertNow) ;
+// service indisponible le 4e jour de 10 h à 10 h 45
+static bool owmHandler(const HalHttpRequest &req, HalHttpResponse &resp) {
+  uint64_t now = halMicros64();
+  if (req.path.rfind("/data/2.5/onecall?", 0) != 0) {
+    resp.status = 404;
+    resp.body = "{\"cod\":\"404\",\"message\":\"Internal error\"}";
+    return true;
+  }
+  if (!queryHas(req.path, "appid=" TOKEN_OPENWEATHER)) {
+    resp.status = 401;
+    resp.body = "{\"cod\":401,\"message\":\"Invalid API key.\"}";
+    return true;
+  }
+  if (now >= localAt(3, 10, 0) && now < localAt(3, 10, 45)) {
+    resp.status = 503;
+    resp.contentType = "text/html";
+    resp.body = "<html><body>Service Unavailable</body></html>";
+    resp.latencyMs = 40;
+    stats.owmRefused++;
+    return true;
+  }
+  long long offset = (long long)(worldEpoch() - fixtureEpoch) / 3600 * 3600;
+  bool currentOnly = queryHas(req.path, "exclude=minutely,hourly,daily");
+  std::string body = currentOnly ? onecallCurrent : onecallFull;
+  bool alert = cfg.alertNow || (now >= localAt(1, 12, 0) && now < localAt(2, 6, 0));
+  if (alert && !alertJson.empty()) {
+    body.insert(body.size() - 1, ",\"alerts\":" + alertJson);
+  }
+  resp.body = shiftTimes(body, offset);
+  resp.latencyMs = currentOnly ? 150 : 350;
+  (currentOnly ? stats.owmCurrent : stats.owmFull)++;
+  return true;
+}
+
+// Telegram : commandes du chat autorisé, plus une commande d'un inconnu (à ignorer)
+struct TgUpdate {
+  long id;
+  uint64_t atUs;
+  long long chat;
+  const char *text;
+};
+static std::vector<TgUpdate> tgPending;
+
+static void scheduleTelegram(uint32_t d) {
+  tgPending.push_back({0, localAt(d, 8, 5), atoll(TELEGRAM_CHAT_ID), "/meteo"});
+  tgPending.push_back({0, localAt(d, 20, 15), atoll(TELEGRAM_CHAT_ID), "/temp"});
+  if (d == 1) tgPending.push_back({0, localAt(d, 10, 0), 999001, "/reboot"});
+}
+
+static bool telegramHandler(const HalHttpRequest &req, HalHttpResponse &resp) {
+  static const std::string prefix = "/bot" TELEGRAM_BOT_TOKEN "/";
+  resp.latencyMs = 180;
+  if (req.path.compare(0, prefix.size(), prefix) != 0) {
+    resp.status = 401;
+    resp.body = "{\"ok\":false,\"error_code\":401,\"description\":\"Unauthorized\"}";
+    return true;
+  }
+  std::string method = req.path.substr(prefix.size());
+  if (method.compare(0, 10, "getUpdates") == 0) {
+    stats.tgPolls++;
+    size_t o = method.find("offset=");
+    long offset = o == std::string::npos ? 0 : atol(method.c_str() + o + 7);
+    // Les mises à jour d'identifiant < offset sont acquittées et disparaissent
+    tgPending.erase(std::remove_if(tgPending.begin(), tgPending.end(), [offset](const TgUpdate &u) { return u.id < offset; }),
+                    tgPending.end());
+    std::string body = "{\"ok\":true,\"result\":[";
+    bool first = true;
+    for (const TgUpdate &u : tgPending) {
+      if (u.atUs > halMicros64()) continue;
+      char item[256];
+      snprintf(item, sizeof(item),
+               "%s{\"update_id\":%ld,\"message\":{\"message_id\":%ld,\"from\":{\"id\":%lld,\"is_bot\":false,"
+               "\"first_name\":\"Sim\"},\"chat\":{\"id\":%lld,\"type\":\"private\"},\"date\":%lld,\"text\":\"%s\"}}",
+               first ? "" : ",", u.id, u.id - 6900, u.chat, u.chat, (long long)worldEpoch(), u.text);
+      body += item;
+      first = false;
+      stats.tgCommands++;
+    }
+    resp.body = body + "]}";
+    return true;
+  }
+  if (method == "sendMessage") {
+    stats.tgSent++;
+    if (cfg.verbose) printf("[MONDE] Telegram <- %s\n", req.body.c_str());
+    resp.body = "{\"ok\":true,\"result\":{\"message_id\":1}}";
+    return true;
+  }
+  resp.status = 404;
+  resp.body = "{\"ok\":false,\"error_code\":404,\"description\":\"Not Found\"}";
+  return true;
+}
+
+// AssistNow Online : messages AID-INI, AID-HUI, AID-ALM et AID-EPH (contenu factice)
+static void ubxAppend(std::string &out, uint8_t cls, uint8_t id, uint16_t len) {
+  std::string m = {(char)0xB5, (char)0x62, (char)cls, (char)id, (char)(len & 0xFF), (char)(len >> 8)};
+  for (uint16_t i = 0; i < len; i++) m += (char)(frand() * 256);
+  uint8_t a = 0, b = 0;
+  for (size_t i = 2; i < m.size(); i++) {
+    a += (uint8_t)m[i];
+    b += a;
+  }
+  out += m;
+  out += (char)a;
+  out += (char)b;
+}
+
+static bool agpsHandler(const HalHttpRequest &req, HalHttpResponse &resp) {
+  if (req.path.find("token=" TOKEN_UBLOX_AGPS) == std::string::npos) {
+    resp.status = 403;
+    resp.contentType = "text/plain";
+    resp.body = "Forbidden";
+    return true;
+  }
+  stats.agpsDownloads++;
+  resp.contentType = "application/ubx";
+  resp.latencyMs = 600;
+  ubxAppend(resp.body, 0x0B, 0x01, 48);
+  ubxAppend(resp.body, 0x0B, 0x02, 72);
+  for (int i = 0; i < 32; i++) ubxAppend(resp.body, 0x0B, 0x30, 40);
+  for (int i = 0; i < 9; i++) ubxAppend(resp.body, 0x0B, 0x31, 104);
+  return true;
+}
+
+// ====================================================================================
+bool worldBegin(const WorldConfig &c) {
+  cfg = c;
+  rng = cfg.seed ? cfg.seed : 1;
+  endUs = (uint64_t)cfg.days * 86400000000ULL;
+  setenv("TZ", TZ_STRING, 1);
+  tzset();
+  halSetEpoch(cfg.startEpoch);
+  halSetNtpEpoch(cfg.startEpoch);
+  if (cfg.gpsConfigured) {
+    // L'ESP32 seul a redémarré : le récepteur garde la configuration de la session précédente
+    gps.baud = GPS_BAUD;
+    gps.gll = gps.gsa = gps.gsv = gps.vtg = false;
+    gps.rateMs = GPS_NAV_RATE_MS;
+  }
+
+  onecallFull = loadFile("fixtures/sim/onecall.json");
+  onecallCurrent = loadFile("fixtures/sim/onecall_courant.json");
+  alertJson = loadFile("fixtures/sim/alerte.json");
+  if (onecallFull.empty() || onecallCurrent.empty()) {
+    printf("[MONDE] ERREUR: fixtures/sim/onecall*.json introuvables (lancer depuis test/host)\n");
+    return false;
+  }
+  size_t dt = onecallFull.find("\"dt\":");
+  fixtureEpoch = dt == std::string::npos ? cfg.startEpoch : atoll(onecallFull.c_str() + dt + 5);
+
+  halWifiAddAp(WIFI_SSID1, WIFI_PASS1, 6, -58);
+  halWifiAddAp(WIFI_SSID2, WIFI_PASS2, 11, -74);
+  halHttpRoute("api.openweathermap.org", owmHandler);
+  halHttpRoute("api.telegram.org", telegramHandler);
+  halHttpRoute("online-live1.services.u-blox.com", agpsHandler);
+
+  // Boutons relâchés (pull-up), pas d'impulsion PPS avant le fix
+  halSetPin(PIN_BTN1, HIGH);
+  halSetPin(PIN_BTN2, HIGH);
+  halSetPin(PIN_GPS_PPS, LOW);
+  GPS.halOnTransmit(gpsOnTransmit);
+  gps.fixAtUs = (uint64_t)(28000 + frand() * 8000) * 1000; // démarrage à froid
+
+  for (uint32_t d = 0; d <= cfg.days; d++) {
+    scheduleDay(d);
+    scheduleTelegram(d);
+  }
+  auto byTime = [](const Event &a, const Event &b) { return a.us < b.us; };
+  std::stable_sort(events.begin(), events.end(), byTime);
+  std::stable_sort(pinEvents.begin(), pinEvents.end(), byTime);
+  halOnAdvance(deliverPins);
+  // update_id croissants dans l'ordre d'arrivée, comme chez Telegram
+  std::stable_sort(tgPending.begin(), tgPending.end(), [](const TgUpdate &a, const TgUpdate &b) { return a.atUs < b.atUs; });
+  for (size_t i = 0; i < tgPending.size(); i++) tgPending[i].id = 7000 + (long)i;
+  environment();
+  envNextUs = 60000000;
+  return true;
+}
+
+static uint64_t nextDueUs() {
+  uint64_t next = std::min(gps.nextUs, envNextUs);
+  if (nextEvent < events.size()) next = std::min(next, events[nextEvent].us);
+  if (nextPinEvent < pinEvents.size()) next = std::min(next, pinEvents[nextPinEvent].us);
+  return next;
+}
+
+// Avance de l'horloge (delay, attente de la boucle) : chaque front de bouton échu est
+// livré à son instant, comme l'interruption sur la cible horodate le front pendant
+// qu'une tâche bloque loop()
+static void deliverPins(uint64_t untilUs) {
+  while (nextPinEvent < pinEvents.size() && pinEvents[nextPinEvent].us <= untilUs) {
+    const Event &e = pinEvents[nextPinEvent++];
+    uint64_t now = halMicros64();
+    if (e.us > now) halAdvanceUs(e.us - now);
+    halSetPin(e.pin, e.level);
+  }
+}
+
+// Livre tout ce qui est échu ; true si quelque chose l'a été
+static bool deliverDue() {
+  uint64_t now = halMicros64();
+  bool any = nextPinEvent < pinEvents.size() && pinEvents[nextPinEvent].us <= now;
+  deliverPins(now);
+  while (nextEvent < events.size() && events[nextEvent].us <= now) {
+    const Event &e = events[nextEvent++];
+    halWifiLink(e.level != 0);
+    if (!e.level) stats.outages++;
+    if (cfg.verbose) printf("[MONDE] Point d'acces %s\n", e.level ? "retabli" : "coupe");
+    any = true;
+  }
+  if (gps.nextUs <= now) {
+    gpsEpoch();
+    // Époque suivante alignée sur la période (les secondes manquées ne sont pas rattrapées)
+    uint64_t period = gps.rateMs * 1000ULL;
+    gps.nextUs = (now / period + 1) * period;
+    any = true;
+  }
+  if (envNextUs <= now) {
+    environment();
+    envNextUs = now + 60000000;
+    any = true;
+  }
+  return any;
+}
+
+void worldAdvance(uint64_t untilUs) {
+  uint64_t now = halMicros64();
+  uint64_t next = nextDueUs();
+  if (next > untilUs) {
+    if (untilUs != UINT64_MAX && untilUs > now) halAdvanceUs(untilUs - now);
+    return;
+  }
+  if (next > now) halAdvanceUs(next - now);
+  deliverDue();
+}
+
+void worldPump() {
+  deliverDue();
+}
+
+void worldReport() {
+  printf("Monde : %u appuis, %u coupures du point d'acces\n", (unsigned)stats.presses, (unsigned)stats.outages);
+  printf("  GPS : %u trames (%u Ko), %u octets perdus (debit), %u ACK UBX, %u o AID recus, %u PPS, fix a %.1f s\n",
+         (unsigned)stats.gpsSentences, (unsigned)(stats.gpsBytes / 1024), (unsigned)stats.gpsDropped,
+         (unsigned)stats.ubxAcks, (unsigned)stats.aidBytes, (unsigned)stats.ppsPulses, stats.fixUs / 1e6);
+  printf("  Recepteur GPS a %u bauds, UART a %u bauds, trames GSV %s\n", (unsigned)gps.baud,
+         (unsigned)GPS.baudRate(), gps.gsv ? "actives" : "coupees");
+  printf("  OpenWeather : %u reponses completes, %u meteo courante, %u refus 503\n", (unsigned)stats.owmFull,
+         (unsigned)stats.owmCurrent, (unsigned)stats.owmRefused);
+  printf("  Telegram : %u interrogations, %u commandes livrees, %u messages recus ; AssistNow : %u telechargements\n",
+         (unsigned)stats.tgPolls, (unsigned)stats.tgCommands, (unsigned)stats.tgSent, (unsigned)stats.agpsDownloads);
+}
+
+bool worldGpsOk() {
+  return GPS.baudRate() == gps.baud && gps.baud == GPS_BAUD && !gps.gsv && stats.fixUs;
+}
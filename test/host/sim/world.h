@@ -0,0 +1,29 @@
+// world.h (simulateur)
+#pragma once
+#include "hal.h"
+
+// ====================================================================================
+// Monde simulé autour du firmware : récepteur GPS u-blox 7 (UBX, NMEA 1 Hz, PPS),
+// BME280 et capteur de lumière au rythme des journées, appuis sur les boutons, points
+// d'accès WiFi avec coupures, serveurs OpenWeather (fixtures/sim), Telegram et
+// AssistNow. Tout est déterministe pour une graine donnée.
+// ====================================================================================
+
+struct WorldConfig {
+  time_t startEpoch; // heure UTC du démarrage simulé
+  uint32_t days;     // durée couverte par le scénario (appuis, coupures, commandes)
+  uint32_t seed;
+  bool verbose;      // événements du monde affichés
+  bool alertNow;     // alerte servie dès le démarrage (images de rendu)
+  bool gpsConfigured; // récepteur déjà à GPS_BAUD, trames coupées (redémarrage de l'ESP32 seul)
+};
+
+// Avant setup() : horloge murale, points d'accès, serveurs, niveaux des broches
+bool worldBegin(const WorldConfig &cfg);
+// Rappel halOnIdle : avance jusqu'au prochain événement (livré) ou jusqu'à untilUs
+void worldAdvance(uint64_t untilUs);
+// Livre les événements échus pendant que loop() travaillait
+void worldPump();
+void worldReport();
+// Récepteur GPS lisible à la fin : même débit des deux côtés, trames inutiles coupées, fix
+bool worldGpsOk();
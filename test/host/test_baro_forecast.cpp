@@ -0,0 +1,180 @@
+// test_baro_forecast.cpp
+// Prévision Zambretti (src/baro_forecast.cpp) : tables et classement, puis rejeu des séries
+// de fixtures/baro par baroAddSample sous l'horloge virtuelle (date de la série pour la saison)
+#include "hal.h"
+#include <algorithm>
+#include <dirent.h>
+#include <string>
+#include <vector>
+#include "../../src/baro_forecast.cpp" // historique statique remis à zéro entre deux séries
+#include "check.h"
+
+static const char *FIXTURE_DIR = "fixtures/baro";
+
+// Place millis() sur t (ms depuis le début de la série)
+static uint64_t seriesStartUs = 0;
+static void clockTo(uint32_t ms) {
+  uint64_t target = seriesStartUs + (uint64_t)ms * 1000;
+  uint64_t now = halMicros64();
+  if (target > now) halAdvanceUs(target - now);
+}
+
+static void startSeries(time_t epoch) {
+  history = BaroHistory();
+  seriesStartUs = halMicros64() + 1000000;
+  halSetEpoch(epoch - (time_t)(seriesStartUs / 1000000));
+  clockTo(0);
+}
+
+static void testClassifier() {
+  // Indice Z = a - b x P, borné par tendance (baisse 1..9, stable 10..19, hausse 20..32)
+  CHECK_EQ(zambrettiIndex(1000.0f, -1, 0), 7);
+  CHECK_EQ(zambrettiIndex(1050.0f, -1, 0), 1);
+  CHECK_EQ(zambrettiIndex(950.0f, -1, 0), 9);
+  CHECK_EQ(zambrettiIndex(1020.0f, 0, 0), 11);
+  CHECK_EQ(zambrettiIndex(1060.0f, 0, 0), 10);
+  CHECK_EQ(zambrettiIndex(1030.0f, 1, 0), 20);
+  CHECK_EQ(zambrettiIndex(960.0f, 1, 0), 31);
+  // Saison : hausse en été et baisse en hiver décalées de BARO_SEASON_ADJUST_HPA
+  CHECK_EQ(zambrettiIndex(1000.0f, 1, 0), 25);
+  CHECK_EQ(zambrettiIndex(1000.0f, 1, 1), 24);
+  CHECK_EQ(zambrettiIndex(1000.0f, -1, -1), 8);
+  CHECK_EQ(zambrettiIndex(1000.0f, -1, 1), 7);
+  CHECK_EQ(zambrettiIndex(1000.0f, 1, -1), 25);
+
+  CHECK_EQ(zambrettiLetter(7), 'U');
+  CHECK_EQ(zambrettiLetter(11), 'B');
+  CHECK_EQ(zambrettiLetter(31), 'Y');
+  CHECK_EQ(zambrettiLetter(0), '?');
+  CHECK_EQ(zambrettiLetter(33), '?');
+  CHECK(strcmp(zambrettiText('A'), "Beau temps stable") == 0);
+  CHECK(strcmp(zambrettiIcon('Z'), "storm") == 0);
+  CHECK(strcmp(zambrettiText('?'), "") == 0);
+  CHECK(strcmp(zambrettiIcon('?'), "clouds") == 0);
+  // Chaque indice de 1 à 32 a une lettre, un texte et une icône
+  for (uint8_t z = 1; z <= 32; z++) {
+    char l = zambrettiLetter(z);
+    CHECK(l >= 'A' && l <= 'Z');
+    CHECK(zambrettiText(l)[0] != '\0');
+  }
+
+  CHECK_NEAR(seaLevel(1000.0f, 0.0f), 1000.0, 0.001);
+  CHECK_NEAR(seaLevel(1000.0f, 100.0f), 1011.94, 0.05);
+}
+
+static void testSamples() {
+  startSeries(1760000000); // octobre 2025
+  BaroForecast f = {};
+  baroAddSample(NAN, 45, 44.84, f);
+  baroAddSample(250.0f, 45, 44.84, f);
+  baroAddSample(1200.0f, 45, 44.84, f);
+  CHECK(!f.valid); // capteur absent ou mesure aberrante : rien n'est publié
+
+  // Pression constante : tendance inconnue avant BARO_MIN_SPAN_MS, puis stable
+  uint32_t ms = 0;
+  for (; ms < BARO_MIN_SPAN_MS; ms += REFRESH_SENSOR_MS) {
+    clockTo(ms);
+    baroAddSample(1013.0f, NAN, 44.84, f);
+  }
+  CHECK(f.valid);
+  CHECK(!f.trendValid);
+  CHECK_EQ(f.trend, 0);
+  CHECK_NEAR(f.seaLevelHpa, seaLevel(1013.0f, BARO_DEFAULT_ALT_M), 0.01); // sans GPS : altitude par défaut
+  clockTo(ms);
+  baroAddSample(1013.0f, NAN, 44.84, f);
+  CHECK(f.trendValid);
+  CHECK_NEAR(f.trendHpa3h, 0.0, 0.05);
+
+  // Hausse de 1 hPa/h pendant 2 h : tendance ramenée à 3 h
+  uint32_t rampStart = ms;
+  for (; ms <= rampStart + 2 * 3600000UL; ms += REFRESH_SENSOR_MS) {
+    clockTo(ms);
+    baroAddSample(1013.0f + (ms - rampStart) / 3600000.0f, 45.0f, 44.84, f);
+  }
+  CHECK_EQ(f.trend, 1);
+  CHECK_NEAR(f.trendHpa3h, 2.0, 0.35); // +2 hPa sur les 3 h d'historique (1 h stable, 2 h de hausse)
+  CHECK(f.classifyUs < 1000);
+}
+
+// --- Séries de fixtures/baro ---
+struct Series {
+  std::string name;
+  time_t start = 0;
+  double latitude = 45.0;
+  double trend = NAN;
+  char expected = '?';
+  std::vector<uint32_t> ms;
+  std::vector<float> hpa, alt;
+};
+
+static time_t parseUtc(const char *s) {
+  struct tm tmv = {};
+  if (sscanf(s, "%d-%d-%dT%d:%d:%d", &tmv.tm_year, &tmv.tm_mon, &tmv.tm_mday, &tmv.tm_hour, &tmv.tm_min,
+             &tmv.tm_sec) != 6)
+    return 0;
+  tmv.tm_year -= 1900;
+  tmv.tm_mon -= 1;
+  return timegm(&tmv);
+}
+
+static bool loadSeries(const std::string &path, Series &s) {
+  FILE *fp = fopen(path.c_str(), "r");
+  if (!fp) return false;
+  s.name = path;
+  char line[256];
+  while (fgets(line, sizeof(line), fp)) {
+    char text[64];
+    if (line[0] == '#') {
+      if (sscanf(line, "# debut: %63s", text) == 1) s.start = parseUtc(text);
+      sscanf(line, "# latitude: %lf", &s.latitude);
+      sscanf(line, "# tendance: %lf", &s.trend);
+      sscanf(line, "# attendu: %c", &s.expected);
+      continue;
+    }
+    unsigned long ms;
+    char p[32], a[32];
+    if (sscanf(line, "%lu,%31[^,],%31s", &ms, p, a) != 3) continue; // en-tête des colonnes
+    s.ms.push_back(ms);
+    s.hpa.push_back(strtof(p, nullptr)); // "nan" : mesure manquante
+    s.alt.push_back(strtof(a, nullptr)); // "nan" : pas de fix GPS
+  }
+  fclose(fp);
+  return !s.ms.empty();
+}
+
+static void replaySeries(const Series &s) {
+  startSeries(s.start);
+  BaroForecast f = {};
+  uint32_t worstUs = 0;
+  for (size_t i = 0; i < s.ms.size(); i++) {
+    clockTo(s.ms[i]);
+    baroAddSample(s.hpa[i], s.alt[i], s.latitude, f);
+    worstUs = max(worstUs, f.classifyUs);
+  }
+  CHECK(f.valid && f.trendValid);
+  CHECK_EQ(f.letter, s.expected);
+  if (!isnan(s.trend)) CHECK_NEAR(f.trendHpa3h, s.trend, 0.5);
+  printf("  %s : %.1f hPa mer, %+.1f hPa/3h -> %c %s (attendu %c), classement max %u us\n", s.name.c_str(),
+         f.seaLevelHpa, f.trendHpa3h, f.letter, f.text, s.expected, (unsigned)worstUs);
+}
+
+int main() {
+  testClassifier();
+  testSamples();
+  std::vector<std::string> files;
+  if (DIR *d = opendir(FIXTURE_DIR)) {
+    while (dirent *e = readdir(d)) {
+      std::string n = e->d_name;
+      if (n.size() > 4 && n.compare(n.size() - 4, 4, ".csv") == 0) files.push_back(std::string(FIXTURE_DIR) + "/" + n);
+    }
+    closedir(d);
+  }
+  std::sort(files.begin(), files.end());
+  CHECK(!files.empty());
+  for (const std::string &path : files) {
+    Series s;
+    CHECK(loadSeries(path, s));
+    if (!s.ms.empty()) replaySeries(s);
+  }
+  return checkSummary("test_baro_forecast");
+}
@@ -0,0 +1,253 @@
+// test_nmea.cpp
+// Analyseur GGA/RMC (src/nmea.cpp) : trames connues, cas limites, puis rejeu des journaux
+// de fixtures/gps comparé à un décodage de référence indépendant (doubles, strtod)
+#include <Arduino.h>
+#include <dirent.h>
+#include <string>
+#include <vector>
+#include "nmea.h"
+#include "check.h"
+
+static const char *FIXTURE_DIR = "fixtures/gps";
+
+// Trame complète avec sa somme de contrôle
+static std::string sentence(const char *body) {
+  uint8_t sum = 0;
+  for (const char *c = body; *c; c++) sum ^= (uint8_t)*c;
+  char tail[8];
+  snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+  return std::string("$") + body + tail;
+}
+
+// Nombre de trames acceptées pendant l'envoi de s
+static int feed(NmeaParser &p, const std::string &s) {
+  int accepted = 0;
+  for (char c : s) accepted += p.encode(c);
+  return accepted;
+}
+
+static void testGga() {
+  NmeaParser p;
+  CHECK_EQ(feed(p, sentence("GPGGA,143512.00,4450.77412,N,00034.66120,W,1,08,1.02,27.4,M,49.5,M,,")), 1);
+  const NmeaFix &f = p.fix();
+  CHECK_EQ(f.latE7, 448462353);  // 44° + 50,77412' / 60
+  CHECK_EQ(f.lonE7, -5776866);   // -(34,66120' / 60)
+  CHECK_EQ(f.altCm, 2740);
+  CHECK_EQ(f.hdopX100, 102);
+  CHECK_EQ(f.sats, 8);
+  CHECK_EQ(f.quality, 1);
+  CHECK_EQ(f.utcMs, (14 * 3600 + 35 * 60 + 12) * 1000UL);
+  CHECK_EQ(p.sentencesOk, 1);
+  CHECK_EQ(p.checksumErrors, 0);
+}
+
+static void testRmc() {
+  NmeaParser p;
+  CHECK_EQ(feed(p, sentence("GPRMC,143512.00,A,4450.77412,N,00034.66120,W,0.412,,191026,,,A")), 1);
+  CHECK(p.fix().rmcValid);
+  CHECK_EQ(p.fix().dateDmy, 191026);
+  CHECK_EQ(p.fix().latE7, 448462353);
+  // Statut 'V' : position invalide, le fix précédent reste
+  CHECK_EQ(feed(p, sentence("GPRMC,143513.00,V,4451.00000,N,00034.66120,W,,,191026,,,N")), 0);
+  CHECK_EQ(p.fix().latE7, 448462353);
+}
+
+static void testHemispheresAndTalkers() {
+  NmeaParser p;
+  CHECK_EQ(feed(p, sentence("GNGGA,000001.50,3351.12345,S,15112.54321,E,2,12,0.6,-12.30,M,,M,,")), 1);
+  CHECK_EQ(p.fix().latE7, -338520575);
+  CHECK_EQ(p.fix().lonE7, 1512090535);
+  CHECK_EQ(p.fix().altCm, -1230);
+  CHECK_EQ(p.fix().hdopX100, 60);
+  CHECK_EQ(p.fix().quality, 2);
+  CHECK_EQ(p.fix().utcMs, 1500);
+  CHECK_EQ(feed(p, sentence("GLGGA,235959.999,0000.00000,N,00000.00000,E,1,04,9.9,0,M,,M,,")), 1);
+  CHECK_EQ(p.fix().utcMs, 86399999UL);
+}
+
+static void testRejections() {
+  NmeaParser p;
+  feed(p, sentence("GPGGA,143512.00,4450.77412,N,00034.66120,W,1,08,1.02,27.4,M,49.5,M,,"));
+
+  // Somme de contrôle fausse
+  std::string bad = sentence("GPGGA,143513.00,4450.77412,N,00034.66120,W,1,09,1.02,27.4,M,49.5,M,,");
+  bad[bad.size() - 3] = bad[bad.size() - 3] == '0' ? '1' : '0';
+  CHECK_EQ(feed(p, bad), 0);
+  CHECK_EQ(p.checksumErrors, 1);
+  CHECK_EQ(p.fix().sats, 8);
+
+  // Chiffre hexadécimal invalide
+  CHECK_EQ(feed(p, "$GPGGA,143513.00,,,,,0,00,,,,,,,*G1\r\n"), 0);
+  CHECK_EQ(p.checksumErrors, 2);
+
+  // Trame sans somme de contrôle : refusée sans compter d'erreur
+  CHECK_EQ(feed(p, "$GPGGA,143514.00,4450.77412,N,00034.66120,W,1,09,1.02,27.4,M,49.5,M,,\r\n"), 0);
+  CHECK_EQ(p.checksumErrors, 2);
+
+  // Qualité 0 : pas de fix, la position précédente reste mais la qualité tombe
+  CHECK_EQ(feed(p, sentence("GPGGA,143515.00,,,,,0,03,99.99,,,,,,")), 0);
+  CHECK_EQ(p.fix().quality, 0);
+  CHECK_EQ(p.fix().sats, 3);
+  CHECK_EQ(p.fix().latE7, 448462353);
+  CHECK_EQ(p.sentencesOk, 1);
+}
+
+static void testResyncAndSkip() {
+  NmeaParser p;
+  // Trame coupée (octets perdus) : le '$' suivant repart de zéro
+  std::string s = "$GPGGA,1435";
+  s += sentence("GPRMC,143512.00,A,4450.77412,N,00034.66120,W,0.412,,191026,,,A");
+  CHECK_EQ(feed(p, s), 1);
+  CHECK(p.fix().rmcValid);
+
+  // Autres trames : ignorées dès l'en-tête, même sans somme de contrôle correcte
+  feed(p, sentence("GPGSV,3,1,11,02,47,302,31,05,21,228,25,13,66,071,35,15,40,131,33"));
+  feed(p, sentence("GPVTG,,T,,M,0.412,N,0.763,K,A"));
+  feed(p, "$GPGLL,garbage*00\r\n");
+  CHECK_EQ(p.sentencesSkipped, 3);
+  CHECK_EQ(p.checksumErrors, 0);
+
+  // Champ trop long : tronqué dans le tampon, sans débordement
+  CHECK_EQ(feed(p, sentence("GPGGA,143516.00,4450.77412,N,00034.66120,W,1,08,1.02,27.4,M,49.5,M,12345678901234567890,")),
+           1);
+  CHECK_EQ(p.fix().sats, 8);
+
+  // Altitude gardée par le RMC suivant (le RMC ne la porte pas)
+  feed(p, sentence("GPGGA,143517.00,4450.77412,N,00034.66120,W,1,08,1.02,31.7,M,49.5,M,,"));
+  feed(p, sentence("GPRMC,143517.00,A,4450.77412,N,00034.66120,W,0.412,,191026,,,A"));
+  CHECK_EQ(p.fix().altCm, 3170);
+}
+
+// --- Décodage de référence d'une ligne de journal ---
+struct RefSentence {
+  bool framed;      // commence par '$' et porte "*hh"
+  bool checksumOk;
+  bool skipped;     // en-tête de 5 caractères autre que GGA/RMC
+  bool accepted;    // GGA avec qualité > 0 ou RMC 'A'
+  bool gga;
+  double lat, lon, alt, hdop;
+  long sats, utcMs, date;
+};
+
+static std::vector<std::string> split(const std::string &s, char sep) {
+  std::vector<std::string> out(1);
+  for (char c : s) {
+    if (c == sep) out.emplace_back();
+    else out.back() += c;
+  }
+  return out;
+}
+
+static double angle(const std::string &v, const std::string &hemi, int degDigits) {
+  if (v.size() <= (size_t)degDigits) return 0;
+  double a = atof(v.substr(0, degDigits).c_str()) + strtod(v.c_str() + degDigits, nullptr) / 60.0;
+  return (hemi == "S" || hemi == "W") ? -a : a;
+}
+
+static long utc(const std::string &v) {
+  if (v.size() < 6) return -1;
+  return (long)llround((atoi(v.substr(0, 2).c_str()) * 3600 + atoi(v.substr(2, 2).c_str()) * 60) * 1000.0 +
+                       strtod(v.c_str() + 4, nullptr) * 1000.0);
+}
+
+static RefSentence reference(const std::string &line) {
+  RefSentence r = {};
+  size_t star = line.find('*');
+  if (line.empty() || line[0] != '$') return r;
+  std::string body = line.substr(1, star == std::string::npos ? std::string::npos : star - 1);
+  std::vector<std::string> f = split(body, ',');
+  r.skipped = f[0].size() != 5 || (f[0].compare(2, 3, "GGA") != 0 && f[0].compare(2, 3, "RMC") != 0);
+  if (star == std::string::npos || star + 3 > line.size()) return r;
+  r.framed = true;
+  uint8_t sum = 0;
+  for (char c : body) sum ^= (uint8_t)c;
+  r.checksumOk = strtol(line.substr(star + 1, 2).c_str(), nullptr, 16) == sum && isxdigit(line[star + 1]) &&
+                 isxdigit(line[star + 2]);
+  if (!r.checksumOk || r.skipped) return r;
+  r.gga = f[0].compare(2, 3, "GGA") == 0;
+  if (r.gga && f.size() > 9) {
+    r.accepted = atoi(f[6].c_str()) > 0;
+    r.utcMs = utc(f[1]);
+    r.lat = angle(f[2], f[3], 2);
+    r.lon = angle(f[4], f[5], 3);
+    r.sats = atol(f[7].c_str());
+    r.hdop = atof(f[8].c_str());
+    r.alt = atof(f[9].c_str());
+  } else if (!r.gga && f.size() > 9) {
+    r.accepted = f[2] == "A";
+    r.utcMs = utc(f[1]);
+    r.lat = angle(f[3], f[4], 2);
+    r.lon = angle(f[5], f[6], 3);
+    r.date = atol(f[9].c_str());
+  }
+  return r;
+}
+
+static std::vector<std::string> fixtureFiles() {
+  std::vector<std::string> files;
+  if (DIR *d = opendir(FIXTURE_DIR)) {
+    while (dirent *e = readdir(d)) {
+      std::string n = e->d_name;
+      if (n.size() > 5 && n.compare(n.size() - 5, 5, ".nmea") == 0) files.push_back(std::string(FIXTURE_DIR) + "/" + n);
+    }
+    closedir(d);
+  }
+  return files;
+}
+
+static void replayFixture(const std::string &path) {
+  FILE *fp = fopen(path.c_str(), "rb");
+  CHECK(fp != nullptr);
+  if (!fp) return;
+  NmeaParser p;
+  char raw[512];
+  uint32_t lines = 0, accepted = 0, expectedErrors = 0, expectedSkipped = 0;
+  int mismatches = 0;
+  while (fgets(raw, sizeof(raw), fp)) {
+    std::string line = raw;
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+    RefSentence ref = reference(line);
+    int got = feed(p, std::string(raw));
+    lines++;
+    if (ref.framed && !ref.checksumOk && !ref.skipped) expectedErrors++;
+    if (!line.empty() && line[0] == '$' && ref.skipped) expectedSkipped++;
+    if (got != (ref.accepted ? 1 : 0)) {
+      if (mismatches++ < 5) printf("  %s : ligne %u acceptee=%d, attendu %d : %s\n", path.c_str(), lines, got,
+                                   ref.accepted, line.c_str());
+      continue;
+    }
+    if (!got) continue;
+    accepted++;
+    const NmeaFix &f = p.fix();
+    // Troncature en virgule fixe : au plus une unité de la dernière décimale
+    CHECK_NEAR(f.latE7, llround(ref.lat * 1e7), 1);
+    CHECK_NEAR(f.lonE7, llround(ref.lon * 1e7), 1);
+    CHECK_EQ(f.utcMs, ref.utcMs);
+    if (ref.gga) {
+      CHECK_EQ(f.sats, ref.sats);
+      CHECK_NEAR(f.hdopX100, ref.hdop * 100, 1);
+      CHECK_NEAR(f.altCm, ref.alt * 100, 1);
+    } else {
+      CHECK_EQ(f.dateDmy, ref.date);
+    }
+  }
+  fclose(fp);
+  CHECK_EQ(mismatches, 0);
+  CHECK_EQ(p.sentencesOk, accepted);
+  CHECK_EQ(p.checksumErrors, expectedErrors);
+  CHECK_EQ(p.sentencesSkipped, expectedSkipped);
+  printf("  %s : %u lignes, %u positions, %u erreurs de somme, %u trames ignorees\n", path.c_str(), lines,
+         accepted, (unsigned)p.checksumErrors, (unsigned)p.sentencesSkipped);
+}
+
+int main() {
+  testGga();
+  testRmc();
+  testHemispheresAndTalkers();
+  testRejections();
+  testResyncAndSkip();
+  std::vector<std::string> files = fixtureFiles();
+  CHECK(!files.empty());
+  for (const std::string &f : files) replayFixture(f);
+  return checkSummary("test_nmea");
+}
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""Bouchon local du service AssistNow Online pour tester la station sans jeton.
+
+Usage :
+    python3 tools/agps_stub.py capture.ubx [--port 8080]
+
+puis dans config.h :
+    #define AGPS_URL "http://<ip-du-pc>:8080/GetOnlineData.ashx"
+
+Chaque requête reçoit le contenu de capture.ubx (une réponse AssistNow
+enregistrée, format 'aid'). Les paramètres de la requête sont affichés pour
+vérifier le jeton, la position et les types de données demandés.
+"""
+import argparse
+import http.server
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("capture")
+    ap.add_argument("--port", type=int, default=8080)
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as f:
+        payload = f.read()
+
+    class Handler(http.server.BaseHTTPRequestHandler):
+        def do_GET(self):
+            path, _, query = self.path.partition("?")
+            if not path.endswith("GetOnlineData.ashx"):
+                self.send_error(404)
+                return
+            print("requete:", ";".join(p for p in query.split(";") if not p.startswith("token=")))
+            self.send_response(200)
+            self.send_header("Content-Type", "application/ubx")
+            self.send_header("Content-Length", str(len(payload)))
+            self.end_headers()
+            self.wfile.write(payload)
+
+    print("AssistNow bouchon sur le port %d (%d o)" % (args.port, len(payload)))
+    http.server.HTTPServer(("", args.port), Handler).serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Comparaison de deux séries de micro-bancs d'essai de la station.
+
+Usage :
+    pio run -e Meteo_Station_bench -t upload && pio device monitor | tee bench.log
+    python3 tools/bench_compare.py reference.log bench.log [--seuil 5] [--csv]
+
+Chaque journal série contient des lignes "BENCH {...}" (voir include/bench.h) :
+une ligne d'en-tête ("begin"), une par cas (cycles min/médiane/moyenne/max) et une
+ligne de fin. Si un journal contient plusieurs séries (bouton appuyé), la dernière
+complète est retenue. Les cas sont comparés sur la médiane des cycles : un cas plus
+lent de plus de --seuil % est une régression et le code de sortie vaut 1. Aucune
+dépendance externe.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Dernière série complète du journal : (en-tête, {cas: résultat})."""
+    header, cases, done = None, {}, None
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            pos = line.find("BENCH {")
+            if pos < 0:
+                continue
+            try:
+                rec = json.loads(line[pos + 6:])
+            except ValueError:
+                continue  # ligne coupée par un autre message série
+            if "begin" in rec:
+                header, cases = rec, {}
+            elif "case" in rec:
+                cases[rec["case"]] = rec
+            elif "end" in rec and header is not None:
+                done = (header, cases)
+    if done is None:
+        if not cases:
+            sys.exit(f"{path} : aucune ligne BENCH")
+        print(f"{path} : serie incomplete (pas de ligne de fin)", file=sys.stderr)
+        done = (header or {}, cases)
+    return done
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("reference", help="journal série de référence")
+    parser.add_argument("candidat", help="journal série à comparer")
+    parser.add_argument("--seuil", type=float, default=5.0,
+                        help="écart de médiane (%%) au-delà duquel un cas est signalé (5)")
+    parser.add_argument("--csv", action="store_true", help="sortie CSV")
+    args = parser.parse_args()
+
+    ref_head, ref = load(args.reference)
+    new_head, new = load(args.candidat)
+    if ref_head.get("cpu_mhz") != new_head.get("cpu_mhz"):
+        print(f"ATTENTION : frequences CPU differentes ({ref_head.get('cpu_mhz')} / "
+              f"{new_head.get('cpu_mhz')} MHz)", file=sys.stderr)
+
+    rows, regressions = [], 0
+    for name in list(ref) + [n for n in new if n not in ref]:
+        a, b = ref.get(name), new.get(name)
+        if a is None or b is None:
+            rows.append((name, a and a["med"], b and b["med"], None, "absent" if b is None else "nouveau"))
+            continue
+        delta = (b["med"] - a["med"]) * 100.0 / max(a["med"], 1)
+        if delta > args.seuil:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif delta < -args.seuil:
+            verdict = "amelioration"
+        else:
+            verdict = ""
+        rows.append((name, a["med"], b["med"], delta, verdict))
+
+    if args.csv:
+        print("cas,reference_cycles,candidat_cycles,ecart_pct,verdict")
+        for name, a, b, delta, verdict in rows:
+            print(f"{name},{a if a is not None else ''},{b if b is not None else ''},"
+                  f"{'' if delta is None else f'{delta:.1f}'},{verdict}")
+    else:
+        print(f"Reference : {ref_head.get('version', '?')}  Candidat : {new_head.get('version', '?')}  "
+              f"(mediane des cycles, seuil {args.seuil:g} %)")
+        width = max(len(r[0]) for r in rows)
+        for name, a, b, delta, verdict in rows:
+            cells = (f"{a if a is not None else '-':>12} {b if b is not None else '-':>12} "
+                     f"{'' if delta is None else f'{delta:+7.1f} %':>9}")
+            print(f"{name:<{width}} {cells}  {verdict}")
+        print(f"{regressions} regression(s) sur {len(rows)} cas")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
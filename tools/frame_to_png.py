@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Convertit les captures [FRAME] du port série en images PNG.
+
+Usage :
+    pio device monitor | tee boot.log
+    python3 tools/frame_to_png.py boot.log [--out captures] [--ref references]
+
+Avec --ref, chaque page est comparée au PNG de même nom du dossier de
+référence et le nombre de pixels différents est affiché (code retour 1 si
+au moins une page diffère).
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+HEADER = re.compile(r"\[FRAME\] page=(\d+) w=(\d+) h=(\d+) rle=(\d+)")
+
+
+def parse_frames(lines):
+    frame = None
+    for line in lines:
+        line = line.strip()
+        m = HEADER.search(line)
+        if m:
+            frame = {"page": int(m.group(1)), "w": int(m.group(2)), "h": int(m.group(3)), "hex": []}
+        elif frame is not None and line.endswith("[FRAME] fin"):
+            yield frame
+            frame = None
+        elif frame is not None:
+            frame["hex"].append(line)
+
+
+def decode_rle(data, count):
+    """Suites [longueur-1][couleur LSB][couleur MSB] en RGB565 -> liste de (r, g, b)."""
+    pixels = []
+    for i in range(0, len(data) - 2, 3):
+        color = data[i + 1] | (data[i + 2] << 8)
+        rgb = (((color >> 11) & 0x1F) * 255 // 31, ((color >> 5) & 0x3F) * 255 // 63, (color & 0x1F) * 255 // 31)
+        pixels.extend([rgb] * (data[i] + 1))
+    if len(pixels) != count:
+        raise ValueError("image tronquee: %d pixels au lieu de %d" % (len(pixels), count))
+    return pixels
+
+
+def write_png(path, w, h, pixels):
+    raw = bytearray()
+    for y in range(h):
+        raw.append(0)
+        for r, g, b in pixels[y * w:(y + 1) * w]:
+            raw += bytes((r, g, b))
+
+    def chunk(tag, body):
+        return struct.pack(">I", len(body)) + tag + body + struct.pack(">I", zlib.crc32(tag + body) & 0xFFFFFFFF)
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", w, h, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(bytes(raw), 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def read_png(path):
+    """Lecteur minimal pour les PNG produits par write_png (RGB 8 bits, filtre 0)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    pos, idat, w, h = 8, b"", 0, 0
+    while pos < len(data):
+        (length,) = struct.unpack(">I", data[pos:pos + 4])
+        tag, body = data[pos + 4:pos + 8], data[pos + 8:pos + 8 + length]
+        if tag == b"IHDR":
+            w, h = struct.unpack(">II", body[:8])
+        elif tag == b"IDAT":
+            idat += body
+        pos += 12 + length
+    raw = zlib.decompress(idat)
+    stride = w * 3 + 1
+    return w, h, [tuple(raw[y * stride + 1 + x * 3:y * stride + 4 + x * 3]) for y in range(h) for x in range(w)]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log")
+    ap.add_argument("--out", default="captures")
+    ap.add_argument("--ref")
+    args = ap.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    with open(args.log, errors="replace") as f:
+        frames = list(parse_frames(f))
+    if not frames:
+        print("Aucune capture [FRAME] (RENDER_FRAME_DUMP=1 dans config.h ?)")
+        return 1
+
+    differs = False
+    for fr in frames:
+        pixels = decode_rle(bytes.fromhex("".join(fr["hex"])), fr["w"] * fr["h"])
+        name = "page%d.png" % fr["page"]
+        write_png(os.path.join(args.out, name), fr["w"], fr["h"], pixels)
+        msg = "%s: %dx%d" % (name, fr["w"], fr["h"])
+        ref = os.path.join(args.ref, name) if args.ref else None
+        if ref and os.path.exists(ref):
+            rw, rh, rpx = read_png(ref)
+            diff = sum(1 for a, b in zip(pixels, rpx) if a != b) if (rw, rh) == (fr["w"], fr["h"]) else fr["w"] * fr["h"]
+            msg += ", %d pixels differents de la reference" % diff
+            differs |= diff > 0
+        print(msg)
+    return 1 if differs else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Serveur local d'images firmware pour mesurer les mises à jour OTA.
+
+Usage :
+    python3 tools/ota_server.py [.pio/build/Meteo_Station/firmware.bin] --cle ota_key.pem [--port 8000]
+
+L'image est servie telle quelle (/firmware.bin) et compressée gzip
+(/firmware.bin.gz), chacune avec sa signature détachée (<chemin>.sig) : signature
+DER du SHA-256 de l'image décompressée par la clé privée (openssl), vérifiée par la
+station avec OTA_SIGNING_PUBKEY. Le serveur affiche le SHA-256 de l'image, les commandes
+de déclenchement (Telegram et point d'entrée local de la station), puis pour
+chaque téléchargement la taille transférée, la durée et le débit. La station
+journalise de son côté ([OTA]) la durée totale et le plus long blocage de
+l'écran ; comparer les deux variantes donne le gain de la compression.
+"""
+import argparse
+import gzip
+import hashlib
+import http.server
+import socket
+import subprocess
+import sys
+import time
+
+
+def local_ip():
+    s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    try:
+        s.connect(("192.0.2.1", 9))  # aucun paquet envoyé : choix de l'interface seulement
+        return s.getsockname()[0]
+    finally:
+        s.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("firmware", nargs="?", default=".pio/build/Meteo_Station/firmware.bin")
+    ap.add_argument("--cle", required=True, help="clé privée PEM de signature (hors du dépôt)")
+    ap.add_argument("--port", type=int, default=8000)
+    ap.add_argument("--station", default="<ip-station>", help="adresse de la station (commande curl)")
+    args = ap.parse_args()
+
+    with open(args.firmware, "rb") as f:
+        image = f.read()
+    packed = gzip.compress(image, compresslevel=9, mtime=0)
+    sha = hashlib.sha256(image).hexdigest()
+    try:
+        sig = subprocess.run(["openssl", "dgst", "-sha256", "-sign", args.cle], input=image,
+                             stdout=subprocess.PIPE, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.exit("signature impossible (openssl) : %s" % e)
+    files = {"/firmware.bin": image, "/firmware.bin.gz": packed, "/firmware.bin.sig": sig, "/firmware.bin.gz.sig": sig}
+
+    class Handler(http.server.BaseHTTPRequestHandler):
+        def do_GET(self):
+            payload = files.get(self.path.partition("?")[0])
+            if payload is None:
+                self.send_error(404)
+                return
+            t0 = time.monotonic()
+            self.send_response(200)
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Length", str(len(payload)))
+            self.end_headers()
+            self.wfile.write(payload)
+            dt = time.monotonic() - t0
+            print("%s : %d o en %.2f s (%.1f Ko/s)" % (self.path, len(payload), dt, len(payload) / 1024 / max(dt, 1e-6)))
+
+        def log_message(self, fmt, *a):
+            pass
+
+    base = "http://%s:%d" % (local_ip(), args.port)
+    print("Image %d o, gzip %d o (-%d %%)" % (len(image), len(packed), 100 - len(packed) * 100 // len(image)))
+    print("SHA-256 %s, signature %d o" % (sha, len(sig)))
+    print("Telegram : /ota %s/firmware.bin.gz %s" % (base, sha))
+    print("Local    : curl -X POST -H 'X-OTA-Token: <OTA_HTTP_TOKEN>' --data-urlencode 'url=%s/firmware.bin.gz' "
+          "--data-urlencode 'sha256=%s' http://%s/ota" % (base, sha, args.station))
+    http.server.HTTPServer(("", args.port), Handler).serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Décodeur des trames de télémétrie MessagePack de la station.
+
+Usage :
+    python3 tools/telemetry_decode.py http://<station>/telemetry
+    python3 tools/telemetry_decode.py http://<station>/telemetry.log [--csv]
+    python3 tools/telemetry_decode.py telemetry.bin [--csv]
+    python3 tools/telemetry_decode.py 97 01 ce ...      (trame en hexadécimal)
+
+Une URL ou un fichier se terminant par .log/.bin est lu comme un journal
+(trames précédées de leur longueur sur 2 octets, gros-boutiste). Les noms et
+les échelles des champs dépendent de la version du schéma (premier élément
+de la trame) : voir include/telemetry_frame.h. Aucune dépendance externe.
+"""
+import argparse
+import datetime
+import struct
+import sys
+import urllib.request
+
+# Champs par version : (groupe, [(nom, diviseur), ...]) ; diviseur None = valeur brute
+SCHEMAS = {
+    1: [
+        ("interieur", [("temp_c", 100), ("hum_pct", 10), ("p_station_hpa", 10), ("p_mer_hpa", 10),
+                       ("tendance_hpa_3h", 10), ("zambretti", None)]),
+        ("exterieur", [("temp_c", 100), ("hum_pct", 1), ("vent_ms", 100), ("code", None),
+                       ("temp_min_c", 100), ("temp_max_c", 100), ("alerte", None), ("age_s", None)]),
+        ("gps", [("lat", 1e7), ("lon", 1e7), ("alt_m", 100), ("sats", None), ("hdop", 100), ("fix", None)]),
+        ("systeme", [("tas_libre", None), ("plus_grand_bloc", None), ("cpu_libre_pct", None),
+                     ("rssi_dbm", None), ("coupures_wifi", None), ("requetes_meteo", None)]),
+    ],
+}
+
+
+class Reader:
+    """Sous-ensemble de MessagePack produit par ArduinoJson (pas d'ext ni de bin)."""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, n):
+        if self.pos + n > len(self.data):
+            raise ValueError("trame tronquee")
+        chunk = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return chunk
+
+    def unpack(self, fmt):
+        return struct.unpack(">" + fmt, self.take(struct.calcsize(">" + fmt)))[0]
+
+    def value(self):
+        b = self.take(1)[0]
+        if b <= 0x7F:
+            return b
+        if b >= 0xE0:
+            return b - 0x100
+        if 0x90 <= b <= 0x9F:
+            return [self.value() for _ in range(b & 0x0F)]
+        if 0x80 <= b <= 0x8F:
+            return {self.value(): self.value() for _ in range(b & 0x0F)}
+        if 0xA0 <= b <= 0xBF:
+            return self.take(b & 0x1F).decode("utf-8")
+        simple = {0xC0: None, 0xC2: False, 0xC3: True}
+        if b in simple:
+            return simple[b]
+        numbers = {0xCA: "f", 0xCB: "d", 0xCC: "B", 0xCD: "H", 0xCE: "I", 0xCF: "Q",
+                   0xD0: "b", 0xD1: "h", 0xD2: "i", 0xD3: "q"}
+        if b in numbers:
+            return self.unpack(numbers[b])
+        if b in (0xD9, 0xDA, 0xDB):
+            return self.take(self.unpack({0xD9: "B", 0xDA: "H", 0xDB: "I"}[b])).decode("utf-8")
+        if b in (0xDC, 0xDD):
+            return [self.value() for _ in range(self.unpack("H" if b == 0xDC else "I"))]
+        if b in (0xDE, 0xDF):
+            return {self.value(): self.value() for _ in range(self.unpack("H" if b == 0xDE else "I"))}
+        raise ValueError("type MessagePack non gere: 0x%02x" % b)
+
+
+def decode_frame(data):
+    frame = Reader(data).value()
+    if not isinstance(frame, list) or not frame:
+        raise ValueError("trame invalide")
+    version = frame[0]
+    if version not in SCHEMAS:
+        raise ValueError("schema %s inconnu" % version)
+    out = {
+        "schema": version,
+        "heure": datetime.datetime.fromtimestamp(frame[1]).isoformat() if frame[1] else None,
+        "uptime_s": frame[2],
+    }
+    for (group, fields), values in zip(SCHEMAS[version], frame[3:]):
+        for (name, scale), v in zip(fields, values):
+            if scale is not None and v is not None:
+                v = round(v / scale, 7)
+            out[group + "." + name] = v
+    return out
+
+
+def split_log(data):
+    pos = 0
+    while pos + 2 <= len(data):
+        n = struct.unpack(">H", data[pos:pos + 2])[0]
+        if n == 0 or pos + 2 + n > len(data):
+            break  # fin de journal écrite partiellement (coupure d'alimentation)
+        yield data[pos + 2:pos + 2 + n]
+        pos += 2 + n
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("source", nargs="+", help="URL, fichier journal ou octets hexadécimaux")
+    ap.add_argument("--csv", action="store_true", help="une ligne par trame")
+    args = ap.parse_args()
+
+    src = args.source[0]
+    is_log = src.endswith(".log") or src.endswith(".bin")
+    if src.startswith("http://"):
+        data = urllib.request.urlopen(src, timeout=10).read()
+    elif len(args.source) == 1 and not all(c in "0123456789abcdefABCDEF" for c in src):
+        with open(src, "rb") as f:
+            data = f.read()
+    else:
+        data = bytes.fromhex("".join(args.source))
+        is_log = False
+
+    frames = list(split_log(data)) if is_log else [data]
+    rows = [decode_frame(f) for f in frames]
+    if args.csv:
+        keys = list(rows[0].keys()) if rows else []
+        print(",".join(keys))
+        for row in rows:
+            print(",".join("" if row.get(k) is None else str(row.get(k)) for k in keys))
+    else:
+        for frame, row in zip(frames, rows):
+            print("--- %d octets" % len(frame))
+            for k, v in row.items():
+                print("  %-28s %s" % (k, v))
+    if is_log:
+        print("%d trames, %d octets (%.1f o/trame)" % (len(rows), len(data), len(data) / max(len(rows), 1)),
+              file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()